@@ -21,6 +21,22 @@
 #define AK_HASH_MAP_INITIAL_ITEM_CAPACITY 64
 #endif
 
+#ifndef AK_HASH_MAP_SMALL_CAPACITY
+#define AK_HASH_MAP_SMALL_CAPACITY 16
+#endif
+
+#ifndef AK_HASH_MAP_BATCH_SIZE
+#define AK_HASH_MAP_BATCH_SIZE 16
+#endif
+
+#ifndef AK_HASH_MAP_REHASH_STEP
+#define AK_HASH_MAP_REHASH_STEP 64
+#endif
+
+#ifndef AK_BTREE_NODE_SIZE
+#define AK_BTREE_NODE_SIZE 256
+#endif
+
 #include <stdint.h>
 #include <stdarg.h>
 
@@ -183,6 +199,31 @@ ak_arena* AK_Create_Arena(uint64_t InitialBlockSize = AK_ARENA_INITIAL_BLOCK_SIZ
 void AK_Delete(ak_arena* Arena);
 void* operator new(size_t Size, ak_arena* Arena);
 
+//~Slab definition
+struct ak__slab_block
+{
+    ak__slab_block* Next;
+};
+
+//NOTE(EVERYONE): Fixed size blocks pushed from an arena. Freed blocks go onto a free list and are handed out again 
+//before the arena grows, so many containers with the same block size can share one slab
+struct ak_slab
+{
+    ak_arena*       Arena;
+    uint64_t        BlockSize;
+    uint64_t        BlockAlignment;
+    ak__slab_block* FreeBlocks;
+    uint64_t        FreeBlockCount;
+    
+    void* Push_Block(ak_arena_clear_flag ClearFlag = AK_ARENA_CLEAR);
+    bool Push_Blocks(void** Blocks, uint64_t Count, ak_arena_clear_flag ClearFlag = AK_ARENA_CLEAR);
+    void Free_Block(void* Block);
+};
+
+ak_slab* AK_Create_Slab(uint64_t BlockSize, uint64_t BlockAlignment = 8, uint64_t ArenaBlockSize = AK_ARENA_INITIAL_BLOCK_SIZE, 
+                        ak_allocator* Allocator = NULL);
+void AK_Delete(ak_slab* Slab);
+
 //~Heap definition
 #if 0
 struct ak_heap : public ak_allocator
@@ -229,6 +270,41 @@ template <typename type> void AK_Delete(ak_dynamic_array<type>* Array);
 template <typename type, uint64_t bucket_capacity>
 struct ak_bucket_array;
 
+template <uint64_t value>
+struct ak__log2
+{
+    static const uint64_t Value = 1 + ak__log2<value/2>::Value;
+};
+
+template <>
+struct ak__log2<1>
+{
+    static const uint64_t Value = 0;
+};
+
+//NOTE(EVERYONE): Maps a flat index into a bucket index and an entry index. Power of two capacities 
+//become a shift and a mask, everything else divides through a reciprocal computed at compile time
+template <uint64_t bucket_capacity, bool is_pow2 = ((bucket_capacity & (bucket_capacity-1)) == 0)>
+struct ak__bucket_indexer
+{
+    static const uint64_t Reciprocal = ((uint64_t)-1) / bucket_capacity + 1;
+    
+    static uint64_t Get_Bucket_Index(uint64_t Index);
+    static uint64_t Get_Entry_Index(uint64_t Index, uint64_t BucketIndex);
+    static uint64_t Get_Base_Index(uint64_t BucketIndex);
+};
+
+template <uint64_t bucket_capacity>
+struct ak__bucket_indexer<bucket_capacity, true>
+{
+    static const uint64_t Shift = ak__log2<bucket_capacity>::Value;
+    static const uint64_t Mask = bucket_capacity-1;
+    
+    static uint64_t Get_Bucket_Index(uint64_t Index);
+    static uint64_t Get_Entry_Index(uint64_t Index, uint64_t BucketIndex);
+    static uint64_t Get_Base_Index(uint64_t BucketIndex);
+};
+
 template <typename type, uint64_t bucket_capacity>
 struct ak__bucket
 {
@@ -236,23 +312,47 @@ struct ak__bucket
     uint64_t Length;
 };
 
+//NOTE(EVERYONE): The end iterator is a sentinel with a null entry pointer. Iterating only 
+//compares pointers and touches the bucket list when a bucket runs out
 template <typename type, uint64_t bucket_capacity>
 struct ak_bucket_array_iterator
 {
-    ak_bucket_array<type, bucket_capacity>* Array;
-    uint64_t CurrentBucketIndex;
-    uint64_t CurrentIndexInBucket;
+    ak__bucket<type, bucket_capacity>** Bucket = NULL;
+    ak__bucket<type, bucket_capacity>** LastBucket = NULL;
+    type* At = NULL;
+    type* End = NULL;
     
     type& operator*();
     void operator++();
     bool operator!=(const ak_bucket_array_iterator& Iterator);
 };
 
+template <typename type, uint64_t bucket_capacity>
+struct ak_bucket_array_span_iterator
+{
+    ak__bucket<type, bucket_capacity>** Bucket;
+    
+    ak_array<type> operator*();
+    void operator++();
+    bool operator!=(const ak_bucket_array_span_iterator& Iterator);
+};
+
+template <typename type, uint64_t bucket_capacity>
+struct ak_bucket_array_spans
+{
+    ak__bucket<type, bucket_capacity>** FirstBucket;
+    ak__bucket<type, bucket_capacity>** EndBucket;
+    
+    ak_bucket_array_span_iterator<type, bucket_capacity> begin();
+    ak_bucket_array_span_iterator<type, bucket_capacity> end();
+};
+
 template <typename type, uint64_t bucket_capacity = AK_ARRAY_BUCKET_INITIAL_CAPACITY>
 struct ak_bucket_array
 {
     ak_allocator* Allocator = NULL;
-    ak_arena* Storage = NULL;
+    ak_slab* Storage = NULL;
+    bool OwnsStorage = false;
     ak_dynamic_array<ak__bucket<type, bucket_capacity>*> Buckets = {};
     uint64_t CurrentBucketIndex = 0;
     uint64_t Length = 0;
@@ -260,6 +360,7 @@ struct ak_bucket_array
     bool Add(const type& Entry);
     bool Add_Range(const type* Entries, uint64_t Count);
     bool Add_Range(const type* Start, const type* End);
+    ak_array<ak_array<type>> Push_Uninitialized(uint64_t Count, ak_arena* Arena);
     
     type* Pop();
     
@@ -269,18 +370,56 @@ struct ak_bucket_array
     bool Resize(uint64_t NewLength);
     
     void Clear();
+    void Trim();
     
     ak_buffer Get_Buffer(ak_arena* Arena);
     ak_array<type> Get_Array(ak_arena* Arena);
     
     ak_bucket_array<type, bucket_capacity> Copy();
     
+    ak_bucket_array_spans<type, bucket_capacity> Spans();
+    
     ak_bucket_array_iterator<type, bucket_capacity> begin();
     ak_bucket_array_iterator<type, bucket_capacity> end();
 };
 
+template <typename type, uint64_t bucket_capacity = AK_ARRAY_BUCKET_INITIAL_CAPACITY> ak_slab* 
+AK_Create_Bucket_Array_Slab(uint64_t ArenaBlockSize = AK_ARENA_INITIAL_BLOCK_SIZE, ak_allocator* Allocator = NULL);
+template <typename type, uint64_t bucket_capacity = AK_ARRAY_BUCKET_INITIAL_CAPACITY> ak_bucket_array<type, bucket_capacity> 
+AK_Create_Bucket_Array(ak_slab* Slab = NULL, ak_allocator* Allocator = NULL);
 template <typename type, uint64_t bucket_capacity> void AK_Delete(ak_bucket_array<type, bucket_capacity>* Array);
 
+//~Concurrent bucket array definition
+template <typename type, uint64_t bucket_capacity>
+struct ak__concurrent_bucket
+{
+    type              Data[bucket_capacity];
+    volatile uint64_t Committed;
+};
+
+template <typename type, uint64_t bucket_capacity = AK_ARRAY_BUCKET_INITIAL_CAPACITY>
+struct ak_concurrent_bucket_array
+{
+    ak_allocator* Allocator = NULL;
+    ak__concurrent_bucket<type, bucket_capacity>* volatile* Buckets = NULL;
+    uint64_t MaxBucketCount = 0;
+    volatile uint64_t ReservedCount = 0;
+    volatile uint64_t PublishedLength = 0;
+    
+    bool Add(const type& Entry);
+    type* Add_And_Get(const type& Entry);
+    
+    uint64_t Get_Length();
+    type* Get(uint64_t Index);
+    type& operator[](uint64_t Index);
+    
+    void Clear();
+};
+
+template <typename type, uint64_t bucket_capacity = AK_ARRAY_BUCKET_INITIAL_CAPACITY> ak_concurrent_bucket_array<type, bucket_capacity> 
+AK_Create_Concurrent_Bucket_Array(uint64_t MaxBucketCount, ak_allocator* Allocator = NULL);
+template <typename type, uint64_t bucket_capacity> void AK_Delete(ak_concurrent_bucket_array<type, bucket_capacity>* Array);
+
 //~Hash Map definition
 template <typename key, typename value>
 struct ak_hashmap;
@@ -300,17 +439,48 @@ struct ak_hashmap_pair
     const value& Value;
 };
 
+//NOTE(EVERYONE): Hash maps keep their keys and values densely packed, so iterating is a walk over the item arrays
 template <typename key, typename value>
 struct ak_hashmap_iterator
 {
-    const ak_hashmap<key, value>* HashMap;
-    uint32_t CurrentIndex;
+    const key*      Keys;
+    const value*    Values;
+    const uint32_t* Length;
+    uint32_t        CurrentIndex;
     
     ak_hashmap_pair<key, value> operator*();
     void operator++();
     bool operator!=(const ak_hashmap_iterator& Iterator);
 };
 
+#ifdef AK_HASH_MAP_STATS
+#ifndef AK_HASH_MAP_STATS_BUCKET_COUNT
+#define AK_HASH_MAP_STATS_BUCKET_COUNT 16
+#endif
+
+//NOTE(EVERYONE): Only compiled in with AK_HASH_MAP_STATS, which has to be defined the same for every file including 
+//the header. Probe lengths count the slots a lookup looks at and the last bucket of a histogram collects everything 
+//longer. The table fields (Length and below) are filled in by AK_Get_Hash_Map_Stats
+struct ak_hashmap_stats
+{
+    uint64_t HitCount;
+    uint64_t MissCount;
+    uint64_t HitProbeLengths[AK_HASH_MAP_STATS_BUCKET_COUNT];
+    uint64_t MissProbeLengths[AK_HASH_MAP_STATS_BUCKET_COUNT];
+    uint32_t MaxProbeLength;
+    uint32_t RehashCount;
+    uint64_t RehashCycles;
+    
+    uint32_t Length;
+    uint32_t SlotCapacity;
+    float    LoadFactor;
+    uint32_t MaxClusterLength;
+    uint64_t BaseCounts[AK_HASH_MAP_STATS_BUCKET_COUNT]; //NOTE(EVERYONE): Number of slots for each BaseCount
+};
+#endif
+
+//NOTE(EVERYONE): Maps holding at most AK_HASH_MAP_SMALL_CAPACITY items have no slot table (Slots is NULL). ItemSlots 
+//then holds the hash of each item and lookups scan it linearly, the slot table is built once the map outgrows it
 template <typename key, typename value>
 struct ak_hashmap
 {
@@ -324,11 +494,56 @@ struct ak_hashmap
     key* Keys = NULL;
     value* Values = NULL;
     
+    //NOTE(EVERYONE): With IncrementalRehash set, growing keeps the old slot table and every insert or remove moves 
+    //AK_HASH_MAP_REHASH_STEP old slots into the new table, so no single operation pays for the whole rehash. 
+    //SlotTag is the top bit of ItemSlots that marks items living in Slots rather than OldSlots
+    bool IncrementalRehash = false;
+    ak__hashmap_slot* OldSlots = NULL;
+    uint32_t OldSlotCapacity = 0;
+    uint32_t MigrateIndex = 0;
+    uint32_t SlotTag = 0;
+    
+    //NOTE(EVERYONE): Fraction of the slots that can be used before the slot table grows, in (0, 1]
+    float MaxLoadFactor = 2.0f/3.0f;
+    
+#ifdef AK_HASH_MAP_STATS
+    ak_hashmap_stats Stats = {};
+#endif
+    
     void Add(const key& Key, const value& Value);
     value* Find(const key& Key);
     void Remove(const key& Key);
     void Clear();
     
+    //NOTE(EVERYONE): These hash and probe the map once. Find_Or_Add zeroes the value of a newly inserted key, 
+    //Try_Add returns false and leaves the map untouched when the key already exists
+    value* Find_Or_Add(const key& Key, bool* WasInserted = NULL);
+    value* Insert_Or_Assign(const key& Key, const value& Value);
+    bool Try_Add(const key& Key, const value& Value);
+    
+    //NOTE(EVERYONE): Hash must be ak_hash_traits<key>::Hash of the key. Lookups can use any type the traits can 
+    //hash and compare against key (e.g. const char* for ak_str8 keys) without building a temporary key
+    template <typename lookup> value* Find_With_Hash(const lookup& Key, uint32_t Hash);
+    template <typename lookup> value* Find_As(const lookup& Key);
+    void Add_With_Hash(const key& Key, const value& Value, uint32_t Hash);
+    void Remove_With_Hash(const key& Key, uint32_t Hash);
+    
+    //NOTE(EVERYONE): Processes keys in groups of AK_HASH_MAP_BATCH_SIZE, hashing and prefetching a whole group 
+    //before probing so the cache misses of independent keys overlap. Missing keys write NULL to OutValues
+    void Find_Batch(const key* BatchKeys, uint32_t Count, value** OutValues);
+    void Add_Batch(const key* BatchKeys, const value* BatchValues, uint32_t Count);
+    
+    //NOTE(EVERYONE): Reserve sizes the slots and items so Count keys fit without growing. Shrink_To_Fit resizes 
+    //both down to the current length
+    void Reserve(uint32_t Count);
+    void Shrink_To_Fit();
+    
+#ifndef AK_STD_NO_FILE_IO
+    //NOTE(EVERYONE): Writes the map as a single image that AK_Load_Mapped_Hash_Map can query in place. Keys and values 
+    //have to be trivially copyable, except ak_str8 keys whose bytes are appended to the image
+    bool Save(const char* Path);
+#endif
+    
     ak_hashmap_iterator<key, value> begin() const;
     ak_hashmap_iterator<key, value> end() const;
 };
@@ -340,6 +555,11 @@ AK_Create_Hash_Map(uint32_t InitialSlotCapacity=AK_HASH_MAP_INITIAL_SLOT_CAPACIT
 template <typename key, typename value> void
 AK_Delete(ak_hashmap<key, value>* HashMap);
 
+#ifdef AK_HASH_MAP_STATS
+template <typename key, typename value> ak_hashmap_stats
+AK_Get_Hash_Map_Stats(const ak_hashmap<key, value>* Map);
+#endif
+
 uint32_t AK_Hash_Function(uint32_t Key);
 uint32_t AK_Hash_Function(int32_t Key);
 
@@ -351,5184 +571,11488 @@ uint32_t AK_Hash_Function(double Key);
 
 uint32_t AK_Hash_Function(const char* Key);
 
-//~Pool definition
-#define AK_POOL16_MAX_CAPACITY ((1 << 16)-1)
+//NOTE(EVERYONE): Seeded 64 bit hash of a byte buffer that consumes 16-48 bytes per step. The string overloads of 
+//AK_Hash_Function fold this down to 32 bits. AK_Hash_CRC32C uses the SSE4.2 crc32 instruction when the CPU has 
+//it (checked once at runtime unless the target guarantees it) and a table otherwise, both giving identical results
+uint64_t AK_Hash64(const void* Data, uint64_t Length, uint64_t Seed = 0);
+uint32_t AK_Hash_CRC32C(const void* Data, uint64_t Length, uint32_t Seed = 0);
 
-union ak__pool_id
+static constexpr uint64_t AK__Hash64_Secret[4] = 
 {
-    uint64_t ID;
-    struct
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+//NOTE(EVERYONE): Compile time copy of AK_Hash64 and the ak_str8 hash, step for step, so the hash of a string literal 
+//can be a constant. AK_Str8_Lit_Hash("Name") equals AK_Hash_Function(AK_Str8_Lit("Name")), which lets literal keys 
+//go through Find_With_Hash and lets a string hash be switched on with literal cases (compare the strings in the case, 
+//different strings can share a hash)
+constexpr uint64_t AK__Const_Mul_Hi64(uint64_t A, uint64_t B)
+{
+    uint64_t ALo = A & 0xFFFFFFFF, AHi = A >> 32;
+    uint64_t BLo = B & 0xFFFFFFFF, BHi = B >> 32;
+    uint64_t HiLo = AHi*BLo;
+    uint64_t Cross = ((ALo*BLo) >> 32) + (HiLo & 0xFFFFFFFF) + ALo*BHi;
+    return AHi*BHi + (HiLo >> 32) + (Cross >> 32);
+}
+
+constexpr uint64_t AK__Const_Hash64_Mix(uint64_t A, uint64_t B)
+{
+    return (A*B) ^ AK__Const_Mul_Hi64(A, B);
+}
+
+constexpr uint64_t AK__Const_Hash64_Read(const char* Ptr, uint32_t ByteCount)
+{
+    //NOTE(EVERYONE): Little endian like the memcpy reads of AK_Hash64
+    uint64_t Result = 0;
+    for(uint32_t Index = 0; Index < ByteCount; Index++)
+        Result |= (uint64_t)(uint8_t)Ptr[Index] << (Index*8);
+    return Result;
+}
+
+constexpr uint64_t AK_Const_Hash64(const char* Str, uint64_t Length, uint64_t Seed = 0)
+{
+    const char* At = Str;
+    Seed ^= AK__Const_Hash64_Mix(Seed ^ AK__Hash64_Secret[0], AK__Hash64_Secret[1]);
+    
+    uint64_t A = 0, B = 0;
+    if(Length <= 16)
     {
-        uint32_t Key;
-        struct
+        if(Length >= 4)
         {
-            uint16_t PreviousIndex;
-            uint16_t NextIndex;
-        };
-    };
-    
-    struct
+            uint64_t Offset = (Length >> 3) << 2;
+            A = (AK__Const_Hash64_Read(At, 4) << 32) | AK__Const_Hash64_Read(At + Offset, 4);
+            B = (AK__Const_Hash64_Read(At + Length - 4, 4) << 32) | AK__Const_Hash64_Read(At + Length - 4 - Offset, 4);
+        }
+        else if(Length > 0)
+        {
+            A = ((uint64_t)(uint8_t)At[0] << 16) | ((uint64_t)(uint8_t)At[Length >> 1] << 8) | (uint8_t)At[Length-1];
+        }
+    }
+    else
     {
-        uint32_t __Unused__;
-        struct
+        uint64_t Remaining = Length;
+        if(Remaining > 48)
         {
-            uint16_t Type;
-            uint16_t Index;
-        };
-    };
-};
+            uint64_t Seed1 = Seed;
+            uint64_t Seed2 = Seed;
+            do
+            {
+                Seed  = AK__Const_Hash64_Mix(AK__Const_Hash64_Read(At, 8) ^ AK__Hash64_Secret[1], AK__Const_Hash64_Read(At + 8, 8) ^ Seed);
+                Seed1 = AK__Const_Hash64_Mix(AK__Const_Hash64_Read(At + 16, 8) ^ AK__Hash64_Secret[2], AK__Const_Hash64_Read(At + 24, 8) ^ Seed1);
+                Seed2 = AK__Const_Hash64_Mix(AK__Const_Hash64_Read(At + 32, 8) ^ AK__Hash64_Secret[3], AK__Const_Hash64_Read(At + 40, 8) ^ Seed2);
+                At += 48;
+                Remaining -= 48;
+            } while(Remaining > 48);
+            Seed ^= Seed1 ^ Seed2;
+        }
+        
+        while(Remaining > 16)
+        {
+            Seed = AK__Const_Hash64_Mix(AK__Const_Hash64_Read(At, 8) ^ AK__Hash64_Secret[1], AK__Const_Hash64_Read(At + 8, 8) ^ Seed);
+            At += 16;
+            Remaining -= 16;
+        }
+        
+        A = AK__Const_Hash64_Read(At + Remaining - 16, 8);
+        B = AK__Const_Hash64_Read(At + Remaining - 8, 8);
+    }
+    
+    A ^= AK__Hash64_Secret[1];
+    B ^= Seed;
+    return AK__Const_Hash64_Mix((A*B) ^ AK__Hash64_Secret[0] ^ Length, AK__Const_Mul_Hi64(A, B) ^ AK__Hash64_Secret[1]);
+}
 
-#define AK__INVALID_POOL_INDEX ((uint16_t)-1)
+constexpr uint32_t AK_Const_Hash_Str8(const char* Str, uint64_t Length)
+{
+    return (uint32_t)(AK_Const_Hash64(Str, Length) ^ (AK_Const_Hash64(Str, Length) >> 32));
+}
 
-template <typename type>
-struct ak__pool_entry
+#define AK_Str8_Lit_Hash(s) AK_Const_Hash_Str8((const char*)s, sizeof(s)-1)
+
+//NOTE(EVERYONE): Hash maps hash and compare keys through this struct. Specialize it to customize a key type or to 
+//allow lookups with other types
+template <typename key>
+struct ak_hash_traits
 {
-    ak__pool_id ID;
-    type        Entry;
+    static uint32_t Hash(const key& Key);
+    static uint64_t Hash64(const key& Key); //NOTE(EVERYONE): Defaults to a 64 bit mix of Hash for non integer keys
+    static bool Equals(const key& A, const key& B);
 };
 
-template <typename type, uint64_t bucket_capacity>
-struct ak_pool;
+//~Static hash map definition
+//NOTE(EVERYONE): Read only map built once from a fixed set of keys with a minimal perfect hash (hash and displace, 
+//PTHash style). Keys are grouped into small buckets by hash, and every bucket stores the pilot that sends all of its 
+//keys to free slots. A lookup is one bucket read, one slot computation and one key compare, with no probing. 
+//Pilots, keys and values share a single allocation
+template <typename key, typename value>
+struct ak_static_hashmap
+{
+    ak_allocator* Allocator = NULL;
+    uint32_t Length = 0;
+    uint32_t BucketCount = 0;
+    uint64_t Seed = 0;
+    
+    uint32_t* Pilots = NULL;
+    key* Keys = NULL;
+    value* Values = NULL;
+    
+    value* Find(const key& Key) const;
+    template <typename lookup> value* Find_As(const lookup& Key) const;
+    
+    ak_hashmap_iterator<key, value> begin() const;
+    ak_hashmap_iterator<key, value> end() const;
+};
 
-template <typename type, uint64_t bucket_capacity>
-struct ak_pool_iterator
+//NOTE(EVERYONE): Keys are hashed with ak_hash_traits<key>::Hash64. Fails and returns an empty map when two keys share 
+//a Hash64, which for non integer keys that only specialize Hash means their 32 bit hashes collide. Specialize Hash64 
+//for large sets of those keys
+template <typename key, typename value> ak_static_hashmap<key, value>
+AK_Create_Static_Hash_Map(const key* Keys, const value* Values, uint32_t Count, ak_allocator* Allocator = NULL);
+
+template <typename key, typename value> void
+AK_Delete(ak_static_hashmap<key, value>* HashMap);
+
+//~Mapped hash map definition
+//NOTE(EVERYONE): Define AK_STD_NO_FILE_IO to leave out ak_hashmap::Save, ak_mapped_hashmap and the platform headers 
+//they need
+#ifndef AK_STD_NO_FILE_IO
+struct ak__file_mapping
 {
-    ak_pool<type, bucket_capacity>* Pool;
-    uint16_t CurrentIndex;
-    type& operator*();
-    void operator++();
-    bool operator!=(const ak_pool_iterator& Iterator);
+    void*    Data;
+    uint64_t Size;
+    void*    Handle;
 };
 
-template <typename type, uint64_t bucket_capacity = AK_ARRAY_BUCKET_INITIAL_CAPACITY>
-struct ak_pool
+//NOTE(EVERYONE): Read only view of an ak_hashmap image mapped straight from disk. Slots and items are used in place, 
+//only ak_str8 keys are patched to point into the mapping (on copy on write pages). The image is only reachable 
+//through the lookups and iteration, so nothing can write to the mapped pages
+template <typename key, typename value>
+struct ak_mapped_hashmap
 {
-    using ak_pool_storage = ak_bucket_array<ak__pool_entry<type>, bucket_capacity>;
-    
-    static const uint64_t MAX_CAPACITY = (1ull << 32)-1;
+private:
+    const ak__hashmap_slot* Slots = NULL;
+    const key* Keys = NULL;
+    const value* Values = NULL;
+    uint32_t SlotCapacity = 0;
+    uint32_t Length = 0;
+    ak__file_mapping Mapping = {};
     
-    ak_pool_storage Data;
-    uint16_t Type = 0;
-    uint16_t Length = 0;
-    uint16_t FirstAllocatedIndex = AK__INVALID_POOL_INDEX;
-    uint16_t FirstAvailableIndex = AK__INVALID_POOL_INDEX;
-    uint32_t NextKey = 1;
+    template <typename map_key, typename map_value> 
+    friend ak_mapped_hashmap<map_key, map_value> AK_Load_Mapped_Hash_Map(const char* Path);
     
-    uint64_t Allocate(const type& Value = {});
-    type* Allocate_And_Get(uint64_t* ID = NULL);
-    void Free(uint64_t ID);
-    void Free_All();
+    template <typename map_key, typename map_value> 
+    friend void AK_Delete(ak_mapped_hashmap<map_key, map_value>* HashMap);
     
-    bool Is_Allocated(uint64_t ID);
-    type* Get(uint64_t ID);
-    type& operator[](uint64_t ID);
+public:
+    const value* Find(const key& Key) const;
+    template <typename lookup> const value* Find_As(const lookup& Key) const;
+    uint32_t Get_Length() const;
     
-    ak_pool_iterator<type, bucket_capacity> begin();
-    ak_pool_iterator<type, bucket_capacity> end();
+    ak_hashmap_iterator<key, value> begin() const;
+    ak_hashmap_iterator<key, value> end() const;
 };
 
-template <typename type, uint64_t bucket_capacity> 
-void AK_Delete(ak_pool<type, bucket_capacity>* Pool);
+//NOTE(EVERYONE): Checks the header and walks the slot table once so a truncated or corrupt image fails to load 
+//instead of being read out of bounds. Returns an empty map on failure
+template <typename key, typename value> ak_mapped_hashmap<key, value>
+AK_Load_Mapped_Hash_Map(const char* Path);
 
-//~String definition
-#define AK_STR8_FIND_ERROR ((uint64_t)-1)
+template <typename key, typename value> void
+AK_Delete(ak_mapped_hashmap<key, value>* HashMap);
+#endif //AK_STD_NO_FILE_IO
 
-bool AK_Is_Newline(char Code);
-bool AK_Is_Whitespace(char Code);
-uint64_t AK_CStr_Length(const char* Str);
+//~Concurrent hash map definition
+#define AK__CACHE_LINE_SIZE 64
+#define AK__RW_LOCK_READER_SLOTS 8
 
-//TODO(JJ): ak_str16 and ak_str32
+struct ak__rw_lock_counter
+{
+    volatile uint64_t Value;
+    uint8_t Padding[AK__CACHE_LINE_SIZE-sizeof(uint64_t)];
+};
 
-struct ak_str8
+//NOTE(EVERYONE): Reader writer spin lock. Readers are spread over several counters, each on its own cache line, and 
+//a thread always uses the same one so concurrent lookups do not fight over a single lock word. A writer raises 
+//Writer, which stops new readers so writers cannot starve, and then waits for every reader counter to drain
+struct ak__rw_lock
 {
-    const char* Str;
-    uint64_t    Length;
+    ak__rw_lock_counter Writer;
+    ak__rw_lock_counter Readers[AK__RW_LOCK_READER_SLOTS];
+};
+
+template <typename key, typename value>
+struct ak__concurrent_hashmap_shard
+{
+    //NOTE(EVERYONE): Keeps the lock off the cache lines of the neighbouring shard and of its own map
+    uint8_t PaddingBefore[AK__CACHE_LINE_SIZE];
+    ak__rw_lock Lock;
+    ak_hashmap<key, value> Map;
+    uint8_t PaddingAfter[AK__CACHE_LINE_SIZE];
+};
+
+//NOTE(EVERYONE): A power of two number of ak_hashmap shards, each behind its own reader writer lock and with its own 
+//storage. The top bits of the key hash pick the shard and the same hash is used to probe inside it, so every key is 
+//hashed once. Lookups only take the shared lock and copy the value out since pointers into a shard are not stable
+template <typename key, typename value>
+struct ak_concurrent_hashmap
+{
+    ak_allocator* Allocator = NULL;
+    ak__concurrent_hashmap_shard<key, value>* Shards = NULL;
+    uint32_t ShardCount = 0;
+    uint32_t ShardShift = 0;
+    
+    bool Find(const key& Key, value* OutValue);
+    bool Contains(const key& Key);
+    bool Try_Add(const key& Key, const value& Value);
+    void Insert_Or_Assign(const key& Key, const value& Value);
+    bool Remove(const key& Key);
+    uint32_t Get_Length();
+};
+
+template <typename key, typename value> ak_concurrent_hashmap<key, value>
+AK_Create_Concurrent_Hash_Map(uint32_t ShardCount = 16, uint32_t InitialSlotCapacity=AK_HASH_MAP_INITIAL_SLOT_CAPACITY, 
+                              uint32_t InitialItemCapacity=AK_HASH_MAP_INITIAL_ITEM_CAPACITY, ak_allocator* Allocator = NULL);
+
+template <typename key, typename value> void
+AK_Delete(ak_concurrent_hashmap<key, value>* HashMap);
+
+//~Hash set definition
+//NOTE(EVERYONE): Uses the same slots, probing and growth as ak_hashmap without a value array, so MaxLoadFactor and 
+//IncrementalRehash behave as they do for maps. Keys are densely packed so iterating a set is a walk over Keys
+template <typename key>
+struct ak_hashset
+{
+    ak_allocator* Allocator = NULL;
+    uint32_t Length = 0;
+    uint32_t SlotCapacity = 0;
+    uint32_t ItemCapacity = 0;
     
-    const char& operator[](uint64_t Index) const;
+    ak__hashmap_slot* Slots = NULL;
+    uint32_t* ItemSlots = NULL;
+    key* Keys = NULL;
     
-    bool Is_Null_Or_Empty();
-    bool Is_Null_Or_Whitespace();
+    bool IncrementalRehash = false;
+    ak__hashmap_slot* OldSlots = NULL;
+    uint32_t OldSlotCapacity = 0;
+    uint32_t MigrateIndex = 0;
+    uint32_t SlotTag = 0;
     
-    uint64_t Find_First(char Code);
-    uint64_t Find_Last(char Code);
+    float MaxLoadFactor = 2.0f/3.0f;
     
-    ak_str8 Prefix(uint64_t Count);
-    ak_str8 Chop(uint64_t Count);
-    ak_str8 Postfix(uint64_t Count);
-    ak_str8 Skip(uint64_t Count);
-    ak_str8 Substr(uint64_t First, uint64_t End);
+#ifdef AK_HASH_MAP_STATS
+    ak_hashmap_stats Stats = {};
+#endif
     
-    bool Begins_With(const ak_str8& CompStr);
-    bool Ends_With(const ak_str8& CompStr);
-    ak_str8 Trim_Whitespace();
+    //NOTE(EVERYONE): Add returns false when the key was already in the set, Remove returns false when it was not
+    bool Add(const key& Key);
+    bool Contains(const key& Key) const;
+    bool Remove(const key& Key);
+    void Clear();
     
-    bool Is_Null_Term();
-    const char* To_CStr(ak_arena* Arena);
-    ak_str8 Copy(ak_arena* Arena);
+    void Union(const ak_hashset<key>& Set);
+    void Intersect(const ak_hashset<key>& Set);
+    void Difference(const ak_hashset<key>& Set);
+    
+    const key* begin() const;
+    const key* end() const;
 };
 
-struct ak_str8_node
+template <typename key> ak_hashset<key>
+AK_Create_Hash_Set(uint32_t InitialSlotCapacity=AK_HASH_MAP_INITIAL_SLOT_CAPACITY, uint32_t InitialItemCapacity=AK_HASH_MAP_INITIAL_ITEM_CAPACITY,
+                   ak_allocator* Allocator = NULL);
+
+template <typename key> void
+AK_Delete(ak_hashset<key>* HashSet);
+
+//~Hash multimap definition
+template <typename value>
+struct ak__hash_multimap_pair
 {
-    ak_str8_node* Next;
-    ak_str8       String;
+    uint32_t Group;
+    value    Value;
 };
 
-struct ak_str8_list
+struct ak__hash_multimap_group
 {
-    ak_str8_node* First;
-    ak_str8_node* Last;
-    uint64_t      NodeCount;
-    uint64_t      TotalLength;
-    
-    void Push_Explicit(const ak_str8& PushedString, ak_str8_node* Node);
-    void Push(const ak_str8& PushedString, ak_arena* Arena);
-    
-    ak_str8 Join(ak_arena* Arena);
-    ak_str8 Join_New_Line(ak_arena* Arena);
-    
-    void FormatV(ak_arena* Arena, const char* Format, va_list Args);
-    void Format(ak_arena* Arena, const char* Format, ...);
+    uint64_t Offset;
+    uint64_t Count;
+    uint64_t Capacity;
+    uint64_t PendingCount;
 };
 
-ak_str8 AK_Str8(const char* Str);
-ak_str8 AK_Str8(const char* Str, uint64_t StrLength);
-ak_str8 AK_Str8(const char* First, const char* Last);
-#define AK_Str8_Lit(s) AK_Str8((const char*)s, sizeof(s)-1)
-ak_str8_list AK_Str8_Split(const ak_str8& String, ak_arena* Arena, char* SplitChars, uint32_t CharCount);
-ak_str8 AK_Str8_FormatV(ak_arena* Arena, const char* Format, va_list Args);
-ak_str8 AK_Str8_Format(ak_arena* Arena, const char* Format, ...);
-
-//TODO(JJ): UTF8 functions
+//NOTE(EVERYONE): One to many map. Add only appends pairs, Find then packs them so the values of every key sit next to 
+//each other (in the order they were added) and come back as one span. Build packs every group tightly with a 
+//counting sort, which is also what the first Find does. Later Finds only pack the pairs added since: a group that 
+//outgrows its room moves to the end of PackedValues with double the room, and everything is rebuilt once the room 
+//left behind reaches half of PackedValues, so mixing Add and Find costs amortized O(1) per value. Packing moves 
+//values, so a span from Find is only valid until the next Find or Build that follows an Add
+template <typename key, typename value>
+struct ak_hash_multimap
+{
+    ak_allocator* Allocator = NULL;
+    uint64_t Length = 0;
+    
+    ak_hashmap<key, uint32_t> Groups; //NOTE(EVERYONE): Key to group index, in order of first insertion
+    ak_dynamic_array<ak__hash_multimap_pair<value>> Pairs; //NOTE(EVERYONE): Pairs added since the last pack
+    
+    //NOTE(EVERYONE): Values of group i are Spans[i].Count values from PackedValues[Spans[i].Offset]. PackedLength 
+    //includes the spare room of every group and the WastedLength left behind by groups that moved
+    ak_dynamic_array<ak__hash_multimap_group> Spans;
+    value* PackedValues = NULL;
+    uint64_t PackedLength = 0;
+    uint64_t PackedCapacity = 0;
+    uint64_t WastedLength = 0;
+    
+    void Add(const key& Key, const value& Value);
+    void Build();
+    ak_array<value> Find(const key& Key);
+    template <typename lookup> ak_array<value> Find_As(const lookup& Key);
+    void Clear();
+};
 
-bool operator!=(const ak_str8& A, const ak_str8& B);
-bool operator==(const ak_str8& A, const ak_str8& B);
+template <typename key, typename value> ak_hash_multimap<key, value>
+AK_Create_Hash_Multimap(ak_allocator* Allocator = NULL);
 
-uint32_t AK_Hash_Function(const ak_str8& Str);
+template <typename key, typename value> void
+AK_Delete(ak_hash_multimap<key, value>* Map);
 
-#endif //AK_STD_INCLUDE
+//~Paged hash map definition
+struct ak__paged_hashmap_block
+{
+    ak__paged_hashmap_block* Next;
+    uint64_t                 Size;
+};
 
-#ifdef AK_STD_IMPLEMENTATION
+//NOTE(EVERYONE): Hash map that lives on an arena. Items go into fixed size pages that never move, so value pointers 
+//stay valid until the key is removed, and removed items are reused. Slot tables and page lists that are outgrown are 
+//kept and handed out again as pages or page lists instead of being leaked, since the arena cannot free them
+template <typename key, typename value>
+struct ak_paged_hashmap
+{
+    ak_arena* Arena = NULL;
+    uint32_t Length = 0;
+    uint32_t SlotCapacity = 0;
+    ak__hashmap_slot* Slots = NULL;
+    
+    uint32_t PageShift = 0; //NOTE(EVERYONE): Items per page is 1 << PageShift
+    uint32_t PageCount = 0;
+    uint32_t PageListCapacity = 0;
+    uint8_t** Pages = NULL;
+    
+    //NOTE(EVERYONE): Items handed out so far. Removed items are chained from FreeItem
+    uint32_t ItemCount = 0;
+    uint32_t FreeItem = (uint32_t)-1;
+    ak__paged_hashmap_block* RetiredBlocks = NULL;
+    
+    void Add(const key& Key, const value& Value);
+    value* Find(const key& Key);
+    template <typename lookup> value* Find_As(const lookup& Key);
+    value* Find_Or_Add(const key& Key, bool* WasInserted = NULL);
+    bool Remove(const key& Key);
+    
+    //NOTE(EVERYONE): Keeps the slot table and pages for reuse, nothing new is pushed onto the arena until the map 
+    //grows past its old size
+    void Clear();
+};
 
-#ifndef AK_STD_MALLOC
-#include <stdlib.h>
-#define AK_STD_MALLOC(size) malloc(size)
-#define AK_STD_FREE(memory) free(memory)
-#endif //AK_STD_MALLOC
+//NOTE(EVERYONE): EstimatedCount sizes the slot table and the pages up front, a good estimate means no growth at all
+template <typename key, typename value> ak_paged_hashmap<key, value>
+AK_Create_Paged_Hash_Map(ak_arena* Arena, uint32_t EstimatedCount = AK_HASH_MAP_INITIAL_ITEM_CAPACITY);
 
-#ifndef AK_STD_MEMCPY
-#include <string.h>
-#define AK_STD_MEMCPY(dest, src, n) memcpy(dest, src, n)
-#define AK_STD_MEMSET(ptr, value, n) memset(ptr, value, n)
-#endif //AK_STD_MEMCPY
+//~Swiss hash map definition
+//NOTE(EVERYONE): Alternative engine to ak_hashmap. Every slot has a one byte control tag (empty, deleted or 7 bits 
+//of the hash) and lookups compare a whole group of 16 tags at once. Keys and values stay densely packed like ak_hashmap
+template <typename key, typename value>
+struct ak_swiss_hashmap
+{
+    ak_allocator* Allocator = NULL;
+    uint32_t Length = 0;
+    uint32_t SlotCapacity = 0;
+    uint32_t ItemCapacity = 0;
+    uint32_t GrowthLeft = 0;
+    
+    int8_t* Controls = NULL;
+    uint32_t* SlotItems = NULL;
+    uint32_t* ItemSlots = NULL;
+    key* Keys = NULL;
+    value* Values = NULL;
+    
+    void Add(const key& Key, const value& Value);
+    value* Find(const key& Key);
+    void Remove(const key& Key);
+    void Clear();
+    
+    ak_hashmap_iterator<key, value> begin() const;
+    ak_hashmap_iterator<key, value> end() const;
+};
 
-#ifndef AK_STD_ASSERT
-#include <assert.h>
-#define AK_STD_ASSERT(condition, message) assert(condition)
-#endif //AK_STD_ASSERT
+template <typename key, typename value> ak_swiss_hashmap<key, value>
+AK_Create_Swiss_Hash_Map(uint32_t InitialSlotCapacity=AK_HASH_MAP_INITIAL_SLOT_CAPACITY, uint32_t InitialItemCapacity=AK_HASH_MAP_INITIAL_ITEM_CAPACITY,
+                         ak_allocator* Allocator = NULL);
 
-#define AK__Max(a, b) ((a) > (b) ? (a) : (b))
-#define AK__Min(a, b) ((a) < (b) ? (a) : (b))
+template <typename key, typename value> void
+AK_Delete(ak_swiss_hashmap<key, value>* HashMap);
 
-void AK__Memory_Copy(void* Dest, const void* Src, size_t Size)
+//~Robin hood hash map definition
+//NOTE(EVERYONE): Alternative engine to ak_hashmap. Slots are kept ordered by their distance from the base slot, so a 
+//miss stops as soon as it passes a slot closer to its base than the probe, and removes shift the run back instead 
+//of leaving holes. Keys and values stay densely packed like ak_hashmap
+struct ak__robin_hood_slot
 {
-    AK_STD_MEMCPY(Dest, Src, Size);
-}
+    uint32_t Hash = 0;
+    uint32_t ItemIndex = 0;
+    uint32_t Distance = 0; //NOTE(EVERYONE): Probe distance plus one, zero means the slot is empty
+};
 
-void AK__Memory_Set(void* Dest, uint8_t Value, size_t Size)
+template <typename key, typename value>
+struct ak_robin_hood_hashmap
 {
-    AK_STD_MEMSET(Dest, Value, Size);
-}
+    ak_allocator* Allocator = NULL;
+    uint32_t Length = 0;
+    uint32_t SlotCapacity = 0;
+    uint32_t ItemCapacity = 0;
+    
+    ak__robin_hood_slot* Slots = NULL;
+    uint32_t* ItemSlots = NULL;
+    key* Keys = NULL;
+    value* Values = NULL;
+    
+    void Add(const key& Key, const value& Value);
+    value* Find(const key& Key);
+    void Remove(const key& Key);
+    void Clear();
+    
+    ak_hashmap_iterator<key, value> begin() const;
+    ak_hashmap_iterator<key, value> end() const;
+};
 
-void AK__Memory_Clear(void* Dest, size_t Size)
-{
-    AK_STD_MEMSET(Dest, 0, Size);
-}
+template <typename key, typename value> ak_robin_hood_hashmap<key, value>
+AK_Create_Robin_Hood_Hash_Map(uint32_t InitialSlotCapacity=AK_HASH_MAP_INITIAL_SLOT_CAPACITY, uint32_t InitialItemCapacity=AK_HASH_MAP_INITIAL_ITEM_CAPACITY,
+                              ak_allocator* Allocator = NULL);
 
-uint64_t AK__Memory_Align(uint64_t Value, uint64_t Alignment)
-{
-    Alignment = Alignment ? Alignment : 1;
-    uint64_t Mod = Value & (Alignment-1);
-    return Mod ? Value + (Alignment-Mod) : Value;
-}
+template <typename key, typename value> void
+AK_Delete(ak_robin_hood_hashmap<key, value>* HashMap);
 
-void* AK__Alloc(size_t Size, uint64_t UserData)
-{
-    return AK_STD_MALLOC(Size);
-}
+//~BTree map definition
+#define AK__BTREE_CAPACITY(header_size, entry_size) \
+(((AK_BTREE_NODE_SIZE - (header_size)) / (entry_size)) > 4 ? ((AK_BTREE_NODE_SIZE - (header_size)) / (entry_size)) : 4)
+#define AK__BTREE_MAX_HEIGHT 32
 
-void AK__Free(void* Memory, uint64_t UserData)
+//NOTE(EVERYONE): Node capacities are derived from AK_BTREE_NODE_SIZE so a node spans a few cache lines. Leaves 
+//are linked in key order for range iteration
+template <typename key, typename value>
+struct ak__btree_leaf
 {
-    if(Memory) AK_STD_FREE(Memory);
-}
+    static const uint32_t Capacity = AK__BTREE_CAPACITY(sizeof(uint32_t)+2*sizeof(void*), sizeof(key)+sizeof(value));
+    
+    uint32_t        Count;
+    ak__btree_leaf* Prev;
+    ak__btree_leaf* Next;
+    key             Keys[Capacity];
+    value           Values[Capacity];
+};
 
-uint64_t AK__Ceil_Pow2(uint64_t V)
+template <typename key>
+struct ak__btree_inner
 {
-    --V;
-    V |= V >> 1;
-    V |= V >> 2;
-    V |= V >> 4;
-    V |= V >> 8;
-    V |= V >> 16;
-    V |= V >> 32;
-    ++V;
-    V += ( V == 0 );    
-    return V;
-}
+    static const uint32_t Capacity = AK__BTREE_CAPACITY(sizeof(uint32_t)+sizeof(void*), sizeof(key)+sizeof(void*));
+    
+    uint32_t Count;
+    key      Keys[Capacity];
+    void*    Children[Capacity+1];
+};
 
-ak_allocator* AK__Get_Default_Allocator()
+template <typename key, typename value>
+struct ak_btree_iterator
 {
-    static ak_allocator Allocator;
-    Allocator.Alloc = AK__Alloc;
-    Allocator.Free = AK__Free;
-    return &Allocator;
-}
+    ak__btree_leaf<key, value>* Leaf;
+    uint32_t                    Index;
+    
+    ak_hashmap_pair<key, value> operator*();
+    void operator++();
+    bool operator!=(const ak_btree_iterator& Iterator);
+};
 
-//~Array implementation
-template <typename type>
-type* ak_array<type>::Get(uint64_t Index)
+template <typename key, typename value>
+struct ak_btree_range
 {
-    if(Index >= Length) return NULL;
-    return Data + Index;
-}
+    ak_btree_iterator<key, value> First;
+    ak_btree_iterator<key, value> Last;
+    
+    ak_btree_iterator<key, value> begin() const;
+    ak_btree_iterator<key, value> end() const;
+};
 
-template <typename type>
-const type* ak_array<type>::Get(uint64_t Index) const
+//NOTE(EVERYONE): Ordered map stored as a B+ tree. Keys need operator<, and nodes come from a slab that can be shared 
+//between maps with the same key and value types. A node that falls below half full on Remove borrows from or merges 
+//with a sibling, and merged nodes go back to the slab
+template <typename key, typename value>
+struct ak_btree_map
 {
-    if(Index >= Length) return NULL;
-    return Data + Index;
-}
+    ak_allocator* Allocator = NULL;
+    ak_slab* Storage = NULL;
+    bool OwnsStorage = false;
+    
+    void* Root = NULL;
+    uint32_t Height = 0; //NOTE(EVERYONE): Number of inner levels above the leaves
+    uint64_t Length = 0;
+    ak__btree_leaf<key, value>* FirstLeaf = NULL;
+    
+    void Add(const key& Key, const value& Value);
+    value* Find(const key& Key);
+    bool Remove(const key& Key);
+    void Clear();
+    
+    //NOTE(EVERYONE): Keys have to be sorted and unique. Leaves are packed full and the inner levels are built bottom up
+    void Bulk_Load(const key* Keys, const value* Values, uint64_t Count);
+    
+    ak_btree_iterator<key, value> Lower_Bound(const key& Key);
+    ak_btree_range<key, value> Range(const key& Min, const key& Max); //NOTE(EVERYONE): Keys in [Min, Max)
+    
+    ak_btree_iterator<key, value> begin() const;
+    ak_btree_iterator<key, value> end() const;
+};
 
-template <typename type>
-type& ak_array<type>::operator[](uint64_t Index)
-{
-    AK_STD_ASSERT(Index < Length, "Array index out of bounds!");
-    return Data[Index];
-}
+template <typename key, typename value> ak_slab* 
+AK_Create_BTree_Map_Slab(uint64_t ArenaBlockSize = AK_ARENA_INITIAL_BLOCK_SIZE, ak_allocator* Allocator = NULL);
 
-template <typename type>
-const type& ak_array<type>::operator[](uint64_t Index) const
-{
-    AK_STD_ASSERT(Index < Length, "Array index out of bounds!");
-    return Data[Index];
-}
+template <typename key, typename value> ak_btree_map<key, value>
+AK_Create_BTree_Map(ak_slab* Slab = NULL, ak_allocator* Allocator = NULL);
 
-template <typename type>
-void ak_array<type>::Clear()
-{
-    AK__Memory_Clear(Data, sizeof(type)*Length);
-    Length = 0;
-}
+template <typename key, typename value> void
+AK_Delete(ak_btree_map<key, value>* Map);
 
-template <typename type>
-ak_array<type> ak_array<type>::Copy(ak_arena* Arena)
-{
-    ak_array<type> Result = Arena->Push_Array<type>(Length);
-    AK__Memory_Copy(Result.Data, Data, Length*sizeof(type));
-    return Result;
-}
+//~LRU cache definition
+#define AK__LRU_INVALID_INDEX ((uint32_t)-1)
 
-template <typename type>
-type* ak_array<type>::begin()
+enum ak_cache_policy
 {
-    return Data;
-}
+    AK_CACHE_POLICY_LRU,
+    AK_CACHE_POLICY_CLOCK
+};
 
-template <typename type>
-type* ak_array<type>::end()
-{
-    return Data + Length;
-}
+template <typename key, typename value>
+struct ak__lru_entry
+{
+    key      Key;
+    value    Value;
+    uint64_t Cost;
+    uint32_t Prev;
+    uint32_t Next;
+    bool     Referenced;
+};
 
-template <typename type>
-const type* ak_array<type>::begin() const
+template <typename key, typename value>
+struct ak_lru_cache
 {
-    return Data;
-}
+    typedef void evict_callback(const key& Key, value* Value, uint64_t UserData);
+    
+    ak_allocator* Allocator = NULL;
+    ak_cache_policy Policy = AK_CACHE_POLICY_LRU;
+    uint32_t Capacity = 0;
+    uint32_t Length = 0;
+    
+    //NOTE(EVERYONE): With MaxCost set, entries are also evicted until the summed cost of the cache fits
+    uint64_t MaxCost = 0;
+    uint64_t TotalCost = 0;
+    
+    //NOTE(EVERYONE): Entries are preallocated and linked by index from the most recent (Head) to the least recent 
+    //(Tail). Free entries are chained through Next starting at FreeHead
+    ak__lru_entry<key, value>* Entries = NULL;
+    ak_hashmap<key, uint32_t> Lookup;
+    uint32_t Head = AK__LRU_INVALID_INDEX;
+    uint32_t Tail = AK__LRU_INVALID_INDEX;
+    uint32_t FreeHead = AK__LRU_INVALID_INDEX;
+    
+    //NOTE(EVERYONE): Called right before an entry is evicted to make room, not on Remove or Clear
+    evict_callback* EvictCallback = NULL;
+    uint64_t EvictUserData = 0;
+    
+    //NOTE(EVERYONE): In LRU mode a hit moves the entry to the front. In CLOCK mode a hit only sets the referenced bit 
+    //and eviction gives referenced entries a second chance, so reads never touch the links
+    value* Get(const key& Key);
+    value* Put(const key& Key, const value& Value, uint64_t Cost = 1);
+    bool Remove(const key& Key);
+    void Clear();
+};
 
-template <typename type>
-const type* ak_array<type>::end() const
-{
-    return Data + Length;
-}
+template <typename key, typename value> ak_lru_cache<key, value>
+AK_Create_LRU_Cache(uint32_t Capacity, uint64_t MaxCost = 0, ak_cache_policy Policy = AK_CACHE_POLICY_LRU, ak_allocator* Allocator = NULL);
 
-template <typename type>
-ak_array<type> AK_Create_Array(type* Ptr, uint64_t Length)
-{
-    ak_array<type> Result;
-    Result.Data = Ptr;
-    Result.Length = Length;
-    return Result;
-}
+template <typename key, typename value> void
+AK_Delete(ak_lru_cache<key, value>* Cache);
 
-//~Raii implementation
-template <typename type>
-ak_raii<type>::ak_raii(type* Resource)
-{
-    ManagedResource = Resource;
-    Cleanup = true;
-}
+//~Pool definition
+#define AK_POOL16_MAX_CAPACITY ((1 << 16)-1)
 
-template <typename type>
-void ak_raii<type>::Block()
+union ak__pool_id
 {
-    Cleanup = false;
-}
-
-template <typename type>
-void ak_raii<type>::Unblock()
-{
-    Cleanup = true;
-}
+    uint64_t ID;
+    struct
+    {
+        uint32_t Key;
+        struct
+        {
+            uint16_t PreviousIndex;
+            uint16_t NextIndex;
+        };
+    };
+    
+    struct
+    {
+        uint32_t __Unused__;
+        struct
+        {
+            uint16_t Type;
+            uint16_t Index;
+        };
+    };
+};
+
+#define AK__INVALID_POOL_INDEX ((uint16_t)-1)
 
 template <typename type>
-ak_raii<type>::~ak_raii()
+struct ak__pool_entry
 {
-    if(Cleanup) AK_Delete(ManagedResource);
-}
+    ak__pool_id ID;
+    type        Entry;
+};
 
-//~Arena implementation
+template <typename type, uint64_t bucket_capacity>
+struct ak_pool;
 
-struct ak__arena_block
+template <typename type, uint64_t bucket_capacity>
+struct ak_pool_iterator
 {
-    uint8_t* Memory;
-    uint64_t Used;
-    uint64_t Size;
-    ak__arena_block* Next;
+    ak_pool<type, bucket_capacity>* Pool;
+    uint16_t CurrentIndex;
+    type& operator*();
+    void operator++();
+    bool operator!=(const ak_pool_iterator& Iterator);
 };
 
-ak__arena_block* AK__Arena_Allocate_Block(uint64_t BlockSize, ak_allocator* Allocator)
+template <typename type, uint64_t bucket_capacity = AK_ARRAY_BUCKET_INITIAL_CAPACITY>
+struct ak_pool
 {
-    ak__arena_block* Block = (ak__arena_block*)Allocator->Alloc(sizeof(ak__arena_block)+BlockSize, Allocator->UserData);
-    if(!Block)
-    {
-        //TODO(JJ): Diagnostic and error logging
-        return NULL;
-    }
+    using ak_pool_storage = ak_bucket_array<ak__pool_entry<type>, bucket_capacity>;
     
-    AK__Memory_Clear(Block, sizeof(ak__arena_block));
-    Block->Memory = (uint8_t*)(Block+1);
-    Block->Size = BlockSize;
+    static const uint64_t MAX_CAPACITY = (1ull << 32)-1;
     
-    return Block;
-}
-
-void AK__Arena_Add_Block(ak_arena* Arena, ak__arena_block* Block)
-{
-    (Arena->FirstBlock == 0) ? 
-    (Arena->FirstBlock = Arena->LastBlock = Block) : 
-    (Arena->LastBlock->Next = Block, Arena->LastBlock = Block);
-}
-
-ak__arena_block* AK__Arena_Get_Block(ak_arena* Arena, uint64_t Size, uint64_t Alignment)
-{
-    ak__arena_block* Block = Arena->CurrentBlock;
-    if(!Block) return NULL;
+    ak_pool_storage Data;
+    uint16_t Type = 0;
+    uint16_t Length = 0;
+    uint16_t FirstAllocatedIndex = AK__INVALID_POOL_INDEX;
+    uint16_t FirstAvailableIndex = AK__INVALID_POOL_INDEX;
+    uint32_t NextKey = 1;
     
-    uint64_t Used = AK__Memory_Align(Block->Used, Alignment);
-    while(Used+Size > Block->Size)
-    {
-        Block = Block->Next;
-        if(!Block) return NULL;
-        Used = AK__Memory_Align(Block->Used, Alignment);
-    }
+    uint64_t Allocate(const type& Value = {});
+    type* Allocate_And_Get(uint64_t* ID = NULL);
+    void Free(uint64_t ID);
+    void Free_All();
     
-    return Block;
-}
+    bool Is_Allocated(uint64_t ID);
+    type* Get(uint64_t ID);
+    type& operator[](uint64_t ID);
+    
+    ak_pool_iterator<type, bucket_capacity> begin();
+    ak_pool_iterator<type, bucket_capacity> end();
+};
 
-void* AK__Arena_Alloc(size_t Size, uint64_t UserData)
-{
-    ak_arena* Arena = (ak_arena*)UserData;
-    return Arena->Push(Size).Data;
-}
+template <typename type, uint64_t bucket_capacity> 
+void AK_Delete(ak_pool<type, bucket_capacity>* Pool);
 
-void AK__Arena_Free(void* Memory, uint64_t UserData)
-{
-    
-}
+//~String definition
+#define AK_STR8_FIND_ERROR ((uint64_t)-1)
 
-ak_buffer ak_arena::Push(uint64_t Size, uint64_t Alignment, ak_arena_clear_flag ClearFlag)
+bool AK_Is_Newline(char Code);
+bool AK_Is_Whitespace(char Code);
+uint64_t AK_CStr_Length(const char* Str);
+
+//TODO(JJ): ak_str16 and ak_str32
+
+struct ak_str8
 {
-    if(!Size) return {};
-    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    const char* Str;
+    uint64_t    Length;
     
-    ak__arena_block* Block = AK__Arena_Get_Block(this, Size, Alignment);
-    if(!Block)
-    {
-        uint64_t BlockSize = InitialBlockSize;
-        if(Size > BlockSize)
-            BlockSize = (Alignment) ? AK__Memory_Align(Size, Alignment) : Size;
-        
-        Block = AK__Arena_Allocate_Block(BlockSize, Allocator);
-        if(!Block)
-        {
-            //TODO(JJ): Diagnostic and error logging
-            return {};
-        }
-        
-        AK__Arena_Add_Block(this, Block);
-    }
+    const char& operator[](uint64_t Index) const;
     
-    CurrentBlock = Block;
-    if(Alignment) CurrentBlock->Used = AK__Memory_Align(CurrentBlock->Used, Alignment);
+    bool Is_Null_Or_Empty();
+    bool Is_Null_Or_Whitespace();
     
-    uint8_t* Ptr = CurrentBlock->Memory + CurrentBlock->Used;
-    CurrentBlock->Used += Size;
+    uint64_t Find_First(char Code);
+    uint64_t Find_Last(char Code);
     
-    if(ClearFlag == AK_ARENA_CLEAR)
-        AK__Memory_Clear(Ptr, Size);
+    ak_str8 Prefix(uint64_t Count);
+    ak_str8 Chop(uint64_t Count);
+    ak_str8 Postfix(uint64_t Count);
+    ak_str8 Skip(uint64_t Count);
+    ak_str8 Substr(uint64_t First, uint64_t End);
     
-    ak_buffer Result;
-    Result.Data = Ptr;
-    Result.Length = Size;
+    bool Begins_With(const ak_str8& CompStr);
+    bool Ends_With(const ak_str8& CompStr);
+    ak_str8 Trim_Whitespace();
     
-    return Result;
-}
+    bool Is_Null_Term();
+    const char* To_CStr(ak_arena* Arena);
+    ak_str8 Copy(ak_arena* Arena);
+};
 
-ak_buffer ak_arena::Push(uint64_t Size, ak_arena_clear_flag ClearFlag)
+struct ak_str8_node
 {
-    ak_buffer Result = Push(Size, 4, ClearFlag);
-    return Result;
-}
+    ak_str8_node* Next;
+    ak_str8       String;
+};
 
-template <typename type> 
-type* ak_arena::Push_Struct(uint64_t Alignment, ak_arena_clear_flag ClearFlag)
+struct ak_str8_list
 {
-    return (type*)Push(sizeof(type), Alignment, ClearFlag).Data;
-}
+    ak_str8_node* First;
+    ak_str8_node* Last;
+    uint64_t      NodeCount;
+    uint64_t      TotalLength;
+    
+    void Push_Explicit(const ak_str8& PushedString, ak_str8_node* Node);
+    void Push(const ak_str8& PushedString, ak_arena* Arena);
+    
+    ak_str8 Join(ak_arena* Arena);
+    ak_str8 Join_New_Line(ak_arena* Arena);
+    
+    void FormatV(ak_arena* Arena, const char* Format, va_list Args);
+    void Format(ak_arena* Arena, const char* Format, ...);
+};
 
-template <typename type> 
-type* ak_arena::Push_Struct(ak_arena_clear_flag ClearFlag)
-{
-    return (type*)Push(sizeof(type), ClearFlag).Data;
-}
+ak_str8 AK_Str8(const char* Str);
+ak_str8 AK_Str8(const char* Str, uint64_t StrLength);
+ak_str8 AK_Str8(const char* First, const char* Last);
+#define AK_Str8_Lit(s) AK_Str8((const char*)s, sizeof(s)-1)
+ak_str8_list AK_Str8_Split(const ak_str8& String, ak_arena* Arena, char* SplitChars, uint32_t CharCount);
+ak_str8 AK_Str8_FormatV(ak_arena* Arena, const char* Format, va_list Args);
+ak_str8 AK_Str8_Format(ak_arena* Arena, const char* Format, ...);
 
-template <typename type> 
-ak_array<type> ak_arena::Push_Array(uint64_t Count, uint64_t Alignment, ak_arena_clear_flag ClearFlag)
-{
-    type* Ptr = (type*)Push(sizeof(type)*Count, Alignment, ClearFlag).Data;
-    return AK_Create_Array<type>(Ptr, Count);
-}
+//TODO(JJ): UTF8 functions
 
-template <typename type> 
-ak_array<type> ak_arena::Push_Array(uint64_t Count, ak_arena_clear_flag ClearFlag)
-{
-    type* Ptr = (type*)Push(sizeof(type)*Count, ClearFlag).Data; 
-    return AK_Create_Array<type>(Ptr, Count);
-}
+bool operator!=(const ak_str8& A, const ak_str8& B);
+bool operator==(const ak_str8& A, const ak_str8& B);
 
-ak_arena_marker ak_arena::Get_Marker()
-{
-    ak_arena_marker Marker;
-    Marker.Arena = this;
-    Marker.Block = CurrentBlock;
-    if(CurrentBlock) Marker.Marker = CurrentBlock->Used;
-    return Marker;
-}
+uint32_t AK_Hash_Function(const ak_str8& Str);
 
-void ak_arena::Set_Marker(ak_arena_marker Marker)
+template <>
+struct ak_hash_traits<ak_str8>
 {
-    AK_STD_ASSERT(Marker.Arena == this, "Marker was not retrieved from this arena!");
-    
-    //NOTE(EVERYONE): If the block is null it always signalizes the beginning of the arena
-    if(!Marker.Block)
-    {
-        CurrentBlock = FirstBlock;
-        if(CurrentBlock) CurrentBlock->Used = 0;
-    }
-    else
-    {
-        CurrentBlock = Marker.Block;
-        CurrentBlock->Used = Marker.Marker;
-        for(ak__arena_block* ArenaBlock = CurrentBlock->Next; ArenaBlock; ArenaBlock = ArenaBlock->Next)
-            ArenaBlock->Used = 0;
-    }
-}
+    static uint32_t Hash(const ak_str8& Key);
+    static uint32_t Hash(const char* Key);
+    static uint64_t Hash64(const ak_str8& Key);
+    static uint64_t Hash64(const char* Key);
+    static bool Equals(const ak_str8& A, const ak_str8& B);
+    static bool Equals(const ak_str8& A, const char* B);
+};
 
-uint64_t ak_arena::Get_Total_Used() const
-{
-    uint64_t Result = 0;
-    for(ak__arena_block* Block = FirstBlock; Block; Block = Block->Next) Result += Block->Used;
-    return Result;
+#ifdef AK_HASH_MAP_STATS
+ak_str8 AK_Hash_Map_Stats_To_Text(const ak_hashmap_stats& Stats, ak_arena* Arena);
+ak_str8 AK_Hash_Map_Stats_To_JSON(const ak_hashmap_stats& Stats, ak_arena* Arena);
+#endif
+
+#endif //AK_STD_INCLUDE
+
+#ifdef AK_STD_IMPLEMENTATION
+
+#ifndef AK_STD_MALLOC
+#include <stdlib.h>
+#define AK_STD_MALLOC(size) malloc(size)
+#define AK_STD_FREE(memory) free(memory)
+#endif //AK_STD_MALLOC
+
+#ifndef AK_STD_MEMCPY
+#include <string.h>
+#define AK_STD_MEMCPY(dest, src, n) memcpy(dest, src, n)
+#define AK_STD_MEMSET(ptr, value, n) memset(ptr, value, n)
+#endif //AK_STD_MEMCPY
+
+#ifndef AK_STD_MEMMOVE
+#include <string.h>
+#define AK_STD_MEMMOVE(dest, src, n) memmove(dest, src, n)
+#endif //AK_STD_MEMMOVE
+
+#ifndef AK_STD_ASSERT
+#include <assert.h>
+#define AK_STD_ASSERT(condition, message) assert(condition)
+#endif //AK_STD_ASSERT
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AK__SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(AK__SSE2)
+#define AK__Prefetch(ptr) _mm_prefetch((const char*)(ptr), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define AK__Prefetch(ptr) __builtin_prefetch(ptr)
+#else
+#define AK__Prefetch(ptr) ((void)(ptr))
+#endif
+
+#if defined(__SSE4_2__) || defined(__AVX__)
+#define AK__SSE42
+#include <nmmintrin.h>
+#elif defined(_M_X64) || defined(_M_IX86) || \
+    ((defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)))
+//NOTE(EVERYONE): The target does not promise SSE4.2, so code that wants it checks the CPU once at runtime
+#define AK__SSE42_DISPATCH
+#include <nmmintrin.h>
+#endif
+
+#ifdef AK_HASH_MAP_STATS
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define AK__Read_Cycle_Counter() __rdtsc()
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define AK__Read_Cycle_Counter() __rdtsc()
+#else
+#define AK__Read_Cycle_Counter() 0ull
+#endif
+#endif
+
+#ifndef AK_STD_NO_FILE_IO
+#ifndef AK_STD_FOPEN
+#include <stdio.h>
+#define AK_STD_FILE FILE
+#define AK_STD_FOPEN(path, mode) fopen(path, mode)
+#define AK_STD_FWRITE(ptr, size, count, file) fwrite(ptr, size, count, file)
+#define AK_STD_FCLOSE(file) fclose(file)
+#endif //AK_STD_FOPEN
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#endif //AK_STD_NO_FILE_IO
+
+#define AK__Max(a, b) ((a) > (b) ? (a) : (b))
+#define AK__Min(a, b) ((a) < (b) ? (a) : (b))
+
+void AK__Memory_Copy(void* Dest, const void* Src, size_t Size)
+{
+    AK_STD_MEMCPY(Dest, Src, Size);
 }
 
-uint64_t ak_arena::Get_Total_Block_Size() const
+void AK__Memory_Move(void* Dest, const void* Src, size_t Size)
 {
-    uint64_t Result = 0;
-    for(ak__arena_block* Block = FirstBlock; Block; Block = Block->Next) Result += Block->Size;
-    return Result;
+    AK_STD_MEMMOVE(Dest, Src, Size);
 }
 
-void ak_arena::Clear(ak_arena_clear_flag ClearFlag) 
+void AK__Memory_Set(void* Dest, uint8_t Value, size_t Size)
 {
-    for(ak__arena_block* Block = FirstBlock; Block; Block = Block->Next)
-    {
-        if(ClearFlag == AK_ARENA_CLEAR) AK__Memory_Clear(Block->Memory, Block->Used);
-        Block->Used = 0;
-    }
+    AK_STD_MEMSET(Dest, Value, Size);
 }
 
-ak_temp_arena::ak_temp_arena(ak_arena* TempArena)
+void AK__Memory_Clear(void* Dest, size_t Size)
 {
-    Begin_Temp(TempArena);
+    AK_STD_MEMSET(Dest, 0, Size);
 }
 
-void ak_temp_arena::Begin_Temp(ak_arena* TempArena)
+uint64_t AK__Memory_Align(uint64_t Value, uint64_t Alignment)
 {
-    Marker = TempArena->Get_Marker();
+    Alignment = Alignment ? Alignment : 1;
+    uint64_t Mod = Value & (Alignment-1);
+    return Mod ? Value + (Alignment-Mod) : Value;
 }
 
-void ak_temp_arena::End_Temp()
+void* AK__Alloc(size_t Size, uint64_t UserData)
 {
-    //NOTE(EVERYONE): If the block is null it always signalizes the beginning of the arena
-    if(Marker.Arena)
-    {
-        Marker.Arena->Set_Marker(Marker);
-        Marker.Arena = NULL;
-    }
+    return AK_STD_MALLOC(Size);
 }
 
-ak_temp_arena::~ak_temp_arena()
+void AK__Free(void* Memory, uint64_t UserData)
 {
-    End_Temp();
+    if(Memory) AK_STD_FREE(Memory);
 }
 
-ak_arena* AK_Create_Arena(uint64_t InitialBlockSize, ak_allocator* Allocator)
+uint64_t AK__Ceil_Pow2(uint64_t V)
 {
-    if(!Allocator) Allocator = AK__Get_Default_Allocator();
-    
-    void* Memory = Allocator->Alloc(InitialBlockSize + sizeof(ak_arena)+sizeof(ak__arena_block), Allocator->UserData);
-    if(!Memory) 
-    {
-        //TODO(JJ): Diagnostic and error logging
-        return NULL;
-    }
-    
-    ak_arena* Result = (ak_arena*)Memory;
-    Result->InitialBlockSize = InitialBlockSize;
-    Result->Allocator = Allocator;
-    
-    ak__arena_block* Block = (ak__arena_block*)(Result+1);
-    AK__Memory_Clear(Block, sizeof(ak__arena_block));
-    Block->Memory = (uint8_t*)(Block+1);
-    Block->Size = InitialBlockSize;
-    Block->Used = 0;
-    AK__Arena_Add_Block(Result, Block);
-    Result->CurrentBlock = Block;
-    
-    Result->Alloc = AK__Arena_Alloc;
-    Result->Free = AK__Arena_Free;
-    Result->UserData = (uint64_t)Result;
-    
+    --V;
+    V |= V >> 1;
+    V |= V >> 2;
+    V |= V >> 4;
+    V |= V >> 8;
+    V |= V >> 16;
+    V |= V >> 32;
+    ++V;
+    V += ( V == 0 );    
+    return V;
+}
+
+uint64_t AK__Mul_Hi64(uint64_t A, uint64_t B)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    return __umulh(A, B);
+#elif defined(__SIZEOF_INT128__)
+    return (uint64_t)(((unsigned __int128)A*(unsigned __int128)B) >> 64);
+#else
+    uint64_t ALo = (uint32_t)A, AHi = A >> 32;
+    uint64_t BLo = (uint32_t)B, BHi = B >> 32;
+    uint64_t LoLo = ALo*BLo;
+    uint64_t HiLo = AHi*BLo;
+    uint64_t LoHi = ALo*BHi;
+    uint64_t HiHi = AHi*BHi;
+    uint64_t Cross = (LoLo >> 32) + (uint32_t)HiLo + LoHi;
+    return HiHi + (HiLo >> 32) + (Cross >> 32);
+#endif
+}
+
+uint32_t AK__Count_Trailing_Zeros32(uint32_t Value)
+{
+#ifdef _MSC_VER
+    unsigned long Result;
+    _BitScanForward(&Result, Value);
+    return (uint32_t)Result;
+#else
+    return (uint32_t)__builtin_ctz(Value);
+#endif
+}
+
+//~Atomics
+//NOTE(EVERYONE): The 64 bit read modify writes and loads are sequentially consistent so a store to one address 
+//followed by a load of another is never reordered, which the reader writer lock relies on
+uint64_t AK__Atomic_Add64(volatile uint64_t* Value, uint64_t Addend)
+{
+#ifdef _MSC_VER
+    return (uint64_t)_InterlockedExchangeAdd64((volatile __int64*)Value, (__int64)Addend);
+#else
+    return __atomic_fetch_add(Value, Addend, __ATOMIC_SEQ_CST);
+#endif
+}
+
+uint64_t AK__Atomic_Compare_Exchange64(volatile uint64_t* Dest, uint64_t Exchange, uint64_t Comparand)
+{
+#ifdef _MSC_VER
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64*)Dest, (__int64)Exchange, (__int64)Comparand);
+#else
+    __atomic_compare_exchange_n(Dest, &Comparand, Exchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return Comparand;
+#endif
+}
+
+void* AK__Atomic_Compare_Exchange_Ptr(void* volatile* Dest, void* Exchange, void* Comparand)
+{
+#ifdef _MSC_VER
+    return _InterlockedCompareExchangePointer(Dest, Exchange, Comparand);
+#else
+    __atomic_compare_exchange_n(Dest, &Comparand, Exchange, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    return Comparand;
+#endif
+}
+
+uint64_t AK__Atomic_Load64(volatile uint64_t* Value)
+{
+#ifdef _MSC_VER
+    uint64_t Result = *Value;
+    _ReadWriteBarrier();
     return Result;
+#else
+    return __atomic_load_n(Value, __ATOMIC_SEQ_CST);
+#endif
 }
 
-void AK_Delete(ak_arena* Arena)
+void AK__Atomic_Store64(volatile uint64_t* Dest, uint64_t Value)
 {
-    if(Arena)
-    {
-        AK_STD_ASSERT(Arena->FirstBlock, "First block should've been allocated when the arena was created. This is a programming error");
-        ak__arena_block* Block = Arena->FirstBlock->Next;
-        while(Block)
-        {
-            ak__arena_block* BlockToDelete = Block;
-            Block = Block->Next;
-            Arena->Allocator->Free(BlockToDelete, Arena->Allocator->UserData);
-        }
-        
-        Arena->Allocator->Free(Arena, Arena->Allocator->UserData);
-    }
+#ifdef _MSC_VER
+    _InterlockedExchange64((volatile __int64*)Dest, (__int64)Value);
+#else
+    __atomic_store_n(Dest, Value, __ATOMIC_RELEASE);
+#endif
 }
 
-void* operator new(size_t Size, ak_arena* Arena)
+void AK__Atomic_Pause()
 {
-    return Arena->Push(Size).Data;
+#ifdef AK__SSE2
+    _mm_pause();
+#endif
 }
 
-//~Dynamic Array implementation
-template <typename type>
-bool ak_dynamic_array<type>::Add(const type& Entry)
+void* AK__Atomic_Load_Ptr(void* volatile* Value)
 {
-    if(!Capacity)
+#ifdef _MSC_VER
+    void* Result = *Value;
+    _ReadWriteBarrier();
+    return Result;
+#else
+    return __atomic_load_n(Value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+//~File mapping
+#ifndef AK_STD_NO_FILE_IO
+//NOTE(EVERYONE): Maps a whole file. Copy on write mappings can be written to without the changes reaching the file
+bool AK__Map_File(const char* Path, bool CopyOnWrite, ak__file_mapping* Mapping)
+{
+    *Mapping = {};
+    
+#ifdef _WIN32
+    HANDLE File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(File == INVALID_HANDLE_VALUE)
     {
-        if(!Reserve(AK_DYNAMIC_ARRAY_INITIAL_CAPACITY))
-        {
-            //TODO(JJ): Diangostic and error logging
-            return false;
-        }
+        //TODO(JJ): Diagnostic and error logging
+        return false;
     }
     
-    if(Length == Capacity)
+    LARGE_INTEGER FileSize;
+    HANDLE FileMapping = NULL;
+    if(GetFileSizeEx(File, &FileSize) && FileSize.QuadPart)
+        FileMapping = CreateFileMappingA(File, NULL, CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(File);
+    
+    if(!FileMapping)
     {
-        if(!Reserve(Capacity*2))
-        {
-            //TODO(JJ): Diagnostic and error logging
-            return false;
-        }
+        //TODO(JJ): Diagnostic and error logging
+        return false;
     }
     
-    Data[Length++] = Entry;
-    return true;
-}
-
-template <typename type>
-bool ak_dynamic_array<type>::Add_Range(const type* Entries, uint64_t Count)
-{
-    if(!Capacity)
+    void* Data = MapViewOfFile(FileMapping, CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    if(!Data)
     {
-        uint64_t NewCapacity = AK__Max(Count, AK_DYNAMIC_ARRAY_INITIAL_CAPACITY);
-        if(!Reserve(NewCapacity))
-        {
-            //TODO(JJ): Diagnostic and error logging
-            return false;
-        }
+        //TODO(JJ): Diagnostic and error logging
+        CloseHandle(FileMapping);
+        return false;
     }
     
-    if(Length + Count > Capacity)
+    Mapping->Data = Data;
+    Mapping->Size = (uint64_t)FileSize.QuadPart;
+    Mapping->Handle = FileMapping;
+#else
+    int File = open(Path, O_RDONLY);
+    if(File < 0)
     {
-        uint64_t NewCapacity = AK__Max(Length+Count, Capacity*2);
-        if(!Reserve(NewCapacity))
-        {
-            //TODO(JJ): Diagnostic and error logging
-            return false;
-        }
+        //TODO(JJ): Diagnostic and error logging
+        return false;
     }
     
-    AK__Memory_Copy(Data+Length, Entries, Count*sizeof(type));
-    Length += Count;
+    struct stat FileStat;
+    void* Data = MAP_FAILED;
+    if(fstat(File, &FileStat) == 0 && FileStat.st_size)
+    {
+        int Protection = CopyOnWrite ? (PROT_READ|PROT_WRITE) : PROT_READ;
+        Data = mmap(NULL, (size_t)FileStat.st_size, Protection, MAP_PRIVATE, File, 0);
+    }
+    close(File);
+    
+    if(Data == MAP_FAILED)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    
+    Mapping->Data = Data;
+    Mapping->Size = (uint64_t)FileStat.st_size;
+#endif
+    
     return true;
 }
 
-template <typename type>
-bool ak_dynamic_array<type>::Add_Range(const type* Start, const type* End)
+void AK__Unmap_File(ak__file_mapping* Mapping)
 {
-    return Add_Range(Start, End-Start);
+    if(Mapping->Data)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(Mapping->Data);
+        CloseHandle((HANDLE)Mapping->Handle);
+#else
+        munmap(Mapping->Data, (size_t)Mapping->Size);
+#endif
+    }
+    *Mapping = {};
 }
+#endif //AK_STD_NO_FILE_IO
 
-template <typename type>
-bool ak_dynamic_array<type>::Reserve(uint64_t NewCapacity)
+ak_allocator* AK__Get_Default_Allocator()
 {
-    if(!Allocator) Allocator = AK__Get_Default_Allocator();
-    
-    if(NewCapacity < Length) NewCapacity = Length;
-    
-    type* NewData = (type*)Allocator->Alloc(NewCapacity*sizeof(type), Allocator->UserData);
-    if(!NewData)
-    {
-        //TODO(JJ): Error handling
-        return false;
-    }
-    
-    if(Data) 
-    {
-        uint64_t CopySize = Capacity > NewCapacity ? NewCapacity : Capacity;
-        AK__Memory_Copy(NewData, Data, CopySize*sizeof(type));
-        Allocator->Free(Data, Allocator->UserData);
-    }
-    
-    Data = NewData;
-    Capacity = NewCapacity;
-    
-    return true;
+    static ak_allocator Allocator;
+    Allocator.Alloc = AK__Alloc;
+    Allocator.Free = AK__Free;
+    return &Allocator;
 }
 
+//~Array implementation
 template <typename type>
-bool ak_dynamic_array<type>::Resize(uint64_t NewLength)
+type* ak_array<type>::Get(uint64_t Index)
 {
-    if(NewLength > Capacity) 
-    {
-        if(!Reserve(NewLength))
-        {
-            //TODO(JJ): Diagnostic and error logging
-            return false;
-        }
-    }
-    Length = NewLength;
-    return true;
+    if(Index >= Length) return NULL;
+    return Data + Index;
 }
 
-template <typename type> 
-ak_dynamic_array<type> AK_Dynamic_Create_Array(uint64_t InitialCapacity, ak_allocator* Allocator)
+template <typename type>
+const type* ak_array<type>::Get(uint64_t Index) const
 {
-    ak_dynamic_array<type> Result;
-    Result.Allocator = Allocator;
-    Result.Reserve(InitialCapacity);
-    return Result;
+    if(Index >= Length) return NULL;
+    return Data + Index;
 }
 
 template <typename type>
-void AK_Delete(ak_dynamic_array<type>* Array)
+type& ak_array<type>::operator[](uint64_t Index)
 {
-    if(Array && Array->Data)
-    {
-        Array->Allocator->Free(Array->Data, Array->Allocator->UserData);
-        AK__Memory_Clear(Array, sizeof(ak_dynamic_array<type>));
-    }
+    AK_STD_ASSERT(Index < Length, "Array index out of bounds!");
+    return Data[Index];
 }
 
-//~Bucket Array implementation
-template <typename type, uint64_t bucket_capacity>
-type& ak_bucket_array_iterator<type, bucket_capacity>::operator*()
+template <typename type>
+const type& ak_array<type>::operator[](uint64_t Index) const
 {
-    return Array->Buckets[CurrentBucketIndex]->Data[CurrentIndexInBucket];
+    AK_STD_ASSERT(Index < Length, "Array index out of bounds!");
+    return Data[Index];
 }
 
-template <typename type, uint64_t bucket_capacity>
-bool ak_bucket_array_iterator<type, bucket_capacity>::operator!=(const ak_bucket_array_iterator& Iterator)
+template <typename type>
+void ak_array<type>::Clear()
 {
-    uint64_t Index = (CurrentBucketIndex*bucket_capacity) + CurrentIndexInBucket;
-    return Index < Array->Length;
+    AK__Memory_Clear(Data, sizeof(type)*Length);
+    Length = 0;
 }
 
-template <typename type, uint64_t bucket_capacity>
-void ak_bucket_array_iterator<type, bucket_capacity>::operator++()
+template <typename type>
+ak_array<type> ak_array<type>::Copy(ak_arena* Arena)
 {
-    CurrentIndexInBucket++;
-    if(CurrentIndexInBucket == bucket_capacity)
-    {
-        CurrentBucketIndex++;
-        CurrentIndexInBucket = 0;
-    }
+    ak_array<type> Result = Arena->Push_Array<type>(Length);
+    AK__Memory_Copy(Result.Data, Data, Length*sizeof(type));
+    return Result;
 }
 
-template <typename type, uint64_t bucket_capacity>
-ak__bucket<type, bucket_capacity>* AK__Array_Get_Current_Bucket(ak_bucket_array<type, bucket_capacity>* Array)
+template <typename type>
+type* ak_array<type>::begin()
 {
-    if(!Array->Allocator) 
-    {
-        Array->Allocator = AK__Get_Default_Allocator();
-        Array->Buckets.Allocator = Array->Allocator;
-    }
-    
-    if(!Array->Storage)
-    {
-        Array->Storage = AK_Create_Arena(AK_ARENA_INITIAL_BLOCK_SIZE, Array->Allocator);
-        if(!Array->Storage)
-        {
-            //TODO(JJ): Diagnostic and error logging
-            return NULL;
-        }
-    }
-    
-    if(Array->CurrentBucketIndex == Array->Buckets.Length)
-    {
-        ak__bucket<type, bucket_capacity>* Bucket = Array->Storage->Push_Struct<ak__bucket<type, bucket_capacity>>();
-        if(!Bucket)
-        {
-            //TODO(JJ): Diagnostic and error logging
-            return NULL;
-        }
-        Bucket->Length = 0;
-        Array->Buckets.Add(Bucket);
-    }
-    
-    return Array->Buckets[Array->CurrentBucketIndex];
+    return Data;
 }
 
-template <typename type, uint64_t bucket_capacity>
-bool ak_bucket_array<type, bucket_capacity>::Add(const type& Entry)
+template <typename type>
+type* ak_array<type>::end()
 {
-    ak__bucket<type, bucket_capacity>* CurrentBucket = AK__Array_Get_Current_Bucket(this);
-    if(!CurrentBucket)
-    {
-        //TODO(JJ): Diagnostic and error logging
-        return false;
-    }
-    
-    if(CurrentBucket->Length == bucket_capacity)
-    {
-        CurrentBucketIndex++;
-        return Add(Entry);
-    }
-    
-    CurrentBucket->Data[CurrentBucket->Length++] = Entry;
-    Length++;
-    return true;
+    return Data + Length;
 }
 
-template <typename type, uint64_t bucket_capacity>
-bool ak_bucket_array<type, bucket_capacity>::Add_Range(const type* Entries, uint64_t Count)
+template <typename type>
+const type* ak_array<type>::begin() const
 {
-    const type* EntryAt = Entries;
-    while(Count--) 
-    { 
-        if(!Add(*EntryAt))
-        {
-            //TODO(JJ): Diagnostic and error logging
-            return false;
-        }
-        EntryAt++; 
-    }
-    
-    return true;
+    return Data;
 }
 
-template <typename type, uint64_t bucket_capacity>
-bool ak_bucket_array<type, bucket_capacity>::Add_Range(const type* Start, const type* End)
+template <typename type>
+const type* ak_array<type>::end() const
 {
-    return Add_Range(Start, End-Start);
+    return Data + Length;
 }
 
-template <typename type, uint64_t bucket_capacity>
-type* ak_bucket_array<type, bucket_capacity>::Pop()
+template <typename type>
+ak_array<type> AK_Create_Array(type* Ptr, uint64_t Length)
 {
-    if(!Length) return NULL;
-    
-    ak__bucket<type, bucket_capacity>* Bucket = Buckets[CurrentBucketIndex];
-    AK_STD_ASSERT(Bucket->Length, "Invalid bucket count. Cannot pop a bucket with a length of 0");
-    
-    Bucket->Length--;
-    type* Result = Bucket->Data + Bucket->Length;
-    if(Bucket->Length == 0) CurrentBucketIndex = ((CurrentBucketIndex) ? (CurrentBucketIndex-1) : 0);
-    Length--;
+    ak_array<type> Result;
+    Result.Data = Ptr;
+    Result.Length = Length;
     return Result;
 }
 
-template <typename type, uint64_t bucket_capacity>
-type* ak_bucket_array<type, bucket_capacity>::Get(uint64_t Index)
+//~Raii implementation
+template <typename type>
+ak_raii<type>::ak_raii(type* Resource)
 {
-    uint64_t BucketIndex = Index / bucket_capacity;
-    if(BucketIndex >= Buckets.Length) return NULL;
-    
-    uint64_t EntryIndex = Index % bucket_capacity;
-    if(EntryIndex >= Buckets[BucketIndex]->Length) return NULL;
-    
-    return Buckets[BucketIndex]->Data + EntryIndex;
+    ManagedResource = Resource;
+    Cleanup = true;
 }
 
-template <typename type, uint64_t bucket_capacity>
-type& ak_bucket_array<type, bucket_capacity>::operator[](uint64_t Index)
+template <typename type>
+void ak_raii<type>::Block()
 {
-    type* Result = Get(Index);
-    AK_STD_ASSERT(Result, "Array out of bounds!");
-    return *Result;
+    Cleanup = false;
 }
 
-template <typename type, uint64_t bucket_capacity>
-bool ak_bucket_array<type, bucket_capacity>::Resize(uint64_t NewLength)
+template <typename type>
+void ak_raii<type>::Unblock()
 {
-    uint64_t NewLengthBucketIndex = NewLength / bucket_capacity;
-    uint64_t NewLengthEntryIndex = NewLength % bucket_capacity;
-    
-    if(CurrentBucketIndex > NewLengthBucketIndex)
-    {
-        uint64_t Difference = CurrentBucketIndex-NewLengthBucketIndex;
-        for(uint64_t BucketIndex = 0; BucketIndex < Difference; BucketIndex++)
-        {
-            Buckets[CurrentBucketIndex]->Length = 0;
-            CurrentBucketIndex--;
-        }
-    }
-    else if(CurrentBucketIndex < NewLengthBucketIndex)
-    {
-        uint64_t Difference = NewLengthBucketIndex-CurrentBucketIndex;
-        for(uint64_t BucketIndex = 0; BucketIndex < Difference; BucketIndex++)
-        {
-            ak__bucket<type, bucket_capacity>* Bucket = AK__Array_Get_Current_Bucket(this);
-            if(!Bucket)
-            {
-                //TODO(JJ): Diagnostic and error logging
-                return false;
-            }
-            
-            Bucket->Length = bucket_capacity;
-            CurrentBucketIndex++;
-        }
-    }
-    
-    ak__bucket<type, bucket_capacity>* Bucket = AK__Array_Get_Current_Bucket(this);
-    if(!Bucket)
-    {
-        //TODO(JJ): Diagnostic and error logging
-        return false;
-    }
-    Bucket->Length = NewLengthEntryIndex;
-    Length = NewLength;
-    return true;
+    Cleanup = true;
 }
 
-template <typename type, uint64_t bucket_capacity>
-void ak_bucket_array<type, bucket_capacity>::Clear()
+template <typename type>
+ak_raii<type>::~ak_raii()
 {
-    for(uint64_t BucketIndex = 0; BucketIndex < Buckets.Length; BucketIndex++)
-    {
-        AK__Memory_Clear(Buckets[BucketIndex].Data, sizeof(type)*bucket_capacity);
-        Buckets[BucketIndex].Length = 0;
-    }
-    Length = 0;
+    if(Cleanup) AK_Delete(ManagedResource);
 }
 
-template <typename type, uint64_t bucket_capacity>
-ak_buffer ak_bucket_array<type, bucket_capacity>::Get_Buffer(ak_arena* Arena)
+//~Arena implementation
+
+struct ak__arena_block
 {
-    type* Memory = Arena->Push_Array<type>(Length);
-    
-    type* At = Memory;
-    for(uint64_t BucketIndex = 0; BucketIndex < Buckets.Length; BucketIndex++)
+    uint8_t* Memory;
+    uint64_t Used;
+    uint64_t Size;
+    ak__arena_block* Next;
+};
+
+ak__arena_block* AK__Arena_Allocate_Block(uint64_t BlockSize, ak_allocator* Allocator)
+{
+    ak__arena_block* Block = (ak__arena_block*)Allocator->Alloc(sizeof(ak__arena_block)+BlockSize, Allocator->UserData);
+    if(!Block)
     {
-        ak__bucket<type, bucket_capacity>* Bucket = Buckets[BucketIndex];
-        AK__Memory_Copy(At, Bucket->Data, Bucket->Length*sizeof(type));
-        At += Bucket->Length;
+        //TODO(JJ): Diagnostic and error logging
+        return NULL;
     }
     
-    ak_buffer Result = {};
-    Result.Data = Memory;
-    Result.Length = Length*sizeof(type);
-    return Result;
+    AK__Memory_Clear(Block, sizeof(ak__arena_block));
+    Block->Memory = (uint8_t*)(Block+1);
+    Block->Size = BlockSize;
+    
+    return Block;
 }
 
-template <typename type, uint64_t bucket_capacity>
-ak_array<type> ak_bucket_array<type, bucket_capacity>::Get_Array(ak_arena* Arena)
+void AK__Arena_Add_Block(ak_arena* Arena, ak__arena_block* Block)
 {
-    ak_buffer Buffer = Get_Buffer(Arena);
-    ak_array<type> Result = AK_Create_Array<type>((type*)Buffer.Data, Length);
-    return Result;
+    (Arena->FirstBlock == 0) ? 
+    (Arena->FirstBlock = Arena->LastBlock = Block) : 
+    (Arena->LastBlock->Next = Block, Arena->LastBlock = Block);
 }
 
-template <typename type, uint64_t bucket_capacity>
-ak_bucket_array<type, bucket_capacity> ak_bucket_array<type, bucket_capacity>::Copy()
+ak__arena_block* AK__Arena_Get_Block(ak_arena* Arena, uint64_t Size, uint64_t Alignment)
 {
-    ak_bucket_array<type, bucket_capacity> Result;
-    Result.Allocator = Allocator;
-    Result.Storage = AK_Create_Arena(AK_ARENA_INITIAL_BLOCK_SIZE, Allocator);
-    if(!Result.Storage)
+    ak__arena_block* Block = Arena->CurrentBlock;
+    if(!Block) return NULL;
+    
+    uint64_t Used = AK__Memory_Align(Block->Used, Alignment);
+    while(Used+Size > Block->Size)
     {
-        //TODO(JJ): Diagnostic and error logging
-        return {};
+        Block = Block->Next;
+        if(!Block) return NULL;
+        Used = AK__Memory_Align(Block->Used, Alignment);
     }
-    Result.Buckets.Allocator = Allocator;
     
-    ak_raii<ak_bucket_array  <type, bucket_capacity>> RAII(&Result);
-    Result.Buckets.Resize(Buckets.Length);
+    return Block;
+}
+
+void* AK__Arena_Alloc(size_t Size, uint64_t UserData)
+{
+    ak_arena* Arena = (ak_arena*)UserData;
+    return Arena->Push(Size).Data;
+}
+
+void AK__Arena_Free(void* Memory, uint64_t UserData)
+{
     
-    for(uint64_t BucketIndex = 0; BucketIndex < Buckets.Length; BucketIndex++)
+}
+
+ak_buffer ak_arena::Push(uint64_t Size, uint64_t Alignment, ak_arena_clear_flag ClearFlag)
+{
+    if(!Size) return {};
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    
+    ak__arena_block* Block = AK__Arena_Get_Block(this, Size, Alignment);
+    if(!Block)
     {
-        ak__bucket<type, bucket_capacity>* Bucket = Result.Storage->Push_Struct<ak__bucket<type, bucket_capacity>>();
-        if(!Bucket)
+        uint64_t BlockSize = InitialBlockSize;
+        if(Size > BlockSize)
+            BlockSize = (Alignment) ? AK__Memory_Align(Size, Alignment) : Size;
+        
+        Block = AK__Arena_Allocate_Block(BlockSize, Allocator);
+        if(!Block)
         {
             //TODO(JJ): Diagnostic and error logging
             return {};
         }
         
-        Bucket->Length = Buckets[BucketIndex]->Length;
-        Result.Buckets[BucketIndex] = Bucket;
-        AK__Memory_Copy(Bucket->Data, Buckets[BucketIndex]->Data, sizeof(type)*Buckets[BucketIndex]->Length);
+        AK__Arena_Add_Block(this, Block);
     }
     
-    Result.CurrentBucketIndex = CurrentBucketIndex;
-    Result.Length = Length;
+    CurrentBlock = Block;
+    if(Alignment) CurrentBlock->Used = AK__Memory_Align(CurrentBlock->Used, Alignment);
     
-    RAII.Block();
+    uint8_t* Ptr = CurrentBlock->Memory + CurrentBlock->Used;
+    CurrentBlock->Used += Size;
+    
+    if(ClearFlag == AK_ARENA_CLEAR)
+        AK__Memory_Clear(Ptr, Size);
+    
+    ak_buffer Result;
+    Result.Data = Ptr;
+    Result.Length = Size;
     
     return Result;
 }
 
-template <typename type, uint64_t bucket_capacity>
-ak_bucket_array_iterator<type, bucket_capacity> ak_bucket_array<type, bucket_capacity>::begin()
+ak_buffer ak_arena::Push(uint64_t Size, ak_arena_clear_flag ClearFlag)
 {
-    ak_bucket_array_iterator<type, bucket_capacity> Result;
-    Result.Array = this;
-    Result.CurrentBucketIndex = 0;
-    Result.CurrentIndexInBucket = 0;
+    ak_buffer Result = Push(Size, 4, ClearFlag);
     return Result;
 }
 
-template <typename type, uint64_t bucket_capacity>
-ak_bucket_array_iterator<type, bucket_capacity> ak_bucket_array<type, bucket_capacity>::end()
+template <typename type> 
+type* ak_arena::Push_Struct(uint64_t Alignment, ak_arena_clear_flag ClearFlag)
 {
-    return {};
+    return (type*)Push(sizeof(type), Alignment, ClearFlag).Data;
 }
 
-template <typename type, uint64_t bucket_capacity> 
-void AK_Delete(ak_bucket_array<type, bucket_capacity>* Array)
+template <typename type> 
+type* ak_arena::Push_Struct(ak_arena_clear_flag ClearFlag)
 {
-    if(Array)
-    {
-        AK_Delete(&Array->Buckets);
-        AK_Delete(Array->Storage);
-        AK__Memory_Clear(Array, sizeof(ak_bucket_array<type, bucket_capacity>));
-    }
+    return (type*)Push(sizeof(type), ClearFlag).Data;
 }
 
-//~Hash Map implementation
-template <typename key, typename value>
-ak_hashmap_pair<key, value> ak_hashmap_iterator<key, value>::operator*()
+template <typename type> 
+ak_array<type> ak_arena::Push_Array(uint64_t Count, uint64_t Alignment, ak_arena_clear_flag ClearFlag)
 {
-    ak_hashmap_pair<key, value> Result = 
-    {
-        HashMap->Keys[CurrentIndex], 
-        HashMap->Values[CurrentIndex]
-    };
-    return Result;
+    type* Ptr = (type*)Push(sizeof(type)*Count, Alignment, ClearFlag).Data;
+    return AK_Create_Array<type>(Ptr, Count);
 }
 
-template <typename key, typename value>
-void ak_hashmap_iterator<key, value>::operator++()
+template <typename type> 
+ak_array<type> ak_arena::Push_Array(uint64_t Count, ak_arena_clear_flag ClearFlag)
 {
-    CurrentIndex++;
+    type* Ptr = (type*)Push(sizeof(type)*Count, ClearFlag).Data; 
+    return AK_Create_Array<type>(Ptr, Count);
 }
 
-template <typename key, typename value>
-bool ak_hashmap_iterator<key, value>::operator!=(const ak_hashmap_iterator& Iterator)
+ak_arena_marker ak_arena::Get_Marker()
 {
-    return CurrentIndex != HashMap->Length;
+    ak_arena_marker Marker;
+    Marker.Arena = this;
+    Marker.Block = CurrentBlock;
+    if(CurrentBlock) Marker.Marker = CurrentBlock->Used;
+    return Marker;
 }
 
-ak__hashmap_slot* AK__HashMap_Realloc_Slots(ak__hashmap_slot* OldSlots, uint32_t* ItemSlots, uint32_t OldCapacity, uint32_t NewCapacity, 
-                                            ak_allocator* Allocator)
+void ak_arena::Set_Marker(ak_arena_marker Marker)
 {
-    uint32_t SlotMask = NewCapacity-1;
-    
-    uint64_t AllocSize = NewCapacity*sizeof(ak__hashmap_slot);
-    ak__hashmap_slot* Slots = (ak__hashmap_slot*)Allocator->Alloc(AllocSize, Allocator->UserData);
-    AK__Memory_Clear(Slots, AllocSize);
+    AK_STD_ASSERT(Marker.Arena == this, "Marker was not retrieved from this arena!");
     
-    for(uint32_t OldSlotIndex = 0; OldSlotIndex < OldCapacity; OldSlotIndex++)
+    //NOTE(EVERYONE): If the block is null it always signalizes the beginning of the arena
+    if(!Marker.Block)
     {
-        if(OldSlots[OldSlotIndex].IsValid)
-        {
-            uint32_t Hash = OldSlots[OldSlotIndex].Hash;
-            uint32_t BaseSlot = Hash & SlotMask;
-            uint32_t Slot = BaseSlot;
-            while(Slots[Slot].IsValid)
-                Slot = (Slot+1) & SlotMask;
-            Slots[Slot].Hash = Hash;
-            uint32_t ItemIndex = OldSlots[OldSlotIndex].ItemIndex;
-            Slots[Slot].ItemIndex = ItemIndex;
-            ItemSlots[ItemIndex] = Slot;            
-            Slots[BaseSlot].BaseCount++;
-            Slots[Slot].IsValid = true;
-        }
+        CurrentBlock = FirstBlock;
+        if(CurrentBlock) CurrentBlock->Used = 0;
+    }
+    else
+    {
+        CurrentBlock = Marker.Block;
+        CurrentBlock->Used = Marker.Marker;
+        for(ak__arena_block* ArenaBlock = CurrentBlock->Next; ArenaBlock; ArenaBlock = ArenaBlock->Next)
+            ArenaBlock->Used = 0;
     }
-    
-    Allocator->Free(OldSlots, Allocator->UserData);
-    return Slots;
 }
 
-template <typename key, typename value>
-void AK__HashMap_Realloc(ak_hashmap<key, value>* Map)
+uint64_t ak_arena::Get_Total_Used() const
 {
-    Map->ItemCapacity *= 2;
-    
-    ak_allocator* Allocator = Map->Allocator;
-    
-    uint64_t AllocSize = Map->ItemCapacity * (sizeof(key) + sizeof(value) + sizeof(uint32_t));
-    void* MapData = Allocator->Alloc(AllocSize, Allocator->UserData);        
-    AK__Memory_Clear(MapData, AllocSize);
-    
-    uint32_t* NewItemSlots = (uint32_t*)MapData;
-    key* NewKeys = (key*)(NewItemSlots + Map->ItemCapacity);
-    value* NewValues = (value*)(NewKeys + Map->ItemCapacity);        
-    
-    AK__Memory_Copy(NewItemSlots, Map->ItemSlots, Map->Length*sizeof(uint32_t));
-    AK__Memory_Copy(NewKeys, Map->Keys, Map->Length*sizeof(key));
-    AK__Memory_Copy(NewValues, Map->Values, Map->Length*sizeof(value));
-    Allocator->Free(Map->ItemSlots, Allocator->UserData);
-    
-    Map->ItemSlots = NewItemSlots;
-    Map->Keys = NewKeys;
-    Map->Values = NewValues;        
+    uint64_t Result = 0;
+    for(ak__arena_block* Block = FirstBlock; Block; Block = Block->Next) Result += Block->Used;
+    return Result;
 }
 
-template <typename key>
-int64_t AK__HashMap_Find_Slot(key* Keys, ak__hashmap_slot* Slots, uint32_t SlotCapacity, const key& Key)
+uint64_t ak_arena::Get_Total_Block_Size() const
 {
-    uint32_t SlotMask = SlotCapacity - 1;
-    uint32_t Hash = AK_Hash_Function(Key);
-    
-    uint32_t BaseSlot = Hash & SlotMask;
-    uint32_t BaseCount = Slots[BaseSlot].BaseCount;
-    uint32_t Slot = BaseSlot;
-    
-    while(BaseCount > 0)
+    uint64_t Result = 0;
+    for(ak__arena_block* Block = FirstBlock; Block; Block = Block->Next) Result += Block->Size;
+    return Result;
+}
+
+void ak_arena::Clear(ak_arena_clear_flag ClearFlag) 
+{
+    for(ak__arena_block* Block = FirstBlock; Block; Block = Block->Next)
     {
-        if(Slots[Slot].IsValid)
-        {
-            uint32_t SlotHash = Slots[Slot].Hash;
-            uint32_t SlotBase = SlotHash & SlotMask;
-            if(SlotBase == BaseSlot)
-            {
-                BaseCount--;
-                if(SlotHash == Hash && (Keys[Slots[Slot].ItemIndex] == Key))
-                    return (int64_t)Slot;
-            }
-        }        
-        
-        Slot = (Slot+1) & SlotMask;
+        if(ClearFlag == AK_ARENA_CLEAR) AK__Memory_Clear(Block->Memory, Block->Used);
+        Block->Used = 0;
     }
-    
-    return -1;
 }
 
-template <typename key, typename value>
-void ak_hashmap<key, value>::Add(const key& Key, const value& Value)
+ak_temp_arena::ak_temp_arena(ak_arena* TempArena)
 {
-    if(!Slots || !ItemSlots)
-        *this = AK_Create_Hash_Map<key, value>();
-    
-    AK_STD_ASSERT(AK__HashMap_Find_Slot(Keys, Slots, SlotCapacity, Key) < 0, "Cannot insert duplicate keys into hash map");
-    
-    if(Length >= (SlotCapacity - SlotCapacity/3))
+    Begin_Temp(TempArena);
+}
+
+void ak_temp_arena::Begin_Temp(ak_arena* TempArena)
+{
+    Marker = TempArena->Get_Marker();
+}
+
+void ak_temp_arena::End_Temp()
+{
+    //NOTE(EVERYONE): If the block is null it always signalizes the beginning of the arena
+    if(Marker.Arena)
     {
-        uint32_t OldCapacity = SlotCapacity;
-        SlotCapacity = (uint32_t)AK__Ceil_Pow2(SlotCapacity*2);
-        Slots = AK__HashMap_Realloc_Slots(Slots, ItemSlots, OldCapacity, SlotCapacity, Allocator);
+        Marker.Arena->Set_Marker(Marker);
+        Marker.Arena = NULL;
     }
+}
+
+ak_temp_arena::~ak_temp_arena()
+{
+    End_Temp();
+}
+
+ak_arena* AK_Create_Arena(uint64_t InitialBlockSize, ak_allocator* Allocator)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
     
-    uint32_t SlotMask = SlotCapacity-1;
-    uint32_t Hash = AK_Hash_Function(Key);
-    
-    uint32_t BaseSlot = Hash & SlotMask;
-    uint32_t BaseCount = Slots[BaseSlot].BaseCount;
-    uint32_t Slot = BaseSlot;
-    uint32_t FirstFree = Slot;
-    
-    while(BaseCount)
+    void* Memory = Allocator->Alloc(InitialBlockSize + sizeof(ak_arena)+sizeof(ak__arena_block), Allocator->UserData);
+    if(!Memory) 
     {
-        uint32_t SlotHash = Slots[Slot].Hash;
-        if(!Slots[Slot].IsValid && Slots[FirstFree].IsValid) FirstFree = Slot;
-        uint32_t SlotBase = SlotHash & SlotMask;
-        if(SlotBase == BaseSlot)
-            BaseCount--;
-        Slot = (Slot+1) & SlotMask;
+        //TODO(JJ): Diagnostic and error logging
+        return NULL;
     }
     
-    Slot = FirstFree;
-    while(Slots[Slot].IsValid)
-        Slot = (Slot+1) & SlotMask;
-    
-    if(Length >= ItemCapacity)
-        AK__HashMap_Realloc(this);
+    ak_arena* Result = (ak_arena*)Memory;
+    AK__Memory_Clear(Result, sizeof(ak_arena));
+    Result->InitialBlockSize = InitialBlockSize;
+    Result->Allocator = Allocator;
     
-    AK_STD_ASSERT(!Slots[Slot].IsValid && (Hash & SlotMask) == BaseSlot, "");
-    AK_STD_ASSERT(Hash, "Invalid hash");
-    
-    Slots[Slot].Hash = Hash;
-    Slots[Slot].ItemIndex = Length;
-    Slots[Slot].IsValid = true;
-    Slots[BaseSlot].BaseCount++;
+    ak__arena_block* Block = (ak__arena_block*)(Result+1);
+    AK__Memory_Clear(Block, sizeof(ak__arena_block));
+    Block->Memory = (uint8_t*)(Block+1);
+    Block->Size = InitialBlockSize;
+    Block->Used = 0;
+    AK__Arena_Add_Block(Result, Block);
+    Result->CurrentBlock = Block;
     
-    ItemSlots[Length] = Slot;
-    Keys[Length] = Key;
-    Values[Length] = Value;
+    Result->Alloc = AK__Arena_Alloc;
+    Result->Free = AK__Arena_Free;
+    Result->UserData = (uint64_t)Result;
     
-    Length++;
+    return Result;
 }
 
-template <typename key, typename value>
-value* ak_hashmap<key, value>::Find(const key& Key)
+void AK_Delete(ak_arena* Arena)
 {
-    if(!Slots || !ItemSlots)
-        *this = AK_Create_Hash_Map<key, value>();
-    
-    int64_t Slot = AK__HashMap_Find_Slot(Keys, Slots, SlotCapacity, Key);
-    if(Slot < 0) return NULL;
-    
-    uint32_t Index = Slots[Slot].ItemIndex;
-    return Values + Index;
+    if(Arena)
+    {
+        AK_STD_ASSERT(Arena->FirstBlock, "First block should've been allocated when the arena was created. This is a programming error");
+        ak__arena_block* Block = Arena->FirstBlock->Next;
+        while(Block)
+        {
+            ak__arena_block* BlockToDelete = Block;
+            Block = Block->Next;
+            Arena->Allocator->Free(BlockToDelete, Arena->Allocator->UserData);
+        }
+        
+        Arena->Allocator->Free(Arena, Arena->Allocator->UserData);
+    }
 }
 
-template <typename key, typename value>
-void ak_hashmap<key, value>::Remove(const key& Key)
+void* operator new(size_t Size, ak_arena* Arena)
 {
-    if(!Slots || !ItemSlots)
-        *this = AK_Create_Hash_Map<key, value>();
-    
-    int64_t Slot = AK__HashMap_Find_Slot(Keys, Slots, SlotCapacity, Key);
-    AK_STD_ASSERT(Slot >= 0, "Cannot find entry with key in hash map");
-    AK_STD_ASSERT(Slots[Slot].IsValid, "Hash is invalid");
+    return Arena->Push(Size).Data;
+}
+
+//~Slab implementation
+void* ak_slab::Push_Block(ak_arena_clear_flag ClearFlag)
+{
+    void* Result = NULL;
+    if(!Push_Blocks(&Result, 1, ClearFlag)) return NULL;
+    return Result;
+}
+
+bool ak_slab::Push_Blocks(void** Blocks, uint64_t Count, ak_arena_clear_flag ClearFlag)
+{
+    uint64_t Index = 0;
+    for(; Index < Count && FreeBlocks; Index++)
+    {
+        Blocks[Index] = FreeBlocks;
+        AK_SLL_Stack_Pop(FreeBlocks);
+        FreeBlockCount--;
+        if(ClearFlag == AK_ARENA_CLEAR) AK__Memory_Clear(Blocks[Index], BlockSize);
+    }
     
-    if(Slot >= 0 && Slots[Slot].IsValid)
+    if(Index < Count)
     {
-        uint32_t SlotMask = SlotCapacity-1;
-        uint32_t Hash = Slots[Slot].Hash;
-        uint32_t BaseSlot = Hash & SlotMask;
-        Slots[BaseSlot].BaseCount--;
-        Slots[Slot].Hash = 0;
-        Slots[Slot].IsValid = false;
-        
-        uint32_t Index = Slots[Slot].ItemIndex;
-        uint32_t LastIndex = Length-1;
-        
-        if(Index != LastIndex)
+        //NOTE(EVERYONE): Whatever the free list could not cover comes from a single arena push
+        uint64_t PushCount = Count-Index;
+        uint8_t* Memory = Arena->Push(PushCount*BlockSize, BlockAlignment, ClearFlag).Data;
+        if(!Memory)
         {
-            Keys[Index] = Keys[LastIndex];
-            ItemSlots[Index] = ItemSlots[LastIndex];
-            Values[Index] = Values[LastIndex];
-            Slots[ItemSlots[LastIndex]].ItemIndex = Index;
+            //NOTE(EVERYONE): Give back whatever we popped from the free list
+            while(Index--) Free_Block(Blocks[Index]);
+            
+            //TODO(JJ): Diagnostic and error logging
+            return false;
         }
         
-        Length--;
+        for(; Index < Count; Index++, Memory += BlockSize)
+            Blocks[Index] = Memory;
     }
+    
+    return true;
 }
 
-template <typename key, typename value>
-void ak_hashmap<key, value>::Clear()
+void ak_slab::Free_Block(void* Block)
 {
-    AK__Memory_Clear(Slots, SlotCapacity*sizeof(ak__hashmap_slot));
-    AK__Memory_Clear(ItemSlots, ItemCapacity*(sizeof(uint32_t)+sizeof(key)+sizeof(value)));
-    Length = 0;
+    if(Block)
+    {
+        ak__slab_block* FreeBlock = (ak__slab_block*)Block;
+        AK_SLL_Stack_Push(FreeBlocks, FreeBlock);
+        FreeBlockCount++;
+    }
 }
 
-template <typename key, typename value>
-ak_hashmap_iterator<key, value> ak_hashmap<key, value>::begin() const
+ak_slab* AK_Create_Slab(uint64_t BlockSize, uint64_t BlockAlignment, uint64_t ArenaBlockSize, ak_allocator* Allocator)
 {
-    ak_hashmap_iterator<key, value> Result;
-    Result.HashMap = this;
-    Result.CurrentIndex = 0;
-    return Result;
+    BlockAlignment = AK__Max(BlockAlignment, alignof(ak__slab_block));
+    BlockSize = AK__Memory_Align(AK__Max(BlockSize, sizeof(ak__slab_block)), BlockAlignment);
+    
+    ak_arena* Arena = AK_Create_Arena(AK__Max(ArenaBlockSize, BlockSize), Allocator);
+    if(!Arena)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return NULL;
+    }
+    
+    ak_slab* Slab = Arena->Push_Struct<ak_slab>();
+    Slab->Arena = Arena;
+    Slab->BlockSize = BlockSize;
+    Slab->BlockAlignment = BlockAlignment;
+    return Slab;
 }
 
-template <typename key, typename value>
-ak_hashmap_iterator<key, value> ak_hashmap<key, value>::end() const
+void AK_Delete(ak_slab* Slab)
 {
-    return {};
+    if(Slab) AK_Delete(Slab->Arena);
 }
 
-template <typename key, typename value> 
-ak_hashmap<key, value>  AK_Create_Hash_Map(uint32_t InitialSlotCapacity, uint32_t InitialItemCapacity, ak_allocator* Allocator)
+//~Dynamic Array implementation
+template <typename type>
+bool ak_dynamic_array<type>::Add(const type& Entry)
 {
-    if(!Allocator) Allocator = AK__Get_Default_Allocator();
-    
-    ak_hashmap<key, value> Result = {};
-    Result.Allocator = Allocator;
-    Result.SlotCapacity = (uint32_t)AK__Ceil_Pow2(InitialSlotCapacity);
-    Result.ItemCapacity = InitialItemCapacity;
-    
-    Result.Slots = (ak__hashmap_slot*)Allocator->Alloc(sizeof(ak__hashmap_slot)*Result.SlotCapacity, Allocator->UserData);
-    
-    size_t AllocationSize = Result.ItemCapacity * (sizeof(key) + sizeof(value) + sizeof(uint32_t));
-    void* MapData = Allocator->Alloc(AllocationSize, Allocator->UserData);
-    
-    Result.ItemSlots = (uint32_t*)MapData;
-    Result.Keys = (key*)(Result.ItemSlots + Result.ItemCapacity);
-    Result.Values = (value*)(Result.Keys + Result.ItemCapacity);
+    if(!Capacity)
+    {
+        if(!Reserve(AK_DYNAMIC_ARRAY_INITIAL_CAPACITY))
+        {
+            //TODO(JJ): Diangostic and error logging
+            return false;
+        }
+    }
     
-    AK__Memory_Clear(Result.Slots, sizeof(ak__hashmap_slot)*Result.SlotCapacity);
-    AK__Memory_Clear(MapData, AllocationSize);
+    if(Length == Capacity)
+    {
+        if(!Reserve(Capacity*2))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return false;
+        }
+    }
     
-    return Result;
+    Data[Length++] = Entry;
+    return true;
 }
 
-template <typename key, typename value>
-void AK_Delete(ak_hashmap<key, value>* HashMap)
+template <typename type>
+bool ak_dynamic_array<type>::Add_Range(const type* Entries, uint64_t Count)
 {
-    if(HashMap)
+    if(!Capacity)
     {
-        HashMap->Allocator->Free(HashMap->Slots, HashMap->Allocator->UserData);
-        HashMap->Allocator->Free(HashMap->ItemSlots, HashMap->Allocator->UserData);
+        uint64_t NewCapacity = AK__Max(Count, AK_DYNAMIC_ARRAY_INITIAL_CAPACITY);
+        if(!Reserve(NewCapacity))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return false;
+        }
+    }
+    
+    if(Length + Count > Capacity)
+    {
+        uint64_t NewCapacity = AK__Max(Length+Count, Capacity*2);
+        if(!Reserve(NewCapacity))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return false;
+        }
     }
+    
+    AK__Memory_Copy(Data+Length, Entries, Count*sizeof(type));
+    Length += Count;
+    return true;
 }
 
-uint32_t AK_Hash_Function(uint32_t Key)
+template <typename type>
+bool ak_dynamic_array<type>::Add_Range(const type* Start, const type* End)
 {
-    Key = (Key+0x7ed55d16) + (Key<<12);
-    Key = (Key^0xc761c23c) ^ (Key>>19);
-    Key = (Key+0x165667b1) + (Key<<5);
-    Key = (Key+0xd3a2646c) ^ (Key<<9);
-    Key = (Key+0xfd7046c5) + (Key<<3);
-    Key = (Key^0xb55a4f09) ^ (Key>>16);
-    return Key;
+    return Add_Range(Start, End-Start);
 }
 
-uint32_t AK_Hash_Function(int32_t Key)
+template <typename type>
+bool ak_dynamic_array<type>::Reserve(uint64_t NewCapacity)
 {
-    return AK_Hash_Function((uint32_t)Key);
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    
+    if(NewCapacity < Length) NewCapacity = Length;
+    
+    type* NewData = (type*)Allocator->Alloc(NewCapacity*sizeof(type), Allocator->UserData);
+    if(!NewData)
+    {
+        //TODO(JJ): Error handling
+        return false;
+    }
+    
+    if(Data) 
+    {
+        uint64_t CopySize = Capacity > NewCapacity ? NewCapacity : Capacity;
+        AK__Memory_Copy(NewData, Data, CopySize*sizeof(type));
+        Allocator->Free(Data, Allocator->UserData);
+    }
+    
+    Data = NewData;
+    Capacity = NewCapacity;
+    
+    return true;
 }
 
-uint32_t AK_Hash_Function(uint64_t Key)
+template <typename type>
+bool ak_dynamic_array<type>::Resize(uint64_t NewLength)
 {
-    Key = ( ~Key ) + ( Key << 18 );
-    Key = Key ^ ( Key >> 31 );
-    Key = Key * 21;
-    Key = Key ^ ( Key >> 11 );
-    Key = Key + ( Key << 6 );
-    Key = Key ^ ( Key >> 22 );      
-    return (uint32_t)Key;
+    if(NewLength > Capacity) 
+    {
+        if(!Reserve(NewLength))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return false;
+        }
+    }
+    Length = NewLength;
+    return true;
 }
 
-uint32_t AK_Hash_Function(int64_t Key)
+template <typename type> 
+ak_dynamic_array<type> AK_Dynamic_Create_Array(uint64_t InitialCapacity, ak_allocator* Allocator)
 {
-    return AK_Hash_Function((uint64_t)Key);
+    ak_dynamic_array<type> Result;
+    Result.Allocator = Allocator;
+    Result.Reserve(InitialCapacity);
+    return Result;
 }
 
-uint32_t AK_Hash_Function(float Key)
+template <typename type>
+void AK_Delete(ak_dynamic_array<type>* Array)
 {
-    union
+    if(Array && Array->Data)
     {
-        float    F;
-        uint32_t I;
-    } U;
-    
-    U.F = Key;
-    return AK_Hash_Function(U.I);
+        Array->Allocator->Free(Array->Data, Array->Allocator->UserData);
+        AK__Memory_Clear(Array, sizeof(ak_dynamic_array<type>));
+    }
 }
 
-uint32_t AK_Hash_Function(double Key)
+//~Bucket Array implementation
+template <uint64_t bucket_capacity, bool is_pow2>
+uint64_t ak__bucket_indexer<bucket_capacity, is_pow2>::Get_Bucket_Index(uint64_t Index)
 {
-    union
-    {
-        double   D;
-        uint64_t I;
-    } U;
-    
-    U.D = Key;
-    return AK_Hash_Function(U.I);
+    //NOTE(EVERYONE): The reciprocal is exact for every 32 bit index, so only huge indices fall back to a divide
+    if(Index <= 0xFFFFFFFF) return AK__Mul_Hi64(Reciprocal, Index);
+    return Index / bucket_capacity;
 }
 
-uint32_t AK_Hash_Function(const char* String)
+template <uint64_t bucket_capacity, bool is_pow2>
+uint64_t ak__bucket_indexer<bucket_capacity, is_pow2>::Get_Entry_Index(uint64_t Index, uint64_t BucketIndex)
 {
-    uint64_t Result = 0;
-    uint64_t Rand1 = 31414;
-    const uint64_t Rand2 = 27183;
-    
-    const char* At = String;
-    while(*At)
-    {
-        Result *= Rand1;
-        Result += *At;
-        Rand1 *= Rand2;
-        At++;
-    }
-    
-    return AK_Hash_Function(Result);
+    return Index - BucketIndex*bucket_capacity;
 }
 
-//~Pool implementation
+template <uint64_t bucket_capacity, bool is_pow2>
+uint64_t ak__bucket_indexer<bucket_capacity, is_pow2>::Get_Base_Index(uint64_t BucketIndex)
+{
+    return BucketIndex*bucket_capacity;
+}
 
-template <typename type, uint64_t bucket_capacity>
-type& ak_pool_iterator<type, bucket_capacity>::operator*()
+template <uint64_t bucket_capacity>
+uint64_t ak__bucket_indexer<bucket_capacity, true>::Get_Bucket_Index(uint64_t Index)
 {
-    return Pool->Data[CurrentIndex].Entry;
+    return Index >> Shift;
 }
 
-template <typename type, uint64_t bucket_capacity>
-void ak_pool_iterator<type, bucket_capacity>::operator++()
+template <uint64_t bucket_capacity>
+uint64_t ak__bucket_indexer<bucket_capacity, true>::Get_Entry_Index(uint64_t Index, uint64_t BucketIndex)
 {
-    CurrentIndex = Pool->Data[CurrentIndex].ID.NextIndex;
+    return Index & Mask;
 }
 
-template <typename type, uint64_t bucket_capacity>
-bool ak_pool_iterator<type, bucket_capacity>::operator!=(const ak_pool_iterator& Iterator)
+template <uint64_t bucket_capacity>
+uint64_t ak__bucket_indexer<bucket_capacity, true>::Get_Base_Index(uint64_t BucketIndex)
 {
-    return CurrentIndex != AK__INVALID_POOL_INDEX;
+    return BucketIndex << Shift;
 }
 
 template <typename type, uint64_t bucket_capacity>
-uint64_t ak_pool<type, bucket_capacity>::Allocate(const type& Value)
+void AK__Array_Iterator_Enter_Bucket(ak_bucket_array_iterator<type, bucket_capacity>* Iterator)
 {
-    uint16_t Index;
-    if(FirstAvailableIndex != AK__INVALID_POOL_INDEX)
-    {
-        Index = FirstAvailableIndex;
-        FirstAvailableIndex = Data[Index].ID.NextIndex;
-    }
-    else
+    for(; Iterator->Bucket != Iterator->LastBucket; Iterator->Bucket++)
     {
-        Index = (uint16_t)Data.Length;
-        if(!Data.Add({}))
+        ak__bucket<type, bucket_capacity>* Bucket = *Iterator->Bucket;
+        if(Bucket->Length)
         {
-            //TODO(JJ): Diagnsotic and error logging
-            return 0;
+            Iterator->At = Bucket->Data;
+            Iterator->End = Bucket->Data + Bucket->Length;
+            return;
         }
     }
     
-    AK_STD_ASSERT(Index < MAX_CAPACITY, "Pool capacity overflow!");
-    if(Index >= MAX_CAPACITY)
+    Iterator->At = Iterator->End = NULL;
+}
+
+template <typename type, uint64_t bucket_capacity>
+type& ak_bucket_array_iterator<type, bucket_capacity>::operator*()
+{
+    return *At;
+}
+
+template <typename type, uint64_t bucket_capacity>
+bool ak_bucket_array_iterator<type, bucket_capacity>::operator!=(const ak_bucket_array_iterator& Iterator)
+{
+    return At != Iterator.At;
+}
+
+template <typename type, uint64_t bucket_capacity>
+void ak_bucket_array_iterator<type, bucket_capacity>::operator++()
+{
+    if(++At == End)
     {
-        //TODO(JJ): Diagnostic and error logging
-        return 0;
+        Bucket++;
+        AK__Array_Iterator_Enter_Bucket(this);
     }
+}
+
+template <typename type, uint64_t bucket_capacity>
+ak_array<type> ak_bucket_array_span_iterator<type, bucket_capacity>::operator*()
+{
+    return AK_Create_Array<type>((*Bucket)->Data, (*Bucket)->Length);
+}
+
+template <typename type, uint64_t bucket_capacity>
+void ak_bucket_array_span_iterator<type, bucket_capacity>::operator++()
+{
+    Bucket++;
+}
+
+template <typename type, uint64_t bucket_capacity>
+bool ak_bucket_array_span_iterator<type, bucket_capacity>::operator!=(const ak_bucket_array_span_iterator& Iterator)
+{
+    return Bucket != Iterator.Bucket;
+}
+
+template <typename type, uint64_t bucket_capacity>
+ak_bucket_array_span_iterator<type, bucket_capacity> ak_bucket_array_spans<type, bucket_capacity>::begin()
+{
+    ak_bucket_array_span_iterator<type, bucket_capacity> Result;
+    Result.Bucket = FirstBucket;
+    return Result;
+}
+
+template <typename type, uint64_t bucket_capacity>
+ak_bucket_array_span_iterator<type, bucket_capacity> ak_bucket_array_spans<type, bucket_capacity>::end()
+{
+    ak_bucket_array_span_iterator<type, bucket_capacity> Result;
+    Result.Bucket = EndBucket;
+    return Result;
+}
+
+template <typename type, uint64_t bucket_capacity>
+bool AK__Array_Reserve_Buckets(ak_bucket_array<type, bucket_capacity>* Array, uint64_t BucketCount, ak_arena_clear_flag ClearFlag)
+{
+    if(BucketCount <= Array->Buckets.Length) return true;
     
-    ak__pool_entry<type>* Entry = &Data[Index];
-    Entry->Entry = Value;
-    Entry->ID.Key = NextKey++;
+    if(!Array->Allocator) Array->Allocator = AK__Get_Default_Allocator();
+    if(!Array->Buckets.Allocator) Array->Buckets.Allocator = Array->Allocator;
     
-    if(!NextKey)
+    if(!Array->Storage)
     {
-        //NOTE(EVERYONE): We have overflowed the keys. Reset its position. All id entries that have had previous index values
-        //will now be valid. This isn't super secure but hey, this really isn't the point of the pool data structure
-        NextKey = 1;
+        Array->Storage = AK_Create_Bucket_Array_Slab<type, bucket_capacity>(AK_ARENA_INITIAL_BLOCK_SIZE, Array->Allocator);
+        if(!Array->Storage)
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return false;
+        }
+        Array->OwnsStorage = true;
     }
     
-    if(FirstAllocatedIndex != AK__INVALID_POOL_INDEX)
+    AK_STD_ASSERT(Array->Storage->BlockSize >= sizeof(ak__bucket<type, bucket_capacity>), "Slab blocks are too small for the bucket array");
+    
+    uint64_t NewBucketCount = BucketCount-Array->Buckets.Length;
+    if(BucketCount > Array->Buckets.Capacity)
     {
-        ak__pool_entry<type>* FirstEntry = &Data[FirstAllocatedIndex];
-        FirstEntry->ID.PreviousIndex = Index;
+        if(!Array->Buckets.Reserve(AK__Max(BucketCount, Array->Buckets.Capacity*2)))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return false;
+        }
     }
     
-    Entry->ID.PreviousIndex = AK__INVALID_POOL_INDEX;
-    Entry->ID.NextIndex = FirstAllocatedIndex;
-    
-    FirstAllocatedIndex = Index;
-    
-    Length++;
+    //NOTE(EVERYONE): All the missing buckets are pushed from the slab at once, straight into the bucket list
+    ak__bucket<type, bucket_capacity>** NewBuckets = Array->Buckets.Data + Array->Buckets.Length;
+    if(!Array->Storage->Push_Blocks((void**)NewBuckets, NewBucketCount, ClearFlag))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
     
-    ak__pool_id Result;
-    Result.Key = Entry->ID.Key;
-    Result.Type = Type;
-    Result.Index = Index;
+    for(uint64_t BucketIndex = 0; BucketIndex < NewBucketCount; BucketIndex++)
+        NewBuckets[BucketIndex]->Length = 0;
+    Array->Buckets.Length = BucketCount;
     
-    return Result.ID;
+    return true;
 }
 
 template <typename type, uint64_t bucket_capacity>
-type* ak_pool<type, bucket_capacity>::Allocate_And_Get(uint64_t* OutID)
+ak__bucket<type, bucket_capacity>* AK__Array_Get_Current_Bucket(ak_bucket_array<type, bucket_capacity>* Array)
 {
-    ak__pool_id ID = {Allocate()};
-    if(!ID.ID) return NULL;
-    if(OutID) *OutID = ID.ID;
-    return &Data[ID.Index].Entry;
+    if(!AK__Array_Reserve_Buckets(Array, Array->CurrentBucketIndex+1, AK_ARENA_CLEAR))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return NULL;
+    }
+    
+    return Array->Buckets[Array->CurrentBucketIndex];
 }
 
 template <typename type, uint64_t bucket_capacity>
-void ak_pool<type, bucket_capacity>::Free(uint64_t TempID)
+ak__bucket<type, bucket_capacity>* AK__Array_Reserve_Entries(ak_bucket_array<type, bucket_capacity>* Array, uint64_t Count)
 {
-    if(Is_Allocated(TempID))
+    ak__bucket<type, bucket_capacity>* Bucket = AK__Array_Get_Current_Bucket(Array);
+    if(!Bucket) return NULL;
+    
+    uint64_t Remaining = bucket_capacity-Bucket->Length;
+    if(Count > Remaining)
     {
-        ak__pool_id ID = {TempID};
-        ak__pool_entry<type>* Entry = &Data[ID.Index];
-        
-        int32_t IsHead = ID.Index == FirstAllocatedIndex;
-        if(!IsHead)
-        {
-            AK_STD_ASSERT(Entry->ID.PreviousIndex != AK__INVALID_POOL_INDEX, "Cannot be the head of the pool and have a valid previous index");
-            Data[Entry->ID.PreviousIndex].ID.NextIndex = Entry->ID.NextIndex;
-        }
-        else
-            FirstAllocatedIndex = Entry->ID.NextIndex;
-        
-        if(Entry->ID.NextIndex != AK__INVALID_POOL_INDEX)
+        uint64_t BucketCount = ((Count-Remaining) + (bucket_capacity-1)) / bucket_capacity;
+        if(!AK__Array_Reserve_Buckets(Array, Array->CurrentBucketIndex+BucketCount+1, AK_ARENA_NO_CLEAR))
         {
-            ak__pool_entry<type>* NextEntry = &Data[Entry->ID.NextIndex];
-            NextEntry->ID.PreviousIndex = Entry->ID.PreviousIndex;
+            //TODO(JJ): Diagnostic and error logging
+            return NULL;
         }
-        
-        Entry->ID.ID = 0;
-        Entry->ID.NextIndex = FirstAvailableIndex;
-        
-        FirstAvailableIndex = ID.Index;
-        
-        Length--;
     }
+    
+    return Bucket;
 }
 
 template <typename type, uint64_t bucket_capacity>
-void ak_pool<type, bucket_capacity>::Free_All()
+type* AK__Array_Get_Entry(ak_bucket_array<type, bucket_capacity>* Array, uint64_t Index)
 {
-    if(Data) Data.Clear();
-    Length = 0;
-    FirstAllocatedIndex = 0;
-    FirstAvailableIndex = 0;
+    AK_STD_ASSERT(Index < Array->Length, "Array out of bounds!");
+    uint64_t BucketIndex = ak__bucket_indexer<bucket_capacity>::Get_Bucket_Index(Index);
+    uint64_t EntryIndex = ak__bucket_indexer<bucket_capacity>::Get_Entry_Index(Index, BucketIndex);
+    return Array->Buckets.Data[BucketIndex]->Data + EntryIndex;
 }
 
 template <typename type, uint64_t bucket_capacity>
-bool ak_pool<type, bucket_capacity>::Is_Allocated(uint64_t TempID)
+bool ak_bucket_array<type, bucket_capacity>::Add(const type& Entry)
 {
-    if(TempID)
+    ak__bucket<type, bucket_capacity>* CurrentBucket = AK__Array_Get_Current_Bucket(this);
+    if(!CurrentBucket)
     {
-        ak__pool_id ID = {TempID};
-        ak__pool_entry<type>* Entry = &Data[ID.Index];
-        bool Result = Entry->ID.Key && Entry->ID.Key == ID.Key;
-        return Result;
+        //TODO(JJ): Diagnostic and error logging
+        return false;
     }
-    return false;
+    
+    if(CurrentBucket->Length == bucket_capacity)
+    {
+        CurrentBucketIndex++;
+        CurrentBucket = AK__Array_Get_Current_Bucket(this);
+        if(!CurrentBucket)
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return false;
+        }
+    }
+    
+    CurrentBucket->Data[CurrentBucket->Length++] = Entry;
+    Length++;
+    return true;
 }
 
 template <typename type, uint64_t bucket_capacity>
-type* ak_pool<type, bucket_capacity>::Get(uint64_t TempID)
+bool ak_bucket_array<type, bucket_capacity>::Add_Range(const type* Entries, uint64_t Count)
 {
-    if(!Is_Allocated(TempID)) return NULL;
-    ak__pool_id ID = {TempID};
-    return &Data[ID.Index].Entry;
+    if(!Count) return true;
+    
+    ak__bucket<type, bucket_capacity>* Bucket = AK__Array_Reserve_Entries(this, Count);
+    if(!Bucket)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    
+    const type* EntryAt = Entries;
+    for(;;)
+    {
+        uint64_t CopyCount = AK__Min(Count, bucket_capacity-Bucket->Length);
+        AK__Memory_Copy(Bucket->Data + Bucket->Length, EntryAt, CopyCount*sizeof(type));
+        Bucket->Length += CopyCount;
+        Length += CopyCount;
+        EntryAt += CopyCount;
+        Count -= CopyCount;
+        
+        //NOTE(EVERYONE): Like Add, we only move onto the next bucket when there are entries left to write
+        if(!Count) break;
+        Bucket = Buckets[++CurrentBucketIndex];
+    }
+    
+    return true;
 }
 
 template <typename type, uint64_t bucket_capacity>
-type& ak_pool<type, bucket_capacity>::operator[](uint64_t ID)
+bool ak_bucket_array<type, bucket_capacity>::Add_Range(const type* Start, const type* End)
 {
-    type* Result = Get(ID);
-    AK_STD_ASSERT(Result, "Cannot index into pool with invalid id");
-    return *Result;
+    return Add_Range(Start, End-Start);
 }
 
 template <typename type, uint64_t bucket_capacity>
-ak_pool_iterator<type, bucket_capacity> ak_pool<type, bucket_capacity>::begin()
+ak_array<ak_array<type>> ak_bucket_array<type, bucket_capacity>::Push_Uninitialized(uint64_t Count, ak_arena* Arena)
 {
-    ak_pool_iterator<type, bucket_capacity> Result;
-    Result.Pool = this;
-    Result.CurrentIndex = FirstAllocatedIndex;
+    if(!Count) return {};
+    
+    ak__bucket<type, bucket_capacity>* Bucket = AK__Array_Reserve_Entries(this, Count);
+    if(!Bucket)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return {};
+    }
+    
+    uint64_t Remaining = bucket_capacity-Bucket->Length;
+    uint64_t SpanCount = 1;
+    if(Count > Remaining) SpanCount += ((Count-Remaining) + (bucket_capacity-1)) / bucket_capacity;
+    if(!Remaining) SpanCount--;
+    
+    ak_array<ak_array<type>> Result = Arena->Push_Array<ak_array<type>>(SpanCount, AK_ARENA_NO_CLEAR);
+    if(!Result.Data)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return {};
+    }
+    
+    uint64_t SpanIndex = 0;
+    for(;;)
+    {
+        uint64_t SpanLength = AK__Min(Count, bucket_capacity-Bucket->Length);
+        if(SpanLength)
+        {
+            Result.Data[SpanIndex++] = AK_Create_Array<type>(Bucket->Data + Bucket->Length, SpanLength);
+            Bucket->Length += SpanLength;
+            Length += SpanLength;
+            Count -= SpanLength;
+        }
+        
+        if(!Count) break;
+        Bucket = Buckets[++CurrentBucketIndex];
+    }
+    
+    AK_STD_ASSERT(SpanIndex == SpanCount, "Invalid span count. This is a programming error");
     return Result;
 }
 
 template <typename type, uint64_t bucket_capacity>
-ak_pool_iterator<type, bucket_capacity> ak_pool<type, bucket_capacity>::end()
+type* ak_bucket_array<type, bucket_capacity>::Pop()
 {
-    return {};
+    if(!Length) return NULL;
+    
+    ak__bucket<type, bucket_capacity>* Bucket = Buckets[CurrentBucketIndex];
+    AK_STD_ASSERT(Bucket->Length, "Invalid bucket count. Cannot pop a bucket with a length of 0");
+    
+    Bucket->Length--;
+    type* Result = Bucket->Data + Bucket->Length;
+    if(Bucket->Length == 0) CurrentBucketIndex = ((CurrentBucketIndex) ? (CurrentBucketIndex-1) : 0);
+    Length--;
+    return Result;
 }
 
-template <typename type, uint64_t bucket_capacity> 
-void AK_Delete(ak_pool<type, bucket_capacity>* Pool)
+template <typename type, uint64_t bucket_capacity>
+type* ak_bucket_array<type, bucket_capacity>::Get(uint64_t Index)
 {
-    if(Pool)
-    {
-        AK_Delete(&Pool->Data);
-        AK__Memory_Clear(Pool, sizeof(ak_pool<type, bucket_capacity>));
-    }
+    uint64_t BucketIndex = ak__bucket_indexer<bucket_capacity>::Get_Bucket_Index(Index);
+    if(BucketIndex >= Buckets.Length) return NULL;
+    
+    uint64_t EntryIndex = ak__bucket_indexer<bucket_capacity>::Get_Entry_Index(Index, BucketIndex);
+    if(EntryIndex >= Buckets.Data[BucketIndex]->Length) return NULL;
+    
+    return Buckets.Data[BucketIndex]->Data + EntryIndex;
 }
 
-#define STB_SPRINTF_IMPLEMENTATION
+template <typename type, uint64_t bucket_capacity>
+type& ak_bucket_array<type, bucket_capacity>::operator[](uint64_t Index)
+{
+    type* Result = Get(Index);
+    AK_STD_ASSERT(Result, "Array out of bounds!");
+    return *Result;
+}
 
-// stb_sprintf - v1.10 - public domain snprintf() implementation
-// originally by Jeff Roberts / RAD Game Tools, 2015/10/20
-// http://github.com/nothings/stb
-//
-// allowed types:  sc uidBboXx p AaGgEef n
-// lengths      :  hh h ll j z t I64 I32 I
-//
-// Contributors:
-//    Fabian "ryg" Giesen (reformatting)
-//    github:aganm (attribute format)
-//
-// Contributors (bugfixes):
-//    github:d26435
-//    github:trex78
-//    github:account-login
-//    Jari Komppa (SI suffixes)
-//    Rohit Nirmal
-//    Marcin Wojdyr
-//    Leonard Ritter
-//    Stefano Zanotti
-//    Adam Allison
-//    Arvid Gerstmann
-//    Markus Kolb
-//
-// LICENSE:
-//
-//   See end of file for license information.
-
-#ifndef STB_SPRINTF_H_INCLUDE
-#define STB_SPRINTF_H_INCLUDE
-
-/*
-Single file sprintf replacement.
+template <typename type, uint64_t bucket_capacity>
+bool ak_bucket_array<type, bucket_capacity>::Resize(uint64_t NewLength)
+{
+    uint64_t NewLengthBucketIndex = ak__bucket_indexer<bucket_capacity>::Get_Bucket_Index(NewLength);
+    uint64_t NewLengthEntryIndex = ak__bucket_indexer<bucket_capacity>::Get_Entry_Index(NewLength, NewLengthBucketIndex);
+    
+    if(CurrentBucketIndex > NewLengthBucketIndex)
+    {
+        uint64_t Difference = CurrentBucketIndex-NewLengthBucketIndex;
+        for(uint64_t BucketIndex = 0; BucketIndex < Difference; BucketIndex++)
+        {
+            Buckets[CurrentBucketIndex]->Length = 0;
+            CurrentBucketIndex--;
+        }
+    }
+    else if(CurrentBucketIndex < NewLengthBucketIndex)
+    {
+        uint64_t Difference = NewLengthBucketIndex-CurrentBucketIndex;
+        for(uint64_t BucketIndex = 0; BucketIndex < Difference; BucketIndex++)
+        {
+            ak__bucket<type, bucket_capacity>* Bucket = AK__Array_Get_Current_Bucket(this);
+            if(!Bucket)
+            {
+                //TODO(JJ): Diagnostic and error logging
+                return false;
+            }
+            
+            Bucket->Length = bucket_capacity;
+            CurrentBucketIndex++;
+        }
+    }
+    
+    ak__bucket<type, bucket_capacity>* Bucket = AK__Array_Get_Current_Bucket(this);
+    if(!Bucket)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    Bucket->Length = NewLengthEntryIndex;
+    Length = NewLength;
+    return true;
+}
 
-Originally written by Jeff Roberts at RAD Game Tools - 2015/10/20.
-Hereby placed in public domain.
+template <typename type, uint64_t bucket_capacity>
+void ak_bucket_array<type, bucket_capacity>::Clear()
+{
+    for(uint64_t BucketIndex = 0; BucketIndex < Buckets.Length; BucketIndex++)
+    {
+        AK__Memory_Clear(Buckets[BucketIndex]->Data, sizeof(type)*Buckets[BucketIndex]->Length);
+        Buckets[BucketIndex]->Length = 0;
+    }
+    CurrentBucketIndex = 0;
+    Length = 0;
+}
 
-This is a full sprintf replacement that supports everything that
-the C runtime sprintfs support, including float/double, 64-bit integers,
-hex floats, field parameters (%*.*d stuff), length reads backs, etc.
+template <typename type, uint64_t bucket_capacity>
+void AK__Array_Move_Storage(ak_bucket_array<type, bucket_capacity>* Array)
+{
+    uint64_t BucketCount = Array->Buckets.Length;
+    ak_slab* NewStorage = AK_Create_Bucket_Array_Slab<type, bucket_capacity>(AK_ARENA_INITIAL_BLOCK_SIZE, Array->Allocator);
+    ak_dynamic_array<ak__bucket<type, bucket_capacity>*> NewBuckets;
+    NewBuckets.Allocator = Array->Allocator;
+    if(!NewStorage || !NewBuckets.Reserve(BucketCount) || 
+       !NewStorage->Push_Blocks((void**)NewBuckets.Data, BucketCount, AK_ARENA_NO_CLEAR))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        if(NewStorage) AK_Delete(NewStorage);
+        AK_Delete(&NewBuckets);
+        return;
+    }
+    NewBuckets.Length = BucketCount;
+    
+    for(uint64_t BucketIndex = 0; BucketIndex < BucketCount; BucketIndex++)
+    {
+        ak__bucket<type, bucket_capacity>* OldBucket = Array->Buckets[BucketIndex];
+        ak__bucket<type, bucket_capacity>* NewBucket = NewBuckets[BucketIndex];
+        
+        //NOTE(EVERYONE): Entries past the bucket length stay zero, which is what Add expects of a bucket
+        AK__Memory_Copy(NewBucket->Data, OldBucket->Data, OldBucket->Length*sizeof(type));
+        AK__Memory_Clear(NewBucket->Data + OldBucket->Length, (bucket_capacity-OldBucket->Length)*sizeof(type));
+        NewBucket->Length = OldBucket->Length;
+    }
+    
+    AK_Delete(Array->Storage);
+    AK_Delete(&Array->Buckets);
+    Array->Storage = NewStorage;
+    Array->Buckets = NewBuckets;
+}
 
-Why would you need this if sprintf already exists?  Well, first off,
-it's *much* faster (see below). It's also much smaller than the CRT
-versions code-space-wise. We've also added some simple improvements
-that are super handy (commas in thousands, callbacks at buffer full,
-for example). Finally, the format strings for MSVC and GCC differ
-for 64-bit integers (among other small things), so this lets you use
-the same format strings in cross platform code.
+template <typename type, uint64_t bucket_capacity>
+void ak_bucket_array<type, bucket_capacity>::Trim()
+{
+    //NOTE(EVERYONE): Buckets after the current bucket are empty. They go back to the slab free list where any 
+    //bucket array sharing the slab can reuse them
+    uint64_t BucketCount = Length ? CurrentBucketIndex+1 : 0;
+    if(BucketCount >= Buckets.Length) return;
+    
+    for(uint64_t BucketIndex = BucketCount; BucketIndex < Buckets.Length; BucketIndex++)
+        Storage->Free_Block(Buckets[BucketIndex]);
+    Buckets.Length = BucketCount;
+    CurrentBucketIndex = AK__Min(CurrentBucketIndex, BucketCount);
+    
+    if(!BucketCount)
+    {
+        //NOTE(EVERYONE): An empty array gives all of its memory back
+        AK_Delete(&Buckets);
+        if(OwnsStorage)
+        {
+            AK_Delete(Storage);
+            Storage = NULL;
+            OwnsStorage = false;
+        }
+        CurrentBucketIndex = 0;
+    }
+    else 
+    {
+        //NOTE(EVERYONE): Nobody else can reuse the free blocks of a slab the array owns, and a slab never gives arena 
+        //memory back. Once most of it is free the surviving buckets move into a fresh slab and the old one is deleted
+        if(OwnsStorage && Storage->FreeBlockCount > BucketCount)
+            AK__Array_Move_Storage(this);
+        
+        if(Buckets.Capacity > BucketCount*2)
+            Buckets.Reserve(BucketCount);
+    }
+}
 
-It uses the standard single file trick of being both the header file
-and the source itself. If you just include it normally, you just get
-the header file function definitions. To get the code, you include
-it from a C or C++ file and define STB_SPRINTF_IMPLEMENTATION first.
+template <typename type, uint64_t bucket_capacity>
+ak_buffer ak_bucket_array<type, bucket_capacity>::Get_Buffer(ak_arena* Arena)
+{
+    type* Memory = Arena->Push_Array<type>(Length);
+    
+    type* At = Memory;
+    for(uint64_t BucketIndex = 0; BucketIndex < Buckets.Length; BucketIndex++)
+    {
+        ak__bucket<type, bucket_capacity>* Bucket = Buckets[BucketIndex];
+        AK__Memory_Copy(At, Bucket->Data, Bucket->Length*sizeof(type));
+        At += Bucket->Length;
+    }
+    
+    ak_buffer Result = {};
+    Result.Data = Memory;
+    Result.Length = Length*sizeof(type);
+    return Result;
+}
 
-It only uses va_args macros from the C runtime to do it's work. It
-does cast doubles to S64s and shifts and divides U64s, which does
-drag in CRT code on most platforms.
+template <typename type, uint64_t bucket_capacity>
+ak_array<type> ak_bucket_array<type, bucket_capacity>::Get_Array(ak_arena* Arena)
+{
+    ak_buffer Buffer = Get_Buffer(Arena);
+    ak_array<type> Result = AK_Create_Array<type>((type*)Buffer.Data, Length);
+    return Result;
+}
 
-It compiles to roughly 8K with float support, and 4K without.
-As a comparison, when using MSVC static libs, calling sprintf drags
-in 16K.
+template <typename type, uint64_t bucket_capacity>
+ak_bucket_array<type, bucket_capacity> ak_bucket_array<type, bucket_capacity>::Copy()
+{
+    //NOTE(EVERYONE): A copy shares the slab of the original unless the original owns its storage
+    ak_bucket_array<type, bucket_capacity> Result = AK_Create_Bucket_Array<type, bucket_capacity>(OwnsStorage ? NULL : Storage, Allocator);
+    
+    ak_raii<ak_bucket_array  <type, bucket_capacity>> RAII(&Result);
+    if(!AK__Array_Reserve_Buckets(&Result, Buckets.Length, AK_ARENA_NO_CLEAR))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return {};
+    }
+    
+    for(uint64_t BucketIndex = 0; BucketIndex < Buckets.Length; BucketIndex++)
+    {
+        ak__bucket<type, bucket_capacity>* Bucket = Result.Buckets[BucketIndex];
+        Bucket->Length = Buckets[BucketIndex]->Length;
+        AK__Memory_Copy(Bucket->Data, Buckets[BucketIndex]->Data, sizeof(type)*Buckets[BucketIndex]->Length);
+    }
+    
+    Result.CurrentBucketIndex = CurrentBucketIndex;
+    Result.Length = Length;
+    
+    RAII.Block();
+    
+    return Result;
+}
 
-API:
-====
-int stbsp_sprintf( char * buf, char const * fmt, ... )
-int stbsp_snprintf( char * buf, int count, char const * fmt, ... )
-  Convert an arg list into a buffer.  stbsp_snprintf always returns
-  a zero-terminated string (unlike regular snprintf).
+template <typename type, uint64_t bucket_capacity>
+ak_bucket_array_spans<type, bucket_capacity> ak_bucket_array<type, bucket_capacity>::Spans()
+{
+    //NOTE(EVERYONE): Every bucket before the current bucket is full and every bucket after it is empty
+    uint64_t BucketCount = AK__Min(CurrentBucketIndex+1, Buckets.Length);
+    
+    ak_bucket_array_spans<type, bucket_capacity> Result;
+    Result.FirstBucket = Buckets.Data;
+    Result.EndBucket = Buckets.Data + BucketCount;
+    return Result;
+}
 
-int stbsp_vsprintf( char * buf, char const * fmt, va_list va )
-int stbsp_vsnprintf( char * buf, int count, char const * fmt, va_list va )
-  Convert a va_list arg list into a buffer.  stbsp_vsnprintf always returns
-  a zero-terminated string (unlike regular snprintf).
+template <typename type, uint64_t bucket_capacity>
+ak_bucket_array_iterator<type, bucket_capacity> ak_bucket_array<type, bucket_capacity>::begin()
+{
+    ak_bucket_array_spans<type, bucket_capacity> BucketSpans = Spans();
+    
+    ak_bucket_array_iterator<type, bucket_capacity> Result;
+    Result.Bucket = BucketSpans.FirstBucket;
+    Result.LastBucket = BucketSpans.EndBucket;
+    AK__Array_Iterator_Enter_Bucket(&Result);
+    return Result;
+}
 
-int stbsp_vsprintfcb( STBSP_SPRINTFCB * callback, void * user, char * buf, char const * fmt, va_list va )
-    typedef char * STBSP_SPRINTFCB( char const * buf, void * user, int len );
-  Convert into a buffer, calling back every STB_SPRINTF_MIN chars.
-  Your callback can then copy the chars out, print them or whatever.
-  This function is actually the workhorse for everything else.
-  The buffer you pass in must hold at least STB_SPRINTF_MIN characters.
-    // you return the next buffer to use or 0 to stop converting
+template <typename type, uint64_t bucket_capacity>
+ak_bucket_array_iterator<type, bucket_capacity> ak_bucket_array<type, bucket_capacity>::end()
+{
+    return {};
+}
 
-void stbsp_set_separators( char comma, char period )
-  Set the comma and period characters to use.
+template <typename type, uint64_t bucket_capacity> 
+ak_slab* AK_Create_Bucket_Array_Slab(uint64_t ArenaBlockSize, ak_allocator* Allocator)
+{
+    return AK_Create_Slab(sizeof(ak__bucket<type, bucket_capacity>), alignof(ak__bucket<type, bucket_capacity>), ArenaBlockSize, Allocator);
+}
 
-FLOATS/DOUBLES:
-===============
-This code uses a internal float->ascii conversion method that uses
-doubles with error correction (double-doubles, for ~105 bits of
-precision).  This conversion is round-trip perfect - that is, an atof
-of the values output here will give you the bit-exact double back.
+template <typename type, uint64_t bucket_capacity> 
+ak_bucket_array<type, bucket_capacity> AK_Create_Bucket_Array(ak_slab* Slab, ak_allocator* Allocator)
+{
+    ak_bucket_array<type, bucket_capacity> Result;
+    Result.Allocator = Allocator;
+    Result.Buckets.Allocator = Allocator;
+    Result.Storage = Slab;
+    return Result;
+}
 
-One difference is that our insignificant digits will be different than
-with MSVC or GCC (but they don't match each other either).  We also
-don't attempt to find the minimum length matching float (pre-MSVC15
-doesn't either).
+template <typename type, uint64_t bucket_capacity> 
+void AK_Delete(ak_bucket_array<type, bucket_capacity>* Array)
+{
+    if(Array)
+    {
+        if(Array->OwnsStorage) 
+        {
+            AK_Delete(Array->Storage);
+        }
+        else if(Array->Storage)
+        {
+            for(uint64_t BucketIndex = 0; BucketIndex < Array->Buckets.Length; BucketIndex++)
+                Array->Storage->Free_Block(Array->Buckets[BucketIndex]);
+        }
+        
+        AK_Delete(&Array->Buckets);
+        *Array = {};
+    }
+}
 
-If you don't need float or doubles at all, define STB_SPRINTF_NOFLOAT
-and you'll save 4K of code space.
+//~Concurrent bucket array implementation
+template <typename type, uint64_t bucket_capacity>
+ak__concurrent_bucket<type, bucket_capacity>* AK__Concurrent_Array_Load_Bucket(ak_concurrent_bucket_array<type, bucket_capacity>* Array, 
+                                                                               uint64_t BucketIndex)
+{
+    return (ak__concurrent_bucket<type, bucket_capacity>*)AK__Atomic_Load_Ptr((void* volatile*)(Array->Buckets + BucketIndex));
+}
 
-64-BIT INTS:
-============
-This library also supports 64-bit integers and you can use MSVC style or
-GCC style indicators (%I64d or %lld).  It supports the C99 specifiers
-for size_t and ptr_diff_t (%jd %zd) as well.
+template <typename type, uint64_t bucket_capacity>
+bool ak_concurrent_bucket_array<type, bucket_capacity>::Add(const type& Entry)
+{
+    return Add_And_Get(Entry) != NULL;
+}
 
-EXTRAS:
-=======
-Like some GCCs, for integers and floats, you can use a ' (single quote)
-specifier and commas will be inserted on the thousands: "%'d" on 12345
-would print 12,345.
+template <typename type, uint64_t bucket_capacity>
+type* ak_concurrent_bucket_array<type, bucket_capacity>::Add_And_Get(const type& Entry)
+{
+    uint64_t Index = AK__Atomic_Add64(&ReservedCount, 1);
+    uint64_t BucketIndex = ak__bucket_indexer<bucket_capacity>::Get_Bucket_Index(Index);
+    if(BucketIndex >= MaxBucketCount)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return NULL;
+    }
+    
+    ak__concurrent_bucket<type, bucket_capacity>* Bucket = AK__Concurrent_Array_Load_Bucket(this, BucketIndex);
+    if(!Bucket)
+    {
+        //NOTE(EVERYONE): Every producer that lands in a missing bucket allocates one, the first to install it 
+        //into the directory wins and everyone else frees theirs. The allocator has to be thread safe
+        ak__concurrent_bucket<type, bucket_capacity>* NewBucket = 
+            (ak__concurrent_bucket<type, bucket_capacity>*)Allocator->Alloc(sizeof(ak__concurrent_bucket<type, bucket_capacity>), Allocator->UserData);
+        if(!NewBucket)
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return NULL;
+        }
+        NewBucket->Committed = 0;
+        
+        Bucket = (ak__concurrent_bucket<type, bucket_capacity>*)AK__Atomic_Compare_Exchange_Ptr((void* volatile*)(Buckets + BucketIndex), NewBucket, NULL);
+        if(Bucket) Allocator->Free(NewBucket, Allocator->UserData);
+        else Bucket = NewBucket;
+    }
+    
+    type* Result = Bucket->Data + ak__bucket_indexer<bucket_capacity>::Get_Entry_Index(Index, BucketIndex);
+    *Result = Entry;
+    AK__Atomic_Add64(&Bucket->Committed, 1);
+    return Result;
+}
 
-For integers and floats, you can use a "$" specifier and the number
-will be converted to float and then divided to get kilo, mega, giga or
-tera and then printed, so "%$d" 1000 is "1.0 k", "%$.2d" 2536000 is
-"2.53 M", etc. For byte values, use two $:s, like "%$$d" to turn
-2536000 to "2.42 Mi". If you prefer JEDEC suffixes to SI ones, use three
-$:s: "%$$$d" -> "2.42 M". To remove the space between the number and the
-suffix, add "_" specifier: "%_$d" -> "2.53M".
-
-In addition to octal and hexadecimal conversions, you can print
-integers in binary: "%b" for 256 would print 100.
-
-PERFORMANCE vs MSVC 2008 32-/64-bit (GCC is even slower than MSVC):
-===================================================================
-"%d" across all 32-bit ints (4.8x/4.0x faster than 32-/64-bit MSVC)
-"%24d" across all 32-bit ints (4.5x/4.2x faster)
-"%x" across all 32-bit ints (4.5x/3.8x faster)
-"%08x" across all 32-bit ints (4.3x/3.8x faster)
-"%f" across e-10 to e+10 floats (7.3x/6.0x faster)
-"%e" across e-10 to e+10 floats (8.1x/6.0x faster)
-"%g" across e-10 to e+10 floats (10.0x/7.1x faster)
-"%f" for values near e-300 (7.9x/6.5x faster)
-"%f" for values near e+300 (10.0x/9.1x faster)
-"%e" for values near e-300 (10.1x/7.0x faster)
-"%e" for values near e+300 (9.2x/6.0x faster)
-"%.320f" for values near e-300 (12.6x/11.2x faster)
-"%a" for random values (8.6x/4.3x faster)
-"%I64d" for 64-bits with 32-bit values (4.8x/3.4x faster)
-"%I64d" for 64-bits > 32-bit values (4.9x/5.5x faster)
-"%s%s%s" for 64 char strings (7.1x/7.3x faster)
-"...512 char string..." ( 35.0x/32.5x faster!)
-*/
-
-#if defined(__clang__)
-#if defined(__has_feature) && defined(__has_attribute)
-#if __has_feature(address_sanitizer)
-#if __has_attribute(__no_sanitize__)
-#define STBSP__ASAN __attribute__((__no_sanitize__("address")))
-#elif __has_attribute(__no_sanitize_address__)
-#define STBSP__ASAN __attribute__((__no_sanitize_address__))
-#elif __has_attribute(__no_address_safety_analysis__)
-#define STBSP__ASAN __attribute__((__no_address_safety_analysis__))
-#endif
-#endif
-#endif
-#elif defined(__GNUC__) && (__GNUC__ >= 5 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
-#if defined(__SANITIZE_ADDRESS__) && __SANITIZE_ADDRESS__
-#define STBSP__ASAN __attribute__((__no_sanitize_address__))
-#endif
-#endif
-
-#ifndef STBSP__ASAN
-#define STBSP__ASAN
-#endif
-
-#ifdef STB_SPRINTF_STATIC
-#define STBSP__PUBLICDEC static
-#define STBSP__PUBLICDEF static STBSP__ASAN
-#else
-#ifdef __cplusplus
-#define STBSP__PUBLICDEC extern "C"
-#define STBSP__PUBLICDEF extern "C" STBSP__ASAN
-#else
-#define STBSP__PUBLICDEC extern
-#define STBSP__PUBLICDEF STBSP__ASAN
-#endif
-#endif
-
-#if defined(__has_attribute)
-#if __has_attribute(format)
-#define STBSP__ATTRIBUTE_FORMAT(fmt,va) __attribute__((format(printf,fmt,va)))
-#endif
-#endif
-
-#ifndef STBSP__ATTRIBUTE_FORMAT
-#define STBSP__ATTRIBUTE_FORMAT(fmt,va)
-#endif
-
-#ifdef _MSC_VER
-#define STBSP__NOTUSED(v)  (void)(v)
-#else
-#define STBSP__NOTUSED(v)  (void)sizeof(v)
-#endif
-
-#ifndef STB_SPRINTF_MIN
-#define STB_SPRINTF_MIN 512 // how many characters per callback
-#endif
-typedef char *STBSP_SPRINTFCB(const char *buf, void *user, int len);
-
-#ifndef STB_SPRINTF_DECORATE
-#define STB_SPRINTF_DECORATE(name) stbsp_##name // define this before including if you want to change the names
-#endif
-
-STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(vsprintf)(char *buf, char const *fmt, va_list va);
-STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(vsnprintf)(char *buf, int count, char const *fmt, va_list va);
-STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(sprintf)(char *buf, char const *fmt, ...) STBSP__ATTRIBUTE_FORMAT(2,3);
-STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(snprintf)(char *buf, int count, char const *fmt, ...) STBSP__ATTRIBUTE_FORMAT(3,4);
-
-STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(vsprintfcb)(STBSP_SPRINTFCB *callback, void *user, char *buf, char const *fmt, va_list va);
-STBSP__PUBLICDEC void STB_SPRINTF_DECORATE(set_separators)(char comma, char period);
-
-#endif // STB_SPRINTF_H_INCLUDE
-
-#ifdef STB_SPRINTF_IMPLEMENTATION
-
-#define stbsp__uint32 unsigned int
-#define stbsp__int32 signed int
-
-#ifdef _MSC_VER
-#define stbsp__uint64 unsigned __int64
-#define stbsp__int64 signed __int64
-#else
-#define stbsp__uint64 unsigned long long
-#define stbsp__int64 signed long long
-#endif
-#define stbsp__uint16 unsigned short
-
-#ifndef stbsp__uintptr
-#if defined(__ppc64__) || defined(__powerpc64__) || defined(__aarch64__) || defined(_M_X64) || defined(__x86_64__) || defined(__x86_64) || defined(__s390x__)
-#define stbsp__uintptr stbsp__uint64
-#else
-#define stbsp__uintptr stbsp__uint32
-#endif
-#endif
-
-#ifndef STB_SPRINTF_MSVC_MODE // used for MSVC2013 and earlier (MSVC2015 matches GCC)
-#if defined(_MSC_VER) && (_MSC_VER < 1900)
-#define STB_SPRINTF_MSVC_MODE
-#endif
-#endif
-
-#ifdef STB_SPRINTF_NOUNALIGNED // define this before inclusion to force stbsp_sprintf to always use aligned accesses
-#define STBSP__UNALIGNED(code)
-#else
-#define STBSP__UNALIGNED(code) code
-#endif
-
-#ifndef STB_SPRINTF_NOFLOAT
-// internal float utility functions
-static stbsp__int32 stbsp__real_to_str(char const **start, stbsp__uint32 *len, char *out, stbsp__int32 *decimal_pos, double value, stbsp__uint32 frac_digits);
-static stbsp__int32 stbsp__real_to_parts(stbsp__int64 *bits, stbsp__int32 *expo, double value);
-#define STBSP__SPECIAL 0x7000
-#endif
-
-static char stbsp__period = '.';
-static char stbsp__comma = ',';
-static struct
-{
-    short temp; // force next field to be 2-byte aligned
-    char pair[201];
-} stbsp__digitpair =
+template <typename type, uint64_t bucket_capacity>
+uint64_t ak_concurrent_bucket_array<type, bucket_capacity>::Get_Length()
 {
-    0,
-    "00010203040506070809101112131415161718192021222324"
-        "25262728293031323334353637383940414243444546474849"
-        "50515253545556575859606162636465666768697071727374"
-        "75767778798081828384858687888990919293949596979899"
-};
+    uint64_t Published = AK__Atomic_Load64(&PublishedLength);
+    uint64_t Capacity = ak__bucket_indexer<bucket_capacity>::Get_Base_Index(MaxBucketCount);
+    
+    //NOTE(EVERYONE): Walk forward over buckets that are completely written. A partially written bucket only 
+    //extends the length when every slot claimed in it so far has been committed
+    uint64_t NewLength = Published;
+    while(NewLength < Capacity)
+    {
+        uint64_t BucketIndex = ak__bucket_indexer<bucket_capacity>::Get_Bucket_Index(NewLength);
+        ak__concurrent_bucket<type, bucket_capacity>* Bucket = AK__Concurrent_Array_Load_Bucket(this, BucketIndex);
+        if(!Bucket) break;
+        
+        uint64_t BaseIndex = ak__bucket_indexer<bucket_capacity>::Get_Base_Index(BucketIndex);
+        uint64_t Committed = AK__Atomic_Load64(&Bucket->Committed);
+        if(Committed == bucket_capacity)
+        {
+            NewLength = BaseIndex+bucket_capacity;
+            continue;
+        }
+        
+        //NOTE(EVERYONE): Reserved has to be loaded after committed. If they match, nothing claimed in this bucket is still in flight
+        uint64_t Reserved = AK__Atomic_Load64(&ReservedCount);
+        if(Reserved-BaseIndex == Committed) NewLength = BaseIndex+Committed;
+        break;
+    }
+    
+    while(Published < NewLength)
+    {
+        uint64_t Previous = AK__Atomic_Compare_Exchange64(&PublishedLength, NewLength, Published);
+        if(Previous == Published) break;
+        Published = Previous;
+    }
+    
+    return AK__Max(Published, NewLength);
+}
 
-STBSP__PUBLICDEF void STB_SPRINTF_DECORATE(set_separators)(char pcomma, char pperiod)
+template <typename type, uint64_t bucket_capacity>
+type* ak_concurrent_bucket_array<type, bucket_capacity>::Get(uint64_t Index)
 {
-    stbsp__period = pperiod;
-    stbsp__comma = pcomma;
+    if(Index >= AK__Atomic_Load64(&PublishedLength)) return NULL;
+    uint64_t BucketIndex = ak__bucket_indexer<bucket_capacity>::Get_Bucket_Index(Index);
+    return Buckets[BucketIndex]->Data + ak__bucket_indexer<bucket_capacity>::Get_Entry_Index(Index, BucketIndex);
 }
 
-#define STBSP__LEFTJUST 1
-#define STBSP__LEADINGPLUS 2
-#define STBSP__LEADINGSPACE 4
-#define STBSP__LEADING_0X 8
-#define STBSP__LEADINGZERO 16
-#define STBSP__INTMAX 32
-#define STBSP__TRIPLET_COMMA 64
-#define STBSP__NEGATIVE 128
-#define STBSP__METRIC_SUFFIX 256
-#define STBSP__HALFWIDTH 512
-#define STBSP__METRIC_NOSPACE 1024
-#define STBSP__METRIC_1024 2048
-#define STBSP__METRIC_JEDEC 4096
+template <typename type, uint64_t bucket_capacity>
+type& ak_concurrent_bucket_array<type, bucket_capacity>::operator[](uint64_t Index)
+{
+    type* Result = Get(Index);
+    AK_STD_ASSERT(Result, "Array out of bounds! Index must be smaller than the published length");
+    return *Result;
+}
 
-static void stbsp__lead_sign(stbsp__uint32 fl, char *sign)
+template <typename type, uint64_t bucket_capacity>
+void ak_concurrent_bucket_array<type, bucket_capacity>::Clear()
 {
-    sign[0] = 0;
-    if (fl & STBSP__NEGATIVE) {
-        sign[0] = 1;
-        sign[1] = '-';
-    } else if (fl & STBSP__LEADINGSPACE) {
-        sign[0] = 1;
-        sign[1] = ' ';
-    } else if (fl & STBSP__LEADINGPLUS) {
-        sign[0] = 1;
-        sign[1] = '+';
-    }
+    //NOTE(EVERYONE): Clearing is not thread safe. Producers and readers need to be quiescent
+    for(uint64_t BucketIndex = 0; BucketIndex < MaxBucketCount; BucketIndex++)
+        if(Buckets[BucketIndex]) Buckets[BucketIndex]->Committed = 0;
+    ReservedCount = 0;
+    PublishedLength = 0;
 }
 
-static STBSP__ASAN stbsp__uint32 stbsp__strlen_limited(char const *s, stbsp__uint32 limit)
+template <typename type, uint64_t bucket_capacity> ak_concurrent_bucket_array<type, bucket_capacity> 
+AK_Create_Concurrent_Bucket_Array(uint64_t MaxBucketCount, ak_allocator* Allocator)
 {
-    char const * sn = s;
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
     
-    // get up to 4-byte alignment
-    for (;;) {
-        if (((stbsp__uintptr)sn & 3) == 0)
-            break;
-        
-        if (!limit || *sn == 0)
-            return (stbsp__uint32)(sn - s);
-        
-        ++sn;
-        --limit;
-    }
+    ak_concurrent_bucket_array<type, bucket_capacity> Result;
     
-    // scan over 4 bytes at a time to find terminating 0
-    // this will intentionally scan up to 3 bytes past the end of buffers,
-    // but becase it works 4B aligned, it will never cross page boundaries
-    // (hence the STBSP__ASAN markup; the over-read here is intentional
-    // and harmless)
-    while (limit >= 4) {
-        stbsp__uint32 v = *(stbsp__uint32 *)sn;
-        // bit hack to find if there's a 0 byte in there
-        if ((v - 0x01010101) & (~v) & 0x80808080UL)
-            break;
-        
-        sn += 4;
-        limit -= 4;
+    uint64_t AllocSize = MaxBucketCount*sizeof(ak__concurrent_bucket<type, bucket_capacity>*);
+    Result.Buckets = (ak__concurrent_bucket<type, bucket_capacity>* volatile*)Allocator->Alloc(AllocSize, Allocator->UserData);
+    if(!Result.Buckets)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return Result;
     }
     
-    // handle the last few characters to find actual size
-    while (limit && *sn) {
-        ++sn;
-        --limit;
+    AK__Memory_Clear((void*)Result.Buckets, AllocSize);
+    Result.Allocator = Allocator;
+    Result.MaxBucketCount = MaxBucketCount;
+    return Result;
+}
+
+template <typename type, uint64_t bucket_capacity> 
+void AK_Delete(ak_concurrent_bucket_array<type, bucket_capacity>* Array)
+{
+    if(Array && Array->Buckets)
+    {
+        for(uint64_t BucketIndex = 0; BucketIndex < Array->MaxBucketCount; BucketIndex++)
+            Array->Allocator->Free(Array->Buckets[BucketIndex], Array->Allocator->UserData);
+        Array->Allocator->Free((void*)Array->Buckets, Array->Allocator->UserData);
+        Array->Buckets = NULL;
+        Array->MaxBucketCount = 0;
+        Array->ReservedCount = 0;
+        Array->PublishedLength = 0;
     }
-    
-    return (stbsp__uint32)(sn - s);
 }
 
-STBSP__PUBLICDEF int STB_SPRINTF_DECORATE(vsprintfcb)(STBSP_SPRINTFCB *callback, void *user, char *buf, char const *fmt, va_list va)
+//~Hash Map implementation
+template <typename key, typename value>
+ak_hashmap_pair<key, value> ak_hashmap_iterator<key, value>::operator*()
 {
-    static char hex[] = "0123456789abcdefxp";
-    static char hexu[] = "0123456789ABCDEFXP";
-    char *bf;
-    char const *f;
-    int tlen = 0;
-    
-    bf = buf;
-    f = fmt;
-    for (;;) {
-        stbsp__int32 fw, pr, tz;
-        stbsp__uint32 fl;
-        
-        // macros for the callback buffer stuff
-#define stbsp__chk_cb_bufL(bytes)                        \
-{                                                     \
-int len = (int)(bf - buf);                         \
-if ((len + (bytes)) >= STB_SPRINTF_MIN) {          \
-tlen += len;                                    \
-if (0 == (bf = buf = callback(buf, user, len))) \
-goto done;                                   \
-}                                                  \
+    ak_hashmap_pair<key, value> Result = 
+    {
+        Keys[CurrentIndex], 
+        Values[CurrentIndex]
+    };
+    return Result;
 }
-#define stbsp__chk_cb_buf(bytes)    \
-{                                \
-if (callback) {               \
-stbsp__chk_cb_bufL(bytes); \
-}                             \
+
+template <typename key, typename value>
+void ak_hashmap_iterator<key, value>::operator++()
+{
+    CurrentIndex++;
 }
-#define stbsp__flush_cb()                      \
-{                                           \
-stbsp__chk_cb_bufL(STB_SPRINTF_MIN - 1); \
-} // flush if there is even one byte in the buffer
-#define stbsp__cb_buf_clamp(cl, v)                \
-cl = v;                                        \
-if (callback) {                                \
-int lg = STB_SPRINTF_MIN - (int)(bf - buf); \
-if (cl > lg)                                \
-cl = lg;                                 \
+
+template <typename key, typename value>
+bool ak_hashmap_iterator<key, value>::operator!=(const ak_hashmap_iterator& Iterator)
+{
+    return CurrentIndex != *Length;
 }
-        
-        // fast copy everything up to the next % (or end of string)
-        for (;;) {
-            while (((stbsp__uintptr)f) & 3) {
-                schk1:
-                if (f[0] == '%')
-                    goto scandd;
-                schk2:
-                if (f[0] == 0)
-                    goto endfmt;
-                stbsp__chk_cb_buf(1);
-                *bf++ = f[0];
-                ++f;
-            }
-            for (;;) {
-                // Check if the next 4 bytes contain %(0x25) or end of string.
-                // Using the 'hasless' trick:
-                // https://graphics.stanford.edu/~seander/bithacks.html#HasLessInWord
-                stbsp__uint32 v, c;
-                v = *(stbsp__uint32 *)f;
-                c = (~v) & 0x80808080;
-                if (((v ^ 0x25252525) - 0x01010101) & c)
-                    goto schk1;
-                if ((v - 0x01010101) & c)
-                    goto schk2;
-                if (callback)
-                    if ((STB_SPRINTF_MIN - (int)(bf - buf)) < 4)
-                    goto schk1;
-#ifdef STB_SPRINTF_NOUNALIGNED
-                if(((stbsp__uintptr)bf) & 3) {
-                    bf[0] = f[0];
-                    bf[1] = f[1];
-                    bf[2] = f[2];
-                    bf[3] = f[3];
-                } else
-#endif
-                {
-                    *(stbsp__uint32 *)bf = v;
-                }
-                bf += 4;
-                f += 4;
+
+ak__hashmap_slot* AK__HashMap_Realloc_Slots(ak__hashmap_slot* OldSlots, uint32_t* ItemSlots, uint32_t OldCapacity, uint32_t NewCapacity, 
+                                            uint32_t SlotTag, ak_allocator* Allocator)
+{
+    uint32_t SlotMask = NewCapacity-1;
+    
+    uint64_t AllocSize = NewCapacity*sizeof(ak__hashmap_slot);
+    ak__hashmap_slot* Slots = (ak__hashmap_slot*)Allocator->Alloc(AllocSize, Allocator->UserData);
+    AK__Memory_Clear(Slots, AllocSize);
+    
+    for(uint32_t OldSlotIndex = 0; OldSlotIndex < OldCapacity; OldSlotIndex++)
+    {
+        if(OldSlots[OldSlotIndex].IsValid)
+        {
+            uint32_t Hash = OldSlots[OldSlotIndex].Hash;
+            uint32_t BaseSlot = Hash & SlotMask;
+            uint32_t Slot = BaseSlot;
+            while(Slots[Slot].IsValid)
+                Slot = (Slot+1) & SlotMask;
+            Slots[Slot].Hash = Hash;
+            uint32_t ItemIndex = OldSlots[OldSlotIndex].ItemIndex;
+            Slots[Slot].ItemIndex = ItemIndex;
+            ItemSlots[ItemIndex] = Slot | SlotTag;
+            Slots[BaseSlot].BaseCount++;
+            Slots[Slot].IsValid = true;
+        }
+    }
+    
+    Allocator->Free(OldSlots, Allocator->UserData);
+    return Slots;
+}
+
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> AK__HashMap_Begin(const key* Keys, const value* Values, const uint32_t* Length)
+{
+    ak_hashmap_iterator<key, value> Result;
+    Result.Keys = Keys;
+    Result.Values = Values;
+    Result.Length = Length;
+    Result.CurrentIndex = 0;
+    return Result;
+}
+
+//NOTE(EVERYONE): The item slots, keys and values of a map live in one allocation. The old block is freed after the 
+//first Length items are copied over. Sets pass NULL for Values and get no value array
+template <typename key, typename value>
+bool AK__HashMap_Realloc_Items(ak_allocator* Allocator, uint32_t Length, uint32_t NewCapacity, 
+                               uint32_t** ItemSlots, key** Keys, value** Values)
+{
+    uint64_t KeyOffset = AK__Memory_Align(NewCapacity*sizeof(uint32_t), alignof(key));
+    uint64_t ValueOffset = AK__Memory_Align(KeyOffset + NewCapacity*sizeof(key), alignof(value));
+    uint64_t AllocSize = Values ? ValueOffset + NewCapacity*sizeof(value) : ValueOffset;
+    
+    uint8_t* MapData = (uint8_t*)Allocator->Alloc(AllocSize, Allocator->UserData);
+    if(!MapData)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    AK__Memory_Clear(MapData, AllocSize);
+    
+    uint32_t* NewItemSlots = (uint32_t*)MapData;
+    key* NewKeys = (key*)(MapData + KeyOffset);
+    value* NewValues = (value*)(MapData + ValueOffset);
+    
+    if(*ItemSlots)
+    {
+        AK__Memory_Copy(NewItemSlots, *ItemSlots, Length*sizeof(uint32_t));
+        AK__Memory_Copy(NewKeys, *Keys, Length*sizeof(key));
+        if(Values) AK__Memory_Copy(NewValues, *Values, Length*sizeof(value));
+        Allocator->Free(*ItemSlots, Allocator->UserData);
+    }
+    
+    *ItemSlots = NewItemSlots;
+    *Keys = NewKeys;
+    if(Values) *Values = NewValues;
+    return true;
+}
+
+template <typename key, typename value>
+void AK__HashMap_Realloc(ak_hashmap<key, value>* Map)
+{
+    Map->ItemCapacity *= 2;
+    AK__HashMap_Realloc_Items(Map->Allocator, Map->Length, Map->ItemCapacity, &Map->ItemSlots, &Map->Keys, &Map->Values);
+}
+
+struct ak__hashmap_probe
+{
+    int64_t  Slot;
+    uint32_t InsertSlot;
+};
+
+//NOTE(EVERYONE): Walks the slots belonging to the key's base slot once. Slot is the slot holding the key (or -1) and 
+//InsertSlot is the first free slot a new key with this hash can go into. Keys is anything indexable by item index
+template <typename key, typename keys, typename lookup>
+ak__hashmap_probe AK__HashMap_Probe_Keys(const keys& Keys, const ak__hashmap_slot* Slots, uint32_t SlotCapacity, const lookup& Key, uint32_t Hash)
+{
+    uint32_t SlotMask = SlotCapacity - 1;
+    
+    uint32_t BaseSlot = Hash & SlotMask;
+    uint32_t BaseCount = Slots[BaseSlot].BaseCount;
+    uint32_t Slot = BaseSlot;
+    int64_t FirstFree = -1;
+    
+    while(BaseCount > 0)
+    {
+        if(Slots[Slot].IsValid)
+        {
+            uint32_t SlotHash = Slots[Slot].Hash;
+            uint32_t SlotBase = SlotHash & SlotMask;
+            if(SlotBase == BaseSlot)
+            {
+                BaseCount--;
+                if(SlotHash == Hash && ak_hash_traits<key>::Equals(Keys[Slots[Slot].ItemIndex], Key))
+                    return {(int64_t)Slot, 0};
             }
         }
-        scandd:
+        else if(FirstFree < 0) FirstFree = Slot;
         
-        ++f;
+        Slot = (Slot+1) & SlotMask;
+    }
+    
+    if(FirstFree >= 0) return {-1, (uint32_t)FirstFree};
+    
+    while(Slots[Slot].IsValid)
+        Slot = (Slot+1) & SlotMask;
+    return {-1, Slot};
+}
+
+template <typename key, typename lookup>
+ak__hashmap_probe AK__HashMap_Probe(key* Keys, ak__hashmap_slot* Slots, uint32_t SlotCapacity, const lookup& Key, uint32_t Hash)
+{
+    return AK__HashMap_Probe_Keys<key>(Keys, Slots, SlotCapacity, Key, Hash);
+}
+
+#define AK__HASHMAP_SLOT_TAG_BIT 0x80000000u
+
+//NOTE(EVERYONE): Lazily creates the map on first use, keeping any settings made on the default constructed map
+template <typename key, typename value>
+void AK__HashMap_Init(ak_hashmap<key, value>* Map)
+{
+    bool IncrementalRehash = Map->IncrementalRehash;
+    float MaxLoadFactor = Map->MaxLoadFactor;
+    
+    uint32_t ItemCapacity = AK_HASH_MAP_SMALL_CAPACITY ? AK_HASH_MAP_SMALL_CAPACITY : AK_HASH_MAP_INITIAL_ITEM_CAPACITY;
+    *Map = AK_Create_Hash_Map<key, value>(AK_HASH_MAP_INITIAL_SLOT_CAPACITY, ItemCapacity, Map->Allocator);
+    Map->IncrementalRehash = IncrementalRehash;
+    Map->MaxLoadFactor = MaxLoadFactor;
+}
+
+template <typename map>
+ak__hashmap_slot* AK__HashMap_Get_Item_Slot(map* Map, uint32_t ItemIndex)
+{
+    uint32_t ItemSlot = Map->ItemSlots[ItemIndex];
+    uint32_t Slot = ItemSlot & ~AK__HASHMAP_SLOT_TAG_BIT;
+    return ((ItemSlot & AK__HASHMAP_SLOT_TAG_BIT) == Map->SlotTag) ? Map->Slots + Slot : Map->OldSlots + Slot;
+}
+
+//NOTE(EVERYONE): Lookup for maps without a slot table. Compares the stored hashes four at a time and only compares 
+//keys on a hash match. Returns the item index or -1
+template <typename key, typename value, typename lookup>
+int64_t AK__HashMap_Small_Find(const ak_hashmap<key, value>* Map, const lookup& Key, uint32_t Hash)
+{
+    const uint32_t* Hashes = Map->ItemSlots;
+    uint32_t Index = 0;
+    
+#ifdef AK__SSE2
+    __m128i Target = _mm_set1_epi32((int32_t)Hash);
+    for(; Index+4 <= Map->Length; Index += 4)
+    {
+        __m128i Group = _mm_loadu_si128((const __m128i*)(Hashes+Index));
+        uint32_t Mask = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(Group, Target)));
+        while(Mask)
+        {
+            uint32_t ItemIndex = Index+AK__Count_Trailing_Zeros32(Mask);
+            if(ak_hash_traits<key>::Equals(Map->Keys[ItemIndex], Key)) return ItemIndex;
+            Mask &= Mask-1;
+        }
+    }
+#endif
+    
+    for(; Index < Map->Length; Index++)
+    {
+        if(Hashes[Index] == Hash && ak_hash_traits<key>::Equals(Map->Keys[Index], Key))
+            return Index;
+    }
+    
+    return -1;
+}
+
+#ifdef AK_HASH_MAP_STATS
+//NOTE(EVERYONE): A hit looked at every slot from the base slot up to its own. A miss walked the whole run of the base 
+//slot in the current table
+template <typename map>
+void AK__HashMap_Record_Probe(map* Map, uint32_t Hash, const ak__hashmap_slot* Entry)
+{
+    uint32_t ProbeLength = 0;
+    if(Entry)
+    {
+        bool IsOld = Map->OldSlots && Entry >= Map->OldSlots && Entry < Map->OldSlots+Map->OldSlotCapacity;
+        const ak__hashmap_slot* Table = IsOld ? Map->OldSlots : Map->Slots;
+        uint32_t TableMask = (IsOld ? Map->OldSlotCapacity : Map->SlotCapacity)-1;
+        ProbeLength = (((uint32_t)(Entry-Table) - (Hash & TableMask)) & TableMask) + 1;
         
-        // ok, we have a percent, read the modifiers first
-        fw = 0;
-        pr = -1;
-        fl = 0;
-        tz = 0;
+        Map->Stats.HitCount++;
+        Map->Stats.HitProbeLengths[AK__Min(ProbeLength, AK_HASH_MAP_STATS_BUCKET_COUNT)-1]++;
+    }
+    else
+    {
+        uint32_t SlotMask = Map->SlotCapacity-1;
+        uint32_t BaseSlot = Hash & SlotMask;
+        uint32_t BaseCount = Map->Slots[BaseSlot].BaseCount;
+        for(uint32_t Slot = BaseSlot; BaseCount > 0; Slot = (Slot+1) & SlotMask)
+        {
+            const ak__hashmap_slot* Visited = Map->Slots + Slot;
+            if(Visited->IsValid && (Visited->Hash & SlotMask) == BaseSlot) BaseCount--;
+            ProbeLength++;
+        }
+        ProbeLength = AK__Max(ProbeLength, 1);
         
-        // flags
-        for (;;) {
-            switch (f[0]) {
-                // if we have left justify
-                case '-':
-                fl |= STBSP__LEFTJUST;
-                ++f;
-                continue;
-                // if we have leading plus
-                case '+':
-                fl |= STBSP__LEADINGPLUS;
-                ++f;
-                continue;
-                // if we have leading space
-                case ' ':
-                fl |= STBSP__LEADINGSPACE;
-                ++f;
-                continue;
-                // if we have leading 0x
-                case '#':
-                fl |= STBSP__LEADING_0X;
-                ++f;
-                continue;
-                // if we have thousand commas
-                case '\'':
-                fl |= STBSP__TRIPLET_COMMA;
-                ++f;
-                continue;
-                // if we have kilo marker (none->kilo->kibi->jedec)
-                case '$':
-                if (fl & STBSP__METRIC_SUFFIX) {
-                    if (fl & STBSP__METRIC_1024) {
-                        fl |= STBSP__METRIC_JEDEC;
-                    } else {
-                        fl |= STBSP__METRIC_1024;
-                    }
-                } else {
-                    fl |= STBSP__METRIC_SUFFIX;
-                }
-                ++f;
-                continue;
-                // if we don't want space between metric suffix and number
-                case '_':
-                fl |= STBSP__METRIC_NOSPACE;
-                ++f;
-                continue;
-                // if we have leading zero
-                case '0':
-                fl |= STBSP__LEADINGZERO;
-                ++f;
-                goto flags_done;
-                default: goto flags_done;
-            }
+        Map->Stats.MissCount++;
+        Map->Stats.MissProbeLengths[AK__Min(ProbeLength, AK_HASH_MAP_STATS_BUCKET_COUNT)-1]++;
+    }
+    
+    Map->Stats.MaxProbeLength = AK__Max(Map->Stats.MaxProbeLength, ProbeLength);
+}
+#endif
+
+//NOTE(EVERYONE): Looks the key up in the slot table and, while a rehash is in flight, in the old table. InsertSlot 
+//receives where a new key with this hash goes in the current table. Only reads the map, so it is safe for 
+//concurrent readers
+template <typename map, typename lookup>
+ak__hashmap_slot* AK__HashMap_Lookup_Entry(const map* Map, const lookup& Key, uint32_t Hash, uint32_t* InsertSlot)
+{
+    AK_STD_ASSERT(Map->Slots, "Small maps have no slot table, use AK__HashMap_Small_Find");
+    
+    ak__hashmap_probe Probe = AK__HashMap_Probe(Map->Keys, Map->Slots, Map->SlotCapacity, Key, Hash);
+    if(InsertSlot) *InsertSlot = Probe.InsertSlot;
+    ak__hashmap_slot* Result = (Probe.Slot >= 0) ? Map->Slots + Probe.Slot : NULL;
+    
+    if(!Result && Map->OldSlots)
+    {
+        Probe = AK__HashMap_Probe(Map->Keys, Map->OldSlots, Map->OldSlotCapacity, Key, Hash);
+        if(Probe.Slot >= 0) Result = Map->OldSlots + Probe.Slot;
+    }
+    
+    return Result;
+}
+
+//NOTE(EVERYONE): AK__HashMap_Lookup_Entry that also records the probe in the map stats
+template <typename map, typename lookup>
+ak__hashmap_slot* AK__HashMap_Find_Entry(map* Map, const lookup& Key, uint32_t Hash, uint32_t* InsertSlot)
+{
+    ak__hashmap_slot* Result = AK__HashMap_Lookup_Entry(Map, Key, Hash, InsertSlot);
+    
+#ifdef AK_HASH_MAP_STATS
+    AK__HashMap_Record_Probe(Map, Hash, Result);
+#endif
+    
+    return Result;
+}
+
+//NOTE(EVERYONE): Moves up to SlotCount old slots into the current table and frees the old table once it is empty
+template <typename map>
+void AK__HashMap_Migrate_Slots(map* Map, uint32_t SlotCount)
+{
+    if(!Map->OldSlots) return;
+    
+#ifdef AK_HASH_MAP_STATS
+    uint64_t StartCycles = AK__Read_Cycle_Counter();
+#endif
+    
+    ak__hashmap_slot* Slots = Map->Slots;
+    ak__hashmap_slot* OldSlots = Map->OldSlots;
+    uint32_t SlotMask = Map->SlotCapacity-1;
+    uint32_t OldSlotMask = Map->OldSlotCapacity-1;
+    uint32_t EndIndex = (uint32_t)AK__Min((uint64_t)Map->MigrateIndex+SlotCount, (uint64_t)Map->OldSlotCapacity);
+    
+    for(; Map->MigrateIndex < EndIndex; Map->MigrateIndex++)
+    {
+        ak__hashmap_slot* OldSlot = OldSlots + Map->MigrateIndex;
+        if(OldSlot->IsValid)
+        {
+            uint32_t Hash = OldSlot->Hash;
+            OldSlots[Hash & OldSlotMask].BaseCount--;
+            OldSlot->Hash = 0;
+            OldSlot->IsValid = false;
+            
+            uint32_t BaseSlot = Hash & SlotMask;
+            uint32_t Slot = BaseSlot;
+            while(Slots[Slot].IsValid)
+                Slot = (Slot+1) & SlotMask;
+            
+            Slots[Slot].Hash = Hash;
+            Slots[Slot].ItemIndex = OldSlot->ItemIndex;
+            Slots[Slot].IsValid = true;
+            Slots[BaseSlot].BaseCount++;
+            Map->ItemSlots[OldSlot->ItemIndex] = Slot | Map->SlotTag;
         }
-        flags_done:
+    }
+    
+    if(Map->MigrateIndex == Map->OldSlotCapacity)
+    {
+        Map->Allocator->Free(Map->OldSlots, Map->Allocator->UserData);
+        Map->OldSlots = NULL;
+        Map->OldSlotCapacity = 0;
+        Map->MigrateIndex = 0;
+    }
+    
+#ifdef AK_HASH_MAP_STATS
+    Map->Stats.RehashCycles += AK__Read_Cycle_Counter()-StartCycles;
+#endif
+}
+
+template <typename map>
+uint32_t AK__HashMap_Get_Max_Length(map* Map, uint32_t SlotCapacity)
+{
+    //NOTE(EVERYONE): Checked here rather than at creation since the factor can be changed at any time. A factor of 
+    //zero would make the slot table double forever
+    AK_STD_ASSERT(Map->MaxLoadFactor > 0.0f && Map->MaxLoadFactor <= 1.0f, "Invalid hash map max load factor");
+    
+    //NOTE(EVERYONE): One slot always stays free so probing for an insert slot terminates
+    uint32_t Result = (uint32_t)((double)SlotCapacity*Map->MaxLoadFactor);
+    return AK__Min(Result, SlotCapacity-1);
+}
+
+//NOTE(EVERYONE): Builds the slot table of a small map from the hashes kept in ItemSlots
+template <typename map>
+bool AK__HashMap_Promote(map* Map, uint32_t Length)
+{
+    uint32_t NewCapacity = (uint32_t)AK__Ceil_Pow2(AK__Max(AK_HASH_MAP_SMALL_CAPACITY*2, 2));
+    while(Length > AK__HashMap_Get_Max_Length(Map, NewCapacity))
+        NewCapacity *= 2;
+    
+    ak_allocator* Allocator = Map->Allocator;
+    uint64_t AllocSize = NewCapacity*sizeof(ak__hashmap_slot);
+    ak__hashmap_slot* Slots = (ak__hashmap_slot*)Allocator->Alloc(AllocSize, Allocator->UserData);
+    if(!Slots)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    AK__Memory_Clear(Slots, AllocSize);
+    
+    uint32_t SlotMask = NewCapacity-1;
+    for(uint32_t ItemIndex = 0; ItemIndex < Map->Length; ItemIndex++)
+    {
+        uint32_t Hash = Map->ItemSlots[ItemIndex];
+        uint32_t BaseSlot = Hash & SlotMask;
+        uint32_t Slot = BaseSlot;
+        while(Slots[Slot].IsValid)
+            Slot = (Slot+1) & SlotMask;
         
-        // get the field width
-        if (f[0] == '*') {
-            fw = va_arg(va, stbsp__uint32);
-            ++f;
-        } else {
-            while ((f[0] >= '0') && (f[0] <= '9')) {
-                fw = fw * 10 + f[0] - '0';
-                f++;
-            }
-        }
-        // get the precision
-        if (f[0] == '.') {
-            ++f;
-            if (f[0] == '*') {
-                pr = va_arg(va, stbsp__uint32);
-                ++f;
-            } else {
-                pr = 0;
-                while ((f[0] >= '0') && (f[0] <= '9')) {
-                    pr = pr * 10 + f[0] - '0';
-                    f++;
-                }
-            }
-        }
+        Slots[Slot].Hash = Hash;
+        Slots[Slot].ItemIndex = ItemIndex;
+        Slots[Slot].IsValid = true;
+        Slots[BaseSlot].BaseCount++;
+        Map->ItemSlots[ItemIndex] = Slot;
+    }
+    
+    Map->Slots = Slots;
+    Map->SlotCapacity = NewCapacity;
+    Map->SlotTag = 0;
+    return true;
+}
+
+//NOTE(EVERYONE): Doubles the slot table until Length items fit under the load factor
+template <typename map>
+void AK__HashMap_Resize_Slots(map* Map, uint32_t Length)
+{
+    uint32_t NewCapacity = Map->SlotCapacity;
+    while(Length > AK__HashMap_Get_Max_Length(Map, NewCapacity))
+        NewCapacity = (uint32_t)AK__Ceil_Pow2(NewCapacity*2);
+    
+    if(NewCapacity != Map->SlotCapacity)
+    {
+        //NOTE(EVERYONE): Growing again before the last rehash finished completes it synchronously
+        AK__HashMap_Migrate_Slots(Map, Map->OldSlotCapacity);
         
-        // handle integer size overrides
-        switch (f[0]) {
-            // are we halfwidth?
-            case 'h':
-            fl |= STBSP__HALFWIDTH;
-            ++f;
-            if (f[0] == 'h')
-                ++f;  // QUARTERWIDTH
-            break;
-            // are we 64-bit (unix style)
-            case 'l':
-            fl |= ((sizeof(long) == 8) ? STBSP__INTMAX : 0);
-            ++f;
-            if (f[0] == 'l') {
-                fl |= STBSP__INTMAX;
-                ++f;
-            }
-            break;
-            // are we 64-bit on intmax? (c99)
-            case 'j':
-            fl |= (sizeof(size_t) == 8) ? STBSP__INTMAX : 0;
-            ++f;
-            break;
-            // are we 64-bit on size_t or ptrdiff_t? (c99)
-            case 'z':
-            fl |= (sizeof(ptrdiff_t) == 8) ? STBSP__INTMAX : 0;
-            ++f;
-            break;
-            case 't':
-            fl |= (sizeof(ptrdiff_t) == 8) ? STBSP__INTMAX : 0;
-            ++f;
-            break;
-            // are we 64-bit (msft style)
-            case 'I':
-            if ((f[1] == '6') && (f[2] == '4')) {
-                fl |= STBSP__INTMAX;
-                f += 3;
-            } else if ((f[1] == '3') && (f[2] == '2')) {
-                f += 3;
-            } else {
-                fl |= ((sizeof(void *) == 8) ? STBSP__INTMAX : 0);
-                ++f;
-            }
-            break;
-            default: break;
-        }
+        uint32_t OldCapacity = Map->SlotCapacity;
+        Map->SlotCapacity = NewCapacity;
         
-        // handle each replacement
-        switch (f[0]) {
-#define STBSP__NUMSZ 512 // big enough for e308 (with commas) or e-307
-            char num[STBSP__NUMSZ];
-            char lead[8];
-            char tail[8];
-            char *s;
-            char const *h;
-            stbsp__uint32 l, n, cs;
-            stbsp__uint64 n64;
-#ifndef STB_SPRINTF_NOFLOAT
-            double fv;
-#endif
-            stbsp__int32 dp;
-            char const *sn;
+        if(Map->IncrementalRehash)
+        {
+            ak_allocator* Allocator = Map->Allocator;
+            uint64_t AllocSize = NewCapacity*sizeof(ak__hashmap_slot);
             
-            case 's':
-            // get the string
-            s = va_arg(va, char *);
-            if (s == 0)
-                s = (char *)"null";
-            // get the length, limited to desired precision
-            // always limit to ~0u chars since our counts are 32b
-            l = stbsp__strlen_limited(s, (pr >= 0) ? pr : ~0u);
-            lead[0] = 0;
-            tail[0] = 0;
-            pr = 0;
-            dp = 0;
-            cs = 0;
-            // copy the string in
-            goto scopy;
+            Map->OldSlots = Map->Slots;
+            Map->OldSlotCapacity = OldCapacity;
+            Map->MigrateIndex = 0;
+            Map->Slots = (ak__hashmap_slot*)Allocator->Alloc(AllocSize, Allocator->UserData);
+            AK__Memory_Clear(Map->Slots, AllocSize);
             
-            case 'c': // char
-            // get the character
-            s = num + STBSP__NUMSZ - 1;
-            *s = (char)va_arg(va, int);
-            l = 1;
-            lead[0] = 0;
-            tail[0] = 0;
-            pr = 0;
-            dp = 0;
-            cs = 0;
-            goto scopy;
+            //NOTE(EVERYONE): Flipping the tag moves every existing item into the old table without touching ItemSlots
+            Map->SlotTag ^= AK__HASHMAP_SLOT_TAG_BIT;
+        }
+        else
+        {
+            Map->Slots = AK__HashMap_Realloc_Slots(Map->Slots, Map->ItemSlots, OldCapacity, Map->SlotCapacity, Map->SlotTag, Map->Allocator);
+        }
+    }
+}
+
+//NOTE(EVERYONE): Small maps build their slot table here once Length no longer fits
+template <typename map>
+void AK__HashMap_Grow_Slots(map* Map, uint32_t Length)
+{
+#ifdef AK_HASH_MAP_STATS
+    uint64_t StartCycles = AK__Read_Cycle_Counter();
+    uint64_t StartRehashCycles = Map->Stats.RehashCycles;
+    uint32_t StartCapacity = Map->SlotCapacity;
+#endif
+    
+    if(!Map->Slots)
+    {
+        if(Length > AK_HASH_MAP_SMALL_CAPACITY) AK__HashMap_Promote(Map, Length);
+    }
+    else
+    {
+        AK__HashMap_Resize_Slots(Map, Length);
+    }
+    
+#ifdef AK_HASH_MAP_STATS
+    if(Map->SlotCapacity != StartCapacity)
+    {
+        //NOTE(EVERYONE): Finishing an incremental rehash already counted its cycles, so they are replaced, not added
+        Map->Stats.RehashCount++;
+        Map->Stats.RehashCycles = StartRehashCycles + (AK__Read_Cycle_Counter()-StartCycles);
+    }
+#endif
+}
+
+//NOTE(EVERYONE): Adds a key that the lookup did not find, InsertSlot is the slot that lookup returned. The caller 
+//makes room for one more item first. Returns the index of the new item
+template <typename map, typename key>
+uint32_t AK__HashMap_Insert_Key(map* Map, const key& Key, uint32_t Hash, uint32_t InsertSlot)
+{
+    uint32_t Slot = InsertSlot;
+    if(Map->Length >= AK__HashMap_Get_Max_Length(Map, Map->SlotCapacity))
+    {
+        AK__HashMap_Grow_Slots(Map, Map->Length+1);
+        Slot = AK__HashMap_Probe(Map->Keys, Map->Slots, Map->SlotCapacity, Key, Hash).InsertSlot;
+    }
+    
+    AK_STD_ASSERT(!Map->Slots[Slot].IsValid, "Insert slot is already taken");
+    
+    ak__hashmap_slot* Slots = Map->Slots;
+    Slots[Slot].Hash = Hash;
+    Slots[Slot].ItemIndex = Map->Length;
+    Slots[Slot].IsValid = true;
+    Slots[Hash & (Map->SlotCapacity-1)].BaseCount++;
+    
+    uint32_t Index = Map->Length++;
+    Map->ItemSlots[Index] = Slot | Map->SlotTag;
+    Map->Keys[Index] = Key;
+    
+    AK__HashMap_Migrate_Slots(Map, AK_HASH_MAP_REHASH_STEP);
+    return Index;
+}
+
+//NOTE(EVERYONE): Single entry point for inserting into ak_hashmap. Returns the value of the key, adding a zeroed 
+//item when the key is not in the map yet
+template <typename key, typename value>
+value* AK__HashMap_Find_Or_Insert(ak_hashmap<key, value>* Map, const key& Key, uint32_t Hash, bool* WasInserted)
+{
+    AK_STD_ASSERT(Hash, "Invalid hash");
+    
+    if(!Map->Slots)
+    {
+        int64_t ItemIndex = AK__HashMap_Small_Find(Map, Key, Hash);
+        if(ItemIndex >= 0)
+        {
+            if(WasInserted) *WasInserted = false;
+            return Map->Values + ItemIndex;
+        }
+        
+        if(Map->Length < AK_HASH_MAP_SMALL_CAPACITY)
+        {
+            if(Map->Length >= Map->ItemCapacity)
+                AK__HashMap_Realloc(Map);
             
-            case 'n': // weird write-bytes specifier
-            {
-                int *d = va_arg(va, int *);
-                *d = tlen + (int)(bf - buf);
-            } break;
+            uint32_t Index = Map->Length++;
+            Map->ItemSlots[Index] = Hash;
+            Map->Keys[Index] = Key;
+            AK__Memory_Clear(Map->Values + Index, sizeof(value));
             
-#ifdef STB_SPRINTF_NOFLOAT
-            case 'A':              // float
-            case 'a':              // hex float
-            case 'G':              // float
-            case 'g':              // float
-            case 'E':              // float
-            case 'e':              // float
-            case 'f':              // float
-            va_arg(va, double); // eat it
-            s = (char *)"No float";
-            l = 8;
-            lead[0] = 0;
-            tail[0] = 0;
-            pr = 0;
-            cs = 0;
-            STBSP__NOTUSED(dp);
-            goto scopy;
-#else
-            case 'A': // hex float
-            case 'a': // hex float
-            h = (f[0] == 'A') ? hexu : hex;
-            fv = va_arg(va, double);
-            if (pr == -1)
-                pr = 6; // default is 6
-            // read the double into a string
-            if (stbsp__real_to_parts((stbsp__int64 *)&n64, &dp, fv))
-                fl |= STBSP__NEGATIVE;
-            
-            s = num + 64;
-            
-            stbsp__lead_sign(fl, lead);
-            
-            if (dp == -1023)
-                dp = (n64) ? -1022 : 0;
-            else
-                n64 |= (((stbsp__uint64)1) << 52);
-            n64 <<= (64 - 56);
-            if (pr < 15)
-                n64 += ((((stbsp__uint64)8) << 56) >> (pr * 4));
-            // add leading chars
-            
-#ifdef STB_SPRINTF_MSVC_MODE
-            *s++ = '0';
-            *s++ = 'x';
-#else
-            lead[1 + lead[0]] = '0';
-            lead[2 + lead[0]] = 'x';
-            lead[0] += 2;
-#endif
-            *s++ = h[(n64 >> 60) & 15];
-            n64 <<= 4;
-            if (pr)
-                *s++ = stbsp__period;
-            sn = s;
-            
-            // print the bits
-            n = pr;
-            if (n > 13)
-                n = 13;
-            if (pr > (stbsp__int32)n)
-                tz = pr - n;
-            pr = 0;
-            while (n--) {
-                *s++ = h[(n64 >> 60) & 15];
-                n64 <<= 4;
-            }
-            
-            // print the expo
-            tail[1] = h[17];
-            if (dp < 0) {
-                tail[2] = '-';
-                dp = -dp;
-            } else
-                tail[2] = '+';
-            n = (dp >= 1000) ? 6 : ((dp >= 100) ? 5 : ((dp >= 10) ? 4 : 3));
-            tail[0] = (char)n;
-            for (;;) {
-                tail[n] = '0' + dp % 10;
-                if (n <= 3)
-                    break;
-                --n;
-                dp /= 10;
-            }
-            
-            dp = (int)(s - sn);
-            l = (int)(s - (num + 64));
-            s = num + 64;
-            cs = 1 + (3 << 24);
-            goto scopy;
-            
-            case 'G': // float
-            case 'g': // float
-            h = (f[0] == 'G') ? hexu : hex;
-            fv = va_arg(va, double);
-            if (pr == -1)
-                pr = 6;
-            else if (pr == 0)
-                pr = 1; // default is 6
-            // read the double into a string
-            if (stbsp__real_to_str(&sn, &l, num, &dp, fv, (pr - 1) | 0x80000000))
-                fl |= STBSP__NEGATIVE;
-            
-            // clamp the precision and delete extra zeros after clamp
-            n = pr;
-            if (l > (stbsp__uint32)pr)
-                l = pr;
-            while ((l > 1) && (pr) && (sn[l - 1] == '0')) {
-                --pr;
-                --l;
-            }
-            
-            // should we use %e
-            if ((dp <= -4) || (dp > (stbsp__int32)n)) {
-                if (pr > (stbsp__int32)l)
-                    pr = l - 1;
-                else if (pr)
-                    --pr; // when using %e, there is one digit before the decimal
-                goto doexpfromg;
-            }
-            // this is the insane action to get the pr to match %g semantics for %f
-            if (dp > 0) {
-                pr = (dp < (stbsp__int32)l) ? l - dp : 0;
-            } else {
-                pr = -dp + ((pr > (stbsp__int32)l) ? (stbsp__int32) l : pr);
-            }
-            goto dofloatfromg;
+            if(WasInserted) *WasInserted = true;
+            return Map->Values + Index;
+        }
+        
+        AK__HashMap_Grow_Slots(Map, Map->Length+1);
+    }
+    
+    uint32_t Slot;
+    ak__hashmap_slot* Entry = AK__HashMap_Find_Entry(Map, Key, Hash, &Slot);
+    if(Entry)
+    {
+        if(WasInserted) *WasInserted = false;
+        return Map->Values + Entry->ItemIndex;
+    }
+    
+    if(Map->Length >= Map->ItemCapacity)
+        AK__HashMap_Realloc(Map);
+    
+    uint32_t Index = AK__HashMap_Insert_Key(Map, Key, Hash, Slot);
+    AK__Memory_Clear(Map->Values + Index, sizeof(value));
+    
+    if(WasInserted) *WasInserted = true;
+    return Map->Values + Index;
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Add(const key& Key, const value& Value)
+{
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
+    
+    bool WasInserted;
+    value* Result = AK__HashMap_Find_Or_Insert(this, Key, ak_hash_traits<key>::Hash(Key), &WasInserted);
+    AK_STD_ASSERT(WasInserted, "Cannot insert duplicate keys into hash map");
+    *Result = Value;
+}
+
+template <typename key, typename value>
+value* ak_hashmap<key, value>::Find_Or_Add(const key& Key, bool* WasInserted)
+{
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
+    
+    return AK__HashMap_Find_Or_Insert(this, Key, ak_hash_traits<key>::Hash(Key), WasInserted);
+}
+
+template <typename key, typename value>
+value* ak_hashmap<key, value>::Insert_Or_Assign(const key& Key, const value& Value)
+{
+    value* Result = Find_Or_Add(Key);
+    *Result = Value;
+    return Result;
+}
+
+template <typename key, typename value>
+bool ak_hashmap<key, value>::Try_Add(const key& Key, const value& Value)
+{
+    bool WasInserted;
+    value* Result = Find_Or_Add(Key, &WasInserted);
+    if(WasInserted) *Result = Value;
+    return WasInserted;
+}
+
+template <typename key, typename value>
+value* ak_hashmap<key, value>::Find(const key& Key)
+{
+    return Find_With_Hash(Key, ak_hash_traits<key>::Hash(Key));
+}
+
+template <typename key, typename value>
+template <typename lookup>
+value* ak_hashmap<key, value>::Find_With_Hash(const lookup& Key, uint32_t Hash)
+{
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
+    
+    if(!Slots)
+    {
+        int64_t ItemIndex = AK__HashMap_Small_Find(this, Key, Hash);
+        return (ItemIndex >= 0) ? Values + ItemIndex : NULL;
+    }
+    
+    ak__hashmap_slot* Entry = AK__HashMap_Find_Entry(this, Key, Hash, (uint32_t*)NULL);
+    if(!Entry) return NULL;
+    
+    return Values + Entry->ItemIndex;
+}
+
+template <typename key, typename value>
+template <typename lookup>
+value* ak_hashmap<key, value>::Find_As(const lookup& Key)
+{
+    return Find_With_Hash(Key, ak_hash_traits<key>::Hash(Key));
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Add_With_Hash(const key& Key, const value& Value, uint32_t Hash)
+{
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
+    
+    bool WasInserted;
+    value* Result = AK__HashMap_Find_Or_Insert(this, Key, Hash, &WasInserted);
+    AK_STD_ASSERT(WasInserted, "Cannot insert duplicate keys into hash map");
+    *Result = Value;
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Find_Batch(const key* BatchKeys, uint32_t Count, value** OutValues)
+{
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
+    
+    uint32_t SlotMask = SlotCapacity-1;
+    uint32_t Hashes[AK_HASH_MAP_BATCH_SIZE];
+    
+    for(uint32_t BatchIndex = 0; BatchIndex < Count; BatchIndex += AK_HASH_MAP_BATCH_SIZE)
+    {
+        const key* GroupKeys = BatchKeys + BatchIndex;
+        uint32_t GroupCount = AK__Min(Count-BatchIndex, AK_HASH_MAP_BATCH_SIZE);
+        
+        for(uint32_t Index = 0; Index < GroupCount; Index++)
+            Hashes[Index] = ak_hash_traits<key>::Hash(GroupKeys[Index]);
+        
+        //NOTE(EVERYONE): The base slot usually holds the first item of its run, so its key is the best guess to prefetch
+        if(Slots)
+        {
+            for(uint32_t Index = 0; Index < GroupCount; Index++)
+                AK__Prefetch(Slots + (Hashes[Index] & SlotMask));
             
-            case 'E': // float
-            case 'e': // float
-            h = (f[0] == 'E') ? hexu : hex;
-            fv = va_arg(va, double);
-            if (pr == -1)
-                pr = 6; // default is 6
-            // read the double into a string
-            if (stbsp__real_to_str(&sn, &l, num, &dp, fv, pr | 0x80000000))
-                fl |= STBSP__NEGATIVE;
-            doexpfromg:
-            tail[0] = 0;
-            stbsp__lead_sign(fl, lead);
-            if (dp == STBSP__SPECIAL) {
-                s = (char *)sn;
-                cs = 0;
-                pr = 0;
-                goto scopy;
+            for(uint32_t Index = 0; Index < GroupCount; Index++)
+            {
+                ak__hashmap_slot* BaseSlot = Slots + (Hashes[Index] & SlotMask);
+                if(BaseSlot->IsValid) AK__Prefetch(Keys + BaseSlot->ItemIndex);
             }
-            s = num + 64;
-            // handle leading chars
-            *s++ = sn[0];
+        }
+        
+        for(uint32_t Index = 0; Index < GroupCount; Index++)
+            OutValues[BatchIndex+Index] = Find_With_Hash(GroupKeys[Index], Hashes[Index]);
+    }
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Add_Batch(const key* BatchKeys, const value* BatchValues, uint32_t Count)
+{
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
+    
+    //NOTE(EVERYONE): Grow once up front so the table does not move while a group is prefetched
+    AK__HashMap_Grow_Slots(this, Length+Count);
+    
+    uint32_t SlotMask = SlotCapacity-1;
+    uint32_t Hashes[AK_HASH_MAP_BATCH_SIZE];
+    
+    for(uint32_t BatchIndex = 0; BatchIndex < Count; BatchIndex += AK_HASH_MAP_BATCH_SIZE)
+    {
+        const key* GroupKeys = BatchKeys + BatchIndex;
+        uint32_t GroupCount = AK__Min(Count-BatchIndex, AK_HASH_MAP_BATCH_SIZE);
+        
+        for(uint32_t Index = 0; Index < GroupCount; Index++)
+        {
+            Hashes[Index] = ak_hash_traits<key>::Hash(GroupKeys[Index]);
+            if(Slots) AK__Prefetch(Slots + (Hashes[Index] & SlotMask));
+        }
+        
+        for(uint32_t Index = 0; Index < GroupCount; Index++)
+        {
+            bool WasInserted;
+            value* Value = AK__HashMap_Find_Or_Insert(this, GroupKeys[Index], Hashes[Index], &WasInserted);
+            AK_STD_ASSERT(WasInserted, "Cannot insert duplicate keys into hash map");
+            *Value = BatchValues[BatchIndex+Index];
+        }
+    }
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Reserve(uint32_t Count)
+{
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
+    
+    AK__HashMap_Grow_Slots(this, Count);
+    if(Count > ItemCapacity)
+    {
+        if(AK__HashMap_Realloc_Items(Allocator, Length, Count, &ItemSlots, &Keys, &Values))
+            ItemCapacity = Count;
+    }
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Shrink_To_Fit()
+{
+    if(!ItemSlots) return;
+    
+    AK__HashMap_Migrate_Slots(this, OldSlotCapacity);
+    
+    if(Slots && Length <= AK_HASH_MAP_SMALL_CAPACITY)
+    {
+        //NOTE(EVERYONE): Small enough to drop the slot table, the items go back to holding their hashes
+        for(uint32_t ItemIndex = 0; ItemIndex < Length; ItemIndex++)
+            ItemSlots[ItemIndex] = AK__HashMap_Get_Item_Slot(this, ItemIndex)->Hash;
+        
+        Allocator->Free(Slots, Allocator->UserData);
+        Slots = NULL;
+        SlotCapacity = 0;
+        SlotTag = 0;
+    }
+    
+    if(Slots)
+    {
+        uint32_t NewSlotCapacity = 2;
+        while(Length > AK__HashMap_Get_Max_Length(this, NewSlotCapacity))
+            NewSlotCapacity *= 2;
+        
+        if(NewSlotCapacity < SlotCapacity)
+        {
+#ifdef AK_HASH_MAP_STATS
+            uint64_t StartCycles = AK__Read_Cycle_Counter();
+#endif
             
-            if (pr)
-                *s++ = stbsp__period;
+            Slots = AK__HashMap_Realloc_Slots(Slots, ItemSlots, SlotCapacity, NewSlotCapacity, SlotTag, Allocator);
+            SlotCapacity = NewSlotCapacity;
             
-            // handle after decimal
-            if ((l - 1) > (stbsp__uint32)pr)
-                l = pr + 1;
-            for (n = 1; n < l; n++)
-                *s++ = sn[n];
-            // trailing zeros
-            tz = pr - (l - 1);
-            pr = 0;
-            // dump expo
-            tail[1] = h[0xe];
-            dp -= 1;
-            if (dp < 0) {
-                tail[2] = '-';
-                dp = -dp;
-            } else
-                tail[2] = '+';
-#ifdef STB_SPRINTF_MSVC_MODE
-            n = 5;
-#else
-            n = (dp >= 100) ? 5 : 4;
+#ifdef AK_HASH_MAP_STATS
+            Stats.RehashCount++;
+            Stats.RehashCycles += AK__Read_Cycle_Counter()-StartCycles;
 #endif
-            tail[0] = (char)n;
-            for (;;) {
-                tail[n] = '0' + dp % 10;
-                if (n <= 3)
-                    break;
-                --n;
-                dp /= 10;
-            }
-            cs = 1 + (3 << 24); // how many tens
-            goto flt_lead;
-            
-            case 'f': // float
-            fv = va_arg(va, double);
-            doafloat:
-            // do kilos
-            if (fl & STBSP__METRIC_SUFFIX) {
-                double divisor;
-                divisor = 1000.0f;
-                if (fl & STBSP__METRIC_1024)
-                    divisor = 1024.0;
-                while (fl < 0x4000000) {
-                    if ((fv < divisor) && (fv > -divisor))
-                        break;
-                    fv /= divisor;
-                    fl += 0x1000000;
-                }
-            }
-            if (pr == -1)
-                pr = 6; // default is 6
-            // read the double into a string
-            if (stbsp__real_to_str(&sn, &l, num, &dp, fv, pr))
-                fl |= STBSP__NEGATIVE;
-            dofloatfromg:
-            tail[0] = 0;
-            stbsp__lead_sign(fl, lead);
-            if (dp == STBSP__SPECIAL) {
-                s = (char *)sn;
-                cs = 0;
-                pr = 0;
-                goto scopy;
-            }
-            s = num + 64;
-            
-            // handle the three decimal varieties
-            if (dp <= 0) {
-                stbsp__int32 i;
-                // handle 0.000*000xxxx
-                *s++ = '0';
-                if (pr)
-                    *s++ = stbsp__period;
-                n = -dp;
-                if ((stbsp__int32)n > pr)
-                    n = pr;
-                i = n;
-                while (i) {
-                    if ((((stbsp__uintptr)s) & 3) == 0)
-                        break;
-                    *s++ = '0';
-                    --i;
-                }
-                while (i >= 4) {
-                    *(stbsp__uint32 *)s = 0x30303030;
-                    s += 4;
-                    i -= 4;
-                }
-                while (i) {
-                    *s++ = '0';
-                    --i;
-                }
-                if ((stbsp__int32)(l + n) > pr)
-                    l = pr - n;
-                i = l;
-                while (i) {
-                    *s++ = *sn++;
-                    --i;
-                }
-                tz = pr - (n + l);
-                cs = 1 + (3 << 24); // how many tens did we write (for commas below)
-            } else {
-                cs = (fl & STBSP__TRIPLET_COMMA) ? ((600 - (stbsp__uint32)dp) % 3) : 0;
-                if ((stbsp__uint32)dp >= l) {
-                    // handle xxxx000*000.0
-                    n = 0;
-                    for (;;) {
-                        if ((fl & STBSP__TRIPLET_COMMA) && (++cs == 4)) {
-                            cs = 0;
-                            *s++ = stbsp__comma;
-                        } else {
-                            *s++ = sn[n];
-                            ++n;
-                            if (n >= l)
-                                break;
-                        }
-                    }
-                    if (n < (stbsp__uint32)dp) {
-                        n = dp - n;
-                        if ((fl & STBSP__TRIPLET_COMMA) == 0) {
-                            while (n) {
-                                if ((((stbsp__uintptr)s) & 3) == 0)
-                                    break;
-                                *s++ = '0';
-                                --n;
-                            }
-                            while (n >= 4) {
-                                *(stbsp__uint32 *)s = 0x30303030;
-                                s += 4;
-                                n -= 4;
-                            }
-                        }
-                        while (n) {
-                            if ((fl & STBSP__TRIPLET_COMMA) && (++cs == 4)) {
-                                cs = 0;
-                                *s++ = stbsp__comma;
-                            } else {
-                                *s++ = '0';
-                                --n;
-                            }
-                        }
-                    }
-                    cs = (int)(s - (num + 64)) + (3 << 24); // cs is how many tens
-                    if (pr) {
-                        *s++ = stbsp__period;
-                        tz = pr;
-                    }
-                } else {
-                    // handle xxxxx.xxxx000*000
-                    n = 0;
-                    for (;;) {
-                        if ((fl & STBSP__TRIPLET_COMMA) && (++cs == 4)) {
-                            cs = 0;
-                            *s++ = stbsp__comma;
-                        } else {
-                            *s++ = sn[n];
-                            ++n;
-                            if (n >= (stbsp__uint32)dp)
-                                break;
-                        }
-                    }
-                    cs = (int)(s - (num + 64)) + (3 << 24); // cs is how many tens
-                    if (pr)
-                        *s++ = stbsp__period;
-                    if ((l - dp) > (stbsp__uint32)pr)
-                        l = pr + dp;
-                    while (n < l) {
-                        *s++ = sn[n];
-                        ++n;
-                    }
-                    tz = pr - (l - dp);
-                }
-            }
-            pr = 0;
-            
-            // handle k,m,g,t
-            if (fl & STBSP__METRIC_SUFFIX) {
-                char idx;
-                idx = 1;
-                if (fl & STBSP__METRIC_NOSPACE)
-                    idx = 0;
-                tail[0] = idx;
-                tail[1] = ' ';
-                {
-                    if (fl >> 24) { // SI kilo is 'k', JEDEC and SI kibits are 'K'.
-                        if (fl & STBSP__METRIC_1024)
-                            tail[idx + 1] = "_KMGT"[fl >> 24];
-                        else
-                            tail[idx + 1] = "_kMGT"[fl >> 24];
-                        idx++;
-                        // If printing kibits and not in jedec, add the 'i'.
-                        if (fl & STBSP__METRIC_1024 && !(fl & STBSP__METRIC_JEDEC)) {
-                            tail[idx + 1] = 'i';
-                            idx++;
-                        }
-                        tail[0] = idx;
-                    }
-                }
-            };
-            
-            flt_lead:
-            // get the length that we copied
-            l = (stbsp__uint32)(s - (num + 64));
-            s = num + 64;
-            goto scopy;
-#endif
-            
-            case 'B': // upper binary
-            case 'b': // lower binary
-            h = (f[0] == 'B') ? hexu : hex;
-            lead[0] = 0;
-            if (fl & STBSP__LEADING_0X) {
-                lead[0] = 2;
-                lead[1] = '0';
-                lead[2] = h[0xb];
-            }
-            l = (8 << 4) | (1 << 8);
-            goto radixnum;
-            
-            case 'o': // octal
-            h = hexu;
-            lead[0] = 0;
-            if (fl & STBSP__LEADING_0X) {
-                lead[0] = 1;
-                lead[1] = '0';
-            }
-            l = (3 << 4) | (3 << 8);
-            goto radixnum;
-            
-            case 'p': // pointer
-            fl |= (sizeof(void *) == 8) ? STBSP__INTMAX : 0;
-            pr = sizeof(void *) * 2;
-            fl &= ~STBSP__LEADINGZERO; // 'p' only prints the pointer with zeros
-            // fall through - to X
-            
-            case 'X': // upper hex
-            case 'x': // lower hex
-            h = (f[0] == 'X') ? hexu : hex;
-            l = (4 << 4) | (4 << 8);
-            lead[0] = 0;
-            if (fl & STBSP__LEADING_0X) {
-                lead[0] = 2;
-                lead[1] = '0';
-                lead[2] = h[16];
-            }
-            radixnum:
-            // get the number
-            if (fl & STBSP__INTMAX)
-                n64 = va_arg(va, stbsp__uint64);
-            else
-                n64 = va_arg(va, stbsp__uint32);
-            
-            s = num + STBSP__NUMSZ;
-            dp = 0;
-            // clear tail, and clear leading if value is zero
-            tail[0] = 0;
-            if (n64 == 0) {
-                lead[0] = 0;
-                if (pr == 0) {
-                    l = 0;
-                    cs = 0;
-                    goto scopy;
-                }
-            }
-            // convert to string
-            for (;;) {
-                *--s = h[n64 & ((1 << (l >> 8)) - 1)];
-                n64 >>= (l >> 8);
-                if (!((n64) || ((stbsp__int32)((num + STBSP__NUMSZ) - s) < pr)))
-                    break;
-                if (fl & STBSP__TRIPLET_COMMA) {
-                    ++l;
-                    if ((l & 15) == ((l >> 4) & 15)) {
-                        l &= ~15;
-                        *--s = stbsp__comma;
-                    }
-                }
-            };
-            // get the tens and the comma pos
-            cs = (stbsp__uint32)((num + STBSP__NUMSZ) - s) + ((((l >> 4) & 15)) << 24);
-            // get the length that we copied
-            l = (stbsp__uint32)((num + STBSP__NUMSZ) - s);
-            // copy it
-            goto scopy;
-            
-            case 'u': // unsigned
-            case 'i':
-            case 'd': // integer
-            // get the integer and abs it
-            if (fl & STBSP__INTMAX) {
-                stbsp__int64 i64 = va_arg(va, stbsp__int64);
-                n64 = (stbsp__uint64)i64;
-                if ((f[0] != 'u') && (i64 < 0)) {
-                    n64 = (stbsp__uint64)-i64;
-                    fl |= STBSP__NEGATIVE;
-                }
-            } else {
-                stbsp__int32 i = va_arg(va, stbsp__int32);
-                n64 = (stbsp__uint32)i;
-                if ((f[0] != 'u') && (i < 0)) {
-                    n64 = (stbsp__uint32)-i;
-                    fl |= STBSP__NEGATIVE;
-                }
-            }
-            
-#ifndef STB_SPRINTF_NOFLOAT
-            if (fl & STBSP__METRIC_SUFFIX) {
-                if (n64 < 1024)
-                    pr = 0;
-                else if (pr == -1)
-                    pr = 1;
-                fv = (double)(stbsp__int64)n64;
-                goto doafloat;
+        }
+    }
+    
+    uint32_t NewItemCapacity = AK__Max(Length, 1);
+    if(NewItemCapacity < ItemCapacity)
+    {
+        if(AK__HashMap_Realloc_Items(Allocator, Length, NewItemCapacity, &ItemSlots, &Keys, &Values))
+            ItemCapacity = NewItemCapacity;
+    }
+}
+
+//NOTE(EVERYONE): Frees the slot and moves the last key into the removed item. Returns the removed item index, the 
+//caller moves any per item data of its own the same way
+template <typename map>
+uint32_t AK__HashMap_Remove_Slot(map* Map, ak__hashmap_slot* Entry)
+{
+    bool IsOld = Map->OldSlots && Entry >= Map->OldSlots && Entry < Map->OldSlots+Map->OldSlotCapacity;
+    ak__hashmap_slot* Table = IsOld ? Map->OldSlots : Map->Slots;
+    uint32_t TableMask = (IsOld ? Map->OldSlotCapacity : Map->SlotCapacity)-1;
+    
+    Table[Entry->Hash & TableMask].BaseCount--;
+    Entry->Hash = 0;
+    Entry->IsValid = false;
+    
+    uint32_t Index = Entry->ItemIndex;
+    uint32_t LastIndex = Map->Length-1;
+    
+    if(Index != LastIndex)
+    {
+        Map->Keys[Index] = Map->Keys[LastIndex];
+        Map->ItemSlots[Index] = Map->ItemSlots[LastIndex];
+        AK__HashMap_Get_Item_Slot(Map, Index)->ItemIndex = Index;
+    }
+    
+    Map->Length--;
+    return Index;
+}
+
+template <typename key, typename value>
+void AK__HashMap_Remove_Entry(ak_hashmap<key, value>* Map, ak__hashmap_slot* Entry)
+{
+    uint32_t Index = AK__HashMap_Remove_Slot(Map, Entry);
+    if(Index != Map->Length) Map->Values[Index] = Map->Values[Map->Length];
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Remove(const key& Key)
+{
+    Remove_With_Hash(Key, ak_hash_traits<key>::Hash(Key));
+}
+
+//NOTE(EVERYONE): Single entry point for removing from ak_hashmap, for small maps and maps with a slot table alike. 
+//Returns false when the key is not in the map
+template <typename key, typename value>
+bool AK__HashMap_Remove_Key(ak_hashmap<key, value>* Map, const key& Key, uint32_t Hash)
+{
+    if(!Map->Slots)
+    {
+        int64_t ItemIndex = AK__HashMap_Small_Find(Map, Key, Hash);
+        if(ItemIndex < 0) return false;
+        
+        uint32_t LastIndex = --Map->Length;
+        if((uint32_t)ItemIndex != LastIndex)
+        {
+            Map->Keys[ItemIndex] = Map->Keys[LastIndex];
+            Map->ItemSlots[ItemIndex] = Map->ItemSlots[LastIndex];
+            Map->Values[ItemIndex] = Map->Values[LastIndex];
+        }
+        return true;
+    }
+    
+    ak__hashmap_slot* Entry = AK__HashMap_Find_Entry(Map, Key, Hash, (uint32_t*)NULL);
+    if(!Entry) return false;
+    
+    AK__HashMap_Remove_Entry(Map, Entry);
+    AK__HashMap_Migrate_Slots(Map, AK_HASH_MAP_REHASH_STEP);
+    return true;
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Remove_With_Hash(const key& Key, uint32_t Hash)
+{
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
+    
+    bool WasRemoved = AK__HashMap_Remove_Key(this, Key, Hash);
+    AK_STD_ASSERT(WasRemoved, "Cannot find entry with key in hash map");
+}
+
+template <typename key, typename value>
+void ak_hashmap<key, value>::Clear()
+{
+    if(OldSlots)
+    {
+        Allocator->Free(OldSlots, Allocator->UserData);
+        OldSlots = NULL;
+        OldSlotCapacity = 0;
+        MigrateIndex = 0;
+    }
+    
+    //NOTE(EVERYONE): A map that grew large once and is reused with a few entries should not pay for clearing the 
+    //whole table. Only the slots of live items, and the base counts at their home slots, are ever non zero, so those 
+    //are reset directly unless the table is dense enough that a sequential clear is cheaper. Item memory is left as is
+    if(Slots && ItemSlots)
+    {
+        if(Length*4 < SlotCapacity)
+        {
+            uint32_t SlotMask = SlotCapacity-1;
+            for(uint32_t ItemIndex = 0; ItemIndex < Length; ItemIndex++)
+            {
+                uint32_t ItemSlot = ItemSlots[ItemIndex];
+                if((ItemSlot & AK__HASHMAP_SLOT_TAG_BIT) != SlotTag) continue;
+                
+                ak__hashmap_slot* Slot = Slots + (ItemSlot & ~AK__HASHMAP_SLOT_TAG_BIT);
+                Slots[Slot->Hash & SlotMask].BaseCount = 0;
+                *Slot = {};
             }
+        }
+        else
+        {
+            AK__Memory_Clear(Slots, SlotCapacity*sizeof(ak__hashmap_slot));
+        }
+    }
+    
+    Length = 0;
+    SlotTag = 0;
+}
+
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_hashmap<key, value>::begin() const
+{
+    return AK__HashMap_Begin<key, value>(Keys, Values, &Length);
+}
+
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_hashmap<key, value>::end() const
+{
+    return {};
+}
+
+template <typename key, typename value> 
+ak_hashmap<key, value>  AK_Create_Hash_Map(uint32_t InitialSlotCapacity, uint32_t InitialItemCapacity, ak_allocator* Allocator)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    
+    ak_hashmap<key, value> Result = {};
+    Result.Allocator = Allocator;
+    Result.ItemCapacity = InitialItemCapacity;
+    
+    //NOTE(EVERYONE): Maps sized for only a few items start out small, without a slot table
+    if(InitialItemCapacity > AK_HASH_MAP_SMALL_CAPACITY)
+    {
+        Result.SlotCapacity = (uint32_t)AK__Ceil_Pow2(InitialSlotCapacity);
+        Result.Slots = (ak__hashmap_slot*)Allocator->Alloc(sizeof(ak__hashmap_slot)*Result.SlotCapacity, Allocator->UserData);
+        AK__Memory_Clear(Result.Slots, sizeof(ak__hashmap_slot)*Result.SlotCapacity);
+    }
+    
+    AK__HashMap_Realloc_Items(Allocator, 0, Result.ItemCapacity, &Result.ItemSlots, &Result.Keys, &Result.Values);
+    
+    return Result;
+}
+
+template <typename key, typename value>
+void AK_Delete(ak_hashmap<key, value>* HashMap)
+{
+    if(HashMap)
+    {
+        if(HashMap->OldSlots) HashMap->Allocator->Free(HashMap->OldSlots, HashMap->Allocator->UserData);
+        if(HashMap->Slots) HashMap->Allocator->Free(HashMap->Slots, HashMap->Allocator->UserData);
+        HashMap->Allocator->Free(HashMap->ItemSlots, HashMap->Allocator->UserData);
+    }
+}
+
+#ifdef AK_HASH_MAP_STATS
+template <typename key, typename value>
+ak_hashmap_stats AK_Get_Hash_Map_Stats(const ak_hashmap<key, value>* Map)
+{
+    ak_hashmap_stats Result = Map->Stats;
+    Result.Length = Map->Length;
+    Result.SlotCapacity = Map->SlotCapacity;
+    Result.LoadFactor = Map->SlotCapacity ? (float)Map->Length/(float)Map->SlotCapacity : 0.0f;
+    Result.MaxClusterLength = 0;
+    AK__Memory_Clear(Result.BaseCounts, sizeof(Result.BaseCounts));
+    
+    if(Map->Slots)
+    {
+        //NOTE(EVERYONE): Start right after a free slot so a cluster wrapping around the end is counted once. There 
+        //always is a free slot since the load factor keeps one
+        uint32_t SlotMask = Map->SlotCapacity-1;
+        uint32_t FreeSlot = 0;
+        while(Map->Slots[FreeSlot].IsValid) FreeSlot++;
+        
+        uint32_t ClusterLength = 0;
+        for(uint32_t Index = 1; Index <= Map->SlotCapacity; Index++)
+        {
+            const ak__hashmap_slot* Slot = Map->Slots + ((FreeSlot+Index) & SlotMask);
+            ClusterLength = Slot->IsValid ? ClusterLength+1 : 0;
+            Result.MaxClusterLength = AK__Max(Result.MaxClusterLength, ClusterLength);
+            Result.BaseCounts[AK__Min(Slot->BaseCount, AK_HASH_MAP_STATS_BUCKET_COUNT-1)]++;
+        }
+    }
+    
+    return Result;
+}
+
+static void AK__Hash_Map_Stats_Histogram_Text(ak_str8_list* List, ak_arena* Arena, const char* Name, const uint64_t* Buckets, uint32_t FirstValue)
+{
+    List->Format(Arena, "%s:\n", Name);
+    for(uint32_t Index = 0; Index < AK_HASH_MAP_STATS_BUCKET_COUNT; Index++)
+    {
+        const char* Suffix = (Index == AK_HASH_MAP_STATS_BUCKET_COUNT-1) ? "+" : "";
+        List->Format(Arena, "  %u%s: %llu\n", FirstValue+Index, Suffix, (unsigned long long)Buckets[Index]);
+    }
+}
+
+static void AK__Hash_Map_Stats_Histogram_JSON(ak_str8_list* List, ak_arena* Arena, const char* Name, const uint64_t* Buckets)
+{
+    List->Format(Arena, ",\"%s\":[", Name);
+    for(uint32_t Index = 0; Index < AK_HASH_MAP_STATS_BUCKET_COUNT; Index++)
+        List->Format(Arena, Index ? ",%llu" : "%llu", (unsigned long long)Buckets[Index]);
+    List->Push(AK_Str8_Lit("]"), Arena);
+}
+
+ak_str8 AK_Hash_Map_Stats_To_Text(const ak_hashmap_stats& Stats, ak_arena* Arena)
+{
+    ak_str8_list List = {};
+    List.Format(Arena, "Length: %u\nSlot capacity: %u\nLoad factor: %.3f\n", Stats.Length, Stats.SlotCapacity, (double)Stats.LoadFactor);
+    List.Format(Arena, "Hits: %llu\nMisses: %llu\nMax probe length: %u\nMax cluster length: %u\n", 
+                (unsigned long long)Stats.HitCount, (unsigned long long)Stats.MissCount, Stats.MaxProbeLength, Stats.MaxClusterLength);
+    List.Format(Arena, "Rehashes: %u\nRehash cycles: %llu\n", Stats.RehashCount, (unsigned long long)Stats.RehashCycles);
+    AK__Hash_Map_Stats_Histogram_Text(&List, Arena, "Hit probe lengths", Stats.HitProbeLengths, 1);
+    AK__Hash_Map_Stats_Histogram_Text(&List, Arena, "Miss probe lengths", Stats.MissProbeLengths, 1);
+    AK__Hash_Map_Stats_Histogram_Text(&List, Arena, "Base counts", Stats.BaseCounts, 0);
+    return List.Join(Arena);
+}
+
+ak_str8 AK_Hash_Map_Stats_To_JSON(const ak_hashmap_stats& Stats, ak_arena* Arena)
+{
+    ak_str8_list List = {};
+    List.Format(Arena, "{\"length\":%u,\"slot_capacity\":%u,\"load_factor\":%.4f", Stats.Length, Stats.SlotCapacity, (double)Stats.LoadFactor);
+    List.Format(Arena, ",\"hits\":%llu,\"misses\":%llu,\"max_probe_length\":%u,\"max_cluster_length\":%u", 
+                (unsigned long long)Stats.HitCount, (unsigned long long)Stats.MissCount, Stats.MaxProbeLength, Stats.MaxClusterLength);
+    List.Format(Arena, ",\"rehash_count\":%u,\"rehash_cycles\":%llu", Stats.RehashCount, (unsigned long long)Stats.RehashCycles);
+    AK__Hash_Map_Stats_Histogram_JSON(&List, Arena, "hit_probe_lengths", Stats.HitProbeLengths);
+    AK__Hash_Map_Stats_Histogram_JSON(&List, Arena, "miss_probe_lengths", Stats.MissProbeLengths);
+    AK__Hash_Map_Stats_Histogram_JSON(&List, Arena, "base_counts", Stats.BaseCounts);
+    List.Push(AK_Str8_Lit("}"), Arena);
+    return List.Join(Arena);
+}
 #endif
-            
-            // convert to string
-            s = num + STBSP__NUMSZ;
-            l = 0;
-            
-            for (;;) {
-                // do in 32-bit chunks (avoid lots of 64-bit divides even with constant denominators)
-                char *o = s - 8;
-                if (n64 >= 100000000) {
-                    n = (stbsp__uint32)(n64 % 100000000);
-                    n64 /= 100000000;
-                } else {
-                    n = (stbsp__uint32)n64;
-                    n64 = 0;
-                }
-                if ((fl & STBSP__TRIPLET_COMMA) == 0) {
-                    do {
-                        s -= 2;
-                        *(stbsp__uint16 *)s = *(stbsp__uint16 *)&stbsp__digitpair.pair[(n % 100) * 2];
-                        n /= 100;
-                    } while (n);
-                }
-                while (n) {
-                    if ((fl & STBSP__TRIPLET_COMMA) && (l++ == 3)) {
-                        l = 0;
-                        *--s = stbsp__comma;
-                        --o;
-                    } else {
-                        *--s = (char)(n % 10) + '0';
-                        n /= 10;
-                    }
-                }
-                if (n64 == 0) {
-                    if ((s[0] == '0') && (s != (num + STBSP__NUMSZ)))
-                        ++s;
-                    break;
-                }
-                while (s != o)
-                    if ((fl & STBSP__TRIPLET_COMMA) && (l++ == 3)) {
-                    l = 0;
-                    *--s = stbsp__comma;
-                    --o;
-                } else {
-                    *--s = '0';
-                }
-            }
-            
-            tail[0] = 0;
-            stbsp__lead_sign(fl, lead);
-            
-            // get the length that we copied
-            l = (stbsp__uint32)((num + STBSP__NUMSZ) - s);
-            if (l == 0) {
-                *--s = '0';
-                l = 1;
-            }
-            cs = l + (3 << 24);
-            if (pr < 0)
-                pr = 0;
-            
-            scopy:
-            // get fw=leading/trailing space, pr=leading zeros
-            if (pr < (stbsp__int32)l)
-                pr = l;
-            n = pr + lead[0] + tail[0] + tz;
-            if (fw < (stbsp__int32)n)
-                fw = n;
-            fw -= n;
-            pr -= l;
-            
-            // handle right justify and leading zeros
-            if ((fl & STBSP__LEFTJUST) == 0) {
-                if (fl & STBSP__LEADINGZERO) // if leading zeros, everything is in pr
-                {
-                    pr = (fw > pr) ? fw : pr;
-                    fw = 0;
-                } else {
-                    fl &= ~STBSP__TRIPLET_COMMA; // if no leading zeros, then no commas
-                }
-            }
-            
-            // copy the spaces and/or zeros
-            if (fw + pr) {
-                stbsp__int32 i;
-                stbsp__uint32 c;
-                
-                // copy leading spaces (or when doing %8.4d stuff)
-                if ((fl & STBSP__LEFTJUST) == 0)
-                    while (fw > 0) {
-                    stbsp__cb_buf_clamp(i, fw);
-                    fw -= i;
-                    while (i) {
-                        if ((((stbsp__uintptr)bf) & 3) == 0)
-                            break;
-                        *bf++ = ' ';
-                        --i;
-                    }
-                    while (i >= 4) {
-                        *(stbsp__uint32 *)bf = 0x20202020;
-                        bf += 4;
-                        i -= 4;
-                    }
-                    while (i) {
-                        *bf++ = ' ';
-                        --i;
-                    }
-                    stbsp__chk_cb_buf(1);
-                }
-                
-                // copy leader
-                sn = lead + 1;
-                while (lead[0]) {
-                    stbsp__cb_buf_clamp(i, lead[0]);
-                    lead[0] -= (char)i;
-                    while (i) {
-                        *bf++ = *sn++;
-                        --i;
-                    }
-                    stbsp__chk_cb_buf(1);
-                }
-                
-                // copy leading zeros
-                c = cs >> 24;
-                cs &= 0xffffff;
-                cs = (fl & STBSP__TRIPLET_COMMA) ? ((stbsp__uint32)(c - ((pr + cs) % (c + 1)))) : 0;
-                while (pr > 0) {
-                    stbsp__cb_buf_clamp(i, pr);
-                    pr -= i;
-                    if ((fl & STBSP__TRIPLET_COMMA) == 0) {
-                        while (i) {
-                            if ((((stbsp__uintptr)bf) & 3) == 0)
-                                break;
-                            *bf++ = '0';
-                            --i;
-                        }
-                        while (i >= 4) {
-                            *(stbsp__uint32 *)bf = 0x30303030;
-                            bf += 4;
-                            i -= 4;
-                        }
-                    }
-                    while (i) {
-                        if ((fl & STBSP__TRIPLET_COMMA) && (cs++ == c)) {
-                            cs = 0;
-                            *bf++ = stbsp__comma;
-                        } else
-                            *bf++ = '0';
-                        --i;
-                    }
-                    stbsp__chk_cb_buf(1);
-                }
-            }
-            
-            // copy leader if there is still one
-            sn = lead + 1;
-            while (lead[0]) {
-                stbsp__int32 i;
-                stbsp__cb_buf_clamp(i, lead[0]);
-                lead[0] -= (char)i;
-                while (i) {
-                    *bf++ = *sn++;
-                    --i;
-                }
-                stbsp__chk_cb_buf(1);
-            }
-            
-            // copy the string
-            n = l;
-            while (n) {
-                stbsp__int32 i;
-                stbsp__cb_buf_clamp(i, n);
-                n -= i;
-                STBSP__UNALIGNED(while (i >= 4) {
-                                     *(stbsp__uint32 volatile *)bf = *(stbsp__uint32 volatile *)s;
-                                     bf += 4;
-                                     s += 4;
-                                     i -= 4;
-                                 })
-                    while (i) {
-                    *bf++ = *s++;
-                    --i;
-                }
-                stbsp__chk_cb_buf(1);
-            }
-            
-            // copy trailing zeros
-            while (tz) {
-                stbsp__int32 i;
-                stbsp__cb_buf_clamp(i, tz);
-                tz -= i;
-                while (i) {
-                    if ((((stbsp__uintptr)bf) & 3) == 0)
-                        break;
-                    *bf++ = '0';
-                    --i;
-                }
-                while (i >= 4) {
-                    *(stbsp__uint32 *)bf = 0x30303030;
-                    bf += 4;
-                    i -= 4;
-                }
-                while (i) {
-                    *bf++ = '0';
-                    --i;
-                }
-                stbsp__chk_cb_buf(1);
-            }
-            
-            // copy tail if there is one
-            sn = tail + 1;
-            while (tail[0]) {
-                stbsp__int32 i;
-                stbsp__cb_buf_clamp(i, tail[0]);
-                tail[0] -= (char)i;
-                while (i) {
-                    *bf++ = *sn++;
-                    --i;
-                }
-                stbsp__chk_cb_buf(1);
-            }
-            
-            // handle the left justify
-            if (fl & STBSP__LEFTJUST)
-                if (fw > 0) {
-                while (fw) {
-                    stbsp__int32 i;
-                    stbsp__cb_buf_clamp(i, fw);
-                    fw -= i;
-                    while (i) {
-                        if ((((stbsp__uintptr)bf) & 3) == 0)
-                            break;
-                        *bf++ = ' ';
-                        --i;
-                    }
-                    while (i >= 4) {
-                        *(stbsp__uint32 *)bf = 0x20202020;
-                        bf += 4;
-                        i -= 4;
-                    }
-                    while (i--)
-                        *bf++ = ' ';
-                    stbsp__chk_cb_buf(1);
-                }
-            }
-            break;
-            
-            default: // unknown, just copy code
-            s = num + STBSP__NUMSZ - 1;
-            *s = f[0];
-            l = 1;
-            fw = fl = 0;
-            lead[0] = 0;
-            tail[0] = 0;
-            pr = 0;
-            dp = 0;
-            cs = 0;
-            goto scopy;
-        }
-        ++f;
-    }
-    endfmt:
-    
-    if (!callback)
-        *bf = 0;
-    else
-        stbsp__flush_cb();
-    
-    done:
-    return tlen + (int)(bf - buf);
-}
-
-// cleanup
-#undef STBSP__LEFTJUST
-#undef STBSP__LEADINGPLUS
-#undef STBSP__LEADINGSPACE
-#undef STBSP__LEADING_0X
-#undef STBSP__LEADINGZERO
-#undef STBSP__INTMAX
-#undef STBSP__TRIPLET_COMMA
-#undef STBSP__NEGATIVE
-#undef STBSP__METRIC_SUFFIX
-#undef STBSP__NUMSZ
-#undef stbsp__chk_cb_bufL
-#undef stbsp__chk_cb_buf
-#undef stbsp__flush_cb
-#undef stbsp__cb_buf_clamp
-
-// ============================================================================
-//   wrapper functions
 
-STBSP__PUBLICDEF int STB_SPRINTF_DECORATE(sprintf)(char *buf, char const *fmt, ...)
+uint64_t AK__Hash64_Read64(const uint8_t* Ptr)
 {
-    int result;
-    va_list va;
-    va_start(va, fmt);
-    result = STB_SPRINTF_DECORATE(vsprintfcb)(0, 0, buf, fmt, va);
-    va_end(va);
-    return result;
+    uint64_t Result;
+    AK__Memory_Copy(&Result, Ptr, sizeof(uint64_t));
+    return Result;
 }
 
-typedef struct stbsp__context {
-    char *buf;
-    int count;
-    int length;
-    char tmp[STB_SPRINTF_MIN];
-} stbsp__context;
-
-static char *stbsp__clamp_callback(const char *buf, void *user, int len)
+uint64_t AK__Hash64_Read32(const uint8_t* Ptr)
 {
-    stbsp__context *c = (stbsp__context *)user;
-    c->length += len;
-    
-    if (len > c->count)
-        len = c->count;
-    
-    if (len) {
-        if (buf != c->buf) {
-            const char *s, *se;
-            char *d;
-            d = c->buf;
-            s = buf;
-            se = buf + len;
-            do {
-                *d++ = *s++;
-            } while (s < se);
-        }
-        c->buf += len;
-        c->count -= len;
-    }
-    
-    if (c->count <= 0)
-        return c->tmp;
-    return (c->count >= STB_SPRINTF_MIN) ? c->buf : c->tmp; // go direct into buffer if you can
+    uint32_t Result;
+    AK__Memory_Copy(&Result, Ptr, sizeof(uint32_t));
+    return Result;
 }
 
-static char * stbsp__count_clamp_callback( const char * buf, void * user, int len )
+//NOTE(EVERYONE): Full 128 bit product of A and B, folded together with an xor
+uint64_t AK__Hash64_Mix(uint64_t A, uint64_t B)
 {
-    stbsp__context * c = (stbsp__context*)user;
-    (void) sizeof(buf);
-    
-    c->length += len;
-    return c->tmp; // go direct into buffer if you can
+    return (A*B) ^ AK__Mul_Hi64(A, B);
 }
 
-STBSP__PUBLICDEF int STB_SPRINTF_DECORATE( vsnprintf )( char * buf, int count, char const * fmt, va_list va )
+uint64_t AK_Hash64(const void* Data, uint64_t Length, uint64_t Seed)
 {
-    stbsp__context c;
+    const uint8_t* At = (const uint8_t*)Data;
+    const uint64_t* Secret = AK__Hash64_Secret;
     
-    if ( (count == 0) && !buf )
+    Seed ^= AK__Hash64_Mix(Seed ^ Secret[0], Secret[1]);
+    
+    uint64_t A, B;
+    if(Length <= 16)
     {
-        c.length = 0;
-        
-        STB_SPRINTF_DECORATE( vsprintfcb )( stbsp__count_clamp_callback, &c, c.tmp, fmt, va );
+        if(Length >= 4)
+        {
+            uint64_t Offset = (Length >> 3) << 2;
+            A = (AK__Hash64_Read32(At) << 32) | AK__Hash64_Read32(At + Offset);
+            B = (AK__Hash64_Read32(At + Length - 4) << 32) | AK__Hash64_Read32(At + Length - 4 - Offset);
+        }
+        else if(Length > 0)
+        {
+            A = ((uint64_t)At[0] << 16) | ((uint64_t)At[Length >> 1] << 8) | At[Length-1];
+            B = 0;
+        }
+        else
+        {
+            A = B = 0;
+        }
     }
     else
     {
-        int l;
+        uint64_t Remaining = Length;
+        if(Remaining > 48)
+        {
+            //NOTE(EVERYONE): Three independent lanes so the multiplies of one step overlap
+            uint64_t Seed1 = Seed;
+            uint64_t Seed2 = Seed;
+            do
+            {
+                Seed  = AK__Hash64_Mix(AK__Hash64_Read64(At) ^ Secret[1], AK__Hash64_Read64(At + 8) ^ Seed);
+                Seed1 = AK__Hash64_Mix(AK__Hash64_Read64(At + 16) ^ Secret[2], AK__Hash64_Read64(At + 24) ^ Seed1);
+                Seed2 = AK__Hash64_Mix(AK__Hash64_Read64(At + 32) ^ Secret[3], AK__Hash64_Read64(At + 40) ^ Seed2);
+                At += 48;
+                Remaining -= 48;
+            } while(Remaining > 48);
+            Seed ^= Seed1 ^ Seed2;
+        }
         
-        c.buf = buf;
-        c.count = count;
-        c.length = 0;
-        
-        STB_SPRINTF_DECORATE( vsprintfcb )( stbsp__clamp_callback, &c, stbsp__clamp_callback(0,&c,0), fmt, va );
+        while(Remaining > 16)
+        {
+            Seed = AK__Hash64_Mix(AK__Hash64_Read64(At) ^ Secret[1], AK__Hash64_Read64(At + 8) ^ Seed);
+            At += 16;
+            Remaining -= 16;
+        }
         
-        // zero-terminate
-        l = (int)( c.buf - buf );
-        if ( l >= count ) // should never be greater, only equal (or less) than count
-            l = count - 1;
-        buf[l] = 0;
+        A = AK__Hash64_Read64(At + Remaining - 16);
+        B = AK__Hash64_Read64(At + Remaining - 8);
     }
     
-    return c.length;
+    A ^= Secret[1];
+    B ^= Seed;
+    
+    uint64_t Low = A*B;
+    uint64_t High = AK__Mul_Hi64(A, B);
+    return AK__Hash64_Mix(Low ^ Secret[0] ^ Length, High ^ Secret[1]);
 }
 
-STBSP__PUBLICDEF int STB_SPRINTF_DECORATE(snprintf)(char *buf, int count, char const *fmt, ...)
+#ifndef AK__SSE42
+struct ak__crc32c_table
 {
-    int result;
-    va_list va;
-    va_start(va, fmt);
-    
-    result = STB_SPRINTF_DECORATE(vsnprintf)(buf, count, fmt, va);
-    va_end(va);
+    uint32_t Entries[256];
+};
+
+ak__crc32c_table AK__Build_CRC32C_Table()
+{
+    ak__crc32c_table Result;
+    for(uint32_t Index = 0; Index < 256; Index++)
+    {
+        uint32_t Entry = Index;
+        for(uint32_t Bit = 0; Bit < 8; Bit++)
+            Entry = (Entry >> 1) ^ ((Entry & 1) ? 0x82F63B78u : 0);
+        Result.Entries[Index] = Entry;
+    }
+    return Result;
+}
+
+uint32_t AK__CRC32C_Table(const uint8_t* At, uint64_t Length, uint32_t Result)
+{
+    static const ak__crc32c_table Table = AK__Build_CRC32C_Table();
+    for(; Length; Length--, At++)
+        Result = Table.Entries[(Result ^ *At) & 0xFF] ^ (Result >> 8);
+    return Result;
+}
+#endif
+
+#if defined(AK__SSE42) || defined(AK__SSE42_DISPATCH)
+#if !defined(AK__SSE42) && !defined(_MSC_VER)
+__attribute__((target("sse4.2")))
+#endif
+uint32_t AK__CRC32C_SSE42(const uint8_t* At, uint64_t Length, uint32_t Result)
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    uint64_t Result64 = Result;
+    for(; Length >= 8; Length -= 8, At += 8)
+        Result64 = _mm_crc32_u64(Result64, AK__Hash64_Read64(At));
+    Result = (uint32_t)Result64;
+#endif
+    for(; Length >= 4; Length -= 4, At += 4)
+        Result = _mm_crc32_u32(Result, (uint32_t)AK__Hash64_Read32(At));
+    for(; Length; Length--, At++)
+        Result = _mm_crc32_u8(Result, *At);
+    return Result;
+}
+#endif
+
+#ifdef AK__SSE42_DISPATCH
+bool AK__CPU_Has_SSE42()
+{
+#ifdef _MSC_VER
+    int Info[4];
+    __cpuid(Info, 1);
+    return (Info[2] & (1 << 20)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+#endif
+
+uint32_t AK_Hash_CRC32C(const void* Data, uint64_t Length, uint32_t Seed)
+{
+    const uint8_t* At = (const uint8_t*)Data;
     
-    return result;
+#if defined(AK__SSE42)
+    return ~AK__CRC32C_SSE42(At, Length, ~Seed);
+#elif defined(AK__SSE42_DISPATCH)
+    static const bool HasSSE42 = AK__CPU_Has_SSE42();
+    return HasSSE42 ? ~AK__CRC32C_SSE42(At, Length, ~Seed) : ~AK__CRC32C_Table(At, Length, ~Seed);
+#else
+    return ~AK__CRC32C_Table(At, Length, ~Seed);
+#endif
 }
 
-STBSP__PUBLICDEF int STB_SPRINTF_DECORATE(vsprintf)(char *buf, char const *fmt, va_list va)
+uint32_t AK_Hash_Function(uint32_t Key)
 {
-    return STB_SPRINTF_DECORATE(vsprintfcb)(0, 0, buf, fmt, va);
+    Key = (Key+0x7ed55d16) + (Key<<12);
+    Key = (Key^0xc761c23c) ^ (Key>>19);
+    Key = (Key+0x165667b1) + (Key<<5);
+    Key = (Key+0xd3a2646c) ^ (Key<<9);
+    Key = (Key+0xfd7046c5) + (Key<<3);
+    Key = (Key^0xb55a4f09) ^ (Key>>16);
+    return Key;
 }
 
-// =======================================================================
-//   low level float utility functions
+uint32_t AK_Hash_Function(int32_t Key)
+{
+    return AK_Hash_Function((uint32_t)Key);
+}
 
-#ifndef STB_SPRINTF_NOFLOAT
+uint32_t AK_Hash_Function(uint64_t Key)
+{
+    Key = ( ~Key ) + ( Key << 18 );
+    Key = Key ^ ( Key >> 31 );
+    Key = Key * 21;
+    Key = Key ^ ( Key >> 11 );
+    Key = Key + ( Key << 6 );
+    Key = Key ^ ( Key >> 22 );      
+    return (uint32_t)Key;
+}
 
-// copies d to bits w/ strict aliasing (this compiles to nothing on /Ox)
-#define STBSP__COPYFP(dest, src)                   \
-{                                               \
-int cn;                                      \
-for (cn = 0; cn < 8; cn++)                   \
-((char *)&dest)[cn] = ((char *)&src)[cn]; \
+uint32_t AK_Hash_Function(int64_t Key)
+{
+    return AK_Hash_Function((uint64_t)Key);
 }
 
-// get float info
-static stbsp__int32 stbsp__real_to_parts(stbsp__int64 *bits, stbsp__int32 *expo, double value)
+uint32_t AK_Hash_Function(float Key)
 {
-    double d;
-    stbsp__int64 b = 0;
-    
-    // load value and round at the frac_digits
-    d = value;
-    
-    STBSP__COPYFP(b, d);
+    union
+    {
+        float    F;
+        uint32_t I;
+    } U;
     
-    *bits = b & ((((stbsp__uint64)1) << 52) - 1);
-    *expo = (stbsp__int32)(((b >> 52) & 2047) - 1023);
+    U.F = Key;
+    return AK_Hash_Function(U.I);
+}
+
+uint32_t AK_Hash_Function(double Key)
+{
+    union
+    {
+        double   D;
+        uint64_t I;
+    } U;
     
-    return (stbsp__int32)((stbsp__uint64) b >> 63);
+    U.D = Key;
+    return AK_Hash_Function(U.I);
 }
 
-static double const stbsp__bot[23] = {
-    1e+000, 1e+001, 1e+002, 1e+003, 1e+004, 1e+005, 1e+006, 1e+007, 1e+008, 1e+009, 1e+010, 1e+011,
-    1e+012, 1e+013, 1e+014, 1e+015, 1e+016, 1e+017, 1e+018, 1e+019, 1e+020, 1e+021, 1e+022
-};
-static double const stbsp__negbot[22] = {
-    1e-001, 1e-002, 1e-003, 1e-004, 1e-005, 1e-006, 1e-007, 1e-008, 1e-009, 1e-010, 1e-011,
-    1e-012, 1e-013, 1e-014, 1e-015, 1e-016, 1e-017, 1e-018, 1e-019, 1e-020, 1e-021, 1e-022
-};
-static double const stbsp__negboterr[22] = {
-    -5.551115123125783e-018,  -2.0816681711721684e-019, -2.0816681711721686e-020, -4.7921736023859299e-021, -8.1803053914031305e-022, 4.5251888174113741e-023,
-    4.5251888174113739e-024,  -2.0922560830128471e-025, -6.2281591457779853e-026, -3.6432197315497743e-027, 6.0503030718060191e-028,  2.0113352370744385e-029,
-    -3.0373745563400371e-030, 1.1806906454401013e-032,  -7.7705399876661076e-032, 2.0902213275965398e-033,  -7.1542424054621921e-034, -7.1542424054621926e-035,
-    2.4754073164739869e-036,  5.4846728545790429e-037,  9.2462547772103625e-038,  -4.8596774326570872e-039
-};
-static double const stbsp__top[13] = {
-    1e+023, 1e+046, 1e+069, 1e+092, 1e+115, 1e+138, 1e+161, 1e+184, 1e+207, 1e+230, 1e+253, 1e+276, 1e+299
-};
-static double const stbsp__negtop[13] = {
-    1e-023, 1e-046, 1e-069, 1e-092, 1e-115, 1e-138, 1e-161, 1e-184, 1e-207, 1e-230, 1e-253, 1e-276, 1e-299
-};
-static double const stbsp__toperr[13] = {
-    8388608,
-    6.8601809640529717e+028,
-    -7.253143638152921e+052,
-    -4.3377296974619174e+075,
-    -1.5559416129466825e+098,
-    -3.2841562489204913e+121,
-    -3.7745893248228135e+144,
-    -1.7356668416969134e+167,
-    -3.8893577551088374e+190,
-    -9.9566444326005119e+213,
-    6.3641293062232429e+236,
-    -5.2069140800249813e+259,
-    -5.2504760255204387e+282
-};
-static double const stbsp__negtoperr[13] = {
-    3.9565301985100693e-040,  -2.299904345391321e-063,  3.6506201437945798e-086,  1.1875228833981544e-109,
-    -5.0644902316928607e-132, -6.7156837247865426e-155, -2.812077463003139e-178,  -5.7778912386589953e-201,
-    7.4997100559334532e-224,  -4.6439668915134491e-247, -6.3691100762962136e-270, -9.436808465446358e-293,
-    8.0970921678014997e-317
-};
+uint32_t AK_Hash_Function(const char* String)
+{
+    uint64_t Result = AK_Hash64(String, AK_CStr_Length(String));
+    return (uint32_t)(Result ^ (Result >> 32));
+}
 
-#if defined(_MSC_VER) && (_MSC_VER <= 1200)
-static stbsp__uint64 const stbsp__powten[20] = {
-    1,
-    10,
-    100,
-    1000,
-    10000,
-    100000,
-    1000000,
-    10000000,
-    100000000,
-    1000000000,
-    10000000000,
-    100000000000,
-    1000000000000,
-    10000000000000,
-    100000000000000,
-    1000000000000000,
-    10000000000000000,
-    100000000000000000,
-    1000000000000000000,
-    10000000000000000000U
-};
-#define stbsp__tento19th ((stbsp__uint64)1000000000000000000)
-#else
-static stbsp__uint64 const stbsp__powten[20] = {
-    1,
-    10,
-    100,
-    1000,
-    10000,
-    100000,
-    1000000,
-    10000000,
-    100000000,
-    1000000000,
-    10000000000ULL,
-    100000000000ULL,
-    1000000000000ULL,
-    10000000000000ULL,
-    100000000000000ULL,
-    1000000000000000ULL,
-    10000000000000000ULL,
-    100000000000000000ULL,
-    1000000000000000000ULL,
-    10000000000000000000ULL
-};
-#define stbsp__tento19th (1000000000000000000ULL)
-#endif
+uint64_t AK__Mix64(uint64_t Value)
+{
+    Value ^= Value >> 30;
+    Value *= 0xbf58476d1ce4e5b9ull;
+    Value ^= Value >> 27;
+    Value *= 0x94d049bb133111ebull;
+    Value ^= Value >> 31;
+    return Value;
+}
 
-#define stbsp__ddmulthi(oh, ol, xh, yh)                            \
-{                                                               \
-double ahi = 0, alo, bhi = 0, blo;                           \
-stbsp__int64 bt;                                             \
-oh = xh * yh;                                                \
-STBSP__COPYFP(bt, xh);                                       \
-bt &= ((~(stbsp__uint64)0) << 27);                           \
-STBSP__COPYFP(ahi, bt);                                      \
-alo = xh - ahi;                                              \
-STBSP__COPYFP(bt, yh);                                       \
-bt &= ((~(stbsp__uint64)0) << 27);                           \
-STBSP__COPYFP(bhi, bt);                                      \
-blo = yh - bhi;                                              \
-ol = ((ahi * bhi - oh) + ahi * blo + alo * bhi) + alo * blo; \
+//NOTE(EVERYONE): Integers are mixed in full since their value is their identity. Every other key goes through its 
+//32 bit Hash, so keys that Equals treats as the same but whose bytes differ (padding, owned pointers, a specialized 
+//Equals) still get the same 64 bit hash
+uint64_t AK__Hash64_Default(uint32_t Key)
+{
+    return AK__Mix64(Key);
 }
 
-#define stbsp__ddtoS64(ob, xh, xl)          \
-{                                        \
-double ahi = 0, alo, vh, t;           \
-ob = (stbsp__int64)xh;                \
-vh = (double)ob;                      \
-ahi = (xh - vh);                      \
-t = (ahi - xh);                       \
-alo = (xh - (ahi - t)) - (vh + t);    \
-ob += (stbsp__int64)(ahi + alo + xl); \
+uint64_t AK__Hash64_Default(int32_t Key)
+{
+    return AK__Mix64((uint32_t)Key);
 }
 
-#define stbsp__ddrenorm(oh, ol) \
-{                            \
-double s;                 \
-s = oh + ol;              \
-ol = ol - (s - oh);       \
-oh = s;                   \
+uint64_t AK__Hash64_Default(uint64_t Key)
+{
+    return AK__Mix64(Key);
 }
 
-#define stbsp__ddmultlo(oh, ol, xh, xl, yh, yl) ol = ol + (xh * yl + xl * yh);
+uint64_t AK__Hash64_Default(int64_t Key)
+{
+    return AK__Mix64((uint64_t)Key);
+}
 
-#define stbsp__ddmultlos(oh, ol, xh, yl) ol = ol + (xh * yl);
+template <typename key>
+uint64_t AK__Hash64_Default(const key& Key)
+{
+    return AK__Mix64(ak_hash_traits<key>::Hash(Key));
+}
 
-static void stbsp__raise_to_power10(double *ohi, double *olo, double d, stbsp__int32 power) // power can be -323 to +350
+template <typename key>
+uint32_t ak_hash_traits<key>::Hash(const key& Key)
 {
-    double ph, pl;
-    if ((power >= 0) && (power <= 22)) {
-        stbsp__ddmulthi(ph, pl, d, stbsp__bot[power]);
-    } else {
-        stbsp__int32 e, et, eb;
-        double p2h, p2l;
-        
-        e = power;
-        if (power < 0)
-            e = -e;
-        et = (e * 0x2c9) >> 14; /* %23 */
-        if (et > 13)
-            et = 13;
-        eb = e - (et * 23);
-        
-        ph = d;
-        pl = 0.0;
-        if (power < 0) {
-            if (eb) {
-                --eb;
-                stbsp__ddmulthi(ph, pl, d, stbsp__negbot[eb]);
-                stbsp__ddmultlos(ph, pl, d, stbsp__negboterr[eb]);
-            }
-            if (et) {
-                stbsp__ddrenorm(ph, pl);
-                --et;
-                stbsp__ddmulthi(p2h, p2l, ph, stbsp__negtop[et]);
-                stbsp__ddmultlo(p2h, p2l, ph, pl, stbsp__negtop[et], stbsp__negtoperr[et]);
-                ph = p2h;
-                pl = p2l;
-            }
-        } else {
-            if (eb) {
-                e = eb;
-                if (eb > 22)
-                    eb = 22;
-                e -= eb;
-                stbsp__ddmulthi(ph, pl, d, stbsp__bot[eb]);
-                if (e) {
-                    stbsp__ddrenorm(ph, pl);
-                    stbsp__ddmulthi(p2h, p2l, ph, stbsp__bot[e]);
-                    stbsp__ddmultlos(p2h, p2l, stbsp__bot[e], pl);
-                    ph = p2h;
-                    pl = p2l;
-                }
-            }
-            if (et) {
-                stbsp__ddrenorm(ph, pl);
-                --et;
-                stbsp__ddmulthi(p2h, p2l, ph, stbsp__top[et]);
-                stbsp__ddmultlo(p2h, p2l, ph, pl, stbsp__top[et], stbsp__toperr[et]);
-                ph = p2h;
-                pl = p2l;
-            }
-        }
-    }
-    stbsp__ddrenorm(ph, pl);
-    *ohi = ph;
-    *olo = pl;
+    return AK_Hash_Function(Key);
 }
 
-// given a float value, returns the significant bits in bits, and the position of the
-//   decimal point in decimal_pos.  +/-INF and NAN are specified by special values
-//   returned in the decimal_pos parameter.
-// frac_digits is absolute normally, but if you want from first significant digits (got %g and %e), or in 0x80000000
-static stbsp__int32 stbsp__real_to_str(char const **start, stbsp__uint32 *len, char *out, stbsp__int32 *decimal_pos, double value, stbsp__uint32 frac_digits)
+template <typename key>
+uint64_t ak_hash_traits<key>::Hash64(const key& Key)
 {
-    double d;
-    stbsp__int64 bits = 0;
-    stbsp__int32 expo, e, ng, tens;
+    return AK__Hash64_Default(Key);
+}
+
+template <typename key>
+bool ak_hash_traits<key>::Equals(const key& A, const key& B)
+{
+    return A == B;
+}
+
+//~Static hash map implementation
+#define AK__STATIC_HASHMAP_BUCKET_SIZE 4
+#define AK__STATIC_HASHMAP_MAX_PILOT (1u << 30)
+#define AK__STATIC_HASHMAP_MAX_ATTEMPTS 8
+#define AK__STATIC_HASHMAP_FREE_SLOT 0xFFFFFFFFu
+
+uint64_t AK__Static_HashMap_Key_Hash(uint64_t Hash, uint64_t Seed)
+{
+    return AK__Mix64(Hash ^ Seed);
+}
+
+uint32_t AK__Static_HashMap_Bucket(uint64_t KeyHash, uint32_t BucketCount)
+{
+    return (uint32_t)AK__Mul_Hi64(KeyHash, BucketCount);
+}
+
+uint32_t AK__Static_HashMap_Slot(uint64_t KeyHash, uint32_t Pilot, uint32_t SlotCount)
+{
+    return (uint32_t)AK__Mul_Hi64(AK__Mix64(KeyHash ^ (Pilot*0x9E3779B97F4A7C15ull)), SlotCount);
+}
+
+//NOTE(EVERYONE): Finds a pilot for every bucket, largest buckets first while the table is still empty. SlotKeys 
+//receives the key index that lands in each slot. Scratch needs room for 2*Count + 2*BucketCount + 1 uint32s
+bool AK__Static_HashMap_Search(const uint64_t* Hashes, uint32_t Count, uint32_t BucketCount, uint64_t Seed, 
+                               uint32_t* Pilots, uint32_t* SlotKeys, uint32_t* Scratch)
+{
+    uint32_t* BucketKeys = Scratch;
+    uint32_t* BucketStarts = BucketKeys + Count;
+    uint32_t* BucketOrder = BucketStarts + BucketCount + 1;
+    uint32_t* BucketSlots = BucketOrder + BucketCount;
     
-    d = value;
-    STBSP__COPYFP(bits, d);
-    expo = (stbsp__int32)((bits >> 52) & 2047);
-    ng = (stbsp__int32)((stbsp__uint64) bits >> 63);
-    if (ng)
-        d = -d;
+    //NOTE(EVERYONE): Group the key indices by bucket with a counting sort
+    AK__Memory_Clear(BucketStarts, (BucketCount+1)*sizeof(uint32_t));
+    for(uint32_t KeyIndex = 0; KeyIndex < Count; KeyIndex++)
+        BucketStarts[AK__Static_HashMap_Bucket(AK__Static_HashMap_Key_Hash(Hashes[KeyIndex], Seed), BucketCount)+1]++;
     
-    if (expo == 2047) // is nan or inf?
+    uint32_t MaxBucketSize = 0;
+    for(uint32_t BucketIndex = 0; BucketIndex < BucketCount; BucketIndex++)
     {
-        *start = (bits & ((((stbsp__uint64)1) << 52) - 1)) ? "NaN" : "Inf";
-        *decimal_pos = STBSP__SPECIAL;
-        *len = 3;
-        return ng;
+        MaxBucketSize = AK__Max(MaxBucketSize, BucketStarts[BucketIndex+1]);
+        BucketStarts[BucketIndex+1] += BucketStarts[BucketIndex];
     }
     
-    if (expo == 0) // is zero or denormal
+    AK__Memory_Clear(BucketOrder, BucketCount*sizeof(uint32_t));
+    for(uint32_t KeyIndex = 0; KeyIndex < Count; KeyIndex++)
     {
-        if (((stbsp__uint64) bits << 1) == 0) // do zero
+        uint32_t BucketIndex = AK__Static_HashMap_Bucket(AK__Static_HashMap_Key_Hash(Hashes[KeyIndex], Seed), BucketCount);
+        BucketKeys[BucketOrder[BucketIndex] + BucketStarts[BucketIndex]] = KeyIndex;
+        BucketOrder[BucketIndex]++;
+    }
+    
+    //NOTE(EVERYONE): Sort the buckets by size, largest first. Bucket sizes are tiny so this is another counting pass
+    uint32_t OrderIndex = 0;
+    for(uint32_t Size = MaxBucketSize; Size > 0; Size--)
+    {
+        for(uint32_t BucketIndex = 0; BucketIndex < BucketCount; BucketIndex++)
+            if(BucketStarts[BucketIndex+1]-BucketStarts[BucketIndex] == Size) BucketOrder[OrderIndex++] = BucketIndex;
+    }
+    
+    for(uint32_t SlotIndex = 0; SlotIndex < Count; SlotIndex++) SlotKeys[SlotIndex] = AK__STATIC_HASHMAP_FREE_SLOT;
+    AK__Memory_Clear(Pilots, BucketCount*sizeof(uint32_t));
+    
+    for(uint32_t Index = 0; Index < OrderIndex; Index++)
+    {
+        uint32_t BucketIndex = BucketOrder[Index];
+        const uint32_t* Keys = BucketKeys + BucketStarts[BucketIndex];
+        uint32_t KeyCount = BucketStarts[BucketIndex+1]-BucketStarts[BucketIndex];
+        
+        //NOTE(EVERYONE): Keys with equal hashes can never be separated, no matter the pilot
+        for(uint32_t KeyIndex = 0; KeyIndex < KeyCount; KeyIndex++)
         {
-            *decimal_pos = 1;
-            *start = out;
-            out[0] = '0';
-            *len = 1;
-            return ng;
+            for(uint32_t OtherIndex = 0; OtherIndex < KeyIndex; OtherIndex++)
+                if(Hashes[Keys[KeyIndex]] == Hashes[Keys[OtherIndex]]) return false;
         }
-        // find the right expo for denormals
+        
+        bool Found = false;
+        for(uint32_t Pilot = 0; Pilot < AK__STATIC_HASHMAP_MAX_PILOT && !Found; Pilot++)
         {
-            stbsp__int64 v = ((stbsp__uint64)1) << 51;
-            while ((bits & v) == 0) {
-                --expo;
-                v >>= 1;
+            Found = true;
+            for(uint32_t KeyIndex = 0; KeyIndex < KeyCount && Found; KeyIndex++)
+            {
+                uint64_t KeyHash = AK__Static_HashMap_Key_Hash(Hashes[Keys[KeyIndex]], Seed);
+                uint32_t Slot = AK__Static_HashMap_Slot(KeyHash, Pilot, Count);
+                if(SlotKeys[Slot] != AK__STATIC_HASHMAP_FREE_SLOT) Found = false;
+                for(uint32_t OtherIndex = 0; OtherIndex < KeyIndex && Found; OtherIndex++)
+                    if(BucketSlots[OtherIndex] == Slot) Found = false;
+                BucketSlots[KeyIndex] = Slot;
+            }
+            
+            if(Found)
+            {
+                Pilots[BucketIndex] = Pilot;
+                for(uint32_t KeyIndex = 0; KeyIndex < KeyCount; KeyIndex++)
+                    SlotKeys[BucketSlots[KeyIndex]] = Keys[KeyIndex];
             }
         }
+        
+        if(!Found) return false;
     }
     
-    // find the decimal exponent as well as the decimal bits of the value
+    return true;
+}
+
+template <typename key, typename value>
+value* ak_static_hashmap<key, value>::Find(const key& Key) const
+{
+    return Find_As(Key);
+}
+
+template <typename key, typename value>
+template <typename lookup>
+value* ak_static_hashmap<key, value>::Find_As(const lookup& Key) const
+{
+    if(!Length) return NULL;
+    
+    uint64_t KeyHash = AK__Static_HashMap_Key_Hash(ak_hash_traits<key>::Hash64(Key), Seed);
+    uint32_t Pilot = Pilots[AK__Static_HashMap_Bucket(KeyHash, BucketCount)];
+    uint32_t Slot = AK__Static_HashMap_Slot(KeyHash, Pilot, Length);
+    return ak_hash_traits<key>::Equals(Keys[Slot], Key) ? Values + Slot : NULL;
+}
+
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_static_hashmap<key, value>::begin() const
+{
+    return AK__HashMap_Begin<key, value>(Keys, Values, &Length);
+}
+
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_static_hashmap<key, value>::end() const
+{
+    return {};
+}
+
+template <typename key, typename value>
+ak_static_hashmap<key, value> AK_Create_Static_Hash_Map(const key* Keys, const value* Values, uint32_t Count, ak_allocator* Allocator)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    
+    ak_static_hashmap<key, value> Result = {};
+    Result.Allocator = Allocator;
+    if(!Count) return Result;
+    
+    uint32_t BucketCount = (Count + AK__STATIC_HASHMAP_BUCKET_SIZE-1) / AK__STATIC_HASHMAP_BUCKET_SIZE;
+    
+    uint64_t KeyOffset = AK__Memory_Align(BucketCount*sizeof(uint32_t), alignof(key));
+    uint64_t ValueOffset = AK__Memory_Align(KeyOffset + (uint64_t)Count*sizeof(key), alignof(value));
+    uint64_t AllocSize = ValueOffset + (uint64_t)Count*sizeof(value);
+    uint64_t ScratchSize = (uint64_t)Count*sizeof(uint64_t) + ((uint64_t)Count*3 + (uint64_t)BucketCount*2 + 1)*sizeof(uint32_t);
+    
+    uint8_t* MapData = (uint8_t*)Allocator->Alloc(AllocSize, Allocator->UserData);
+    uint64_t* Hashes = (uint64_t*)Allocator->Alloc(ScratchSize, Allocator->UserData);
+    if(!MapData || !Hashes)
     {
-        double ph, pl;
-        
-        // log10 estimate - very specifically tweaked to hit or undershoot by no more than 1 of log10 of all expos 1..2046
-        tens = expo - 1023;
-        tens = (tens < 0) ? ((tens * 617) / 2048) : (((tens * 1233) / 4096) + 1);
-        
-        // move the significant bits into position and stick them into an int
-        stbsp__raise_to_power10(&ph, &pl, d, 18 - tens);
-        
-        // get full as much precision from double-double as possible
-        stbsp__ddtoS64(bits, ph, pl);
-        
-        // check if we undershot
-        if (((stbsp__uint64)bits) >= stbsp__tento19th)
-            ++tens;
+        //TODO(JJ): Diagnostic and error logging
+        if(MapData) Allocator->Free(MapData, Allocator->UserData);
+        if(Hashes) Allocator->Free(Hashes, Allocator->UserData);
+        return {};
     }
     
-    // now do the rounding in integer land
-    frac_digits = (frac_digits & 0x80000000) ? ((frac_digits & 0x7ffffff) + 1) : (tens + frac_digits);
-    if ((frac_digits < 24)) {
-        stbsp__uint32 dg = 1;
-        if ((stbsp__uint64)bits >= stbsp__powten[9])
-            dg = 10;
-        while ((stbsp__uint64)bits >= stbsp__powten[dg]) {
-            ++dg;
-            if (dg == 20)
-                goto noround;
-        }
-        if (frac_digits < dg) {
-            stbsp__uint64 r;
-            // add 0.5 at the right position and round
-            e = dg - frac_digits;
-            if ((stbsp__uint32)e >= 24)
-                goto noround;
-            r = stbsp__powten[e];
-            bits = bits + (r / 2);
-            if ((stbsp__uint64)bits >= stbsp__powten[dg])
-                ++tens;
-            bits /= r;
-        }
-        noround:;
+    uint32_t* SlotKeys = (uint32_t*)(Hashes + Count);
+    uint32_t* Scratch = SlotKeys + Count;
+    for(uint32_t KeyIndex = 0; KeyIndex < Count; KeyIndex++)
+        Hashes[KeyIndex] = ak_hash_traits<key>::Hash64(Keys[KeyIndex]);
+    
+    Result.Pilots = (uint32_t*)MapData;
+    Result.Keys = (key*)(MapData + KeyOffset);
+    Result.Values = (value*)(MapData + ValueOffset);
+    Result.BucketCount = BucketCount;
+    
+    bool Built = false;
+    for(uint32_t Attempt = 0; Attempt < AK__STATIC_HASHMAP_MAX_ATTEMPTS && !Built; Attempt++)
+    {
+        Result.Seed = AK__Mix64(Attempt+1);
+        Built = AK__Static_HashMap_Search(Hashes, Count, BucketCount, Result.Seed, Result.Pilots, SlotKeys, Scratch);
     }
     
-    // kill long trailing runs of zeros
-    if (bits) {
-        stbsp__uint32 n;
-        for (;;) {
-            if (bits <= 0xffffffff)
-                break;
-            if (bits % 1000)
-                goto donez;
-            bits /= 1000;
-        }
-        n = (stbsp__uint32)bits;
-        while ((n % 1000) == 0)
-            n /= 1000;
-        bits = n;
-        donez:;
+    if(!Built)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        Allocator->Free(Hashes, Allocator->UserData);
+        Allocator->Free(MapData, Allocator->UserData);
+        return {};
     }
     
-    // convert to string
-    out += 64;
-    e = 0;
-    for (;;) {
-        stbsp__uint32 n;
-        char *o = out - 8;
-        // do the conversion in chunks of U32s (avoid most 64-bit divides, worth it, constant denomiators be damned)
-        if (bits >= 100000000) {
-            n = (stbsp__uint32)(bits % 100000000);
-            bits /= 100000000;
-        } else {
-            n = (stbsp__uint32)bits;
-            bits = 0;
-        }
-        while (n) {
-            out -= 2;
-            *(stbsp__uint16 *)out = *(stbsp__uint16 *)&stbsp__digitpair.pair[(n % 100) * 2];
-            n /= 100;
-            e += 2;
-        }
-        if (bits == 0) {
-            if ((e) && (out[0] == '0')) {
-                ++out;
-                --e;
-            }
-            break;
-        }
-        while (out != o) {
-            *--out = '0';
-            ++e;
-        }
+    for(uint32_t Slot = 0; Slot < Count; Slot++)
+    {
+        Result.Keys[Slot] = Keys[SlotKeys[Slot]];
+        Result.Values[Slot] = Values[SlotKeys[Slot]];
     }
+    Result.Length = Count;
     
-    *decimal_pos = tens;
-    *start = out;
-    *len = e;
-    return ng;
+    Allocator->Free(Hashes, Allocator->UserData);
+    return Result;
 }
 
-#undef stbsp__ddmulthi
-#undef stbsp__ddrenorm
-#undef stbsp__ddmultlo
-#undef stbsp__ddmultlos
-#undef STBSP__SPECIAL
-#undef STBSP__COPYFP
-
-#endif // STB_SPRINTF_NOFLOAT
-
-// clean up
-#undef stbsp__uint16
-#undef stbsp__uint32
-#undef stbsp__int32
-#undef stbsp__uint64
-#undef stbsp__int64
-#undef STBSP__UNALIGNED
-
-#endif // STB_SPRINTF_IMPLEMENTATION
-
-/*
-------------------------------------------------------------------------------
-This software is available under 2 licenses -- choose whichever you prefer.
-------------------------------------------------------------------------------
-ALTERNATIVE A - MIT License
-Copyright (c) 2017 Sean Barrett
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
-------------------------------------------------------------------------------
-ALTERNATIVE B - Public Domain (www.unlicense.org)
-This is free and unencumbered software released into the public domain.
-Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
-software, either in source code form or as a compiled binary, for any purpose,
-commercial or non-commercial, and by any means.
-In jurisdictions that recognize copyright laws, the author or authors of this
-software dedicate any and all copyright interest in the software to the public
-domain. We make this dedication for the benefit of the public at large and to
-the detriment of our heirs and successors. We intend this dedication to be an
-overt act of relinquishment in perpetuity of all present and future rights to
-this software under copyright law.
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
-ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
-WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-------------------------------------------------------------------------------
-*/
-
-bool AK_Is_Newline(char Code)
-{
-    return Code == '\n' || Code == '\r';
-}
-
-bool AK_Is_Whitespace(char Code)
-{
-    return AK_Is_Newline(Code) || Code == ' ' || Code == '\t' || Code == '\v' || Code == '\f';
-}
-
-uint64_t AK_CStr_Length(const char* Str)
+template <typename key, typename value>
+void AK_Delete(ak_static_hashmap<key, value>* HashMap)
 {
-    uint64_t Result = 0;
-    while(*Str++) Result++;
-    return Result;
+    if(HashMap && HashMap->Allocator)
+    {
+        if(HashMap->Pilots) HashMap->Allocator->Free(HashMap->Pilots, HashMap->Allocator->UserData);
+        *HashMap = {};
+    }
 }
 
-const char& ak_str8::operator[](uint64_t Index) const
-{
-    return Str[Index];
-}
+//~Mapped hash map implementation
+#ifndef AK_STD_NO_FILE_IO
+#define AK__HASHMAP_IMAGE_MAGIC 0x31504D48534B41ull //NOTE(EVERYONE): "AKSHMP1"
+#define AK__HASHMAP_IMAGE_ALIGNMENT 64
+
+struct ak__hashmap_image_header
+{
+    uint64_t Magic;
+    uint32_t KeySize;
+    uint32_t ValueSize;
+    uint32_t KeyKind;
+    uint32_t Length;
+    uint32_t SlotCapacity;
+    uint32_t SlotTag;
+    uint64_t SlotsOffset;
+    uint64_t ItemSlotsOffset;
+    uint64_t KeysOffset;
+    uint64_t ValuesOffset;
+    uint64_t BlobOffset;
+    uint64_t BlobSize;
+};
 
-bool ak_str8::Is_Null_Or_Empty()
+//NOTE(EVERYONE): How keys are written to and restored from an image. Keys are copied byte for byte by default
+template <typename key>
+struct ak__hashmap_image_key
 {
-    return !Str || !Length;
-}
+    static const uint32_t Kind = 0;
+    static uint64_t Get_Blob_Size(const key* Keys, uint32_t Length) { return 0; }
+    static bool Write(AK_STD_FILE* File, const key* Keys, uint32_t Length) { return AK_STD_FWRITE(Keys, sizeof(key), Length, File) == Length; }
+    static bool Write_Blob(AK_STD_FILE* File, const key* Keys, uint32_t Length) { return true; }
+    static bool Fixup(key* Keys, uint32_t Length, const uint8_t* Blob, uint64_t BlobSize) { return true; }
+};
 
-bool ak_str8::Is_Null_Or_Whitespace()
+//NOTE(EVERYONE): ak_str8 keys store the offset of their bytes in the blob instead of a pointer
+template <>
+struct ak__hashmap_image_key<ak_str8>
 {
-    if(Is_Null_Or_Empty())
+    static const uint32_t Kind = 1;
+    
+    static uint64_t Get_Blob_Size(const ak_str8* Keys, uint32_t Length)
+    {
+        uint64_t Result = 0;
+        for(uint32_t Index = 0; Index < Length; Index++) Result += Keys[Index].Length;
+        return Result;
+    }
+    
+    static bool Write(AK_STD_FILE* File, const ak_str8* Keys, uint32_t Length)
+    {
+        uint64_t Offset = 0;
+        for(uint32_t Index = 0; Index < Length; Index++)
+        {
+            ak_str8 Key = {(const char*)(uintptr_t)Offset, Keys[Index].Length};
+            if(AK_STD_FWRITE(&Key, sizeof(ak_str8), 1, File) != 1) return false;
+            Offset += Keys[Index].Length;
+        }
         return true;
+    }
     
-    for(uint64_t i = 0; i < Length; i++)
+    static bool Write_Blob(AK_STD_FILE* File, const ak_str8* Keys, uint32_t Length)
     {
-        if(!AK_Is_Whitespace(Str[i]))
-            return false;
+        for(uint32_t Index = 0; Index < Length; Index++)
+        {
+            if(Keys[Index].Length && AK_STD_FWRITE(Keys[Index].Str, 1, Keys[Index].Length, File) != Keys[Index].Length) 
+                return false;
+        }
+        return true;
     }
     
-    return true;
+    static bool Fixup(ak_str8* Keys, uint32_t Length, const uint8_t* Blob, uint64_t BlobSize)
+    {
+        for(uint32_t Index = 0; Index < Length; Index++)
+        {
+            uint64_t Offset = (uint64_t)(uintptr_t)Keys[Index].Str;
+            if(Offset > BlobSize || Keys[Index].Length > BlobSize-Offset) return false;
+            Keys[Index].Str = (const char*)(Blob + Offset);
+        }
+        return true;
+    }
+};
+
+bool AK__Write_Padding(AK_STD_FILE* File, uint64_t* Offset)
+{
+    static const uint8_t Zeros[AK__HASHMAP_IMAGE_ALIGNMENT] = {};
+    uint64_t Aligned = AK__Memory_Align(*Offset, AK__HASHMAP_IMAGE_ALIGNMENT);
+    size_t PaddingSize = (size_t)(Aligned - *Offset);
+    *Offset = Aligned;
+    return AK_STD_FWRITE(Zeros, 1, PaddingSize, File) == PaddingSize;
 }
 
-uint64_t ak_str8::Find_First(char Code)
+template <typename key, typename value>
+bool ak_hashmap<key, value>::Save(const char* Path)
 {
-    const char* Start = Str;
-    const char* End = Str+Length;
+    if(!ItemSlots)
+        AK__HashMap_Init(this);
     
-    while(Start != End)
+    //NOTE(EVERYONE): The image only holds one slot table, small maps get theirs built first
+    if(!Slots && !AK__HashMap_Promote(this, Length))
     {
-        if(*Start == Code)
-            return (uint64_t)(Start - Str);
-        Start++;
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    AK__HashMap_Migrate_Slots(this, OldSlotCapacity);
+    
+    ak__hashmap_image_header Header = {};
+    Header.Magic = AK__HASHMAP_IMAGE_MAGIC;
+    Header.KeySize = sizeof(key);
+    Header.ValueSize = sizeof(value);
+    Header.KeyKind = ak__hashmap_image_key<key>::Kind;
+    Header.Length = Length;
+    Header.SlotCapacity = SlotCapacity;
+    Header.SlotTag = SlotTag;
+    Header.SlotsOffset = AK__Memory_Align(sizeof(ak__hashmap_image_header), AK__HASHMAP_IMAGE_ALIGNMENT);
+    Header.ItemSlotsOffset = AK__Memory_Align(Header.SlotsOffset + SlotCapacity*sizeof(ak__hashmap_slot), AK__HASHMAP_IMAGE_ALIGNMENT);
+    Header.KeysOffset = AK__Memory_Align(Header.ItemSlotsOffset + Length*sizeof(uint32_t), AK__HASHMAP_IMAGE_ALIGNMENT);
+    Header.ValuesOffset = AK__Memory_Align(Header.KeysOffset + Length*sizeof(key), AK__HASHMAP_IMAGE_ALIGNMENT);
+    Header.BlobOffset = AK__Memory_Align(Header.ValuesOffset + Length*sizeof(value), AK__HASHMAP_IMAGE_ALIGNMENT);
+    Header.BlobSize = ak__hashmap_image_key<key>::Get_Blob_Size(Keys, Length);
+    
+    AK_STD_FILE* File = AK_STD_FOPEN(Path, "wb");
+    if(!File)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
     }
     
-    return AK_STR8_FIND_ERROR;
-}
-
-uint64_t ak_str8::Find_Last(char Code)
-{
-    const char* End = Str + (Length-1);
-    while(End != Str-1)
+    uint64_t Offset = sizeof(ak__hashmap_image_header);
+    bool Result = AK_STD_FWRITE(&Header, sizeof(ak__hashmap_image_header), 1, File) == 1;
+    Result = Result && AK__Write_Padding(File, &Offset);
+    Result = Result && AK_STD_FWRITE(Slots, sizeof(ak__hashmap_slot), SlotCapacity, File) == SlotCapacity;
+    Offset += SlotCapacity*sizeof(ak__hashmap_slot);
+    Result = Result && AK__Write_Padding(File, &Offset);
+    Result = Result && AK_STD_FWRITE(ItemSlots, sizeof(uint32_t), Length, File) == Length;
+    Offset += Length*sizeof(uint32_t);
+    Result = Result && AK__Write_Padding(File, &Offset);
+    Result = Result && ak__hashmap_image_key<key>::Write(File, Keys, Length);
+    Offset += Length*sizeof(key);
+    Result = Result && AK__Write_Padding(File, &Offset);
+    Result = Result && AK_STD_FWRITE(Values, sizeof(value), Length, File) == Length;
+    Offset += Length*sizeof(value);
+    Result = Result && AK__Write_Padding(File, &Offset);
+    Result = Result && ak__hashmap_image_key<key>::Write_Blob(File, Keys, Length);
+    
+    if(AK_STD_FCLOSE(File) != 0) Result = false;
+    if(!Result)
     {
-        if(*End == Code)
-            return (uint64_t)(End-Str);
-        
-        End--;
+        //TODO(JJ): Diagnostic and error logging
+        return false;
     }
     
-    return AK_STR8_FIND_ERROR;
+    return true;
 }
 
-ak_str8 ak_str8::Prefix(uint64_t Count)
+template <typename key, typename value>
+const value* ak_mapped_hashmap<key, value>::Find(const key& Key) const
 {
-    Count = AK__Min(Count, Length);
-    ak_str8 Result = {Str, Count};
-    return Result;
+    return Find_As(Key);
 }
 
-ak_str8 ak_str8::Chop(uint64_t Count)
+template <typename key, typename value>
+template <typename lookup>
+const value* ak_mapped_hashmap<key, value>::Find_As(const lookup& Key) const
 {
-    Count = AK__Min(Count, Length);
-    uint64_t Remaining = Length - Count;
-    ak_str8 Result = {Str, Remaining};
-    return Result;
+    if(!Slots) return NULL;
+    
+    ak__hashmap_probe Probe = AK__HashMap_Probe_Keys<key>(Keys, Slots, SlotCapacity, Key, ak_hash_traits<key>::Hash(Key));
+    return (Probe.Slot >= 0) ? Values + Slots[Probe.Slot].ItemIndex : NULL;
 }
 
-ak_str8 ak_str8::Postfix(uint64_t Count)
+template <typename key, typename value>
+uint32_t ak_mapped_hashmap<key, value>::Get_Length() const
 {
-    Count = AK__Min(Count, Length);
-    uint64_t Skip = Length - Count;
-    ak_str8 Result = {Str+Skip, Count};
-    return Result;
+    return Length;
 }
 
-ak_str8 ak_str8::Skip(uint64_t Count)
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_mapped_hashmap<key, value>::begin() const
 {
-    Count= AK__Min(Count, Length);
-    uint64_t Remaining = Length-Count;
-    ak_str8 Result = {Str + Count, Remaining};
-    return Result;
+    return AK__HashMap_Begin<key, value>(Keys, Values, &Length);
 }
 
-ak_str8 ak_str8::Substr(uint64_t First, uint64_t End)
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_mapped_hashmap<key, value>::end() const
 {
-    End = AK__Min(End, Length);
-    First = AK__Min(First, Length);
-    ak_str8 Result = {Str+First, End-First};
-    return Result;
+    return {};
 }
 
-bool ak_str8::Begins_With(const ak_str8& CompStr)
+bool AK__Image_Section_Fits(uint64_t Offset, uint64_t SectionSize, uint64_t FileSize)
 {
-    if(Length < CompStr.Length)
-        return false;
-    
-    for(uint64_t Index = 0; Index < CompStr.Length; Index++)
-    {           
-        if(Str[Index] != CompStr.Str[Index])
-        {
-            return false;
-        }
-    }    
-    
-    return true;
+    return Offset <= FileSize && SectionSize <= FileSize-Offset;
 }
 
-bool ak_str8::Ends_With(const ak_str8& CompStr)
+//NOTE(EVERYONE): Checks that the slots and items of an image point at each other and that every base count matches 
+//its run, so lookups can neither read items outside the image nor probe forever
+bool AK__HashMap_Validate_Image(const ak__hashmap_slot* Slots, uint32_t SlotCapacity, const uint32_t* ItemSlots, 
+                                uint32_t Length, uint32_t SlotTag)
 {
-    if(Length < CompStr.Length) return false;
+    if(SlotTag != 0 && SlotTag != AK__HASHMAP_SLOT_TAG_BIT) return false;
     
-    const char* StrLast = Str + Length-1;
-    const char* CompStrLast = CompStr.Str + CompStr.Length-1;
+    ak_allocator* Allocator = AK__Get_Default_Allocator();
+    uint64_t AllocSize = (uint64_t)SlotCapacity*sizeof(uint32_t);
+    uint32_t* BaseCounts = (uint32_t*)Allocator->Alloc(AllocSize, Allocator->UserData);
+    if(!BaseCounts)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    AK__Memory_Clear(BaseCounts, AllocSize);
     
-    for(uint64_t Index = 0; Index < CompStr.Length; Index++)
+    bool Result = true;
+    uint32_t SlotMask = SlotCapacity-1;
+    uint32_t ValidCount = 0;
+    for(uint32_t Slot = 0; Slot < SlotCapacity && Result; Slot++)
     {
-        if(*StrLast != *CompStrLast)
-            return false;
+        const ak__hashmap_slot* Entry = Slots + Slot;
+        if(!Entry->IsValid) continue;
         
-        StrLast--;
-        CompStrLast--;
+        Result = Entry->ItemIndex < Length && ItemSlots[Entry->ItemIndex] == (Slot | SlotTag);
+        BaseCounts[Entry->Hash & SlotMask]++;
+        ValidCount++;
     }
     
-    return true;
+    Result = Result && ValidCount == Length;
+    for(uint32_t Slot = 0; Slot < SlotCapacity && Result; Slot++)
+        Result = Slots[Slot].BaseCount == BaseCounts[Slot];
+    
+    Allocator->Free(BaseCounts, Allocator->UserData);
+    return Result;
 }
 
-ak_str8 ak_str8::Trim_Whitespace()
+template <typename key, typename value> 
+ak_mapped_hashmap<key, value> AK_Load_Mapped_Hash_Map(const char* Path)
 {
-    ak_str8 Result = *this;
+    ak_mapped_hashmap<key, value> Result = {};
     
-    while(AK_Is_Whitespace(*Result.Str) && Result.Length)
+    //NOTE(EVERYONE): Only ak_str8 keys need writable (copy on write) pages for their pointer fixups
+    bool CopyOnWrite = ak__hashmap_image_key<key>::Kind != 0;
+    if(!AK__Map_File(Path, CopyOnWrite, &Result.Mapping))
     {
-        Result.Str++;
-        Result.Length--;
+        //TODO(JJ): Diagnostic and error logging
+        return {};
     }
     
-    while(Result.Length && AK_Is_Whitespace(Result.Str[Result.Length-1]))
-        Result.Length--;
+    uint8_t* Data = (uint8_t*)Result.Mapping.Data;
+    uint64_t Size = Result.Mapping.Size;
+    ak__hashmap_image_header* Header = (ak__hashmap_image_header*)Data;
+    
+    bool IsValid = Size >= sizeof(ak__hashmap_image_header) && 
+        Header->Magic == AK__HASHMAP_IMAGE_MAGIC && Header->KeySize == sizeof(key) && Header->ValueSize == sizeof(value) && 
+        Header->KeyKind == ak__hashmap_image_key<key>::Kind && Header->SlotCapacity && 
+        !(Header->SlotCapacity & (Header->SlotCapacity-1)) && Header->Length < Header->SlotCapacity &&
+        AK__Image_Section_Fits(Header->SlotsOffset, (uint64_t)Header->SlotCapacity*sizeof(ak__hashmap_slot), Size) &&
+        AK__Image_Section_Fits(Header->ItemSlotsOffset, (uint64_t)Header->Length*sizeof(uint32_t), Size) &&
+        AK__Image_Section_Fits(Header->KeysOffset, (uint64_t)Header->Length*sizeof(key), Size) &&
+        AK__Image_Section_Fits(Header->ValuesOffset, (uint64_t)Header->Length*sizeof(value), Size) &&
+        AK__Image_Section_Fits(Header->BlobOffset, Header->BlobSize, Size);
+    
+    IsValid = IsValid && AK__HashMap_Validate_Image((ak__hashmap_slot*)(Data + Header->SlotsOffset), Header->SlotCapacity, 
+                                                    (uint32_t*)(Data + Header->ItemSlotsOffset), Header->Length, Header->SlotTag);
+    
+    if(IsValid)
+    {
+        key* Keys = (key*)(Data + Header->KeysOffset);
+        IsValid = ak__hashmap_image_key<key>::Fixup(Keys, Header->Length, Data + Header->BlobOffset, Header->BlobSize);
+        
+        Result.Slots = (const ak__hashmap_slot*)(Data + Header->SlotsOffset);
+        Result.Keys = Keys;
+        Result.Values = (const value*)(Data + Header->ValuesOffset);
+        Result.SlotCapacity = Header->SlotCapacity;
+        Result.Length = Header->Length;
+    }
+    
+    if(!IsValid)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        AK__Unmap_File(&Result.Mapping);
+        return {};
+    }
     
     return Result;
 }
 
-bool ak_str8::Is_Null_Term()
+template <typename key, typename value>
+void AK_Delete(ak_mapped_hashmap<key, value>* HashMap)
 {
-    return Str[Length] == 0;
+    if(HashMap)
+    {
+        AK__Unmap_File(&HashMap->Mapping);
+        *HashMap = {};
+    }
 }
+#endif //AK_STD_NO_FILE_IO
 
-const char* ak_str8::To_CStr(ak_arena* Arena)
+//~Concurrent hash map implementation
+uint32_t AK__RW_Lock_Reader_Slot()
 {
-    ak_array<char> Result = Arena->Push_Array<char>(Length+1);
-    if(!Result.Data)
+    //NOTE(EVERYONE): Threads are handed reader counters round robin the first time they read
+    static volatile uint64_t NextSlot;
+    static thread_local uint32_t Slot = (uint32_t)(AK__Atomic_Add64(&NextSlot, 1) % AK__RW_LOCK_READER_SLOTS);
+    return Slot;
+}
+
+//NOTE(EVERYONE): Returns the reader counter that was taken, which has to be handed back to AK__RW_Unlock_Read
+uint32_t AK__RW_Lock_Read(ak__rw_lock* Lock)
+{
+    uint32_t Slot = AK__RW_Lock_Reader_Slot();
+    volatile uint64_t* Readers = &Lock->Readers[Slot].Value;
+    for(;;)
     {
-        //TODO(JJ): Diagnostic and error logging
-        return NULL;
+        //NOTE(EVERYONE): Announce the reader before checking for a writer. A writer does the opposite, so at 
+        //least one of the two always sees the other
+        AK__Atomic_Add64(Readers, 1);
+        if(!AK__Atomic_Load64(&Lock->Writer.Value))
+            return Slot;
+        AK__Atomic_Add64(Readers, (uint64_t)-1);
+        
+        while(AK__Atomic_Load64(&Lock->Writer.Value))
+            AK__Atomic_Pause();
     }
-    
-    Result[Length] = 0;
-    AK__Memory_Copy(Result.Data, Str, Length);
-    return Result.Data;
 }
 
-ak_str8 ak_str8::Copy(ak_arena* Arena)
+void AK__RW_Unlock_Read(ak__rw_lock* Lock, uint32_t Slot)
 {
-    ak_str8 Result = AK_Str8(To_CStr(Arena), Length);
-    return Result;
+    AK__Atomic_Add64(&Lock->Readers[Slot].Value, (uint64_t)-1);
 }
 
-void ak_str8_list::Push_Explicit(const ak_str8& PushedString, ak_str8_node* Node)
+void AK__RW_Lock_Write(ak__rw_lock* Lock)
 {
-    Node->String = PushedString;
-    AK_SLL_Queue_Push(First, Last, Node);
-    NodeCount++;
-    TotalLength += PushedString.Length;
+    //NOTE(EVERYONE): Claim the writer flag first, then wait for the readers that got in before it to leave
+    for(;;)
+    {
+        if(!AK__Atomic_Load64(&Lock->Writer.Value) && AK__Atomic_Compare_Exchange64(&Lock->Writer.Value, 1, 0) == 0)
+            break;
+        AK__Atomic_Pause();
+    }
+    
+    for(uint32_t Slot = 0; Slot < AK__RW_LOCK_READER_SLOTS; Slot++)
+    {
+        while(AK__Atomic_Load64(&Lock->Readers[Slot].Value))
+            AK__Atomic_Pause();
+    }
 }
 
-void ak_str8_list::Push(const ak_str8& PushedString, ak_arena* Arena)
+void AK__RW_Unlock_Write(ak__rw_lock* Lock)
 {
-    ak_str8_node* Node = Arena->Push_Struct<ak_str8_node>();
-    Push_Explicit(PushedString, Node);
+    AK__Atomic_Store64(&Lock->Writer.Value, 0);
 }
 
-ak_str8 ak_str8_list::Join(ak_arena* Arena)
+template <typename key, typename value>
+ak__concurrent_hashmap_shard<key, value>* AK__Concurrent_HashMap_Get_Shard(ak_concurrent_hashmap<key, value>* Map, uint32_t Hash)
 {
-    ak_array<char> Str = Arena->Push_Array<char>(TotalLength+1);
-    char* At = Str.Data;
-    
-    for(ak_str8_node* Node = First; Node; Node = Node->Next)
+    //NOTE(EVERYONE): The slot index comes from the low bits of the hash so the shard uses the high bits
+    uint32_t ShardIndex = Map->ShardShift < 32 ? (Hash >> Map->ShardShift) : 0;
+    return Map->Shards + ShardIndex;
+}
+
+//NOTE(EVERYONE): Lookup for readers holding the shared lock. Unlike Find_With_Hash it never writes to the shard, 
+//so it does not lazily initialize it or record probe stats
+template <typename key, typename value>
+const value* AK__Concurrent_HashMap_Read(const ak_hashmap<key, value>* Map, const key& Key, uint32_t Hash)
+{
+    if(!Map->Slots)
     {
-        AK__Memory_Copy(At, Node->String.Str, Node->String.Length);
-        At += Node->String.Length;
+        int64_t ItemIndex = AK__HashMap_Small_Find(Map, Key, Hash);
+        return (ItemIndex >= 0) ? Map->Values + ItemIndex : NULL;
     }
     
-    Str[TotalLength] = 0;
-    return AK_Str8(Str.Data, TotalLength);
+    ak__hashmap_slot* Entry = AK__HashMap_Lookup_Entry(Map, Key, Hash, (uint32_t*)NULL);
+    return Entry ? Map->Values + Entry->ItemIndex : NULL;
 }
 
-ak_str8 ak_str8_list::Join_New_Line(ak_arena* Arena)
+template <typename key, typename value>
+bool ak_concurrent_hashmap<key, value>::Find(const key& Key, value* OutValue)
 {
-    ak_array<char> Str = Arena->Push_Array<char>(TotalLength+NodeCount+1);
-    char* At = Str.Data;
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    ak__concurrent_hashmap_shard<key, value>* Shard = AK__Concurrent_HashMap_Get_Shard(this, Hash);
     
-    for(ak_str8_node* Node = First; Node; Node = Node->Next)
-    {
-        AK__Memory_Copy(At, Node->String.Str, Node->String.Length);
-        At += Node->String.Length;
-        *At++ = '\n';
-    }
+    uint32_t ReaderSlot = AK__RW_Lock_Read(&Shard->Lock);
+    const value* Value = AK__Concurrent_HashMap_Read(&Shard->Map, Key, Hash);
+    if(Value && OutValue) *OutValue = *Value;
+    AK__RW_Unlock_Read(&Shard->Lock, ReaderSlot);
     
-    Str[TotalLength+NodeCount] = 0;
-    return AK_Str8(Str.Data, TotalLength+NodeCount);
+    return Value != NULL;
 }
 
-void ak_str8_list::FormatV(ak_arena* Arena, const char* Format, va_list Args)
+template <typename key, typename value>
+bool ak_concurrent_hashmap<key, value>::Contains(const key& Key)
 {
-    ak_str8 Result = AK_Str8_FormatV(Arena, Format, Args);
-    Push(Result, Arena);
+    return Find(Key, NULL);
 }
 
-void ak_str8_list::Format(ak_arena* Arena, const char* Format, ...)
+template <typename key, typename value>
+bool ak_concurrent_hashmap<key, value>::Try_Add(const key& Key, const value& Value)
 {
-    va_list Args;
-    va_start(Args, Format);
-    FormatV(Arena, Format, Args);
-    va_end(Args);
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    ak__concurrent_hashmap_shard<key, value>* Shard = AK__Concurrent_HashMap_Get_Shard(this, Hash);
+    
+    AK__RW_Lock_Write(&Shard->Lock);
+    bool WasInserted;
+    value* Result = AK__HashMap_Find_Or_Insert(&Shard->Map, Key, Hash, &WasInserted);
+    if(WasInserted) *Result = Value;
+    AK__RW_Unlock_Write(&Shard->Lock);
+    
+    return WasInserted;
 }
 
-ak_str8 AK_Str8(const char* Str)
+template <typename key, typename value>
+void ak_concurrent_hashmap<key, value>::Insert_Or_Assign(const key& Key, const value& Value)
 {
-    return AK_Str8(Str, AK_CStr_Length(Str));
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    ak__concurrent_hashmap_shard<key, value>* Shard = AK__Concurrent_HashMap_Get_Shard(this, Hash);
+    
+    AK__RW_Lock_Write(&Shard->Lock);
+    *AK__HashMap_Find_Or_Insert(&Shard->Map, Key, Hash, (bool*)NULL) = Value;
+    AK__RW_Unlock_Write(&Shard->Lock);
 }
 
-ak_str8 AK_Str8(const char* Str, uint64_t StrLength)
+template <typename key, typename value>
+bool ak_concurrent_hashmap<key, value>::Remove(const key& Key)
 {
-    ak_str8 Result;
-    Result.Str = Str;
-    Result.Length = StrLength;
-    return Result;
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    ak__concurrent_hashmap_shard<key, value>* Shard = AK__Concurrent_HashMap_Get_Shard(this, Hash);
+    
+    AK__RW_Lock_Write(&Shard->Lock);
+    bool WasRemoved = AK__HashMap_Remove_Key(&Shard->Map, Key, Hash);
+    AK__RW_Unlock_Write(&Shard->Lock);
+    
+    return WasRemoved;
 }
 
-ak_str8 AK_Str8(const char* First, const char* Last)
+template <typename key, typename value>
+uint32_t ak_concurrent_hashmap<key, value>::Get_Length()
 {
-    return AK_Str8(First, Last-First);
+    //NOTE(EVERYONE): Shards are counted one at a time, so with concurrent writers this is only a snapshot
+    uint32_t Result = 0;
+    for(uint32_t ShardIndex = 0; ShardIndex < ShardCount; ShardIndex++)
+    {
+        uint32_t ReaderSlot = AK__RW_Lock_Read(&Shards[ShardIndex].Lock);
+        Result += Shards[ShardIndex].Map.Length;
+        AK__RW_Unlock_Read(&Shards[ShardIndex].Lock, ReaderSlot);
+    }
+    return Result;
 }
 
-ak_str8_list AK_Str8_Split(const ak_str8& String, ak_arena* Arena, char* SplitChars, uint32_t CharCount)
+template <typename key, typename value> 
+ak_concurrent_hashmap<key, value> AK_Create_Concurrent_Hash_Map(uint32_t ShardCount, uint32_t InitialSlotCapacity, 
+                                                                uint32_t InitialItemCapacity, ak_allocator* Allocator)
 {
-    ak_str8_list Result = {};
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
     
-    const char* StrAt = String.Str;
-    const char* WordFirst = StrAt;
-    const char* StrEnd = String.Str + String.Length;
-    for(;StrAt < StrEnd; StrAt++)
+    ak_concurrent_hashmap<key, value> Result = {};
+    Result.Allocator = Allocator;
+    Result.ShardCount = (uint32_t)AK__Ceil_Pow2(AK__Max(ShardCount, 1));
+    Result.ShardShift = 32 - AK__Count_Trailing_Zeros32(Result.ShardCount);
+    
+    uint64_t AllocSize = sizeof(ak__concurrent_hashmap_shard<key, value>)*Result.ShardCount;
+    Result.Shards = (ak__concurrent_hashmap_shard<key, value>*)Allocator->Alloc(AllocSize, Allocator->UserData);
+    if(!Result.Shards)
     {
-        char Byte = *StrAt;
-        int32_t IsSplit = false;
-        
-        for(uint32_t Index = 0; Index < CharCount; Index++)
-        {
-            if(Byte == SplitChars[Index])
-            {
-                IsSplit = true;
-                break;
-            }
-        }
-        
-        if(IsSplit)
-        {
-            if(WordFirst < StrAt) 
-                Result.Push(AK_Str8(WordFirst, StrAt), Arena);
-            WordFirst = StrAt + 1;
-        }
+        //TODO(JJ): Diagnostic and error logging
+        return {};
     }
+    AK__Memory_Clear(Result.Shards, AllocSize);
     
-    if(WordFirst < StrAt) 
-        Result.Push(AK_Str8(WordFirst, StrAt), Arena);
+    //NOTE(EVERYONE): Shards are created up front so lookups never have to lazily initialize under a shared lock
+    for(uint32_t ShardIndex = 0; ShardIndex < Result.ShardCount; ShardIndex++)
+        Result.Shards[ShardIndex].Map = AK_Create_Hash_Map<key, value>(InitialSlotCapacity, InitialItemCapacity, Allocator);
     
     return Result;
 }
 
-ak_str8 AK_Str8_FormatV(ak_arena* Arena, const char* Format, va_list Args)
+template <typename key, typename value>
+void AK_Delete(ak_concurrent_hashmap<key, value>* HashMap)
 {
-    int ActualSize = stbsp_vsnprintf(NULL, 0, Format, Args);
-    
-    ak_array<char> Result = Arena->Push_Array<char>(ActualSize+1);
-    stbsp_vsnprintf(Result.Data, ActualSize+1, Format, Args);
+    if(HashMap && HashMap->Shards)
+    {
+        for(uint32_t ShardIndex = 0; ShardIndex < HashMap->ShardCount; ShardIndex++)
+            AK_Delete(&HashMap->Shards[ShardIndex].Map);
+        HashMap->Allocator->Free(HashMap->Shards, HashMap->Allocator->UserData);
+        *HashMap = {};
+    }
+}
+
+//~Hash set implementation
+template <typename key>
+void AK__HashSet_Init(ak_hashset<key>* Set)
+{
+    bool IncrementalRehash = Set->IncrementalRehash;
+    float MaxLoadFactor = Set->MaxLoadFactor;
     
-    return AK_Str8(Result.Data, ActualSize);
+    *Set = AK_Create_Hash_Set<key>(AK_HASH_MAP_INITIAL_SLOT_CAPACITY, AK_HASH_MAP_INITIAL_ITEM_CAPACITY, Set->Allocator);
+    Set->IncrementalRehash = IncrementalRehash;
+    Set->MaxLoadFactor = MaxLoadFactor;
 }
 
-ak_str8 AK_Str8_Format(ak_arena* Arena, const char* Format, ...)
+template <typename key>
+bool ak_hashset<key>::Add(const key& Key)
 {
-    va_list Args;
-    va_start(Args, Format);
-    ak_str8 Result = AK_Str8_FormatV(Arena, Format, Args);
-    va_end(Args);
-    return Result;
+    if(!Slots)
+        AK__HashSet_Init(this);
+    
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    AK_STD_ASSERT(Hash, "Invalid hash");
+    
+    uint32_t Slot;
+    if(AK__HashMap_Find_Entry(this, Key, Hash, &Slot)) return false;
+    
+    if(Length >= ItemCapacity)
+    {
+        if(!AK__HashMap_Realloc_Items(Allocator, Length, ItemCapacity*2, &ItemSlots, &Keys, (uint8_t**)NULL))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return false;
+        }
+        ItemCapacity *= 2;
+    }
+    
+    AK__HashMap_Insert_Key(this, Key, Hash, Slot);
+    return true;
 }
 
-bool operator!=(const ak_str8& A, const ak_str8& B)
+template <typename key>
+bool ak_hashset<key>::Contains(const key& Key) const
 {
-    if(A.Length != B.Length) return true;
-    for(uint64_t Index = 0; Index < A.Length; Index++)
-        if(A[Index] != B[Index]) return true;
-    return false;
+    if(!Slots) return false;
+    return AK__HashMap_Lookup_Entry(this, Key, ak_hash_traits<key>::Hash(Key), (uint32_t*)NULL) != NULL;
 }
 
-bool operator==(const ak_str8& A, const ak_str8& B)
+template <typename key>
+bool ak_hashset<key>::Remove(const key& Key)
 {
-    if(A.Length != B.Length) return false;
-    for(uint64_t Index = 0; Index < A.Length; Index++)
-        if(A[Index] != B[Index]) return false;
+    if(!Slots) return false;
+    
+    ak__hashmap_slot* Entry = AK__HashMap_Find_Entry(this, Key, ak_hash_traits<key>::Hash(Key), (uint32_t*)NULL);
+    if(!Entry) return false;
+    
+    AK__HashMap_Remove_Slot(this, Entry);
+    AK__HashMap_Migrate_Slots(this, AK_HASH_MAP_REHASH_STEP);
     return true;
 }
 
-uint32_t AK_Hash_Function(const ak_str8& Str)
+template <typename key>
+void ak_hashset<key>::Clear()
 {
-    uint32_t Result = 0;
-    uint32_t Rand1 = 31414;
-    const uint32_t Rand2 = 27183;
-    
-    for(uint64_t Index = 0; Index < Str.Length; Index++)
+    if(OldSlots)
     {
-        Result *= Rand1;
-        Result += Str[Index];
-        Rand1 *= Rand2;
+        Allocator->Free(OldSlots, Allocator->UserData);
+        OldSlots = NULL;
+        OldSlotCapacity = 0;
+        MigrateIndex = 0;
     }
     
-    return Result;
+    if(Slots) AK__Memory_Clear(Slots, SlotCapacity*sizeof(ak__hashmap_slot));
+    Length = 0;
+    SlotTag = 0;
 }
 
-#endif //AK_STD_IMPLEMENTATION
+template <typename key>
+void ak_hashset<key>::Union(const ak_hashset<key>& Set)
+{
+    for(const key& Key : Set) Add(Key);
+}
 
-#ifdef AK_STD_TESTS
+template <typename key>
+void ak_hashset<key>::Intersect(const ak_hashset<key>& Set)
+{
+    //NOTE(EVERYONE): Walk backwards so the swap removal only moves keys that were already checked
+    for(uint32_t Index = Length; Index > 0; Index--)
+    {
+        if(!Set.Contains(Keys[Index-1]))
+            Remove(Keys[Index-1]);
+    }
+}
 
-/*
-   The latest version of this library is available on GitHub;
-   https://github.com/sheredom/utest.h
-*/
+template <typename key>
+void ak_hashset<key>::Difference(const ak_hashset<key>& Set)
+{
+    if(Set.Length < Length)
+    {
+        for(const key& Key : Set) Remove(Key);
+    }
+    else
+    {
+        for(uint32_t Index = Length; Index > 0; Index--)
+        {
+            if(Set.Contains(Keys[Index-1]))
+                Remove(Keys[Index-1]);
+        }
+    }
+}
 
-/*
-   This is free and unencumbered software released into the public domain.
+template <typename key>
+const key* ak_hashset<key>::begin() const
+{
+    return Keys;
+}
 
-   Anyone is free to copy, modify, publish, use, compile, sell, or
-   distribute this software, either in source code form or as a compiled
-   binary, for any purpose, commercial or non-commercial, and by any
-   means.
+template <typename key>
+const key* ak_hashset<key>::end() const
+{
+    return Keys+Length;
+}
 
-   In jurisdictions that recognize copyright laws, the author or authors
-   of this software dedicate any and all copyright interest in the
-   software to the public domain. We make this dedication for the benefit
-   of the public at large and to the detriment of our heirs and
-   successors. We intend this dedication to be an overt act of
-   relinquishment in perpetuity of all present and future rights to this
-   software under copyright law.
+template <typename key>
+ak_hashset<key> AK_Create_Hash_Set(uint32_t InitialSlotCapacity, uint32_t InitialItemCapacity, ak_allocator* Allocator)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    
+    ak_hashset<key> Result = {};
+    Result.Allocator = Allocator;
+    Result.SlotCapacity = (uint32_t)AK__Ceil_Pow2(AK__Max(InitialSlotCapacity, 2));
+    Result.ItemCapacity = AK__Max(InitialItemCapacity, 1);
+    
+    Result.Slots = (ak__hashmap_slot*)Allocator->Alloc(sizeof(ak__hashmap_slot)*Result.SlotCapacity, Allocator->UserData);
+    if(!Result.Slots || 
+       !AK__HashMap_Realloc_Items(Allocator, 0, Result.ItemCapacity, &Result.ItemSlots, &Result.Keys, (uint8_t**)NULL))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        AK_Delete(&Result);
+        return {};
+    }
+    AK__Memory_Clear(Result.Slots, sizeof(ak__hashmap_slot)*Result.SlotCapacity);
+    
+    return Result;
+}
 
-   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
-   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
-   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
-   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
-   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
-   OTHER DEALINGS IN THE SOFTWARE.
+template <typename key>
+void AK_Delete(ak_hashset<key>* HashSet)
+{
+    if(HashSet && HashSet->Allocator)
+    {
+        if(HashSet->Slots) HashSet->Allocator->Free(HashSet->Slots, HashSet->Allocator->UserData);
+        if(HashSet->OldSlots) HashSet->Allocator->Free(HashSet->OldSlots, HashSet->Allocator->UserData);
+        if(HashSet->ItemSlots) HashSet->Allocator->Free(HashSet->ItemSlots, HashSet->Allocator->UserData);
+        *HashSet = {};
+    }
+}
 
-   For more information, please refer to <http://unlicense.org/>
-*/
+//~Hash multimap implementation
+#define AK__HASH_MULTIMAP_SEEN_BIT 0x8000000000000000ull
 
-#ifndef SHEREDOM_UTEST_H_INCLUDED
-#define SHEREDOM_UTEST_H_INCLUDED
+template <typename key, typename value>
+void ak_hash_multimap<key, value>::Add(const key& Key, const value& Value)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    Groups.Allocator = Allocator;
+    Pairs.Allocator = Allocator;
+    Spans.Allocator = Allocator;
+    
+    bool WasInserted;
+    uint32_t* Group = Groups.Find_Or_Add(Key, &WasInserted);
+    if(WasInserted) *Group = Groups.Length-1;
+    
+    ak__hash_multimap_pair<value> Pair;
+    Pair.Group = *Group;
+    Pair.Value = Value;
+    if(!Pairs.Add(Pair))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return;
+    }
+    Length++;
+}
 
-#ifdef _MSC_VER
-/*
-   Disable warning about not inlining 'inline' functions.
-*/
-#pragma warning(disable : 4710)
+//NOTE(EVERYONE): Adds an empty span for every group created since the last pack. Grows geometrically since groups 
+//trickle in a few at a time between Finds
+template <typename key, typename value>
+bool AK__Hash_Multimap_Grow_Spans(ak_hash_multimap<key, value>* Map)
+{
+    uint64_t SpanCount = Map->Spans.Length;
+    uint64_t GroupCount = Map->Groups.Length;
+    if(GroupCount > Map->Spans.Capacity && !Map->Spans.Reserve(AK__Max(GroupCount, Map->Spans.Capacity*2)))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    
+    Map->Spans.Length = GroupCount;
+    for(uint64_t GroupIndex = SpanCount; GroupIndex < GroupCount; GroupIndex++)
+        Map->Spans.Data[GroupIndex] = {};
+    return true;
+}
 
-/*
-   Disable warning about inlining functions that are not marked 'inline'.
-*/
-#pragma warning(disable : 4711)
+template <typename key, typename value>
+void ak_hash_multimap<key, value>::Build()
+{
+    if(!Pairs.Length && PackedLength == Length) return;
+    
+    value* NewValues = (value*)Allocator->Alloc(Length*sizeof(value), Allocator->UserData);
+    if(!NewValues || !AK__Hash_Multimap_Grow_Spans(this))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        if(NewValues) Allocator->Free(NewValues, Allocator->UserData);
+        return;
+    }
+    
+    //NOTE(EVERYONE): Counting sort by group. Packed values keep their place in front of the new pairs of their group
+    ak__hash_multimap_group* GroupSpans = Spans.Data;
+    for(uint64_t PairIndex = 0; PairIndex < Pairs.Length; PairIndex++)
+        GroupSpans[Pairs.Data[PairIndex].Group].PendingCount++;
+    
+    uint64_t Offset = 0;
+    for(uint64_t GroupIndex = 0; GroupIndex < Spans.Length; GroupIndex++)
+    {
+        ak__hash_multimap_group* Group = GroupSpans + GroupIndex;
+        if(Group->Count) AK__Memory_Copy(NewValues + Offset, PackedValues + Group->Offset, Group->Count*sizeof(value));
+        Group->Offset = Offset;
+        Group->Capacity = Group->Count + Group->PendingCount;
+        Group->PendingCount = 0;
+        Offset += Group->Capacity;
+    }
+    
+    for(uint64_t PairIndex = 0; PairIndex < Pairs.Length; PairIndex++)
+    {
+        ak__hash_multimap_group* Group = GroupSpans + Pairs.Data[PairIndex].Group;
+        NewValues[Group->Offset + Group->Count++] = Pairs.Data[PairIndex].Value;
+    }
+    
+    if(PackedValues) Allocator->Free(PackedValues, Allocator->UserData);
+    PackedValues = NewValues;
+    PackedLength = Length;
+    PackedCapacity = Length;
+    WastedLength = 0;
+    Pairs.Length = 0;
+}
 
-#if _MSC_VER > 1900
-/*
-  Disable warning about preprocessor macros not being defined in MSVC headers.
-*/
-#pragma warning(disable : 4668)
-
-/*
-  Disable warning about no function prototype given in MSVC headers.
-*/
-#pragma warning(disable : 4255)
+//NOTE(EVERYONE): Packs only the pairs added since the last pack, in three passes over them: count the new values of 
+//each group, size the groups that have to move (the seen bit marks a group as sized), then move and append
+template <typename key, typename value>
+void AK__Hash_Multimap_Pack_Pending(ak_hash_multimap<key, value>* Map)
+{
+    if(!Map->PackedValues || Map->WastedLength*2 >= Map->PackedLength)
+    {
+        Map->Build();
+        return;
+    }
+    
+    if(!AK__Hash_Multimap_Grow_Spans(Map)) return;
+    
+    const ak__hash_multimap_pair<value>* Pairs = Map->Pairs.Data;
+    uint64_t PairCount = Map->Pairs.Length;
+    ak__hash_multimap_group* GroupSpans = Map->Spans.Data;
+    for(uint64_t PairIndex = 0; PairIndex < PairCount; PairIndex++)
+        GroupSpans[Pairs[PairIndex].Group].PendingCount++;
+    
+    uint64_t NewLength = Map->PackedLength;
+    for(uint64_t PairIndex = 0; PairIndex < PairCount; PairIndex++)
+    {
+        ak__hash_multimap_group* Group = GroupSpans + Pairs[PairIndex].Group;
+        if(Group->PendingCount & AK__HASH_MULTIMAP_SEEN_BIT) continue;
+        
+        uint64_t Count = Group->Count + Group->PendingCount;
+        if(Count > Group->Capacity) NewLength += AK__Max(Count, Group->Capacity*2);
+        Group->PendingCount |= AK__HASH_MULTIMAP_SEEN_BIT;
+    }
+    
+    if(NewLength > Map->PackedCapacity)
+    {
+        ak_allocator* Allocator = Map->Allocator;
+        uint64_t NewCapacity = AK__Max(NewLength, Map->PackedCapacity*2);
+        value* NewValues = (value*)Allocator->Alloc(NewCapacity*sizeof(value), Allocator->UserData);
+        if(!NewValues)
+        {
+            //TODO(JJ): Diagnostic and error logging
+            for(uint64_t PairIndex = 0; PairIndex < PairCount; PairIndex++)
+                GroupSpans[Pairs[PairIndex].Group].PendingCount = 0;
+            return;
+        }
+        
+        AK__Memory_Copy(NewValues, Map->PackedValues, Map->PackedLength*sizeof(value));
+        Allocator->Free(Map->PackedValues, Allocator->UserData);
+        Map->PackedValues = NewValues;
+        Map->PackedCapacity = NewCapacity;
+    }
+    
+    value* Values = Map->PackedValues;
+    for(uint64_t PairIndex = 0; PairIndex < PairCount; PairIndex++)
+    {
+        ak__hash_multimap_group* Group = GroupSpans + Pairs[PairIndex].Group;
+        if(Group->PendingCount)
+        {
+            uint64_t Count = Group->Count + (Group->PendingCount & ~AK__HASH_MULTIMAP_SEEN_BIT);
+            if(Count > Group->Capacity)
+            {
+                uint64_t Capacity = AK__Max(Count, Group->Capacity*2);
+                AK__Memory_Copy(Values + Map->PackedLength, Values + Group->Offset, Group->Count*sizeof(value));
+                Map->WastedLength += Group->Capacity;
+                Group->Offset = Map->PackedLength;
+                Group->Capacity = Capacity;
+                Map->PackedLength += Capacity;
+            }
+            Group->PendingCount = 0;
+        }
+        
+        Values[Group->Offset + Group->Count++] = Pairs[PairIndex].Value;
+    }
+    
+    Map->Pairs.Length = 0;
+}
 
-/*
-  Disable warning about pointer or reference to potentially throwing function.
-*/
-#pragma warning(disable : 5039)
-#endif
+template <typename key, typename value>
+ak_array<value> ak_hash_multimap<key, value>::Find(const key& Key)
+{
+    return Find_As(Key);
+}
 
-#pragma warning(push, 1)
-#endif
+template <typename key, typename value>
+template <typename lookup>
+ak_array<value> ak_hash_multimap<key, value>::Find_As(const lookup& Key)
+{
+    if(Pairs.Length) AK__Hash_Multimap_Pack_Pending(this);
+    
+    ak_array<value> Result;
+    uint32_t* Group = Groups.Find_As(Key);
+    if(Group && *Group < Spans.Length)
+    {
+        Result.Data = PackedValues + Spans.Data[*Group].Offset;
+        Result.Length = Spans.Data[*Group].Count;
+    }
+    return Result;
+}
 
-#if defined(_MSC_VER) && (_MSC_VER < 1920)
-typedef __int64 utest_int64_t;
-typedef unsigned __int64 utest_uint64_t;
-typedef unsigned __int32 utest_uint32_t;
-#else
-#include <stdint.h>
-typedef int64_t utest_int64_t;
-typedef uint64_t utest_uint64_t;
-typedef uint32_t utest_uint32_t;
-#endif
+template <typename key, typename value>
+void ak_hash_multimap<key, value>::Clear()
+{
+    Groups.Clear();
+    Pairs.Length = 0;
+    Spans.Length = 0;
+    if(PackedValues) Allocator->Free(PackedValues, Allocator->UserData);
+    PackedValues = NULL;
+    PackedLength = 0;
+    PackedCapacity = 0;
+    WastedLength = 0;
+    Length = 0;
+}
 
-#include <stddef.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <errno.h>
+template <typename key, typename value>
+ak_hash_multimap<key, value> AK_Create_Hash_Multimap(ak_allocator* Allocator)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    
+    ak_hash_multimap<key, value> Result;
+    Result.Allocator = Allocator;
+    Result.Groups.Allocator = Allocator;
+    Result.Pairs.Allocator = Allocator;
+    Result.Spans.Allocator = Allocator;
+    return Result;
+}
 
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
+template <typename key, typename value>
+void AK_Delete(ak_hash_multimap<key, value>* Map)
+{
+    if(Map)
+    {
+        if(Map->PackedValues) Map->Allocator->Free(Map->PackedValues, Map->Allocator->UserData);
+        if(Map->Groups.ItemSlots) AK_Delete(&Map->Groups);
+        AK_Delete(&Map->Pairs);
+        AK_Delete(&Map->Spans);
+        *Map = {};
+    }
+}
 
-#if defined(__cplusplus)
-#define UTEST_C_FUNC extern "C"
-#else
-#define UTEST_C_FUNC
-#endif
+//~Paged hash map implementation
+#define AK__PAGED_HASHMAP_INVALID_ITEM ((uint32_t)-1)
+#define AK__PAGED_HASHMAP_MIN_PAGE_CAPACITY 16
+#define AK__PAGED_HASHMAP_MAX_PAGE_CAPACITY 4096
 
-#if defined(_MSC_VER) \
-|| defined(__MINGW64__) \
-|| defined(__MINGW32__)
+//NOTE(EVERYONE): A page holds the keys, then the values, then the free list links of its items
+template <typename key, typename value>
+uint64_t AK__Paged_HashMap_Values_Offset(const ak_paged_hashmap<key, value>* Map)
+{
+    return AK__Memory_Align(sizeof(key) << Map->PageShift, alignof(value));
+}
 
-#if defined(__MINGW64__) || defined(__MINGW32__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpragmas"
-#pragma GCC diagnostic ignored "-Wunknown-pragmas"
-#endif
+template <typename key, typename value>
+uint64_t AK__Paged_HashMap_Links_Offset(const ak_paged_hashmap<key, value>* Map)
+{
+    return AK__Memory_Align(AK__Paged_HashMap_Values_Offset(Map) + (sizeof(value) << Map->PageShift), alignof(uint32_t));
+}
 
-// define UTEST_USE_OLD_QPC before #include "utest.h" to use old QueryPerformanceCounter
-#ifndef UTEST_USE_OLD_QPC
-#pragma warning(push, 0)
-#include <Windows.h>
-#pragma warning(pop)
+template <typename key, typename value>
+uint64_t AK__Paged_HashMap_Alignment()
+{
+    return AK__Max(AK__Max(alignof(key), alignof(value)), alignof(ak__paged_hashmap_block));
+}
 
-typedef LARGE_INTEGER utest_large_integer;
-#else
-//use old QueryPerformanceCounter definitions (not sure is this needed in some edge cases or not)
-//on Win7 with VS2015 these extern declaration cause "second C linkage of overloaded function not allowed" error
-typedef union {
-    struct {
-        unsigned long LowPart;
-        long HighPart;
-    } DUMMYSTRUCTNAME;
-    struct {
-        unsigned long LowPart;
-        long HighPart;
-    } u;
-    utest_int64_t QuadPart;
-} utest_large_integer;
+template <typename key, typename value>
+key* AK__Paged_HashMap_Key(const ak_paged_hashmap<key, value>* Map, uint32_t Index)
+{
+    uint8_t* Page = Map->Pages[Index >> Map->PageShift];
+    return (key*)Page + (Index & ((1u << Map->PageShift)-1));
+}
 
-UTEST_C_FUNC __declspec(dllimport) int __stdcall QueryPerformanceCounter(
-                                                                         utest_large_integer *);
-UTEST_C_FUNC __declspec(dllimport) int __stdcall QueryPerformanceFrequency(
-                                                                           utest_large_integer *);
+template <typename key, typename value>
+value* AK__Paged_HashMap_Value(const ak_paged_hashmap<key, value>* Map, uint32_t Index)
+{
+    uint8_t* Page = Map->Pages[Index >> Map->PageShift];
+    return (value*)(Page + AK__Paged_HashMap_Values_Offset(Map)) + (Index & ((1u << Map->PageShift)-1));
+}
 
-#if defined(__MINGW64__) || defined(__MINGW32__)
-#pragma GCC diagnostic pop
-#endif
-#endif
+template <typename key, typename value>
+uint32_t* AK__Paged_HashMap_Link(const ak_paged_hashmap<key, value>* Map, uint32_t Index)
+{
+    uint8_t* Page = Map->Pages[Index >> Map->PageShift];
+    return (uint32_t*)(Page + AK__Paged_HashMap_Links_Offset(Map)) + (Index & ((1u << Map->PageShift)-1));
+}
 
-#elif defined(__linux__) \
-|| defined(__FreeBSD__) \
-|| defined(__OpenBSD__) \
-|| defined(__NetBSD__) \
-|| defined(__DragonFly__) \
-|| defined(__sun__) \
-|| defined(__HAIKU__)
-/*
-   slightly obscure include here - we need to include glibc's features.h, but
-   we don't want to just include a header that might not be defined for other
-   c libraries like musl. Instead we include limits.h, which we know on all
-   glibc distributions includes features.h
-*/
-#include <limits.h>
+template <typename key, typename value>
+struct ak__paged_hashmap_keys
+{
+    const ak_paged_hashmap<key, value>* Map;
+    
+    const key& operator[](uint32_t Index) const
+    {
+        return *AK__Paged_HashMap_Key(Map, Index);
+    }
+};
 
-#if defined(__GLIBC__) && defined(__GLIBC_MINOR__)
-#include <time.h>
+uint32_t AK__Paged_HashMap_Get_Max_Length(uint32_t SlotCapacity)
+{
+    uint32_t Result = (uint32_t)(((uint64_t)SlotCapacity*2)/3);
+    return AK__Min(Result, SlotCapacity-1);
+}
 
-#if ((2 < __GLIBC__) || ((2 == __GLIBC__) && (17 <= __GLIBC_MINOR__)))
-/* glibc is version 2.17 or above, so we can just use clock_gettime */
-#define UTEST_USE_CLOCKGETTIME
-#else
-#include <sys/syscall.h>
-#include <unistd.h>
-#endif
-#else // Other libc implementations
-#include <time.h>
-#define UTEST_USE_CLOCKGETTIME
-#endif
+//NOTE(EVERYONE): Takes the first retired block that is large enough, giving what is left of it back, and only pushes 
+//onto the arena when none fits
+template <typename key, typename value>
+void* AK__Paged_HashMap_Push(ak_paged_hashmap<key, value>* Map, uint64_t Size)
+{
+    uint64_t Alignment = AK__Paged_HashMap_Alignment<key, value>();
+    Size = AK__Memory_Align(AK__Max(Size, sizeof(ak__paged_hashmap_block)), Alignment);
+    
+    for(ak__paged_hashmap_block** Link = &Map->RetiredBlocks; *Link; Link = &(*Link)->Next)
+    {
+        ak__paged_hashmap_block* Block = *Link;
+        if(Block->Size >= Size)
+        {
+            *Link = Block->Next;
+            
+            uint64_t Remaining = Block->Size-Size;
+            if(Remaining >= sizeof(ak__paged_hashmap_block))
+            {
+                ak__paged_hashmap_block* Rest = (ak__paged_hashmap_block*)((uint8_t*)Block + Size);
+                Rest->Size = Remaining;
+                Rest->Next = Map->RetiredBlocks;
+                Map->RetiredBlocks = Rest;
+            }
+            return Block;
+        }
+    }
+    
+    return Map->Arena->Push(Size, Alignment, AK_ARENA_NO_CLEAR).Data;
+}
 
-#elif defined(__APPLE__)
-#include <mach/mach_time.h>
-#endif
+template <typename key, typename value>
+void AK__Paged_HashMap_Retire(ak_paged_hashmap<key, value>* Map, void* Memory, uint64_t Size)
+{
+    if(!Memory || Size < sizeof(ak__paged_hashmap_block)) return;
+    
+    ak__paged_hashmap_block* Block = (ak__paged_hashmap_block*)Memory;
+    Block->Size = Size;
+    Block->Next = Map->RetiredBlocks;
+    Map->RetiredBlocks = Block;
+}
 
-#if defined(_MSC_VER) && (_MSC_VER < 1920)
-#define UTEST_PRId64 "I64d"
-#define UTEST_PRIu64 "I64u"
-#else
-#include <inttypes.h>
+template <typename key, typename value>
+bool AK__Paged_HashMap_Resize_Slots(ak_paged_hashmap<key, value>* Map, uint32_t NewCapacity)
+{
+    uint64_t AllocSize = NewCapacity*sizeof(ak__hashmap_slot);
+    ak__hashmap_slot* Slots = (ak__hashmap_slot*)AK__Paged_HashMap_Push(Map, AllocSize);
+    if(!Slots)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    AK__Memory_Clear(Slots, AllocSize);
+    
+    uint32_t SlotMask = NewCapacity-1;
+    for(uint32_t OldSlotIndex = 0; OldSlotIndex < Map->SlotCapacity; OldSlotIndex++)
+    {
+        const ak__hashmap_slot* OldSlot = Map->Slots + OldSlotIndex;
+        if(OldSlot->IsValid)
+        {
+            uint32_t BaseSlot = OldSlot->Hash & SlotMask;
+            uint32_t Slot = BaseSlot;
+            while(Slots[Slot].IsValid)
+                Slot = (Slot+1) & SlotMask;
+            
+            Slots[Slot].Hash = OldSlot->Hash;
+            Slots[Slot].ItemIndex = OldSlot->ItemIndex;
+            Slots[Slot].IsValid = true;
+            Slots[BaseSlot].BaseCount++;
+        }
+    }
+    
+    AK__Paged_HashMap_Retire(Map, Map->Slots, Map->SlotCapacity*sizeof(ak__hashmap_slot));
+    Map->Slots = Slots;
+    Map->SlotCapacity = NewCapacity;
+    return true;
+}
 
-#define UTEST_PRId64 PRId64
-#define UTEST_PRIu64 PRIu64
-#endif
+template <typename key, typename value>
+uint32_t AK__Paged_HashMap_Allocate_Item(ak_paged_hashmap<key, value>* Map)
+{
+    if(Map->FreeItem != AK__PAGED_HASHMAP_INVALID_ITEM)
+    {
+        uint32_t Result = Map->FreeItem;
+        Map->FreeItem = *AK__Paged_HashMap_Link(Map, Result);
+        return Result;
+    }
+    
+    if(Map->ItemCount == (Map->PageCount << Map->PageShift))
+    {
+        if(Map->PageCount == Map->PageListCapacity)
+        {
+            uint32_t NewCapacity = AK__Max(Map->PageListCapacity*2, 8);
+            uint8_t** Pages = (uint8_t**)AK__Paged_HashMap_Push(Map, NewCapacity*sizeof(uint8_t*));
+            if(!Pages)
+            {
+                //TODO(JJ): Diagnostic and error logging
+                return AK__PAGED_HASHMAP_INVALID_ITEM;
+            }
+            
+            if(Map->Pages) AK__Memory_Copy(Pages, Map->Pages, Map->PageCount*sizeof(uint8_t*));
+            AK__Paged_HashMap_Retire(Map, Map->Pages, Map->PageListCapacity*sizeof(uint8_t*));
+            Map->Pages = Pages;
+            Map->PageListCapacity = NewCapacity;
+        }
+        
+        uint64_t PageSize = AK__Paged_HashMap_Links_Offset(Map) + (sizeof(uint32_t) << Map->PageShift);
+        uint8_t* Page = (uint8_t*)AK__Paged_HashMap_Push(Map, PageSize);
+        if(!Page)
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return AK__PAGED_HASHMAP_INVALID_ITEM;
+        }
+        Map->Pages[Map->PageCount++] = Page;
+    }
+    
+    return Map->ItemCount++;
+}
 
-#if defined(__cplusplus)
-#define UTEST_INLINE inline
+template <typename key, typename value>
+void AK__Paged_HashMap_Init(ak_paged_hashmap<key, value>* Map, uint32_t EstimatedCount)
+{
+    uint32_t Estimate = AK__Max(EstimatedCount, 1);
+    uint64_t PageCapacity = AK__Ceil_Pow2(AK__Min(AK__Max(Estimate, AK__PAGED_HASHMAP_MIN_PAGE_CAPACITY), AK__PAGED_HASHMAP_MAX_PAGE_CAPACITY));
+    Map->PageShift = AK__Count_Trailing_Zeros32((uint32_t)PageCapacity);
+    
+    uint32_t SlotCapacity = 2;
+    while(Estimate > AK__Paged_HashMap_Get_Max_Length(SlotCapacity))
+        SlotCapacity *= 2;
+    AK__Paged_HashMap_Resize_Slots(Map, SlotCapacity);
+}
 
-#if defined(__clang__)
-#define UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS                               \
-_Pragma("clang diagnostic push")                                             \
-_Pragma("clang diagnostic ignored \"-Wglobal-constructors\"")
-
-#define UTEST_INITIALIZER_END_DISABLE_WARNINGS _Pragma("clang diagnostic pop")
-#else
-#define UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS
-#define UTEST_INITIALIZER_END_DISABLE_WARNINGS
-#endif
-
-#define UTEST_INITIALIZER(f)                                                   \
-struct f##_cpp_struct { f##_cpp_struct(); }; \
-UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS static f##_cpp_struct f##_cpp_global UTEST_INITIALIZER_END_DISABLE_WARNINGS; \
-f##_cpp_struct::f##_cpp_struct()
-#elif defined(_MSC_VER)
-#define UTEST_INLINE __forceinline
-
-#if defined(_WIN64)
-#define UTEST_SYMBOL_PREFIX
-#else
-#define UTEST_SYMBOL_PREFIX "_"
-#endif
-
-#if defined(__clang__)
-#define UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS                               \
-_Pragma("clang diagnostic push")                                             \
-_Pragma("clang diagnostic ignored \"-Wmissing-variable-declarations\"")
-
-#define UTEST_INITIALIZER_END_DISABLE_WARNINGS _Pragma("clang diagnostic pop")
-#else
-#define UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS
-#define UTEST_INITIALIZER_END_DISABLE_WARNINGS
-#endif
-
-#pragma section(".CRT$XCU", read)
-#define UTEST_INITIALIZER(f)                                                   \
-static void __cdecl f(void);                                                 \
-UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS                                     \
-__pragma(comment(linker, "/include:" UTEST_SYMBOL_PREFIX #f "_"))            \
-UTEST_C_FUNC __declspec(allocate(".CRT$XCU")) void(__cdecl *             \
-f##_)(void) = f;      \
-UTEST_INITIALIZER_END_DISABLE_WARNINGS                                       \
-static void __cdecl f(void)
-#else
-#if defined(__linux__)
-#if defined(__clang__)
-#if __has_warning("-Wreserved-id-macro")
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wreserved-id-macro"
-#endif
-#endif
-
-#define __STDC_FORMAT_MACROS 1
-
-#if defined(__clang__)
-#if __has_warning("-Wreserved-id-macro")
-#pragma clang diagnostic pop
-#endif
-#endif
-#endif
-
-#define UTEST_INLINE inline
-
-#define UTEST_INITIALIZER(f)                                                   \
-static void f(void) __attribute__((constructor));                            \
-static void f(void)
-#endif
+template <typename key, typename value>
+void ak_paged_hashmap<key, value>::Add(const key& Key, const value& Value)
+{
+    bool WasInserted;
+    value* Result = Find_Or_Add(Key, &WasInserted);
+    AK_STD_ASSERT(WasInserted, "Cannot insert duplicate keys into hash map");
+    if(Result) *Result = Value;
+}
 
-#if defined(__cplusplus)
-#define UTEST_CAST(type, x) static_cast<type>(x)
-#define UTEST_PTR_CAST(type, x) reinterpret_cast<type>(x)
-#define UTEST_EXTERN extern "C"
-#define UTEST_NULL NULL
-#else
-#define UTEST_CAST(type, x) ((type)(x))
-#define UTEST_PTR_CAST(type, x) ((type)(x))
-#define UTEST_EXTERN extern
-#define UTEST_NULL 0
-#endif
+template <typename key, typename value>
+value* ak_paged_hashmap<key, value>::Find(const key& Key)
+{
+    return Find_As(Key);
+}
 
-#ifdef _MSC_VER
-/*
-    io.h contains definitions for some structures with natural padding. This is
-    uninteresting, but for some reason MSVC's behaviour is to warn about
-    including this system header. That *is* interesting
-*/
-#pragma warning(disable : 4820)
-#pragma warning(push, 1)
-#include <io.h>
-#pragma warning(pop)
-#define UTEST_COLOUR_OUTPUT() (_isatty(_fileno(stdout)))
-#else
-#if  defined(__EMSCRIPTEN__)
-#include <emscripten/html5.h>
-#define UTEST_COLOUR_OUTPUT() false
-#else
-#include <unistd.h>
-#define UTEST_COLOUR_OUTPUT() (isatty(STDOUT_FILENO))
-#endif
-#endif
+template <typename key, typename value>
+template <typename lookup>
+value* ak_paged_hashmap<key, value>::Find_As(const lookup& Key)
+{
+    if(!Slots) return NULL;
+    
+    ak__paged_hashmap_keys<key, value> PageKeys = {this};
+    ak__hashmap_probe Probe = AK__HashMap_Probe_Keys<key>(PageKeys, Slots, SlotCapacity, Key, ak_hash_traits<key>::Hash(Key));
+    return (Probe.Slot >= 0) ? AK__Paged_HashMap_Value(this, Slots[Probe.Slot].ItemIndex) : NULL;
+}
 
-static UTEST_INLINE void *utest_realloc(void *const pointer, size_t new_size) {
-    void *const new_pointer = realloc(pointer, new_size);
+template <typename key, typename value>
+value* ak_paged_hashmap<key, value>::Find_Or_Add(const key& Key, bool* WasInserted)
+{
+    AK_STD_ASSERT(Arena, "Paged hash map needs an arena");
+    if(!Slots) AK__Paged_HashMap_Init(this, AK_HASH_MAP_INITIAL_ITEM_CAPACITY);
     
-    if (UTEST_NULL == new_pointer) {
-        free(new_pointer);
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    AK_STD_ASSERT(Hash, "Invalid hash");
+    
+    ak__paged_hashmap_keys<key, value> PageKeys = {this};
+    ak__hashmap_probe Probe = AK__HashMap_Probe_Keys<key>(PageKeys, Slots, SlotCapacity, Key, Hash);
+    if(WasInserted) *WasInserted = Probe.Slot < 0;
+    if(Probe.Slot >= 0) return AK__Paged_HashMap_Value(this, Slots[Probe.Slot].ItemIndex);
+    
+    if(Length >= AK__Paged_HashMap_Get_Max_Length(SlotCapacity))
+    {
+        if(!AK__Paged_HashMap_Resize_Slots(this, SlotCapacity*2)) return NULL;
+        Probe = AK__HashMap_Probe_Keys<key>(PageKeys, Slots, SlotCapacity, Key, Hash);
     }
     
-    return new_pointer;
+    uint32_t ItemIndex = AK__Paged_HashMap_Allocate_Item(this);
+    if(ItemIndex == AK__PAGED_HASHMAP_INVALID_ITEM) return NULL;
+    
+    ak__hashmap_slot* Slot = Slots + Probe.InsertSlot;
+    Slot->Hash = Hash;
+    Slot->ItemIndex = ItemIndex;
+    Slot->IsValid = true;
+    Slots[Hash & (SlotCapacity-1)].BaseCount++;
+    Length++;
+    
+    *AK__Paged_HashMap_Key(this, ItemIndex) = Key;
+    value* Result = AK__Paged_HashMap_Value(this, ItemIndex);
+    AK__Memory_Clear(Result, sizeof(value));
+    return Result;
 }
 
-static UTEST_INLINE utest_int64_t utest_ns(void) {
-#if defined(_MSC_VER) || defined(__MINGW64__) || defined(__MINGW32__)
-    utest_large_integer counter;
-    utest_large_integer frequency;
-    QueryPerformanceCounter(&counter);
-    QueryPerformanceFrequency(&frequency);
-    return UTEST_CAST(utest_int64_t,
-                      (counter.QuadPart * 1000000000) / frequency.QuadPart);
-#elif defined(__linux__) && defined(__STRICT_ANSI__)
-    return UTEST_CAST(utest_int64_t, clock()) * 1000000000 / CLOCKS_PER_SEC;
-#elif defined(__linux__) \
-|| defined(__FreeBSD__) \
-|| defined(__OpenBSD__) \
-|| defined(__NetBSD__) \
-|| defined(__DragonFly__) \
-|| defined(__sun__) \
-|| defined(__HAIKU__)
-    struct timespec ts;
-#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__HAIKU__)
-    timespec_get(&ts, TIME_UTC);
-#else
-    const clockid_t cid = CLOCK_REALTIME;
-#if defined(UTEST_USE_CLOCKGETTIME)
-    clock_gettime(cid, &ts);
-#else
-    syscall(SYS_clock_gettime, cid, &ts);
-#endif
-#endif
-    return UTEST_CAST(utest_int64_t, ts.tv_sec) * 1000 * 1000 * 1000 + ts.tv_nsec;
-#elif __APPLE__
-    return UTEST_CAST(utest_int64_t, mach_absolute_time());
-#elif __EMSCRIPTEN__
-    return emscripten_performance_now() * 1000000.0;
-#else
-#error Unsupported platform!
-#endif
+template <typename key, typename value>
+bool ak_paged_hashmap<key, value>::Remove(const key& Key)
+{
+    if(!Slots) return false;
+    
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    ak__paged_hashmap_keys<key, value> PageKeys = {this};
+    ak__hashmap_probe Probe = AK__HashMap_Probe_Keys<key>(PageKeys, Slots, SlotCapacity, Key, Hash);
+    if(Probe.Slot < 0) return false;
+    
+    ak__hashmap_slot* Slot = Slots + Probe.Slot;
+    Slots[Hash & (SlotCapacity-1)].BaseCount--;
+    Slot->Hash = 0;
+    Slot->IsValid = false;
+    
+    *AK__Paged_HashMap_Link(this, Slot->ItemIndex) = FreeItem;
+    FreeItem = Slot->ItemIndex;
+    Length--;
+    return true;
 }
 
-typedef void (*utest_testcase_t)(int *, size_t);
-
-struct utest_test_state_s {
-    utest_testcase_t func;
-    size_t index;
-    char *name;
-};
-
-struct utest_state_s {
-    struct utest_test_state_s *tests;
-    size_t tests_length;
-    FILE *output;
-};
+template <typename key, typename value>
+void ak_paged_hashmap<key, value>::Clear()
+{
+    if(Slots) AK__Memory_Clear(Slots, SlotCapacity*sizeof(ak__hashmap_slot));
+    Length = 0;
+    ItemCount = 0;
+    FreeItem = AK__PAGED_HASHMAP_INVALID_ITEM;
+}
 
-/* extern to the global state utest needs to execute */
-UTEST_EXTERN struct utest_state_s utest_state;
+template <typename key, typename value>
+ak_paged_hashmap<key, value> AK_Create_Paged_Hash_Map(ak_arena* Arena, uint32_t EstimatedCount)
+{
+    ak_paged_hashmap<key, value> Result;
+    Result.Arena = Arena;
+    AK__Paged_HashMap_Init(&Result, EstimatedCount);
+    return Result;
+}
 
-#if defined(_MSC_VER)
-#define UTEST_WEAK __forceinline
-#else
-#define UTEST_WEAK __attribute__((weak))
-#endif
+//~Swiss hash map implementation
+#define AK__SWISS_GROUP_WIDTH 16
+#define AK__SWISS_EMPTY ((int8_t)-128)
+#define AK__SWISS_DELETED ((int8_t)-2)
 
-#if defined(_MSC_VER)
-#define UTEST_UNUSED
+uint32_t AK__Swiss_Match_Tag(const int8_t* Group, int8_t Tag)
+{
+#ifdef AK__SSE2
+    __m128i Controls = _mm_loadu_si128((const __m128i*)Group);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(Controls, _mm_set1_epi8(Tag)));
 #else
-#define UTEST_UNUSED __attribute__((unused))
-#endif
-
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wvariadic-macros"
-#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
-#endif
-#define UTEST_PRINTF(...)                                                      \
-if (utest_state.output) {                                                    \
-fprintf(utest_state.output, __VA_ARGS__);                                  \
-}                                                                            \
-printf(__VA_ARGS__)
-#ifdef __clang__
-#pragma clang diagnostic pop
+    uint32_t Result = 0;
+    for(uint32_t Index = 0; Index < AK__SWISS_GROUP_WIDTH; Index++)
+        if(Group[Index] == Tag) Result |= (1u << Index);
+    return Result;
 #endif
+}
 
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wvariadic-macros"
-#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
-#endif
+uint32_t AK__Swiss_Match_Empty(const int8_t* Group)
+{
+    return AK__Swiss_Match_Tag(Group, AK__SWISS_EMPTY);
+}
 
-#ifdef _MSC_VER
-#define UTEST_SNPRINTF(BUFFER, N, ...) _snprintf_s(BUFFER, N, N, __VA_ARGS__)
+uint32_t AK__Swiss_Match_Empty_Or_Deleted(const int8_t* Group)
+{
+    //NOTE(EVERYONE): Only the empty and deleted tags have their sign bit set
+#ifdef AK__SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)Group));
 #else
-#define UTEST_SNPRINTF(...) snprintf(__VA_ARGS__)
-#endif
-
-#ifdef __clang__
-#pragma clang diagnostic pop
-#endif
-
-#if defined(__cplusplus)
-/* if we are using c++ we can use overloaded methods (its in the language) */
-#define UTEST_OVERLOADABLE
-#elif defined(__clang__)
-/* otherwise, if we are using clang with c - use the overloadable attribute */
-#define UTEST_OVERLOADABLE __attribute__((overloadable))
+    uint32_t Result = 0;
+    for(uint32_t Index = 0; Index < AK__SWISS_GROUP_WIDTH; Index++)
+        if(Group[Index] < 0) Result |= (1u << Index);
+    return Result;
 #endif
+}
 
-#if defined(UTEST_OVERLOADABLE)
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(float f);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(float f) {
-    UTEST_PRINTF("%f", UTEST_CAST(double, f));
+int8_t AK__Swiss_Get_Tag(uint32_t Hash)
+{
+    return (int8_t)(Hash >> 25);
 }
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(double d);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(double d) {
-    UTEST_PRINTF("%f", d);
+uint32_t AK__Swiss_Get_Growth_Capacity(uint32_t SlotCapacity)
+{
+    return SlotCapacity - SlotCapacity/8;
 }
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long double d);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long double d) {
-    UTEST_PRINTF("%Lf", d);
+template <typename key, typename value>
+void AK__Swiss_Set_Control(ak_swiss_hashmap<key, value>* Map, uint32_t Slot, int8_t Control)
+{
+    //NOTE(EVERYONE): The first group of controls is mirrored after the last slot so a group can always be 
+    //loaded with a single unaligned read
+    Map->Controls[Slot] = Control;
+    if(Slot < AK__SWISS_GROUP_WIDTH) Map->Controls[Map->SlotCapacity+Slot] = Control;
 }
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(int i);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(int i) {
-    UTEST_PRINTF("%d", i);
+template <typename key, typename value>
+int64_t AK__Swiss_Find_Slot(ak_swiss_hashmap<key, value>* Map, const key& Key, uint32_t Hash)
+{
+    uint32_t SlotMask = Map->SlotCapacity-1;
+    int8_t Tag = AK__Swiss_Get_Tag(Hash);
+    
+    uint32_t Slot = Hash & SlotMask;
+    for(uint32_t Step = AK__SWISS_GROUP_WIDTH; Step <= Map->SlotCapacity; Step += AK__SWISS_GROUP_WIDTH)
+    {
+        const int8_t* Group = Map->Controls + Slot;
+        
+        uint32_t Matches = AK__Swiss_Match_Tag(Group, Tag);
+        while(Matches)
+        {
+            uint32_t Candidate = (Slot + AK__Count_Trailing_Zeros32(Matches)) & SlotMask;
+            if(ak_hash_traits<key>::Equals(Map->Keys[Map->SlotItems[Candidate]], Key))
+                return (int64_t)Candidate;
+            Matches &= Matches-1;
+        }
+        
+        if(AK__Swiss_Match_Empty(Group)) break;
+        Slot = (Slot+Step) & SlotMask;
+    }
+    
+    return -1;
 }
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(unsigned int i);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(unsigned int i) {
-    UTEST_PRINTF("%u", i);
+template <typename key, typename value>
+uint32_t AK__Swiss_Find_Insert_Slot(ak_swiss_hashmap<key, value>* Map, uint32_t Hash)
+{
+    uint32_t SlotMask = Map->SlotCapacity-1;
+    uint32_t Slot = Hash & SlotMask;
+    
+    //NOTE(EVERYONE): Triangular probing over groups visits every group once the table is a power of two, and the 
+    //load factor guarantees a free slot exists
+    for(uint32_t Step = AK__SWISS_GROUP_WIDTH;; Step += AK__SWISS_GROUP_WIDTH)
+    {
+        uint32_t Matches = AK__Swiss_Match_Empty_Or_Deleted(Map->Controls + Slot);
+        if(Matches) return (Slot + AK__Count_Trailing_Zeros32(Matches)) & SlotMask;
+        Slot = (Slot+Step) & SlotMask;
+    }
 }
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long int i);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long int i) {
-    UTEST_PRINTF("%ld", i);
+template <typename key, typename value>
+bool AK__Swiss_Rehash(ak_swiss_hashmap<key, value>* Map, uint32_t NewCapacity)
+{
+    ak_allocator* Allocator = Map->Allocator;
+    
+    uint64_t ControlSize = AK__Memory_Align(NewCapacity+AK__SWISS_GROUP_WIDTH, alignof(uint32_t));
+    uint8_t* SlotData = (uint8_t*)Allocator->Alloc(ControlSize + NewCapacity*sizeof(uint32_t), Allocator->UserData);
+    if(!SlotData)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    
+    Allocator->Free(Map->Controls, Allocator->UserData);
+    Map->Controls = (int8_t*)SlotData;
+    Map->SlotItems = (uint32_t*)(SlotData + ControlSize);
+    Map->SlotCapacity = NewCapacity;
+    AK__Memory_Set(Map->Controls, (uint8_t)AK__SWISS_EMPTY, NewCapacity+AK__SWISS_GROUP_WIDTH);
+    
+    //NOTE(EVERYONE): Items are dense so rebuilding the table is a single pass over the keys
+    for(uint32_t ItemIndex = 0; ItemIndex < Map->Length; ItemIndex++)
+    {
+        uint32_t Hash = ak_hash_traits<key>::Hash(Map->Keys[ItemIndex]);
+        uint32_t Slot = AK__Swiss_Find_Insert_Slot(Map, Hash);
+        AK__Swiss_Set_Control(Map, Slot, AK__Swiss_Get_Tag(Hash));
+        Map->SlotItems[Slot] = ItemIndex;
+        Map->ItemSlots[ItemIndex] = Slot;
+    }
+    
+    Map->GrowthLeft = AK__Swiss_Get_Growth_Capacity(NewCapacity) - Map->Length;
+    return true;
 }
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long unsigned int i);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long unsigned int i) {
-    UTEST_PRINTF("%lu", i);
+template <typename key, typename value>
+void ak_swiss_hashmap<key, value>::Add(const key& Key, const value& Value)
+{
+    if(!Controls || !ItemSlots)
+        *this = AK_Create_Swiss_Hash_Map<key, value>();
+    
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    AK_STD_ASSERT(AK__Swiss_Find_Slot(this, Key, Hash) < 0, "Cannot insert duplicate keys into hash map");
+    
+    if(!GrowthLeft)
+    {
+        //NOTE(EVERYONE): When most of the used up growth is deleted slots, rehashing in place is enough
+        uint32_t NewCapacity = SlotCapacity;
+        if(Length >= AK__Swiss_Get_Growth_Capacity(SlotCapacity)/2) NewCapacity *= 2;
+        if(!AK__Swiss_Rehash(this, NewCapacity))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return;
+        }
+    }
+    
+    if(Length >= ItemCapacity)
+    {
+        if(!AK__HashMap_Realloc_Items(Allocator, Length, ItemCapacity*2, &ItemSlots, &Keys, &Values))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return;
+        }
+        ItemCapacity *= 2;
+    }
+    
+    uint32_t Slot = AK__Swiss_Find_Insert_Slot(this, Hash);
+    if(Controls[Slot] == AK__SWISS_EMPTY) GrowthLeft--;
+    AK__Swiss_Set_Control(this, Slot, AK__Swiss_Get_Tag(Hash));
+    SlotItems[Slot] = Length;
+    
+    ItemSlots[Length] = Slot;
+    Keys[Length] = Key;
+    Values[Length] = Value;
+    
+    Length++;
 }
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(const void *p);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(const void *p) {
-    UTEST_PRINTF("%p", p);
+template <typename key, typename value>
+value* ak_swiss_hashmap<key, value>::Find(const key& Key)
+{
+    if(!Controls || !ItemSlots)
+        *this = AK_Create_Swiss_Hash_Map<key, value>();
+    
+    int64_t Slot = AK__Swiss_Find_Slot(this, Key, ak_hash_traits<key>::Hash(Key));
+    if(Slot < 0) return NULL;
+    
+    return Values + SlotItems[Slot];
 }
 
-/*
-   long long is a c++11 extension
-*/
-#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L) ||              \
-defined(__cplusplus) && (__cplusplus >= 201103L)
+template <typename key, typename value>
+void ak_swiss_hashmap<key, value>::Remove(const key& Key)
+{
+    if(!Controls || !ItemSlots)
+        *this = AK_Create_Swiss_Hash_Map<key, value>();
+    
+    int64_t Slot = AK__Swiss_Find_Slot(this, Key, ak_hash_traits<key>::Hash(Key));
+    AK_STD_ASSERT(Slot >= 0, "Cannot find entry with key in hash map");
+    
+    if(Slot >= 0)
+    {
+        AK__Swiss_Set_Control(this, (uint32_t)Slot, AK__SWISS_DELETED);
+        
+        uint32_t Index = SlotItems[Slot];
+        uint32_t LastIndex = Length-1;
+        
+        if(Index != LastIndex)
+        {
+            Keys[Index] = Keys[LastIndex];
+            ItemSlots[Index] = ItemSlots[LastIndex];
+            Values[Index] = Values[LastIndex];
+            SlotItems[ItemSlots[Index]] = Index;
+        }
+        
+        Length--;
+    }
+}
 
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
-#endif
+template <typename key, typename value>
+void ak_swiss_hashmap<key, value>::Clear()
+{
+    if(Controls)
+    {
+        AK__Memory_Set(Controls, (uint8_t)AK__SWISS_EMPTY, SlotCapacity+AK__SWISS_GROUP_WIDTH);
+        GrowthLeft = AK__Swiss_Get_Growth_Capacity(SlotCapacity);
+    }
+    Length = 0;
+}
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long long int i);
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long long int i) {
-    UTEST_PRINTF("%lld", i);
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_swiss_hashmap<key, value>::begin() const
+{
+    return AK__HashMap_Begin<key, value>(Keys, Values, &Length);
 }
 
-UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long long unsigned int i);
-UTEST_WEAK UTEST_OVERLOADABLE void
-utest_type_printer(long long unsigned int i) {
-    UTEST_PRINTF("%llu", i);
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_swiss_hashmap<key, value>::end() const
+{
+    return {};
 }
 
-#ifdef __clang__
-#pragma clang diagnostic pop
-#endif
+template <typename key, typename value> 
+ak_swiss_hashmap<key, value> AK_Create_Swiss_Hash_Map(uint32_t InitialSlotCapacity, uint32_t InitialItemCapacity, ak_allocator* Allocator)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    
+    ak_swiss_hashmap<key, value> Result = {};
+    Result.Allocator = Allocator;
+    Result.ItemCapacity = AK__Max(InitialItemCapacity, 1);
+    
+    uint32_t SlotCapacity = (uint32_t)AK__Ceil_Pow2(AK__Max(InitialSlotCapacity, AK__SWISS_GROUP_WIDTH));
+    if(!AK__Swiss_Rehash(&Result, SlotCapacity) || 
+       !AK__HashMap_Realloc_Items(Allocator, 0, Result.ItemCapacity, &Result.ItemSlots, &Result.Keys, &Result.Values))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        AK_Delete(&Result);
+        return {};
+    }
+    
+    return Result;
+}
 
-#endif
-#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
-#define utest_type_printer(val)                                                \
-UTEST_PRINTF(_Generic((val), signed char                                     \
-: "%d", unsigned char                                  \
-: "%u", short                                          \
-: "%d", unsigned short                                 \
-: "%u", int                                            \
-: "%d", long                                           \
-: "%ld", long long                                     \
-: "%lld", unsigned                                     \
-: "%u", unsigned long                                  \
-: "%lu", unsigned long long                            \
-: "%llu", float                                        \
-: "%f", double                                         \
-: "%f", long double                                    \
-: "%Lf", default                                       \
-: _Generic((val - val), ptrdiff_t                      \
-: "%p", default                             \
-: "undef")),                                \
-(val))
-#else
-/*
-   we don't have the ability to print the values we got, so we create a macro
-   to tell our users we can't do anything fancy
-*/
-#define utest_type_printer(...) UTEST_PRINTF("undef")
-#endif
+template <typename key, typename value>
+void AK_Delete(ak_swiss_hashmap<key, value>* HashMap)
+{
+    if(HashMap && HashMap->Allocator)
+    {
+        HashMap->Allocator->Free(HashMap->Controls, HashMap->Allocator->UserData);
+        HashMap->Allocator->Free(HashMap->ItemSlots, HashMap->Allocator->UserData);
+        *HashMap = {};
+    }
+}
 
-#ifdef _MSC_VER
-#define UTEST_SURPRESS_WARNING_BEGIN                                           \
-__pragma(warning(push)) __pragma(warning(disable : 4127))
-#define UTEST_SURPRESS_WARNING_END __pragma(warning(pop))
-#else
-#define UTEST_SURPRESS_WARNING_BEGIN
-#define UTEST_SURPRESS_WARNING_END
-#endif
+//~Robin hood hash map implementation
+void AK__Robin_Hood_Insert_Slot(ak__robin_hood_slot* Slots, uint32_t SlotCapacity, uint32_t* ItemSlots, 
+                                uint32_t Hash, uint32_t ItemIndex)
+{
+    uint32_t SlotMask = SlotCapacity-1;
+    uint32_t Slot = Hash & SlotMask;
+    
+    ak__robin_hood_slot Entry = {Hash, ItemIndex, 1};
+    for(;;)
+    {
+        ak__robin_hood_slot* Current = Slots + Slot;
+        if(!Current->Distance)
+        {
+            *Current = Entry;
+            ItemSlots[Entry.ItemIndex] = Slot;
+            return;
+        }
+        
+        //NOTE(EVERYONE): Take the slot from entries that are closer to their base and keep placing the displaced one
+        if(Current->Distance < Entry.Distance)
+        {
+            ak__robin_hood_slot Displaced = *Current;
+            *Current = Entry;
+            ItemSlots[Entry.ItemIndex] = Slot;
+            Entry = Displaced;
+        }
+        
+        Slot = (Slot+1) & SlotMask;
+        Entry.Distance++;
+    }
+}
 
-#if defined(__cplusplus) && (__cplusplus >= 201103L)
-#define UTEST_AUTO(x) auto
-#elif !defined(__cplusplus)
+template <typename key, typename value>
+int64_t AK__Robin_Hood_Find_Slot(ak_robin_hood_hashmap<key, value>* Map, const key& Key, uint32_t Hash)
+{
+    uint32_t SlotMask = Map->SlotCapacity-1;
+    uint32_t Slot = Hash & SlotMask;
+    
+    for(uint32_t Distance = 1;; Distance++)
+    {
+        ak__robin_hood_slot* Current = Map->Slots + Slot;
+        if(Current->Distance < Distance) break;
+        if(Current->Hash == Hash && ak_hash_traits<key>::Equals(Map->Keys[Current->ItemIndex], Key))
+            return (int64_t)Slot;
+        Slot = (Slot+1) & SlotMask;
+    }
+    
+    return -1;
+}
 
-#if defined(__clang__)
-/* clang-format off */
-/* had to disable clang-format here because it malforms the pragmas */
-#define UTEST_AUTO(x)                                                          \
-_Pragma("clang diagnostic push")                                             \
-_Pragma("clang diagnostic ignored \"-Wgnu-auto-type\"") __auto_type      \
-_Pragma("clang diagnostic pop")
-/* clang-format on */
-#else
-#define UTEST_AUTO(x) __typeof__(x + 0)
-#endif
+template <typename key, typename value>
+bool AK__Robin_Hood_Realloc_Slots(ak_robin_hood_hashmap<key, value>* Map, uint32_t NewCapacity)
+{
+    ak_allocator* Allocator = Map->Allocator;
+    uint64_t AllocSize = NewCapacity*sizeof(ak__robin_hood_slot);
+    ak__robin_hood_slot* NewSlots = (ak__robin_hood_slot*)Allocator->Alloc(AllocSize, Allocator->UserData);
+    if(!NewSlots)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return false;
+    }
+    AK__Memory_Clear(NewSlots, AllocSize);
+    
+    for(uint32_t SlotIndex = 0; SlotIndex < Map->SlotCapacity; SlotIndex++)
+    {
+        ak__robin_hood_slot* Slot = Map->Slots + SlotIndex;
+        if(Slot->Distance)
+            AK__Robin_Hood_Insert_Slot(NewSlots, NewCapacity, Map->ItemSlots, Slot->Hash, Slot->ItemIndex);
+    }
+    
+    if(Map->Slots) Allocator->Free(Map->Slots, Allocator->UserData);
+    Map->Slots = NewSlots;
+    Map->SlotCapacity = NewCapacity;
+    return true;
+}
 
-#else
-#define UTEST_AUTO(x) typeof(x + 0)
-#endif
+template <typename key, typename value>
+void ak_robin_hood_hashmap<key, value>::Add(const key& Key, const value& Value)
+{
+    if(!Slots || !ItemSlots)
+        *this = AK_Create_Robin_Hood_Hash_Map<key, value>();
+    
+    uint32_t Hash = ak_hash_traits<key>::Hash(Key);
+    AK_STD_ASSERT(AK__Robin_Hood_Find_Slot(this, Key, Hash) < 0, "Cannot insert duplicate keys into hash map");
+    
+    if(Length >= (SlotCapacity - SlotCapacity/8))
+    {
+        if(!AK__Robin_Hood_Realloc_Slots(this, SlotCapacity*2))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return;
+        }
+    }
+    
+    if(Length >= ItemCapacity)
+    {
+        if(!AK__HashMap_Realloc_Items(Allocator, Length, ItemCapacity*2, &ItemSlots, &Keys, &Values))
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return;
+        }
+        ItemCapacity *= 2;
+    }
+    
+    Keys[Length] = Key;
+    Values[Length] = Value;
+    AK__Robin_Hood_Insert_Slot(Slots, SlotCapacity, ItemSlots, Hash, Length);
+    
+    Length++;
+}
 
-#if defined(__clang__)
-#define UTEST_STRNCMP(x, y, size)                                              \
-_Pragma("clang diagnostic push")                                             \
-_Pragma("clang diagnostic ignored \"-Wdisabled-macro-expansion\"")       \
-strncmp(x, y, size) _Pragma("clang diagnostic pop")
-#else
-#define UTEST_STRNCMP(x, y, size) strncmp(x, y, size)
-#endif
+template <typename key, typename value>
+value* ak_robin_hood_hashmap<key, value>::Find(const key& Key)
+{
+    if(!Slots || !ItemSlots)
+        *this = AK_Create_Robin_Hood_Hash_Map<key, value>();
+    
+    int64_t Slot = AK__Robin_Hood_Find_Slot(this, Key, ak_hash_traits<key>::Hash(Key));
+    if(Slot < 0) return NULL;
+    
+    return Values + Slots[Slot].ItemIndex;
+}
 
-#if defined(__clang__)
-#define UTEST_EXPECT(x, y, cond)                                               \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-_Pragma("clang diagnostic push")                                           \
-_Pragma("clang diagnostic ignored \"-Wlanguage-extension-token\"")     \
-_Pragma("clang diagnostic ignored \"-Wc++98-compat-pedantic\"")    \
-_Pragma("clang diagnostic ignored \"-Wfloat-equal\"")          \
-UTEST_AUTO(x) xEval = (x);                                 \
-UTEST_AUTO(y) yEval = (y);                                                 \
-if (!((xEval)cond(yEval))) {                                               \
-_Pragma("clang diagnostic pop")                                          \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                \
-UTEST_PRINTF("  Expected : ");                                           \
-utest_type_printer(xEval);                                               \
-UTEST_PRINTF("\n");                                                      \
-UTEST_PRINTF("    Actual : ");                                           \
-utest_type_printer(yEval);                                               \
-UTEST_PRINTF("\n");                                                      \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
-#elif defined(__GNUC__)
-#define UTEST_EXPECT(x, y, cond)                                               \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-UTEST_AUTO(x) xEval = (x);                                                 \
-UTEST_AUTO(y) yEval = (y);                                                 \
-if (!((xEval)cond(yEval))) {                                               \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : ");                                           \
-utest_type_printer(xEval);                                               \
-UTEST_PRINTF("\n");                                                      \
-UTEST_PRINTF("    Actual : ");                                           \
-utest_type_printer(yEval);                                               \
-UTEST_PRINTF("\n");                                                      \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
-#else
-#define UTEST_EXPECT(x, y, cond)                                               \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (!((x)cond(y))) {                                                       \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
-#endif
+template <typename key, typename value>
+void ak_robin_hood_hashmap<key, value>::Remove(const key& Key)
+{
+    if(!Slots || !ItemSlots)
+        *this = AK_Create_Robin_Hood_Hash_Map<key, value>();
+    
+    int64_t FoundSlot = AK__Robin_Hood_Find_Slot(this, Key, ak_hash_traits<key>::Hash(Key));
+    AK_STD_ASSERT(FoundSlot >= 0, "Cannot find entry with key in hash map");
+    
+    if(FoundSlot >= 0)
+    {
+        uint32_t SlotMask = SlotCapacity-1;
+        uint32_t Slot = (uint32_t)FoundSlot;
+        uint32_t Index = Slots[Slot].ItemIndex;
+        
+        //NOTE(EVERYONE): Backward shift the rest of the run so no tombstone is left behind
+        uint32_t NextSlot = (Slot+1) & SlotMask;
+        while(Slots[NextSlot].Distance > 1)
+        {
+            Slots[Slot] = Slots[NextSlot];
+            Slots[Slot].Distance--;
+            ItemSlots[Slots[Slot].ItemIndex] = Slot;
+            Slot = NextSlot;
+            NextSlot = (NextSlot+1) & SlotMask;
+        }
+        Slots[Slot] = {};
+        
+        uint32_t LastIndex = Length-1;
+        if(Index != LastIndex)
+        {
+            Keys[Index] = Keys[LastIndex];
+            ItemSlots[Index] = ItemSlots[LastIndex];
+            Values[Index] = Values[LastIndex];
+            Slots[ItemSlots[Index]].ItemIndex = Index;
+        }
+        
+        Length--;
+    }
+}
 
-#define EXPECT_TRUE(x)                                                         \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (!(x)) {                                                                \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : true\n");                                     \
-UTEST_PRINTF("    Actual : %s\n", (x) ? "true" : "false");               \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+template <typename key, typename value>
+void ak_robin_hood_hashmap<key, value>::Clear()
+{
+    AK__Memory_Clear(Slots, SlotCapacity*sizeof(ak__robin_hood_slot));
+    Length = 0;
+}
 
-#define EXPECT_FALSE(x)                                                        \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (x) {                                                                   \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : false\n");                                    \
-UTEST_PRINTF("    Actual : %s\n", (x) ? "true" : "false");               \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_robin_hood_hashmap<key, value>::begin() const
+{
+    return AK__HashMap_Begin<key, value>(Keys, Values, &Length);
+}
 
-#define EXPECT_EQ(x, y) UTEST_EXPECT(x, y, ==)
-#define EXPECT_NE(x, y) UTEST_EXPECT(x, y, !=)
-#define EXPECT_LT(x, y) UTEST_EXPECT(x, y, <)
-#define EXPECT_LE(x, y) UTEST_EXPECT(x, y, <=)
-#define EXPECT_GT(x, y) UTEST_EXPECT(x, y, >)
-#define EXPECT_GE(x, y) UTEST_EXPECT(x, y, >=)
+template <typename key, typename value>
+ak_hashmap_iterator<key, value> ak_robin_hood_hashmap<key, value>::end() const
+{
+    return {};
+}
 
-#define EXPECT_STREQ(x, y)                                                     \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (0 != strcmp(x, y)) {                                                   \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : \"%s\"\n", x);                                \
-UTEST_PRINTF("    Actual : \"%s\"\n", y);                                \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+template <typename key, typename value> 
+ak_robin_hood_hashmap<key, value> AK_Create_Robin_Hood_Hash_Map(uint32_t InitialSlotCapacity, uint32_t InitialItemCapacity, ak_allocator* Allocator)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    
+    ak_robin_hood_hashmap<key, value> Result = {};
+    Result.Allocator = Allocator;
+    Result.ItemCapacity = AK__Max(InitialItemCapacity, 1);
+    
+    uint32_t SlotCapacity = (uint32_t)AK__Ceil_Pow2(AK__Max(InitialSlotCapacity, 8));
+    if(!AK__Robin_Hood_Realloc_Slots(&Result, SlotCapacity) || 
+       !AK__HashMap_Realloc_Items(Allocator, 0, Result.ItemCapacity, &Result.ItemSlots, &Result.Keys, &Result.Values))
+    {
+        //TODO(JJ): Diagnostic and error logging
+        AK_Delete(&Result);
+        return {};
+    }
+    
+    return Result;
+}
 
-#define EXPECT_STRNE(x, y)                                                     \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (0 == strcmp(x, y)) {                                                   \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : \"%s\"\n", x);                                \
-UTEST_PRINTF("    Actual : \"%s\"\n", y);                                \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+template <typename key, typename value>
+void AK_Delete(ak_robin_hood_hashmap<key, value>* HashMap)
+{
+    if(HashMap && HashMap->Allocator)
+    {
+        if(HashMap->Slots) HashMap->Allocator->Free(HashMap->Slots, HashMap->Allocator->UserData);
+        if(HashMap->ItemSlots) HashMap->Allocator->Free(HashMap->ItemSlots, HashMap->Allocator->UserData);
+        *HashMap = {};
+    }
+}
 
-#define EXPECT_STRNEQ(x, y, n)                                                 \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (0 != UTEST_STRNCMP(x, y, n)) {                                         \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : \"%.*s\"\n", UTEST_CAST(int, n), x);          \
-UTEST_PRINTF("    Actual : \"%.*s\"\n", UTEST_CAST(int, n), y);          \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+//~BTree map implementation
+//NOTE(EVERYONE): Nodes are small, so counting the keys less than Key beats a branchy binary search and vectorizes
+template <typename key>
+uint32_t AK__BTree_Lower_Bound(const key* Keys, uint32_t Count, const key& Key)
+{
+    uint32_t Result = 0;
+    for(uint32_t Index = 0; Index < Count; Index++)
+        Result += (Keys[Index] < Key) ? 1 : 0;
+    return Result;
+}
 
-#define EXPECT_STRNNE(x, y, n)                                                 \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (0 == UTEST_STRNCMP(x, y, n)) {                                         \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : \"%.*s\"\n", UTEST_CAST(int, n), x);          \
-UTEST_PRINTF("    Actual : \"%.*s\"\n", UTEST_CAST(int, n), y);          \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+#ifdef AK__SSE2
+uint32_t AK__BTree_Count_Less_SSE2(const int32_t* Keys, uint32_t Count, int32_t Key, int32_t Bias)
+{
+    __m128i BiasLanes = _mm_set1_epi32(Bias);
+    __m128i Target = _mm_set1_epi32(Key ^ Bias);
+    __m128i Counts = _mm_setzero_si128();
+    
+    uint32_t Index = 0;
+    for(; Index+4 <= Count; Index += 4)
+    {
+        __m128i Lanes = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(Keys+Index)), BiasLanes);
+        Counts = _mm_sub_epi32(Counts, _mm_cmplt_epi32(Lanes, Target));
+    }
+    
+    Counts = _mm_add_epi32(Counts, _mm_shuffle_epi32(Counts, _MM_SHUFFLE(1, 0, 3, 2)));
+    Counts = _mm_add_epi32(Counts, _mm_shuffle_epi32(Counts, _MM_SHUFFLE(2, 3, 0, 1)));
+    uint32_t Result = (uint32_t)_mm_cvtsi128_si32(Counts);
+    
+    for(; Index < Count; Index++)
+        Result += ((Keys[Index] ^ Bias) < (Key ^ Bias)) ? 1 : 0;
+    return Result;
+}
 
-#define EXPECT_NEAR(x, y, epsilon)                                             \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (utest_fabs(UTEST_CAST(double, x) - UTEST_CAST(double, y)) >            \
-UTEST_CAST(double, epsilon)) {                                         \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : %f\n", UTEST_CAST(double, x));                \
-UTEST_PRINTF("    Actual : %f\n", UTEST_CAST(double, y));                \
-*utest_result = 1;                                                       \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+uint32_t AK__BTree_Lower_Bound(const int32_t* Keys, uint32_t Count, const int32_t& Key)
+{
+    return AK__BTree_Count_Less_SSE2(Keys, Count, Key, 0);
+}
 
-#if defined(__clang__)
-#define UTEST_ASSERT(x, y, cond)                                               \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-_Pragma("clang diagnostic push")                                           \
-_Pragma("clang diagnostic ignored \"-Wlanguage-extension-token\"")     \
-_Pragma("clang diagnostic ignored \"-Wc++98-compat-pedantic\"")    \
-_Pragma("clang diagnostic ignored \"-Wfloat-equal\"")          \
-UTEST_AUTO(x) xEval = (x);                                 \
-UTEST_AUTO(y) yEval = (y);                                                 \
-if (!((xEval)cond(yEval))) {                                               \
-_Pragma("clang diagnostic pop")                                          \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                \
-UTEST_PRINTF("  Expected : ");                                           \
-utest_type_printer(xEval);                                               \
-UTEST_PRINTF("\n");                                                      \
-UTEST_PRINTF("    Actual : ");                                           \
-utest_type_printer(yEval);                                               \
-UTEST_PRINTF("\n");                                                      \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
-#elif defined(__GNUC__)
-#define UTEST_ASSERT(x, y, cond)                                               \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-UTEST_AUTO(x) xEval = (x);                                                 \
-UTEST_AUTO(y) yEval = (y);                                                 \
-if (!((xEval)cond(yEval))) {                                               \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : ");                                           \
-utest_type_printer(xEval);                                               \
-UTEST_PRINTF("\n");                                                      \
-UTEST_PRINTF("    Actual : ");                                           \
-utest_type_printer(yEval);                                               \
-UTEST_PRINTF("\n");                                                      \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
+uint32_t AK__BTree_Lower_Bound(const uint32_t* Keys, uint32_t Count, const uint32_t& Key)
+{
+    //NOTE(EVERYONE): SSE2 only compares signed lanes, flipping the sign bit orders unsigned keys the same way
+    return AK__BTree_Count_Less_SSE2((const int32_t*)Keys, Count, (int32_t)Key, INT32_MIN);
+}
+#endif
+
+template <typename key>
+uint32_t AK__BTree_Child_Index(ak__btree_inner<key>* Inner, const key& Key)
+{
+    //NOTE(EVERYONE): Keys equal to a separator live in the child to its right
+    uint32_t Index = AK__BTree_Lower_Bound(Inner->Keys, Inner->Count, Key);
+    if(Index < Inner->Count && !(Key < Inner->Keys[Index])) Index++;
+    return Index;
+}
+
+template <typename key, typename value>
+void* AK__BTree_Push_Node(ak_btree_map<key, value>* Map)
+{
+    if(!Map->Storage)
+    {
+        Map->Storage = AK_Create_BTree_Map_Slab<key, value>(AK_ARENA_INITIAL_BLOCK_SIZE, Map->Allocator);
+        Map->OwnsStorage = true;
+    }
+    
+    AK_STD_ASSERT(Map->Storage->BlockSize >= AK__Max(sizeof(ak__btree_leaf<key, value>), sizeof(ak__btree_inner<key>)), 
+                  "Slab blocks are too small for the btree nodes");
+    return Map->Storage->Push_Block(AK_ARENA_NO_CLEAR);
+}
+
+template <typename key, typename value>
+ak__btree_leaf<key, value>* AK__BTree_Find_Leaf(const ak_btree_map<key, value>* Map, const key& Key, 
+                                                ak__btree_inner<key>** Path, uint32_t* PathIndices)
+{
+    void* Node = Map->Root;
+    for(uint32_t Depth = 0; Depth < Map->Height; Depth++)
+    {
+        ak__btree_inner<key>* Inner = (ak__btree_inner<key>*)Node;
+        uint32_t ChildIndex = AK__BTree_Child_Index(Inner, Key);
+        if(Path)
+        {
+            Path[Depth] = Inner;
+            PathIndices[Depth] = ChildIndex;
+        }
+        Node = Inner->Children[ChildIndex];
+    }
+    return (ak__btree_leaf<key, value>*)Node;
+}
+
+template <typename key, typename value>
+ak__btree_leaf<key, value>* AK__BTree_Find_Leaf(const ak_btree_map<key, value>* Map, const key& Key)
+{
+    return AK__BTree_Find_Leaf(Map, Key, (ak__btree_inner<key>**)NULL, NULL);
+}
+
+template <typename key, typename value>
+ak_btree_iterator<key, value> AK__BTree_Make_Iterator(ak__btree_leaf<key, value>* Leaf, uint32_t Index)
+{
+    //NOTE(EVERYONE): Stepping past the last entry of a leaf moves on to the next one, iterators always point at a real 
+    //entry or the end
+    while(Leaf && Index >= Leaf->Count)
+    {
+        Leaf = Leaf->Next;
+        Index = 0;
+    }
+    
+    ak_btree_iterator<key, value> Result;
+    Result.Leaf = Leaf;
+    Result.Index = Leaf ? Index : 0;
+    return Result;
+}
+
+template <typename key, typename value>
+ak_hashmap_pair<key, value> ak_btree_iterator<key, value>::operator*()
+{
+    return {Leaf->Keys[Index], Leaf->Values[Index]};
+}
+
+template <typename key, typename value>
+void ak_btree_iterator<key, value>::operator++()
+{
+    *this = AK__BTree_Make_Iterator(Leaf, Index+1);
+}
+
+template <typename key, typename value>
+bool ak_btree_iterator<key, value>::operator!=(const ak_btree_iterator& Iterator)
+{
+    return Leaf != Iterator.Leaf || Index != Iterator.Index;
+}
+
+template <typename key, typename value>
+ak_btree_iterator<key, value> ak_btree_range<key, value>::begin() const
+{
+    return First;
+}
+
+template <typename key, typename value>
+ak_btree_iterator<key, value> ak_btree_range<key, value>::end() const
+{
+    return Last;
+}
+
+template <typename key, typename value>
+void ak_btree_map<key, value>::Add(const key& Key, const value& Value)
+{
+    typedef ak__btree_leaf<key, value> leaf;
+    typedef ak__btree_inner<key> inner;
+    
+    if(!Root)
+    {
+        leaf* NewRoot = (leaf*)AK__BTree_Push_Node(this);
+        if(!NewRoot)
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return;
+        }
+        NewRoot->Count = 0;
+        NewRoot->Prev = NewRoot->Next = NULL;
+        Root = NewRoot;
+        FirstLeaf = NewRoot;
+        Height = 0;
+    }
+    
+    inner* Path[AK__BTREE_MAX_HEIGHT];
+    uint32_t PathIndices[AK__BTREE_MAX_HEIGHT];
+    leaf* Leaf = AK__BTree_Find_Leaf(this, Key, Path, PathIndices);
+    
+    uint32_t Index = AK__BTree_Lower_Bound(Leaf->Keys, Leaf->Count, Key);
+    AK_STD_ASSERT(Index == Leaf->Count || Key < Leaf->Keys[Index], "Cannot insert duplicate keys into btree map");
+    
+    if(Leaf->Count == leaf::Capacity)
+    {
+        leaf* Right = (leaf*)AK__BTree_Push_Node(this);
+        if(!Right)
+        {
+            //TODO(JJ): Diagnostic and error logging
+            return;
+        }
+        
+        uint32_t SplitIndex = leaf::Capacity/2;
+        Right->Count = leaf::Capacity-SplitIndex;
+        AK__Memory_Copy(Right->Keys, Leaf->Keys+SplitIndex, Right->Count*sizeof(key));
+        AK__Memory_Copy(Right->Values, Leaf->Values+SplitIndex, Right->Count*sizeof(value));
+        Leaf->Count = SplitIndex;
+        
+        Right->Prev = Leaf;
+        Right->Next = Leaf->Next;
+        if(Leaf->Next) Leaf->Next->Prev = Right;
+        Leaf->Next = Right;
+        
+        //NOTE(EVERYONE): Push the new leaf up into the parents, splitting every full parent on the way
+        key Separator = Right->Keys[0];
+        void* Child = Right;
+        uint32_t Depth = Height;
+        for(; Depth > 0 && Child; Depth--)
+        {
+            inner* Parent = Path[Depth-1];
+            uint32_t ChildIndex = PathIndices[Depth-1];
+            
+            key Keys[inner::Capacity+1];
+            void* Children[inner::Capacity+2];
+            AK__Memory_Copy(Keys, Parent->Keys, ChildIndex*sizeof(key));
+            AK__Memory_Copy(Keys+ChildIndex+1, Parent->Keys+ChildIndex, (Parent->Count-ChildIndex)*sizeof(key));
+            AK__Memory_Copy(Children, Parent->Children, (ChildIndex+1)*sizeof(void*));
+            AK__Memory_Copy(Children+ChildIndex+2, Parent->Children+ChildIndex+1, (Parent->Count-ChildIndex)*sizeof(void*));
+            Keys[ChildIndex] = Separator;
+            Children[ChildIndex+1] = Child;
+            uint32_t Count = Parent->Count+1;
+            
+            if(Count <= inner::Capacity)
+            {
+                AK__Memory_Copy(Parent->Keys, Keys, Count*sizeof(key));
+                AK__Memory_Copy(Parent->Children, Children, (Count+1)*sizeof(void*));
+                Parent->Count = Count;
+                Child = NULL;
+            }
+            else
+            {
+                inner* RightInner = (inner*)AK__BTree_Push_Node(this);
+                if(!RightInner)
+                {
+                    //TODO(JJ): Diagnostic and error logging
+                    return;
+                }
+                
+                //NOTE(EVERYONE): The middle key moves up instead of being copied like a leaf separator
+                uint32_t MiddleIndex = Count/2;
+                Parent->Count = MiddleIndex;
+                AK__Memory_Copy(Parent->Keys, Keys, MiddleIndex*sizeof(key));
+                AK__Memory_Copy(Parent->Children, Children, (MiddleIndex+1)*sizeof(void*));
+                
+                RightInner->Count = Count-MiddleIndex-1;
+                AK__Memory_Copy(RightInner->Keys, Keys+MiddleIndex+1, RightInner->Count*sizeof(key));
+                AK__Memory_Copy(RightInner->Children, Children+MiddleIndex+1, (RightInner->Count+1)*sizeof(void*));
+                
+                Separator = Keys[MiddleIndex];
+                Child = RightInner;
+            }
+        }
+        
+        if(Child)
+        {
+            AK_STD_ASSERT(Height+1 < AK__BTREE_MAX_HEIGHT, "BTree is too tall");
+            inner* NewRoot = (inner*)AK__BTree_Push_Node(this);
+            if(!NewRoot)
+            {
+                //TODO(JJ): Diagnostic and error logging
+                return;
+            }
+            NewRoot->Count = 1;
+            NewRoot->Keys[0] = Separator;
+            NewRoot->Children[0] = Root;
+            NewRoot->Children[1] = Child;
+            Root = NewRoot;
+            Height++;
+        }
+        
+        if(Index > SplitIndex)
+        {
+            Index -= SplitIndex;
+            Leaf = Right;
+        }
+    }
+    
+    AK__Memory_Move(Leaf->Keys+Index+1, Leaf->Keys+Index, (Leaf->Count-Index)*sizeof(key));
+    AK__Memory_Move(Leaf->Values+Index+1, Leaf->Values+Index, (Leaf->Count-Index)*sizeof(value));
+    Leaf->Keys[Index] = Key;
+    Leaf->Values[Index] = Value;
+    Leaf->Count++;
+    Length++;
+}
+
+template <typename key, typename value>
+value* ak_btree_map<key, value>::Find(const key& Key)
+{
+    if(!Root) return NULL;
+    
+    ak__btree_leaf<key, value>* Leaf = AK__BTree_Find_Leaf(this, Key);
+    uint32_t Index = AK__BTree_Lower_Bound(Leaf->Keys, Leaf->Count, Key);
+    if(Index == Leaf->Count || Key < Leaf->Keys[Index]) return NULL;
+    return Leaf->Values + Index;
+}
+
+//NOTE(EVERYONE): Drops a separator together with the child to its right
+template <typename key>
+void AK__BTree_Remove_Separator(ak__btree_inner<key>* Inner, uint32_t KeyIndex)
+{
+    uint32_t MoveCount = Inner->Count-KeyIndex-1;
+    AK__Memory_Move(Inner->Keys+KeyIndex, Inner->Keys+KeyIndex+1, MoveCount*sizeof(key));
+    AK__Memory_Move(Inner->Children+KeyIndex+1, Inner->Children+KeyIndex+2, MoveCount*sizeof(void*));
+    Inner->Count--;
+}
+
+//NOTE(EVERYONE): Refills a leaf below half full from a sibling under the same parent. When neither sibling can spare 
+//an entry the right leaf of the pair is merged into the left one and freed. Returns true if the parent lost a child
+template <typename key, typename value>
+bool AK__BTree_Rebalance_Leaf(ak_btree_map<key, value>* Map, ak__btree_inner<key>* Parent, uint32_t ChildIndex)
+{
+    typedef ak__btree_leaf<key, value> leaf;
+    
+    leaf* Leaf = (leaf*)Parent->Children[ChildIndex];
+    leaf* Left = ChildIndex > 0 ? (leaf*)Parent->Children[ChildIndex-1] : NULL;
+    leaf* Right = ChildIndex < Parent->Count ? (leaf*)Parent->Children[ChildIndex+1] : NULL;
+    AK_STD_ASSERT(Left || Right, "Btree inner nodes need at least two children");
+    
+    if(Left && Left->Count > leaf::Capacity/2)
+    {
+        AK__Memory_Move(Leaf->Keys+1, Leaf->Keys, Leaf->Count*sizeof(key));
+        AK__Memory_Move(Leaf->Values+1, Leaf->Values, Leaf->Count*sizeof(value));
+        Left->Count--;
+        Leaf->Keys[0] = Left->Keys[Left->Count];
+        Leaf->Values[0] = Left->Values[Left->Count];
+        Leaf->Count++;
+        Parent->Keys[ChildIndex-1] = Leaf->Keys[0];
+        return false;
+    }
+    
+    if(Right && Right->Count > leaf::Capacity/2)
+    {
+        Leaf->Keys[Leaf->Count] = Right->Keys[0];
+        Leaf->Values[Leaf->Count] = Right->Values[0];
+        Leaf->Count++;
+        Right->Count--;
+        AK__Memory_Move(Right->Keys, Right->Keys+1, Right->Count*sizeof(key));
+        AK__Memory_Move(Right->Values, Right->Values+1, Right->Count*sizeof(value));
+        Parent->Keys[ChildIndex] = Right->Keys[0];
+        return false;
+    }
+    
+    uint32_t KeyIndex = Left ? ChildIndex-1 : ChildIndex;
+    leaf* Dest = Left ? Left : Leaf;
+    leaf* Source = Left ? Leaf : Right;
+    AK__Memory_Copy(Dest->Keys+Dest->Count, Source->Keys, Source->Count*sizeof(key));
+    AK__Memory_Copy(Dest->Values+Dest->Count, Source->Values, Source->Count*sizeof(value));
+    Dest->Count += Source->Count;
+    
+    Dest->Next = Source->Next;
+    if(Source->Next) Source->Next->Prev = Dest;
+    
+    AK__BTree_Remove_Separator(Parent, KeyIndex);
+    Map->Storage->Free_Block(Source);
+    return true;
+}
+
+//NOTE(EVERYONE): Same as AK__BTree_Rebalance_Leaf for inner nodes. The parent separator rotates through when 
+//borrowing and comes down between the two nodes when merging
+template <typename key, typename value>
+bool AK__BTree_Rebalance_Inner(ak_btree_map<key, value>* Map, ak__btree_inner<key>* Parent, uint32_t ChildIndex)
+{
+    typedef ak__btree_inner<key> inner;
+    
+    inner* Node = (inner*)Parent->Children[ChildIndex];
+    inner* Left = ChildIndex > 0 ? (inner*)Parent->Children[ChildIndex-1] : NULL;
+    inner* Right = ChildIndex < Parent->Count ? (inner*)Parent->Children[ChildIndex+1] : NULL;
+    AK_STD_ASSERT(Left || Right, "Btree inner nodes need at least two children");
+    
+    if(Left && Left->Count > inner::Capacity/2)
+    {
+        AK__Memory_Move(Node->Keys+1, Node->Keys, Node->Count*sizeof(key));
+        AK__Memory_Move(Node->Children+1, Node->Children, (Node->Count+1)*sizeof(void*));
+        Node->Keys[0] = Parent->Keys[ChildIndex-1];
+        Node->Children[0] = Left->Children[Left->Count];
+        Node->Count++;
+        Parent->Keys[ChildIndex-1] = Left->Keys[Left->Count-1];
+        Left->Count--;
+        return false;
+    }
+    
+    if(Right && Right->Count > inner::Capacity/2)
+    {
+        Node->Keys[Node->Count] = Parent->Keys[ChildIndex];
+        Node->Children[Node->Count+1] = Right->Children[0];
+        Node->Count++;
+        Parent->Keys[ChildIndex] = Right->Keys[0];
+        AK__Memory_Move(Right->Keys, Right->Keys+1, (Right->Count-1)*sizeof(key));
+        AK__Memory_Move(Right->Children, Right->Children+1, Right->Count*sizeof(void*));
+        Right->Count--;
+        return false;
+    }
+    
+    uint32_t KeyIndex = Left ? ChildIndex-1 : ChildIndex;
+    inner* Dest = Left ? Left : Node;
+    inner* Source = Left ? Node : Right;
+    Dest->Keys[Dest->Count] = Parent->Keys[KeyIndex];
+    AK__Memory_Copy(Dest->Keys+Dest->Count+1, Source->Keys, Source->Count*sizeof(key));
+    AK__Memory_Copy(Dest->Children+Dest->Count+1, Source->Children, (Source->Count+1)*sizeof(void*));
+    Dest->Count += Source->Count+1;
+    
+    AK__BTree_Remove_Separator(Parent, KeyIndex);
+    Map->Storage->Free_Block(Source);
+    return true;
+}
+
+template <typename key, typename value>
+bool ak_btree_map<key, value>::Remove(const key& Key)
+{
+    typedef ak__btree_leaf<key, value> leaf;
+    typedef ak__btree_inner<key> inner;
+    
+    if(!Root) return false;
+    
+    inner* Path[AK__BTREE_MAX_HEIGHT];
+    uint32_t PathIndices[AK__BTREE_MAX_HEIGHT];
+    leaf* Leaf = AK__BTree_Find_Leaf(this, Key, Path, PathIndices);
+    uint32_t Index = AK__BTree_Lower_Bound(Leaf->Keys, Leaf->Count, Key);
+    if(Index == Leaf->Count || Key < Leaf->Keys[Index]) return false;
+    
+    uint32_t MoveCount = Leaf->Count-Index-1;
+    AK__Memory_Move(Leaf->Keys+Index, Leaf->Keys+Index+1, MoveCount*sizeof(key));
+    AK__Memory_Move(Leaf->Values+Index, Leaf->Values+Index+1, MoveCount*sizeof(value));
+    Leaf->Count--;
+    Length--;
+    
+    if(!Height)
+    {
+        if(!Leaf->Count)
+        {
+            Storage->Free_Block(Leaf);
+            Root = NULL;
+            FirstLeaf = NULL;
+        }
+        return true;
+    }
+    
+    //NOTE(EVERYONE): Separators above stay valid bounds after a remove, so the parents only change when a node falls 
+    //below half full. Every merge takes a child from the parent, which can push the parent under half full in turn
+    bool Merged = Leaf->Count < leaf::Capacity/2 && AK__BTree_Rebalance_Leaf(this, Path[Height-1], PathIndices[Height-1]);
+    for(uint32_t Depth = Height-1; Merged && Depth > 0; Depth--)
+        Merged = Path[Depth]->Count < inner::Capacity/2 && AK__BTree_Rebalance_Inner(this, Path[Depth-1], PathIndices[Depth-1]);
+    
+    //NOTE(EVERYONE): A root left with a single child is dropped so the tree gets shorter
+    inner* RootInner = (inner*)Root;
+    if(!RootInner->Count)
+    {
+        Root = RootInner->Children[0];
+        Storage->Free_Block(RootInner);
+        Height--;
+    }
+    return true;
+}
+
+template <typename key, typename value>
+void AK__BTree_Free_Node(ak_btree_map<key, value>* Map, void* Node, uint32_t Depth)
+{
+    if(Depth < Map->Height)
+    {
+        ak__btree_inner<key>* Inner = (ak__btree_inner<key>*)Node;
+        for(uint32_t ChildIndex = 0; ChildIndex <= Inner->Count; ChildIndex++)
+            AK__BTree_Free_Node(Map, Inner->Children[ChildIndex], Depth+1);
+    }
+    Map->Storage->Free_Block(Node);
+}
+
+template <typename key, typename value>
+void ak_btree_map<key, value>::Clear()
+{
+    if(Root) AK__BTree_Free_Node(this, Root, 0);
+    Root = NULL;
+    FirstLeaf = NULL;
+    Height = 0;
+    Length = 0;
+}
+
+template <typename key, typename value>
+void ak_btree_map<key, value>::Bulk_Load(const key* Keys, const value* Values, uint64_t Count)
+{
+    typedef ak__btree_leaf<key, value> leaf;
+    typedef ak__btree_inner<key> inner;
+    
+    Clear();
+    if(!Count) return;
+    
+    uint64_t NodeCount = (Count + leaf::Capacity-1) / leaf::Capacity;
+    ak_allocator* NodeAllocator = Allocator ? Allocator : AK__Get_Default_Allocator();
+    void** Nodes = (void**)NodeAllocator->Alloc(NodeCount*(sizeof(void*)+sizeof(key)), NodeAllocator->UserData);
+    if(!Nodes)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return;
+    }
+    key* FirstKeys = (key*)(Nodes + NodeCount);
+    
+    leaf* PrevLeaf = NULL;
+    for(uint64_t LeafIndex = 0; LeafIndex < NodeCount; LeafIndex++)
+    {
+        leaf* Leaf = (leaf*)AK__BTree_Push_Node(this);
+        if(!Leaf)
+        {
+            //TODO(JJ): Diagnostic and error logging
+            NodeCount = LeafIndex;
+            break;
+        }
+        
+        uint64_t FirstIndex = LeafIndex*leaf::Capacity;
+        Leaf->Count = (uint32_t)AK__Min((uint64_t)leaf::Capacity, Count-FirstIndex);
+        AK__Memory_Copy(Leaf->Keys, Keys+FirstIndex, Leaf->Count*sizeof(key));
+        AK__Memory_Copy(Leaf->Values, Values+FirstIndex, Leaf->Count*sizeof(value));
+        
+        Leaf->Prev = PrevLeaf;
+        Leaf->Next = NULL;
+        if(PrevLeaf) PrevLeaf->Next = Leaf;
+        else FirstLeaf = Leaf;
+        PrevLeaf = Leaf;
+        
+        Nodes[LeafIndex] = Leaf;
+        FirstKeys[LeafIndex] = Leaf->Keys[0];
+        Length += Leaf->Count;
+    }
+    
+    //NOTE(EVERYONE): Each pass groups the nodes of a level under full parents until one root is left
+    Height = 0;
+    while(NodeCount > 1)
+    {
+        //NOTE(EVERYONE): Children are spread evenly so no parent is left with a single child, which Remove relies on
+        uint64_t ParentCount = (NodeCount + inner::Capacity) / (inner::Capacity+1);
+        uint64_t ChildIndex = 0;
+        for(uint64_t ParentIndex = 0; ParentIndex < ParentCount; ParentIndex++)
+        {
+            inner* Parent = (inner*)AK__BTree_Push_Node(this);
+            AK_STD_ASSERT(Parent, "Failed to allocate btree node");
+            
+            uint32_t ChildCount = (uint32_t)((NodeCount-ChildIndex) / (ParentCount-ParentIndex));
+            Parent->Count = ChildCount-1;
+            for(uint32_t Index = 0; Index < ChildCount; Index++)
+            {
+                Parent->Children[Index] = Nodes[ChildIndex+Index];
+                if(Index) Parent->Keys[Index-1] = FirstKeys[ChildIndex+Index];
+            }
+            
+            FirstKeys[ParentIndex] = FirstKeys[ChildIndex];
+            Nodes[ParentIndex] = Parent;
+            ChildIndex += ChildCount;
+        }
+        
+        NodeCount = ParentCount;
+        Height++;
+    }
+    
+    Root = NodeCount ? Nodes[0] : NULL;
+    NodeAllocator->Free(Nodes, NodeAllocator->UserData);
+}
+
+template <typename key, typename value>
+ak_btree_iterator<key, value> ak_btree_map<key, value>::Lower_Bound(const key& Key)
+{
+    if(!Root) return {};
+    
+    ak__btree_leaf<key, value>* Leaf = AK__BTree_Find_Leaf(this, Key);
+    return AK__BTree_Make_Iterator(Leaf, AK__BTree_Lower_Bound(Leaf->Keys, Leaf->Count, Key));
+}
+
+template <typename key, typename value>
+ak_btree_range<key, value> ak_btree_map<key, value>::Range(const key& Min, const key& Max)
+{
+    ak_btree_range<key, value> Result;
+    Result.First = Lower_Bound(Min);
+    Result.Last = (Min < Max) ? Lower_Bound(Max) : Result.First;
+    return Result;
+}
+
+template <typename key, typename value>
+ak_btree_iterator<key, value> ak_btree_map<key, value>::begin() const
+{
+    return AK__BTree_Make_Iterator(FirstLeaf, 0);
+}
+
+template <typename key, typename value>
+ak_btree_iterator<key, value> ak_btree_map<key, value>::end() const
+{
+    return {};
+}
+
+template <typename key, typename value>
+ak_slab* AK_Create_BTree_Map_Slab(uint64_t ArenaBlockSize, ak_allocator* Allocator)
+{
+    uint64_t BlockSize = AK__Max(sizeof(ak__btree_leaf<key, value>), sizeof(ak__btree_inner<key>));
+    uint64_t BlockAlignment = AK__Max(alignof(ak__btree_leaf<key, value>), alignof(ak__btree_inner<key>));
+    return AK_Create_Slab(BlockSize, BlockAlignment, ArenaBlockSize, Allocator);
+}
+
+template <typename key, typename value>
+ak_btree_map<key, value> AK_Create_BTree_Map(ak_slab* Slab, ak_allocator* Allocator)
+{
+    ak_btree_map<key, value> Result;
+    Result.Allocator = Allocator;
+    Result.Storage = Slab;
+    return Result;
+}
+
+template <typename key, typename value>
+void AK_Delete(ak_btree_map<key, value>* Map)
+{
+    if(Map)
+    {
+        if(Map->OwnsStorage) AK_Delete(Map->Storage);
+        else if(Map->Storage) Map->Clear();
+        *Map = {};
+    }
+}
+
+//~LRU cache implementation
+template <typename key, typename value>
+void AK__LRU_Unlink(ak_lru_cache<key, value>* Cache, uint32_t Index)
+{
+    ak__lru_entry<key, value>* Entry = Cache->Entries + Index;
+    if(Entry->Prev != AK__LRU_INVALID_INDEX) Cache->Entries[Entry->Prev].Next = Entry->Next;
+    else Cache->Head = Entry->Next;
+    if(Entry->Next != AK__LRU_INVALID_INDEX) Cache->Entries[Entry->Next].Prev = Entry->Prev;
+    else Cache->Tail = Entry->Prev;
+}
+
+template <typename key, typename value>
+void AK__LRU_Push_Front(ak_lru_cache<key, value>* Cache, uint32_t Index)
+{
+    ak__lru_entry<key, value>* Entry = Cache->Entries + Index;
+    Entry->Prev = AK__LRU_INVALID_INDEX;
+    Entry->Next = Cache->Head;
+    if(Cache->Head != AK__LRU_INVALID_INDEX) Cache->Entries[Cache->Head].Prev = Index;
+    else Cache->Tail = Index;
+    Cache->Head = Index;
+}
+
+template <typename key, typename value>
+void AK__LRU_Free_Entry(ak_lru_cache<key, value>* Cache, uint32_t Index)
+{
+    ak__lru_entry<key, value>* Entry = Cache->Entries + Index;
+    AK__LRU_Unlink(Cache, Index);
+    Cache->Lookup.Remove(Entry->Key);
+    Cache->TotalCost -= Entry->Cost;
+    Cache->Length--;
+    
+    Entry->Next = Cache->FreeHead;
+    Cache->FreeHead = Index;
+}
+
+template <typename key, typename value>
+void AK__LRU_Evict(ak_lru_cache<key, value>* Cache, uint32_t KeepIndex)
+{
+    //NOTE(EVERYONE): The clock hand is the tail. Referenced entries lose their bit and go back to the front, the 
+    //entry that was just put is skipped the same way so a costly insert never evicts itself
+    uint32_t Index = Cache->Tail;
+    while(Index == KeepIndex || (Cache->Policy == AK_CACHE_POLICY_CLOCK && Cache->Entries[Index].Referenced))
+    {
+        Cache->Entries[Index].Referenced = false;
+        AK__LRU_Unlink(Cache, Index);
+        AK__LRU_Push_Front(Cache, Index);
+        Index = Cache->Tail;
+    }
+    
+    ak__lru_entry<key, value>* Entry = Cache->Entries + Index;
+    if(Cache->EvictCallback) Cache->EvictCallback(Entry->Key, &Entry->Value, Cache->EvictUserData);
+    AK__LRU_Free_Entry(Cache, Index);
+}
+
+template <typename key, typename value>
+value* ak_lru_cache<key, value>::Get(const key& Key)
+{
+    uint32_t* Index = Lookup.Find(Key);
+    if(!Index) return NULL;
+    
+    if(Policy == AK_CACHE_POLICY_CLOCK)
+    {
+        Entries[*Index].Referenced = true;
+    }
+    else if(Head != *Index)
+    {
+        AK__LRU_Unlink(this, *Index);
+        AK__LRU_Push_Front(this, *Index);
+    }
+    return &Entries[*Index].Value;
+}
+
+template <typename key, typename value>
+value* ak_lru_cache<key, value>::Put(const key& Key, const value& Value, uint64_t Cost)
+{
+    if(!Entries)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return NULL;
+    }
+    
+    uint32_t Index;
+    uint32_t* ExistingIndex = Lookup.Find(Key);
+    if(ExistingIndex)
+    {
+        Index = *ExistingIndex;
+        ak__lru_entry<key, value>* Entry = Entries + Index;
+        TotalCost -= Entry->Cost;
+        Entry->Value = Value;
+        Entry->Cost = Cost;
+        TotalCost += Cost;
+        
+        if(Policy == AK_CACHE_POLICY_CLOCK)
+        {
+            Entry->Referenced = true;
+        }
+        else
+        {
+            AK__LRU_Unlink(this, Index);
+            AK__LRU_Push_Front(this, Index);
+        }
+    }
+    else
+    {
+        if(Length == Capacity) AK__LRU_Evict(this, AK__LRU_INVALID_INDEX);
+        
+        Index = FreeHead;
+        ak__lru_entry<key, value>* Entry = Entries + Index;
+        FreeHead = Entry->Next;
+        
+        Entry->Key = Key;
+        Entry->Value = Value;
+        Entry->Cost = Cost;
+        Entry->Referenced = false;
+        AK__LRU_Push_Front(this, Index);
+        Lookup.Add(Key, Index);
+        TotalCost += Cost;
+        Length++;
+    }
+    
+    while(MaxCost && TotalCost > MaxCost && Length > 1)
+        AK__LRU_Evict(this, Index);
+    
+    return &Entries[Index].Value;
+}
+
+template <typename key, typename value>
+bool ak_lru_cache<key, value>::Remove(const key& Key)
+{
+    uint32_t* Index = Lookup.Find(Key);
+    if(!Index) return false;
+    AK__LRU_Free_Entry(this, *Index);
+    return true;
+}
+
+template <typename key, typename value>
+void ak_lru_cache<key, value>::Clear()
+{
+    Lookup.Clear();
+    for(uint32_t Index = 0; Index < Capacity; Index++)
+        Entries[Index].Next = (Index+1 < Capacity) ? Index+1 : AK__LRU_INVALID_INDEX;
+    FreeHead = Capacity ? 0 : AK__LRU_INVALID_INDEX;
+    Head = Tail = AK__LRU_INVALID_INDEX;
+    Length = 0;
+    TotalCost = 0;
+}
+
+template <typename key, typename value>
+ak_lru_cache<key, value> AK_Create_LRU_Cache(uint32_t Capacity, uint64_t MaxCost, ak_cache_policy Policy, ak_allocator* Allocator)
+{
+    if(!Allocator) Allocator = AK__Get_Default_Allocator();
+    AK_STD_ASSERT(Capacity, "LRU cache needs a capacity");
+    
+    ak_lru_cache<key, value> Result;
+    Result.Allocator = Allocator;
+    Result.Policy = Policy;
+    Result.Capacity = Capacity;
+    Result.MaxCost = MaxCost;
+    
+    Result.Entries = (ak__lru_entry<key, value>*)Allocator->Alloc(sizeof(ak__lru_entry<key, value>)*Capacity, Allocator->UserData);
+    if(!Result.Entries)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return {};
+    }
+    
+    Result.Lookup = AK_Create_Hash_Map<key, uint32_t>(AK_HASH_MAP_INITIAL_SLOT_CAPACITY, AK_HASH_MAP_INITIAL_ITEM_CAPACITY, Allocator);
+    Result.Lookup.Reserve(Capacity);
+    Result.Clear();
+    return Result;
+}
+
+template <typename key, typename value>
+void AK_Delete(ak_lru_cache<key, value>* Cache)
+{
+    if(Cache)
+    {
+        if(Cache->Entries) Cache->Allocator->Free(Cache->Entries, Cache->Allocator->UserData);
+        AK_Delete(&Cache->Lookup);
+        *Cache = {};
+    }
+}
+
+//~Pool implementation
+
+template <typename type, uint64_t bucket_capacity>
+type& ak_pool_iterator<type, bucket_capacity>::operator*()
+{
+    return AK__Array_Get_Entry(&Pool->Data, CurrentIndex)->Entry;
+}
+
+template <typename type, uint64_t bucket_capacity>
+void ak_pool_iterator<type, bucket_capacity>::operator++()
+{
+    CurrentIndex = AK__Array_Get_Entry(&Pool->Data, CurrentIndex)->ID.NextIndex;
+}
+
+template <typename type, uint64_t bucket_capacity>
+bool ak_pool_iterator<type, bucket_capacity>::operator!=(const ak_pool_iterator& Iterator)
+{
+    return CurrentIndex != AK__INVALID_POOL_INDEX;
+}
+
+template <typename type, uint64_t bucket_capacity>
+uint64_t ak_pool<type, bucket_capacity>::Allocate(const type& Value)
+{
+    uint16_t Index;
+    if(FirstAvailableIndex != AK__INVALID_POOL_INDEX)
+    {
+        Index = FirstAvailableIndex;
+        FirstAvailableIndex = AK__Array_Get_Entry(&Data, Index)->ID.NextIndex;
+    }
+    else
+    {
+        Index = (uint16_t)Data.Length;
+        if(!Data.Add({}))
+        {
+            //TODO(JJ): Diagnsotic and error logging
+            return 0;
+        }
+    }
+    
+    AK_STD_ASSERT(Index < MAX_CAPACITY, "Pool capacity overflow!");
+    if(Index >= MAX_CAPACITY)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return 0;
+    }
+    
+    ak__pool_entry<type>* Entry = AK__Array_Get_Entry(&Data, Index);
+    Entry->Entry = Value;
+    Entry->ID.Key = NextKey++;
+    
+    if(!NextKey)
+    {
+        //NOTE(EVERYONE): We have overflowed the keys. Reset its position. All id entries that have had previous index values
+        //will now be valid. This isn't super secure but hey, this really isn't the point of the pool data structure
+        NextKey = 1;
+    }
+    
+    if(FirstAllocatedIndex != AK__INVALID_POOL_INDEX)
+    {
+        ak__pool_entry<type>* FirstEntry = AK__Array_Get_Entry(&Data, FirstAllocatedIndex);
+        FirstEntry->ID.PreviousIndex = Index;
+    }
+    
+    Entry->ID.PreviousIndex = AK__INVALID_POOL_INDEX;
+    Entry->ID.NextIndex = FirstAllocatedIndex;
+    
+    FirstAllocatedIndex = Index;
+    
+    Length++;
+    
+    ak__pool_id Result;
+    Result.Key = Entry->ID.Key;
+    Result.Type = Type;
+    Result.Index = Index;
+    
+    return Result.ID;
+}
+
+template <typename type, uint64_t bucket_capacity>
+type* ak_pool<type, bucket_capacity>::Allocate_And_Get(uint64_t* OutID)
+{
+    ak__pool_id ID = {Allocate()};
+    if(!ID.ID) return NULL;
+    if(OutID) *OutID = ID.ID;
+    return &AK__Array_Get_Entry(&Data, ID.Index)->Entry;
+}
+
+template <typename type, uint64_t bucket_capacity>
+void ak_pool<type, bucket_capacity>::Free(uint64_t TempID)
+{
+    if(Is_Allocated(TempID))
+    {
+        ak__pool_id ID = {TempID};
+        ak__pool_entry<type>* Entry = AK__Array_Get_Entry(&Data, ID.Index);
+        
+        int32_t IsHead = ID.Index == FirstAllocatedIndex;
+        if(!IsHead)
+        {
+            AK_STD_ASSERT(Entry->ID.PreviousIndex != AK__INVALID_POOL_INDEX, "Cannot be the head of the pool and have a valid previous index");
+            AK__Array_Get_Entry(&Data, Entry->ID.PreviousIndex)->ID.NextIndex = Entry->ID.NextIndex;
+        }
+        else
+            FirstAllocatedIndex = Entry->ID.NextIndex;
+        
+        if(Entry->ID.NextIndex != AK__INVALID_POOL_INDEX)
+        {
+            ak__pool_entry<type>* NextEntry = AK__Array_Get_Entry(&Data, Entry->ID.NextIndex);
+            NextEntry->ID.PreviousIndex = Entry->ID.PreviousIndex;
+        }
+        
+        Entry->ID.ID = 0;
+        Entry->ID.NextIndex = FirstAvailableIndex;
+        
+        FirstAvailableIndex = ID.Index;
+        
+        Length--;
+    }
+}
+
+template <typename type, uint64_t bucket_capacity>
+void ak_pool<type, bucket_capacity>::Free_All()
+{
+    Data.Clear();
+    Length = 0;
+    FirstAllocatedIndex = AK__INVALID_POOL_INDEX;
+    FirstAvailableIndex = AK__INVALID_POOL_INDEX;
+}
+
+template <typename type, uint64_t bucket_capacity>
+bool ak_pool<type, bucket_capacity>::Is_Allocated(uint64_t TempID)
+{
+    if(TempID)
+    {
+        ak__pool_id ID = {TempID};
+        ak__pool_entry<type>* Entry = AK__Array_Get_Entry(&Data, ID.Index);
+        bool Result = Entry->ID.Key && Entry->ID.Key == ID.Key;
+        return Result;
+    }
+    return false;
+}
+
+template <typename type, uint64_t bucket_capacity>
+type* ak_pool<type, bucket_capacity>::Get(uint64_t TempID)
+{
+    if(!Is_Allocated(TempID)) return NULL;
+    ak__pool_id ID = {TempID};
+    return &AK__Array_Get_Entry(&Data, ID.Index)->Entry;
+}
+
+template <typename type, uint64_t bucket_capacity>
+type& ak_pool<type, bucket_capacity>::operator[](uint64_t ID)
+{
+    type* Result = Get(ID);
+    AK_STD_ASSERT(Result, "Cannot index into pool with invalid id");
+    return *Result;
+}
+
+template <typename type, uint64_t bucket_capacity>
+ak_pool_iterator<type, bucket_capacity> ak_pool<type, bucket_capacity>::begin()
+{
+    ak_pool_iterator<type, bucket_capacity> Result;
+    Result.Pool = this;
+    Result.CurrentIndex = FirstAllocatedIndex;
+    return Result;
+}
+
+template <typename type, uint64_t bucket_capacity>
+ak_pool_iterator<type, bucket_capacity> ak_pool<type, bucket_capacity>::end()
+{
+    return {};
+}
+
+template <typename type, uint64_t bucket_capacity> 
+void AK_Delete(ak_pool<type, bucket_capacity>* Pool)
+{
+    if(Pool)
+    {
+        AK_Delete(&Pool->Data);
+        AK__Memory_Clear(Pool, sizeof(ak_pool<type, bucket_capacity>));
+    }
+}
+
+#define STB_SPRINTF_IMPLEMENTATION
+
+// stb_sprintf - v1.10 - public domain snprintf() implementation
+// originally by Jeff Roberts / RAD Game Tools, 2015/10/20
+// http://github.com/nothings/stb
+//
+// allowed types:  sc uidBboXx p AaGgEef n
+// lengths      :  hh h ll j z t I64 I32 I
+//
+// Contributors:
+//    Fabian "ryg" Giesen (reformatting)
+//    github:aganm (attribute format)
+//
+// Contributors (bugfixes):
+//    github:d26435
+//    github:trex78
+//    github:account-login
+//    Jari Komppa (SI suffixes)
+//    Rohit Nirmal
+//    Marcin Wojdyr
+//    Leonard Ritter
+//    Stefano Zanotti
+//    Adam Allison
+//    Arvid Gerstmann
+//    Markus Kolb
+//
+// LICENSE:
+//
+//   See end of file for license information.
+
+#ifndef STB_SPRINTF_H_INCLUDE
+#define STB_SPRINTF_H_INCLUDE
+
+/*
+Single file sprintf replacement.
+
+Originally written by Jeff Roberts at RAD Game Tools - 2015/10/20.
+Hereby placed in public domain.
+
+This is a full sprintf replacement that supports everything that
+the C runtime sprintfs support, including float/double, 64-bit integers,
+hex floats, field parameters (%*.*d stuff), length reads backs, etc.
+
+Why would you need this if sprintf already exists?  Well, first off,
+it's *much* faster (see below). It's also much smaller than the CRT
+versions code-space-wise. We've also added some simple improvements
+that are super handy (commas in thousands, callbacks at buffer full,
+for example). Finally, the format strings for MSVC and GCC differ
+for 64-bit integers (among other small things), so this lets you use
+the same format strings in cross platform code.
+
+It uses the standard single file trick of being both the header file
+and the source itself. If you just include it normally, you just get
+the header file function definitions. To get the code, you include
+it from a C or C++ file and define STB_SPRINTF_IMPLEMENTATION first.
+
+It only uses va_args macros from the C runtime to do it's work. It
+does cast doubles to S64s and shifts and divides U64s, which does
+drag in CRT code on most platforms.
+
+It compiles to roughly 8K with float support, and 4K without.
+As a comparison, when using MSVC static libs, calling sprintf drags
+in 16K.
+
+API:
+====
+int stbsp_sprintf( char * buf, char const * fmt, ... )
+int stbsp_snprintf( char * buf, int count, char const * fmt, ... )
+  Convert an arg list into a buffer.  stbsp_snprintf always returns
+  a zero-terminated string (unlike regular snprintf).
+
+int stbsp_vsprintf( char * buf, char const * fmt, va_list va )
+int stbsp_vsnprintf( char * buf, int count, char const * fmt, va_list va )
+  Convert a va_list arg list into a buffer.  stbsp_vsnprintf always returns
+  a zero-terminated string (unlike regular snprintf).
+
+int stbsp_vsprintfcb( STBSP_SPRINTFCB * callback, void * user, char * buf, char const * fmt, va_list va )
+    typedef char * STBSP_SPRINTFCB( char const * buf, void * user, int len );
+  Convert into a buffer, calling back every STB_SPRINTF_MIN chars.
+  Your callback can then copy the chars out, print them or whatever.
+  This function is actually the workhorse for everything else.
+  The buffer you pass in must hold at least STB_SPRINTF_MIN characters.
+    // you return the next buffer to use or 0 to stop converting
+
+void stbsp_set_separators( char comma, char period )
+  Set the comma and period characters to use.
+
+FLOATS/DOUBLES:
+===============
+This code uses a internal float->ascii conversion method that uses
+doubles with error correction (double-doubles, for ~105 bits of
+precision).  This conversion is round-trip perfect - that is, an atof
+of the values output here will give you the bit-exact double back.
+
+One difference is that our insignificant digits will be different than
+with MSVC or GCC (but they don't match each other either).  We also
+don't attempt to find the minimum length matching float (pre-MSVC15
+doesn't either).
+
+If you don't need float or doubles at all, define STB_SPRINTF_NOFLOAT
+and you'll save 4K of code space.
+
+64-BIT INTS:
+============
+This library also supports 64-bit integers and you can use MSVC style or
+GCC style indicators (%I64d or %lld).  It supports the C99 specifiers
+for size_t and ptr_diff_t (%jd %zd) as well.
+
+EXTRAS:
+=======
+Like some GCCs, for integers and floats, you can use a ' (single quote)
+specifier and commas will be inserted on the thousands: "%'d" on 12345
+would print 12,345.
+
+For integers and floats, you can use a "$" specifier and the number
+will be converted to float and then divided to get kilo, mega, giga or
+tera and then printed, so "%$d" 1000 is "1.0 k", "%$.2d" 2536000 is
+"2.53 M", etc. For byte values, use two $:s, like "%$$d" to turn
+2536000 to "2.42 Mi". If you prefer JEDEC suffixes to SI ones, use three
+$:s: "%$$$d" -> "2.42 M". To remove the space between the number and the
+suffix, add "_" specifier: "%_$d" -> "2.53M".
+
+In addition to octal and hexadecimal conversions, you can print
+integers in binary: "%b" for 256 would print 100.
+
+PERFORMANCE vs MSVC 2008 32-/64-bit (GCC is even slower than MSVC):
+===================================================================
+"%d" across all 32-bit ints (4.8x/4.0x faster than 32-/64-bit MSVC)
+"%24d" across all 32-bit ints (4.5x/4.2x faster)
+"%x" across all 32-bit ints (4.5x/3.8x faster)
+"%08x" across all 32-bit ints (4.3x/3.8x faster)
+"%f" across e-10 to e+10 floats (7.3x/6.0x faster)
+"%e" across e-10 to e+10 floats (8.1x/6.0x faster)
+"%g" across e-10 to e+10 floats (10.0x/7.1x faster)
+"%f" for values near e-300 (7.9x/6.5x faster)
+"%f" for values near e+300 (10.0x/9.1x faster)
+"%e" for values near e-300 (10.1x/7.0x faster)
+"%e" for values near e+300 (9.2x/6.0x faster)
+"%.320f" for values near e-300 (12.6x/11.2x faster)
+"%a" for random values (8.6x/4.3x faster)
+"%I64d" for 64-bits with 32-bit values (4.8x/3.4x faster)
+"%I64d" for 64-bits > 32-bit values (4.9x/5.5x faster)
+"%s%s%s" for 64 char strings (7.1x/7.3x faster)
+"...512 char string..." ( 35.0x/32.5x faster!)
+*/
+
+#if defined(__clang__)
+#if defined(__has_feature) && defined(__has_attribute)
+#if __has_feature(address_sanitizer)
+#if __has_attribute(__no_sanitize__)
+#define STBSP__ASAN __attribute__((__no_sanitize__("address")))
+#elif __has_attribute(__no_sanitize_address__)
+#define STBSP__ASAN __attribute__((__no_sanitize_address__))
+#elif __has_attribute(__no_address_safety_analysis__)
+#define STBSP__ASAN __attribute__((__no_address_safety_analysis__))
+#endif
+#endif
+#endif
+#elif defined(__GNUC__) && (__GNUC__ >= 5 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 8))
+#if defined(__SANITIZE_ADDRESS__) && __SANITIZE_ADDRESS__
+#define STBSP__ASAN __attribute__((__no_sanitize_address__))
+#endif
+#endif
+
+#ifndef STBSP__ASAN
+#define STBSP__ASAN
+#endif
+
+#ifdef STB_SPRINTF_STATIC
+#define STBSP__PUBLICDEC static
+#define STBSP__PUBLICDEF static STBSP__ASAN
+#else
+#ifdef __cplusplus
+#define STBSP__PUBLICDEC extern "C"
+#define STBSP__PUBLICDEF extern "C" STBSP__ASAN
+#else
+#define STBSP__PUBLICDEC extern
+#define STBSP__PUBLICDEF STBSP__ASAN
+#endif
+#endif
+
+#if defined(__has_attribute)
+#if __has_attribute(format)
+#define STBSP__ATTRIBUTE_FORMAT(fmt,va) __attribute__((format(printf,fmt,va)))
+#endif
+#endif
+
+#ifndef STBSP__ATTRIBUTE_FORMAT
+#define STBSP__ATTRIBUTE_FORMAT(fmt,va)
+#endif
+
+#ifdef _MSC_VER
+#define STBSP__NOTUSED(v)  (void)(v)
+#else
+#define STBSP__NOTUSED(v)  (void)sizeof(v)
+#endif
+
+#ifndef STB_SPRINTF_MIN
+#define STB_SPRINTF_MIN 512 // how many characters per callback
+#endif
+typedef char *STBSP_SPRINTFCB(const char *buf, void *user, int len);
+
+#ifndef STB_SPRINTF_DECORATE
+#define STB_SPRINTF_DECORATE(name) stbsp_##name // define this before including if you want to change the names
+#endif
+
+STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(vsprintf)(char *buf, char const *fmt, va_list va);
+STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(vsnprintf)(char *buf, int count, char const *fmt, va_list va);
+STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(sprintf)(char *buf, char const *fmt, ...) STBSP__ATTRIBUTE_FORMAT(2,3);
+STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(snprintf)(char *buf, int count, char const *fmt, ...) STBSP__ATTRIBUTE_FORMAT(3,4);
+
+STBSP__PUBLICDEC int STB_SPRINTF_DECORATE(vsprintfcb)(STBSP_SPRINTFCB *callback, void *user, char *buf, char const *fmt, va_list va);
+STBSP__PUBLICDEC void STB_SPRINTF_DECORATE(set_separators)(char comma, char period);
+
+#endif // STB_SPRINTF_H_INCLUDE
+
+#ifdef STB_SPRINTF_IMPLEMENTATION
+
+#define stbsp__uint32 unsigned int
+#define stbsp__int32 signed int
+
+#ifdef _MSC_VER
+#define stbsp__uint64 unsigned __int64
+#define stbsp__int64 signed __int64
+#else
+#define stbsp__uint64 unsigned long long
+#define stbsp__int64 signed long long
+#endif
+#define stbsp__uint16 unsigned short
+
+#ifndef stbsp__uintptr
+#if defined(__ppc64__) || defined(__powerpc64__) || defined(__aarch64__) || defined(_M_X64) || defined(__x86_64__) || defined(__x86_64) || defined(__s390x__)
+#define stbsp__uintptr stbsp__uint64
+#else
+#define stbsp__uintptr stbsp__uint32
+#endif
+#endif
+
+#ifndef STB_SPRINTF_MSVC_MODE // used for MSVC2013 and earlier (MSVC2015 matches GCC)
+#if defined(_MSC_VER) && (_MSC_VER < 1900)
+#define STB_SPRINTF_MSVC_MODE
+#endif
+#endif
+
+#ifdef STB_SPRINTF_NOUNALIGNED // define this before inclusion to force stbsp_sprintf to always use aligned accesses
+#define STBSP__UNALIGNED(code)
+#else
+#define STBSP__UNALIGNED(code) code
+#endif
+
+#ifndef STB_SPRINTF_NOFLOAT
+// internal float utility functions
+static stbsp__int32 stbsp__real_to_str(char const **start, stbsp__uint32 *len, char *out, stbsp__int32 *decimal_pos, double value, stbsp__uint32 frac_digits);
+static stbsp__int32 stbsp__real_to_parts(stbsp__int64 *bits, stbsp__int32 *expo, double value);
+#define STBSP__SPECIAL 0x7000
+#endif
+
+static char stbsp__period = '.';
+static char stbsp__comma = ',';
+static struct
+{
+    short temp; // force next field to be 2-byte aligned
+    char pair[201];
+} stbsp__digitpair =
+{
+    0,
+    "00010203040506070809101112131415161718192021222324"
+        "25262728293031323334353637383940414243444546474849"
+        "50515253545556575859606162636465666768697071727374"
+        "75767778798081828384858687888990919293949596979899"
+};
+
+STBSP__PUBLICDEF void STB_SPRINTF_DECORATE(set_separators)(char pcomma, char pperiod)
+{
+    stbsp__period = pperiod;
+    stbsp__comma = pcomma;
+}
+
+#define STBSP__LEFTJUST 1
+#define STBSP__LEADINGPLUS 2
+#define STBSP__LEADINGSPACE 4
+#define STBSP__LEADING_0X 8
+#define STBSP__LEADINGZERO 16
+#define STBSP__INTMAX 32
+#define STBSP__TRIPLET_COMMA 64
+#define STBSP__NEGATIVE 128
+#define STBSP__METRIC_SUFFIX 256
+#define STBSP__HALFWIDTH 512
+#define STBSP__METRIC_NOSPACE 1024
+#define STBSP__METRIC_1024 2048
+#define STBSP__METRIC_JEDEC 4096
+
+static void stbsp__lead_sign(stbsp__uint32 fl, char *sign)
+{
+    sign[0] = 0;
+    if (fl & STBSP__NEGATIVE) {
+        sign[0] = 1;
+        sign[1] = '-';
+    } else if (fl & STBSP__LEADINGSPACE) {
+        sign[0] = 1;
+        sign[1] = ' ';
+    } else if (fl & STBSP__LEADINGPLUS) {
+        sign[0] = 1;
+        sign[1] = '+';
+    }
+}
+
+static STBSP__ASAN stbsp__uint32 stbsp__strlen_limited(char const *s, stbsp__uint32 limit)
+{
+    char const * sn = s;
+    
+    // get up to 4-byte alignment
+    for (;;) {
+        if (((stbsp__uintptr)sn & 3) == 0)
+            break;
+        
+        if (!limit || *sn == 0)
+            return (stbsp__uint32)(sn - s);
+        
+        ++sn;
+        --limit;
+    }
+    
+    // scan over 4 bytes at a time to find terminating 0
+    // this will intentionally scan up to 3 bytes past the end of buffers,
+    // but becase it works 4B aligned, it will never cross page boundaries
+    // (hence the STBSP__ASAN markup; the over-read here is intentional
+    // and harmless)
+    while (limit >= 4) {
+        stbsp__uint32 v = *(stbsp__uint32 *)sn;
+        // bit hack to find if there's a 0 byte in there
+        if ((v - 0x01010101) & (~v) & 0x80808080UL)
+            break;
+        
+        sn += 4;
+        limit -= 4;
+    }
+    
+    // handle the last few characters to find actual size
+    while (limit && *sn) {
+        ++sn;
+        --limit;
+    }
+    
+    return (stbsp__uint32)(sn - s);
+}
+
+STBSP__PUBLICDEF int STB_SPRINTF_DECORATE(vsprintfcb)(STBSP_SPRINTFCB *callback, void *user, char *buf, char const *fmt, va_list va)
+{
+    static char hex[] = "0123456789abcdefxp";
+    static char hexu[] = "0123456789ABCDEFXP";
+    char *bf;
+    char const *f;
+    int tlen = 0;
+    
+    bf = buf;
+    f = fmt;
+    for (;;) {
+        stbsp__int32 fw, pr, tz;
+        stbsp__uint32 fl;
+        
+        // macros for the callback buffer stuff
+#define stbsp__chk_cb_bufL(bytes)                        \
+{                                                     \
+int len = (int)(bf - buf);                         \
+if ((len + (bytes)) >= STB_SPRINTF_MIN) {          \
+tlen += len;                                    \
+if (0 == (bf = buf = callback(buf, user, len))) \
+goto done;                                   \
+}                                                  \
+}
+#define stbsp__chk_cb_buf(bytes)    \
+{                                \
+if (callback) {               \
+stbsp__chk_cb_bufL(bytes); \
+}                             \
+}
+#define stbsp__flush_cb()                      \
+{                                           \
+stbsp__chk_cb_bufL(STB_SPRINTF_MIN - 1); \
+} // flush if there is even one byte in the buffer
+#define stbsp__cb_buf_clamp(cl, v)                \
+cl = v;                                        \
+if (callback) {                                \
+int lg = STB_SPRINTF_MIN - (int)(bf - buf); \
+if (cl > lg)                                \
+cl = lg;                                 \
+}
+        
+        // fast copy everything up to the next % (or end of string)
+        for (;;) {
+            while (((stbsp__uintptr)f) & 3) {
+                schk1:
+                if (f[0] == '%')
+                    goto scandd;
+                schk2:
+                if (f[0] == 0)
+                    goto endfmt;
+                stbsp__chk_cb_buf(1);
+                *bf++ = f[0];
+                ++f;
+            }
+            for (;;) {
+                // Check if the next 4 bytes contain %(0x25) or end of string.
+                // Using the 'hasless' trick:
+                // https://graphics.stanford.edu/~seander/bithacks.html#HasLessInWord
+                stbsp__uint32 v, c;
+                v = *(stbsp__uint32 *)f;
+                c = (~v) & 0x80808080;
+                if (((v ^ 0x25252525) - 0x01010101) & c)
+                    goto schk1;
+                if ((v - 0x01010101) & c)
+                    goto schk2;
+                if (callback)
+                    if ((STB_SPRINTF_MIN - (int)(bf - buf)) < 4)
+                    goto schk1;
+#ifdef STB_SPRINTF_NOUNALIGNED
+                if(((stbsp__uintptr)bf) & 3) {
+                    bf[0] = f[0];
+                    bf[1] = f[1];
+                    bf[2] = f[2];
+                    bf[3] = f[3];
+                } else
+#endif
+                {
+                    *(stbsp__uint32 *)bf = v;
+                }
+                bf += 4;
+                f += 4;
+            }
+        }
+        scandd:
+        
+        ++f;
+        
+        // ok, we have a percent, read the modifiers first
+        fw = 0;
+        pr = -1;
+        fl = 0;
+        tz = 0;
+        
+        // flags
+        for (;;) {
+            switch (f[0]) {
+                // if we have left justify
+                case '-':
+                fl |= STBSP__LEFTJUST;
+                ++f;
+                continue;
+                // if we have leading plus
+                case '+':
+                fl |= STBSP__LEADINGPLUS;
+                ++f;
+                continue;
+                // if we have leading space
+                case ' ':
+                fl |= STBSP__LEADINGSPACE;
+                ++f;
+                continue;
+                // if we have leading 0x
+                case '#':
+                fl |= STBSP__LEADING_0X;
+                ++f;
+                continue;
+                // if we have thousand commas
+                case '\'':
+                fl |= STBSP__TRIPLET_COMMA;
+                ++f;
+                continue;
+                // if we have kilo marker (none->kilo->kibi->jedec)
+                case '$':
+                if (fl & STBSP__METRIC_SUFFIX) {
+                    if (fl & STBSP__METRIC_1024) {
+                        fl |= STBSP__METRIC_JEDEC;
+                    } else {
+                        fl |= STBSP__METRIC_1024;
+                    }
+                } else {
+                    fl |= STBSP__METRIC_SUFFIX;
+                }
+                ++f;
+                continue;
+                // if we don't want space between metric suffix and number
+                case '_':
+                fl |= STBSP__METRIC_NOSPACE;
+                ++f;
+                continue;
+                // if we have leading zero
+                case '0':
+                fl |= STBSP__LEADINGZERO;
+                ++f;
+                goto flags_done;
+                default: goto flags_done;
+            }
+        }
+        flags_done:
+        
+        // get the field width
+        if (f[0] == '*') {
+            fw = va_arg(va, stbsp__uint32);
+            ++f;
+        } else {
+            while ((f[0] >= '0') && (f[0] <= '9')) {
+                fw = fw * 10 + f[0] - '0';
+                f++;
+            }
+        }
+        // get the precision
+        if (f[0] == '.') {
+            ++f;
+            if (f[0] == '*') {
+                pr = va_arg(va, stbsp__uint32);
+                ++f;
+            } else {
+                pr = 0;
+                while ((f[0] >= '0') && (f[0] <= '9')) {
+                    pr = pr * 10 + f[0] - '0';
+                    f++;
+                }
+            }
+        }
+        
+        // handle integer size overrides
+        switch (f[0]) {
+            // are we halfwidth?
+            case 'h':
+            fl |= STBSP__HALFWIDTH;
+            ++f;
+            if (f[0] == 'h')
+                ++f;  // QUARTERWIDTH
+            break;
+            // are we 64-bit (unix style)
+            case 'l':
+            fl |= ((sizeof(long) == 8) ? STBSP__INTMAX : 0);
+            ++f;
+            if (f[0] == 'l') {
+                fl |= STBSP__INTMAX;
+                ++f;
+            }
+            break;
+            // are we 64-bit on intmax? (c99)
+            case 'j':
+            fl |= (sizeof(size_t) == 8) ? STBSP__INTMAX : 0;
+            ++f;
+            break;
+            // are we 64-bit on size_t or ptrdiff_t? (c99)
+            case 'z':
+            fl |= (sizeof(ptrdiff_t) == 8) ? STBSP__INTMAX : 0;
+            ++f;
+            break;
+            case 't':
+            fl |= (sizeof(ptrdiff_t) == 8) ? STBSP__INTMAX : 0;
+            ++f;
+            break;
+            // are we 64-bit (msft style)
+            case 'I':
+            if ((f[1] == '6') && (f[2] == '4')) {
+                fl |= STBSP__INTMAX;
+                f += 3;
+            } else if ((f[1] == '3') && (f[2] == '2')) {
+                f += 3;
+            } else {
+                fl |= ((sizeof(void *) == 8) ? STBSP__INTMAX : 0);
+                ++f;
+            }
+            break;
+            default: break;
+        }
+        
+        // handle each replacement
+        switch (f[0]) {
+#define STBSP__NUMSZ 512 // big enough for e308 (with commas) or e-307
+            char num[STBSP__NUMSZ];
+            char lead[8];
+            char tail[8];
+            char *s;
+            char const *h;
+            stbsp__uint32 l, n, cs;
+            stbsp__uint64 n64;
+#ifndef STB_SPRINTF_NOFLOAT
+            double fv;
+#endif
+            stbsp__int32 dp;
+            char const *sn;
+            
+            case 's':
+            // get the string
+            s = va_arg(va, char *);
+            if (s == 0)
+                s = (char *)"null";
+            // get the length, limited to desired precision
+            // always limit to ~0u chars since our counts are 32b
+            l = stbsp__strlen_limited(s, (pr >= 0) ? pr : ~0u);
+            lead[0] = 0;
+            tail[0] = 0;
+            pr = 0;
+            dp = 0;
+            cs = 0;
+            // copy the string in
+            goto scopy;
+            
+            case 'c': // char
+            // get the character
+            s = num + STBSP__NUMSZ - 1;
+            *s = (char)va_arg(va, int);
+            l = 1;
+            lead[0] = 0;
+            tail[0] = 0;
+            pr = 0;
+            dp = 0;
+            cs = 0;
+            goto scopy;
+            
+            case 'n': // weird write-bytes specifier
+            {
+                int *d = va_arg(va, int *);
+                *d = tlen + (int)(bf - buf);
+            } break;
+            
+#ifdef STB_SPRINTF_NOFLOAT
+            case 'A':              // float
+            case 'a':              // hex float
+            case 'G':              // float
+            case 'g':              // float
+            case 'E':              // float
+            case 'e':              // float
+            case 'f':              // float
+            va_arg(va, double); // eat it
+            s = (char *)"No float";
+            l = 8;
+            lead[0] = 0;
+            tail[0] = 0;
+            pr = 0;
+            cs = 0;
+            STBSP__NOTUSED(dp);
+            goto scopy;
+#else
+            case 'A': // hex float
+            case 'a': // hex float
+            h = (f[0] == 'A') ? hexu : hex;
+            fv = va_arg(va, double);
+            if (pr == -1)
+                pr = 6; // default is 6
+            // read the double into a string
+            if (stbsp__real_to_parts((stbsp__int64 *)&n64, &dp, fv))
+                fl |= STBSP__NEGATIVE;
+            
+            s = num + 64;
+            
+            stbsp__lead_sign(fl, lead);
+            
+            if (dp == -1023)
+                dp = (n64) ? -1022 : 0;
+            else
+                n64 |= (((stbsp__uint64)1) << 52);
+            n64 <<= (64 - 56);
+            if (pr < 15)
+                n64 += ((((stbsp__uint64)8) << 56) >> (pr * 4));
+            // add leading chars
+            
+#ifdef STB_SPRINTF_MSVC_MODE
+            *s++ = '0';
+            *s++ = 'x';
+#else
+            lead[1 + lead[0]] = '0';
+            lead[2 + lead[0]] = 'x';
+            lead[0] += 2;
+#endif
+            *s++ = h[(n64 >> 60) & 15];
+            n64 <<= 4;
+            if (pr)
+                *s++ = stbsp__period;
+            sn = s;
+            
+            // print the bits
+            n = pr;
+            if (n > 13)
+                n = 13;
+            if (pr > (stbsp__int32)n)
+                tz = pr - n;
+            pr = 0;
+            while (n--) {
+                *s++ = h[(n64 >> 60) & 15];
+                n64 <<= 4;
+            }
+            
+            // print the expo
+            tail[1] = h[17];
+            if (dp < 0) {
+                tail[2] = '-';
+                dp = -dp;
+            } else
+                tail[2] = '+';
+            n = (dp >= 1000) ? 6 : ((dp >= 100) ? 5 : ((dp >= 10) ? 4 : 3));
+            tail[0] = (char)n;
+            for (;;) {
+                tail[n] = '0' + dp % 10;
+                if (n <= 3)
+                    break;
+                --n;
+                dp /= 10;
+            }
+            
+            dp = (int)(s - sn);
+            l = (int)(s - (num + 64));
+            s = num + 64;
+            cs = 1 + (3 << 24);
+            goto scopy;
+            
+            case 'G': // float
+            case 'g': // float
+            h = (f[0] == 'G') ? hexu : hex;
+            fv = va_arg(va, double);
+            if (pr == -1)
+                pr = 6;
+            else if (pr == 0)
+                pr = 1; // default is 6
+            // read the double into a string
+            if (stbsp__real_to_str(&sn, &l, num, &dp, fv, (pr - 1) | 0x80000000))
+                fl |= STBSP__NEGATIVE;
+            
+            // clamp the precision and delete extra zeros after clamp
+            n = pr;
+            if (l > (stbsp__uint32)pr)
+                l = pr;
+            while ((l > 1) && (pr) && (sn[l - 1] == '0')) {
+                --pr;
+                --l;
+            }
+            
+            // should we use %e
+            if ((dp <= -4) || (dp > (stbsp__int32)n)) {
+                if (pr > (stbsp__int32)l)
+                    pr = l - 1;
+                else if (pr)
+                    --pr; // when using %e, there is one digit before the decimal
+                goto doexpfromg;
+            }
+            // this is the insane action to get the pr to match %g semantics for %f
+            if (dp > 0) {
+                pr = (dp < (stbsp__int32)l) ? l - dp : 0;
+            } else {
+                pr = -dp + ((pr > (stbsp__int32)l) ? (stbsp__int32) l : pr);
+            }
+            goto dofloatfromg;
+            
+            case 'E': // float
+            case 'e': // float
+            h = (f[0] == 'E') ? hexu : hex;
+            fv = va_arg(va, double);
+            if (pr == -1)
+                pr = 6; // default is 6
+            // read the double into a string
+            if (stbsp__real_to_str(&sn, &l, num, &dp, fv, pr | 0x80000000))
+                fl |= STBSP__NEGATIVE;
+            doexpfromg:
+            tail[0] = 0;
+            stbsp__lead_sign(fl, lead);
+            if (dp == STBSP__SPECIAL) {
+                s = (char *)sn;
+                cs = 0;
+                pr = 0;
+                goto scopy;
+            }
+            s = num + 64;
+            // handle leading chars
+            *s++ = sn[0];
+            
+            if (pr)
+                *s++ = stbsp__period;
+            
+            // handle after decimal
+            if ((l - 1) > (stbsp__uint32)pr)
+                l = pr + 1;
+            for (n = 1; n < l; n++)
+                *s++ = sn[n];
+            // trailing zeros
+            tz = pr - (l - 1);
+            pr = 0;
+            // dump expo
+            tail[1] = h[0xe];
+            dp -= 1;
+            if (dp < 0) {
+                tail[2] = '-';
+                dp = -dp;
+            } else
+                tail[2] = '+';
+#ifdef STB_SPRINTF_MSVC_MODE
+            n = 5;
+#else
+            n = (dp >= 100) ? 5 : 4;
+#endif
+            tail[0] = (char)n;
+            for (;;) {
+                tail[n] = '0' + dp % 10;
+                if (n <= 3)
+                    break;
+                --n;
+                dp /= 10;
+            }
+            cs = 1 + (3 << 24); // how many tens
+            goto flt_lead;
+            
+            case 'f': // float
+            fv = va_arg(va, double);
+            doafloat:
+            // do kilos
+            if (fl & STBSP__METRIC_SUFFIX) {
+                double divisor;
+                divisor = 1000.0f;
+                if (fl & STBSP__METRIC_1024)
+                    divisor = 1024.0;
+                while (fl < 0x4000000) {
+                    if ((fv < divisor) && (fv > -divisor))
+                        break;
+                    fv /= divisor;
+                    fl += 0x1000000;
+                }
+            }
+            if (pr == -1)
+                pr = 6; // default is 6
+            // read the double into a string
+            if (stbsp__real_to_str(&sn, &l, num, &dp, fv, pr))
+                fl |= STBSP__NEGATIVE;
+            dofloatfromg:
+            tail[0] = 0;
+            stbsp__lead_sign(fl, lead);
+            if (dp == STBSP__SPECIAL) {
+                s = (char *)sn;
+                cs = 0;
+                pr = 0;
+                goto scopy;
+            }
+            s = num + 64;
+            
+            // handle the three decimal varieties
+            if (dp <= 0) {
+                stbsp__int32 i;
+                // handle 0.000*000xxxx
+                *s++ = '0';
+                if (pr)
+                    *s++ = stbsp__period;
+                n = -dp;
+                if ((stbsp__int32)n > pr)
+                    n = pr;
+                i = n;
+                while (i) {
+                    if ((((stbsp__uintptr)s) & 3) == 0)
+                        break;
+                    *s++ = '0';
+                    --i;
+                }
+                while (i >= 4) {
+                    *(stbsp__uint32 *)s = 0x30303030;
+                    s += 4;
+                    i -= 4;
+                }
+                while (i) {
+                    *s++ = '0';
+                    --i;
+                }
+                if ((stbsp__int32)(l + n) > pr)
+                    l = pr - n;
+                i = l;
+                while (i) {
+                    *s++ = *sn++;
+                    --i;
+                }
+                tz = pr - (n + l);
+                cs = 1 + (3 << 24); // how many tens did we write (for commas below)
+            } else {
+                cs = (fl & STBSP__TRIPLET_COMMA) ? ((600 - (stbsp__uint32)dp) % 3) : 0;
+                if ((stbsp__uint32)dp >= l) {
+                    // handle xxxx000*000.0
+                    n = 0;
+                    for (;;) {
+                        if ((fl & STBSP__TRIPLET_COMMA) && (++cs == 4)) {
+                            cs = 0;
+                            *s++ = stbsp__comma;
+                        } else {
+                            *s++ = sn[n];
+                            ++n;
+                            if (n >= l)
+                                break;
+                        }
+                    }
+                    if (n < (stbsp__uint32)dp) {
+                        n = dp - n;
+                        if ((fl & STBSP__TRIPLET_COMMA) == 0) {
+                            while (n) {
+                                if ((((stbsp__uintptr)s) & 3) == 0)
+                                    break;
+                                *s++ = '0';
+                                --n;
+                            }
+                            while (n >= 4) {
+                                *(stbsp__uint32 *)s = 0x30303030;
+                                s += 4;
+                                n -= 4;
+                            }
+                        }
+                        while (n) {
+                            if ((fl & STBSP__TRIPLET_COMMA) && (++cs == 4)) {
+                                cs = 0;
+                                *s++ = stbsp__comma;
+                            } else {
+                                *s++ = '0';
+                                --n;
+                            }
+                        }
+                    }
+                    cs = (int)(s - (num + 64)) + (3 << 24); // cs is how many tens
+                    if (pr) {
+                        *s++ = stbsp__period;
+                        tz = pr;
+                    }
+                } else {
+                    // handle xxxxx.xxxx000*000
+                    n = 0;
+                    for (;;) {
+                        if ((fl & STBSP__TRIPLET_COMMA) && (++cs == 4)) {
+                            cs = 0;
+                            *s++ = stbsp__comma;
+                        } else {
+                            *s++ = sn[n];
+                            ++n;
+                            if (n >= (stbsp__uint32)dp)
+                                break;
+                        }
+                    }
+                    cs = (int)(s - (num + 64)) + (3 << 24); // cs is how many tens
+                    if (pr)
+                        *s++ = stbsp__period;
+                    if ((l - dp) > (stbsp__uint32)pr)
+                        l = pr + dp;
+                    while (n < l) {
+                        *s++ = sn[n];
+                        ++n;
+                    }
+                    tz = pr - (l - dp);
+                }
+            }
+            pr = 0;
+            
+            // handle k,m,g,t
+            if (fl & STBSP__METRIC_SUFFIX) {
+                char idx;
+                idx = 1;
+                if (fl & STBSP__METRIC_NOSPACE)
+                    idx = 0;
+                tail[0] = idx;
+                tail[1] = ' ';
+                {
+                    if (fl >> 24) { // SI kilo is 'k', JEDEC and SI kibits are 'K'.
+                        if (fl & STBSP__METRIC_1024)
+                            tail[idx + 1] = "_KMGT"[fl >> 24];
+                        else
+                            tail[idx + 1] = "_kMGT"[fl >> 24];
+                        idx++;
+                        // If printing kibits and not in jedec, add the 'i'.
+                        if (fl & STBSP__METRIC_1024 && !(fl & STBSP__METRIC_JEDEC)) {
+                            tail[idx + 1] = 'i';
+                            idx++;
+                        }
+                        tail[0] = idx;
+                    }
+                }
+            };
+            
+            flt_lead:
+            // get the length that we copied
+            l = (stbsp__uint32)(s - (num + 64));
+            s = num + 64;
+            goto scopy;
+#endif
+            
+            case 'B': // upper binary
+            case 'b': // lower binary
+            h = (f[0] == 'B') ? hexu : hex;
+            lead[0] = 0;
+            if (fl & STBSP__LEADING_0X) {
+                lead[0] = 2;
+                lead[1] = '0';
+                lead[2] = h[0xb];
+            }
+            l = (8 << 4) | (1 << 8);
+            goto radixnum;
+            
+            case 'o': // octal
+            h = hexu;
+            lead[0] = 0;
+            if (fl & STBSP__LEADING_0X) {
+                lead[0] = 1;
+                lead[1] = '0';
+            }
+            l = (3 << 4) | (3 << 8);
+            goto radixnum;
+            
+            case 'p': // pointer
+            fl |= (sizeof(void *) == 8) ? STBSP__INTMAX : 0;
+            pr = sizeof(void *) * 2;
+            fl &= ~STBSP__LEADINGZERO; // 'p' only prints the pointer with zeros
+            // fall through - to X
+            
+            case 'X': // upper hex
+            case 'x': // lower hex
+            h = (f[0] == 'X') ? hexu : hex;
+            l = (4 << 4) | (4 << 8);
+            lead[0] = 0;
+            if (fl & STBSP__LEADING_0X) {
+                lead[0] = 2;
+                lead[1] = '0';
+                lead[2] = h[16];
+            }
+            radixnum:
+            // get the number
+            if (fl & STBSP__INTMAX)
+                n64 = va_arg(va, stbsp__uint64);
+            else
+                n64 = va_arg(va, stbsp__uint32);
+            
+            s = num + STBSP__NUMSZ;
+            dp = 0;
+            // clear tail, and clear leading if value is zero
+            tail[0] = 0;
+            if (n64 == 0) {
+                lead[0] = 0;
+                if (pr == 0) {
+                    l = 0;
+                    cs = 0;
+                    goto scopy;
+                }
+            }
+            // convert to string
+            for (;;) {
+                *--s = h[n64 & ((1 << (l >> 8)) - 1)];
+                n64 >>= (l >> 8);
+                if (!((n64) || ((stbsp__int32)((num + STBSP__NUMSZ) - s) < pr)))
+                    break;
+                if (fl & STBSP__TRIPLET_COMMA) {
+                    ++l;
+                    if ((l & 15) == ((l >> 4) & 15)) {
+                        l &= ~15;
+                        *--s = stbsp__comma;
+                    }
+                }
+            };
+            // get the tens and the comma pos
+            cs = (stbsp__uint32)((num + STBSP__NUMSZ) - s) + ((((l >> 4) & 15)) << 24);
+            // get the length that we copied
+            l = (stbsp__uint32)((num + STBSP__NUMSZ) - s);
+            // copy it
+            goto scopy;
+            
+            case 'u': // unsigned
+            case 'i':
+            case 'd': // integer
+            // get the integer and abs it
+            if (fl & STBSP__INTMAX) {
+                stbsp__int64 i64 = va_arg(va, stbsp__int64);
+                n64 = (stbsp__uint64)i64;
+                if ((f[0] != 'u') && (i64 < 0)) {
+                    n64 = (stbsp__uint64)-i64;
+                    fl |= STBSP__NEGATIVE;
+                }
+            } else {
+                stbsp__int32 i = va_arg(va, stbsp__int32);
+                n64 = (stbsp__uint32)i;
+                if ((f[0] != 'u') && (i < 0)) {
+                    n64 = (stbsp__uint32)-i;
+                    fl |= STBSP__NEGATIVE;
+                }
+            }
+            
+#ifndef STB_SPRINTF_NOFLOAT
+            if (fl & STBSP__METRIC_SUFFIX) {
+                if (n64 < 1024)
+                    pr = 0;
+                else if (pr == -1)
+                    pr = 1;
+                fv = (double)(stbsp__int64)n64;
+                goto doafloat;
+            }
+#endif
+            
+            // convert to string
+            s = num + STBSP__NUMSZ;
+            l = 0;
+            
+            for (;;) {
+                // do in 32-bit chunks (avoid lots of 64-bit divides even with constant denominators)
+                char *o = s - 8;
+                if (n64 >= 100000000) {
+                    n = (stbsp__uint32)(n64 % 100000000);
+                    n64 /= 100000000;
+                } else {
+                    n = (stbsp__uint32)n64;
+                    n64 = 0;
+                }
+                if ((fl & STBSP__TRIPLET_COMMA) == 0) {
+                    do {
+                        s -= 2;
+                        *(stbsp__uint16 *)s = *(stbsp__uint16 *)&stbsp__digitpair.pair[(n % 100) * 2];
+                        n /= 100;
+                    } while (n);
+                }
+                while (n) {
+                    if ((fl & STBSP__TRIPLET_COMMA) && (l++ == 3)) {
+                        l = 0;
+                        *--s = stbsp__comma;
+                        --o;
+                    } else {
+                        *--s = (char)(n % 10) + '0';
+                        n /= 10;
+                    }
+                }
+                if (n64 == 0) {
+                    if ((s[0] == '0') && (s != (num + STBSP__NUMSZ)))
+                        ++s;
+                    break;
+                }
+                while (s != o)
+                    if ((fl & STBSP__TRIPLET_COMMA) && (l++ == 3)) {
+                    l = 0;
+                    *--s = stbsp__comma;
+                    --o;
+                } else {
+                    *--s = '0';
+                }
+            }
+            
+            tail[0] = 0;
+            stbsp__lead_sign(fl, lead);
+            
+            // get the length that we copied
+            l = (stbsp__uint32)((num + STBSP__NUMSZ) - s);
+            if (l == 0) {
+                *--s = '0';
+                l = 1;
+            }
+            cs = l + (3 << 24);
+            if (pr < 0)
+                pr = 0;
+            
+            scopy:
+            // get fw=leading/trailing space, pr=leading zeros
+            if (pr < (stbsp__int32)l)
+                pr = l;
+            n = pr + lead[0] + tail[0] + tz;
+            if (fw < (stbsp__int32)n)
+                fw = n;
+            fw -= n;
+            pr -= l;
+            
+            // handle right justify and leading zeros
+            if ((fl & STBSP__LEFTJUST) == 0) {
+                if (fl & STBSP__LEADINGZERO) // if leading zeros, everything is in pr
+                {
+                    pr = (fw > pr) ? fw : pr;
+                    fw = 0;
+                } else {
+                    fl &= ~STBSP__TRIPLET_COMMA; // if no leading zeros, then no commas
+                }
+            }
+            
+            // copy the spaces and/or zeros
+            if (fw + pr) {
+                stbsp__int32 i;
+                stbsp__uint32 c;
+                
+                // copy leading spaces (or when doing %8.4d stuff)
+                if ((fl & STBSP__LEFTJUST) == 0)
+                    while (fw > 0) {
+                    stbsp__cb_buf_clamp(i, fw);
+                    fw -= i;
+                    while (i) {
+                        if ((((stbsp__uintptr)bf) & 3) == 0)
+                            break;
+                        *bf++ = ' ';
+                        --i;
+                    }
+                    while (i >= 4) {
+                        *(stbsp__uint32 *)bf = 0x20202020;
+                        bf += 4;
+                        i -= 4;
+                    }
+                    while (i) {
+                        *bf++ = ' ';
+                        --i;
+                    }
+                    stbsp__chk_cb_buf(1);
+                }
+                
+                // copy leader
+                sn = lead + 1;
+                while (lead[0]) {
+                    stbsp__cb_buf_clamp(i, lead[0]);
+                    lead[0] -= (char)i;
+                    while (i) {
+                        *bf++ = *sn++;
+                        --i;
+                    }
+                    stbsp__chk_cb_buf(1);
+                }
+                
+                // copy leading zeros
+                c = cs >> 24;
+                cs &= 0xffffff;
+                cs = (fl & STBSP__TRIPLET_COMMA) ? ((stbsp__uint32)(c - ((pr + cs) % (c + 1)))) : 0;
+                while (pr > 0) {
+                    stbsp__cb_buf_clamp(i, pr);
+                    pr -= i;
+                    if ((fl & STBSP__TRIPLET_COMMA) == 0) {
+                        while (i) {
+                            if ((((stbsp__uintptr)bf) & 3) == 0)
+                                break;
+                            *bf++ = '0';
+                            --i;
+                        }
+                        while (i >= 4) {
+                            *(stbsp__uint32 *)bf = 0x30303030;
+                            bf += 4;
+                            i -= 4;
+                        }
+                    }
+                    while (i) {
+                        if ((fl & STBSP__TRIPLET_COMMA) && (cs++ == c)) {
+                            cs = 0;
+                            *bf++ = stbsp__comma;
+                        } else
+                            *bf++ = '0';
+                        --i;
+                    }
+                    stbsp__chk_cb_buf(1);
+                }
+            }
+            
+            // copy leader if there is still one
+            sn = lead + 1;
+            while (lead[0]) {
+                stbsp__int32 i;
+                stbsp__cb_buf_clamp(i, lead[0]);
+                lead[0] -= (char)i;
+                while (i) {
+                    *bf++ = *sn++;
+                    --i;
+                }
+                stbsp__chk_cb_buf(1);
+            }
+            
+            // copy the string
+            n = l;
+            while (n) {
+                stbsp__int32 i;
+                stbsp__cb_buf_clamp(i, n);
+                n -= i;
+                STBSP__UNALIGNED(while (i >= 4) {
+                                     *(stbsp__uint32 volatile *)bf = *(stbsp__uint32 volatile *)s;
+                                     bf += 4;
+                                     s += 4;
+                                     i -= 4;
+                                 })
+                    while (i) {
+                    *bf++ = *s++;
+                    --i;
+                }
+                stbsp__chk_cb_buf(1);
+            }
+            
+            // copy trailing zeros
+            while (tz) {
+                stbsp__int32 i;
+                stbsp__cb_buf_clamp(i, tz);
+                tz -= i;
+                while (i) {
+                    if ((((stbsp__uintptr)bf) & 3) == 0)
+                        break;
+                    *bf++ = '0';
+                    --i;
+                }
+                while (i >= 4) {
+                    *(stbsp__uint32 *)bf = 0x30303030;
+                    bf += 4;
+                    i -= 4;
+                }
+                while (i) {
+                    *bf++ = '0';
+                    --i;
+                }
+                stbsp__chk_cb_buf(1);
+            }
+            
+            // copy tail if there is one
+            sn = tail + 1;
+            while (tail[0]) {
+                stbsp__int32 i;
+                stbsp__cb_buf_clamp(i, tail[0]);
+                tail[0] -= (char)i;
+                while (i) {
+                    *bf++ = *sn++;
+                    --i;
+                }
+                stbsp__chk_cb_buf(1);
+            }
+            
+            // handle the left justify
+            if (fl & STBSP__LEFTJUST)
+                if (fw > 0) {
+                while (fw) {
+                    stbsp__int32 i;
+                    stbsp__cb_buf_clamp(i, fw);
+                    fw -= i;
+                    while (i) {
+                        if ((((stbsp__uintptr)bf) & 3) == 0)
+                            break;
+                        *bf++ = ' ';
+                        --i;
+                    }
+                    while (i >= 4) {
+                        *(stbsp__uint32 *)bf = 0x20202020;
+                        bf += 4;
+                        i -= 4;
+                    }
+                    while (i--)
+                        *bf++ = ' ';
+                    stbsp__chk_cb_buf(1);
+                }
+            }
+            break;
+            
+            default: // unknown, just copy code
+            s = num + STBSP__NUMSZ - 1;
+            *s = f[0];
+            l = 1;
+            fw = fl = 0;
+            lead[0] = 0;
+            tail[0] = 0;
+            pr = 0;
+            dp = 0;
+            cs = 0;
+            goto scopy;
+        }
+        ++f;
+    }
+    endfmt:
+    
+    if (!callback)
+        *bf = 0;
+    else
+        stbsp__flush_cb();
+    
+    done:
+    return tlen + (int)(bf - buf);
+}
+
+// cleanup
+#undef STBSP__LEFTJUST
+#undef STBSP__LEADINGPLUS
+#undef STBSP__LEADINGSPACE
+#undef STBSP__LEADING_0X
+#undef STBSP__LEADINGZERO
+#undef STBSP__INTMAX
+#undef STBSP__TRIPLET_COMMA
+#undef STBSP__NEGATIVE
+#undef STBSP__METRIC_SUFFIX
+#undef STBSP__NUMSZ
+#undef stbsp__chk_cb_bufL
+#undef stbsp__chk_cb_buf
+#undef stbsp__flush_cb
+#undef stbsp__cb_buf_clamp
+
+// ============================================================================
+//   wrapper functions
+
+STBSP__PUBLICDEF int STB_SPRINTF_DECORATE(sprintf)(char *buf, char const *fmt, ...)
+{
+    int result;
+    va_list va;
+    va_start(va, fmt);
+    result = STB_SPRINTF_DECORATE(vsprintfcb)(0, 0, buf, fmt, va);
+    va_end(va);
+    return result;
+}
+
+typedef struct stbsp__context {
+    char *buf;
+    int count;
+    int length;
+    char tmp[STB_SPRINTF_MIN];
+} stbsp__context;
+
+static char *stbsp__clamp_callback(const char *buf, void *user, int len)
+{
+    stbsp__context *c = (stbsp__context *)user;
+    c->length += len;
+    
+    if (len > c->count)
+        len = c->count;
+    
+    if (len) {
+        if (buf != c->buf) {
+            const char *s, *se;
+            char *d;
+            d = c->buf;
+            s = buf;
+            se = buf + len;
+            do {
+                *d++ = *s++;
+            } while (s < se);
+        }
+        c->buf += len;
+        c->count -= len;
+    }
+    
+    if (c->count <= 0)
+        return c->tmp;
+    return (c->count >= STB_SPRINTF_MIN) ? c->buf : c->tmp; // go direct into buffer if you can
+}
+
+static char * stbsp__count_clamp_callback( const char * buf, void * user, int len )
+{
+    stbsp__context * c = (stbsp__context*)user;
+    (void) sizeof(buf);
+    
+    c->length += len;
+    return c->tmp; // go direct into buffer if you can
+}
+
+STBSP__PUBLICDEF int STB_SPRINTF_DECORATE( vsnprintf )( char * buf, int count, char const * fmt, va_list va )
+{
+    stbsp__context c;
+    
+    if ( (count == 0) && !buf )
+    {
+        c.length = 0;
+        
+        STB_SPRINTF_DECORATE( vsprintfcb )( stbsp__count_clamp_callback, &c, c.tmp, fmt, va );
+    }
+    else
+    {
+        int l;
+        
+        c.buf = buf;
+        c.count = count;
+        c.length = 0;
+        
+        STB_SPRINTF_DECORATE( vsprintfcb )( stbsp__clamp_callback, &c, stbsp__clamp_callback(0,&c,0), fmt, va );
+        
+        // zero-terminate
+        l = (int)( c.buf - buf );
+        if ( l >= count ) // should never be greater, only equal (or less) than count
+            l = count - 1;
+        buf[l] = 0;
+    }
+    
+    return c.length;
+}
+
+STBSP__PUBLICDEF int STB_SPRINTF_DECORATE(snprintf)(char *buf, int count, char const *fmt, ...)
+{
+    int result;
+    va_list va;
+    va_start(va, fmt);
+    
+    result = STB_SPRINTF_DECORATE(vsnprintf)(buf, count, fmt, va);
+    va_end(va);
+    
+    return result;
+}
+
+STBSP__PUBLICDEF int STB_SPRINTF_DECORATE(vsprintf)(char *buf, char const *fmt, va_list va)
+{
+    return STB_SPRINTF_DECORATE(vsprintfcb)(0, 0, buf, fmt, va);
+}
+
+// =======================================================================
+//   low level float utility functions
+
+#ifndef STB_SPRINTF_NOFLOAT
+
+// copies d to bits w/ strict aliasing (this compiles to nothing on /Ox)
+#define STBSP__COPYFP(dest, src)                   \
+{                                               \
+int cn;                                      \
+for (cn = 0; cn < 8; cn++)                   \
+((char *)&dest)[cn] = ((char *)&src)[cn]; \
+}
+
+// get float info
+static stbsp__int32 stbsp__real_to_parts(stbsp__int64 *bits, stbsp__int32 *expo, double value)
+{
+    double d;
+    stbsp__int64 b = 0;
+    
+    // load value and round at the frac_digits
+    d = value;
+    
+    STBSP__COPYFP(b, d);
+    
+    *bits = b & ((((stbsp__uint64)1) << 52) - 1);
+    *expo = (stbsp__int32)(((b >> 52) & 2047) - 1023);
+    
+    return (stbsp__int32)((stbsp__uint64) b >> 63);
+}
+
+static double const stbsp__bot[23] = {
+    1e+000, 1e+001, 1e+002, 1e+003, 1e+004, 1e+005, 1e+006, 1e+007, 1e+008, 1e+009, 1e+010, 1e+011,
+    1e+012, 1e+013, 1e+014, 1e+015, 1e+016, 1e+017, 1e+018, 1e+019, 1e+020, 1e+021, 1e+022
+};
+static double const stbsp__negbot[22] = {
+    1e-001, 1e-002, 1e-003, 1e-004, 1e-005, 1e-006, 1e-007, 1e-008, 1e-009, 1e-010, 1e-011,
+    1e-012, 1e-013, 1e-014, 1e-015, 1e-016, 1e-017, 1e-018, 1e-019, 1e-020, 1e-021, 1e-022
+};
+static double const stbsp__negboterr[22] = {
+    -5.551115123125783e-018,  -2.0816681711721684e-019, -2.0816681711721686e-020, -4.7921736023859299e-021, -8.1803053914031305e-022, 4.5251888174113741e-023,
+    4.5251888174113739e-024,  -2.0922560830128471e-025, -6.2281591457779853e-026, -3.6432197315497743e-027, 6.0503030718060191e-028,  2.0113352370744385e-029,
+    -3.0373745563400371e-030, 1.1806906454401013e-032,  -7.7705399876661076e-032, 2.0902213275965398e-033,  -7.1542424054621921e-034, -7.1542424054621926e-035,
+    2.4754073164739869e-036,  5.4846728545790429e-037,  9.2462547772103625e-038,  -4.8596774326570872e-039
+};
+static double const stbsp__top[13] = {
+    1e+023, 1e+046, 1e+069, 1e+092, 1e+115, 1e+138, 1e+161, 1e+184, 1e+207, 1e+230, 1e+253, 1e+276, 1e+299
+};
+static double const stbsp__negtop[13] = {
+    1e-023, 1e-046, 1e-069, 1e-092, 1e-115, 1e-138, 1e-161, 1e-184, 1e-207, 1e-230, 1e-253, 1e-276, 1e-299
+};
+static double const stbsp__toperr[13] = {
+    8388608,
+    6.8601809640529717e+028,
+    -7.253143638152921e+052,
+    -4.3377296974619174e+075,
+    -1.5559416129466825e+098,
+    -3.2841562489204913e+121,
+    -3.7745893248228135e+144,
+    -1.7356668416969134e+167,
+    -3.8893577551088374e+190,
+    -9.9566444326005119e+213,
+    6.3641293062232429e+236,
+    -5.2069140800249813e+259,
+    -5.2504760255204387e+282
+};
+static double const stbsp__negtoperr[13] = {
+    3.9565301985100693e-040,  -2.299904345391321e-063,  3.6506201437945798e-086,  1.1875228833981544e-109,
+    -5.0644902316928607e-132, -6.7156837247865426e-155, -2.812077463003139e-178,  -5.7778912386589953e-201,
+    7.4997100559334532e-224,  -4.6439668915134491e-247, -6.3691100762962136e-270, -9.436808465446358e-293,
+    8.0970921678014997e-317
+};
+
+#if defined(_MSC_VER) && (_MSC_VER <= 1200)
+static stbsp__uint64 const stbsp__powten[20] = {
+    1,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000,
+    1000000000,
+    10000000000,
+    100000000000,
+    1000000000000,
+    10000000000000,
+    100000000000000,
+    1000000000000000,
+    10000000000000000,
+    100000000000000000,
+    1000000000000000000,
+    10000000000000000000U
+};
+#define stbsp__tento19th ((stbsp__uint64)1000000000000000000)
+#else
+static stbsp__uint64 const stbsp__powten[20] = {
+    1,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000,
+    1000000000,
+    10000000000ULL,
+    100000000000ULL,
+    1000000000000ULL,
+    10000000000000ULL,
+    100000000000000ULL,
+    1000000000000000ULL,
+    10000000000000000ULL,
+    100000000000000000ULL,
+    1000000000000000000ULL,
+    10000000000000000000ULL
+};
+#define stbsp__tento19th (1000000000000000000ULL)
+#endif
+
+#define stbsp__ddmulthi(oh, ol, xh, yh)                            \
+{                                                               \
+double ahi = 0, alo, bhi = 0, blo;                           \
+stbsp__int64 bt;                                             \
+oh = xh * yh;                                                \
+STBSP__COPYFP(bt, xh);                                       \
+bt &= ((~(stbsp__uint64)0) << 27);                           \
+STBSP__COPYFP(ahi, bt);                                      \
+alo = xh - ahi;                                              \
+STBSP__COPYFP(bt, yh);                                       \
+bt &= ((~(stbsp__uint64)0) << 27);                           \
+STBSP__COPYFP(bhi, bt);                                      \
+blo = yh - bhi;                                              \
+ol = ((ahi * bhi - oh) + ahi * blo + alo * bhi) + alo * blo; \
+}
+
+#define stbsp__ddtoS64(ob, xh, xl)          \
+{                                        \
+double ahi = 0, alo, vh, t;           \
+ob = (stbsp__int64)xh;                \
+vh = (double)ob;                      \
+ahi = (xh - vh);                      \
+t = (ahi - xh);                       \
+alo = (xh - (ahi - t)) - (vh + t);    \
+ob += (stbsp__int64)(ahi + alo + xl); \
+}
+
+#define stbsp__ddrenorm(oh, ol) \
+{                            \
+double s;                 \
+s = oh + ol;              \
+ol = ol - (s - oh);       \
+oh = s;                   \
+}
+
+#define stbsp__ddmultlo(oh, ol, xh, xl, yh, yl) ol = ol + (xh * yl + xl * yh);
+
+#define stbsp__ddmultlos(oh, ol, xh, yl) ol = ol + (xh * yl);
+
+static void stbsp__raise_to_power10(double *ohi, double *olo, double d, stbsp__int32 power) // power can be -323 to +350
+{
+    double ph, pl;
+    if ((power >= 0) && (power <= 22)) {
+        stbsp__ddmulthi(ph, pl, d, stbsp__bot[power]);
+    } else {
+        stbsp__int32 e, et, eb;
+        double p2h, p2l;
+        
+        e = power;
+        if (power < 0)
+            e = -e;
+        et = (e * 0x2c9) >> 14; /* %23 */
+        if (et > 13)
+            et = 13;
+        eb = e - (et * 23);
+        
+        ph = d;
+        pl = 0.0;
+        if (power < 0) {
+            if (eb) {
+                --eb;
+                stbsp__ddmulthi(ph, pl, d, stbsp__negbot[eb]);
+                stbsp__ddmultlos(ph, pl, d, stbsp__negboterr[eb]);
+            }
+            if (et) {
+                stbsp__ddrenorm(ph, pl);
+                --et;
+                stbsp__ddmulthi(p2h, p2l, ph, stbsp__negtop[et]);
+                stbsp__ddmultlo(p2h, p2l, ph, pl, stbsp__negtop[et], stbsp__negtoperr[et]);
+                ph = p2h;
+                pl = p2l;
+            }
+        } else {
+            if (eb) {
+                e = eb;
+                if (eb > 22)
+                    eb = 22;
+                e -= eb;
+                stbsp__ddmulthi(ph, pl, d, stbsp__bot[eb]);
+                if (e) {
+                    stbsp__ddrenorm(ph, pl);
+                    stbsp__ddmulthi(p2h, p2l, ph, stbsp__bot[e]);
+                    stbsp__ddmultlos(p2h, p2l, stbsp__bot[e], pl);
+                    ph = p2h;
+                    pl = p2l;
+                }
+            }
+            if (et) {
+                stbsp__ddrenorm(ph, pl);
+                --et;
+                stbsp__ddmulthi(p2h, p2l, ph, stbsp__top[et]);
+                stbsp__ddmultlo(p2h, p2l, ph, pl, stbsp__top[et], stbsp__toperr[et]);
+                ph = p2h;
+                pl = p2l;
+            }
+        }
+    }
+    stbsp__ddrenorm(ph, pl);
+    *ohi = ph;
+    *olo = pl;
+}
+
+// given a float value, returns the significant bits in bits, and the position of the
+//   decimal point in decimal_pos.  +/-INF and NAN are specified by special values
+//   returned in the decimal_pos parameter.
+// frac_digits is absolute normally, but if you want from first significant digits (got %g and %e), or in 0x80000000
+static stbsp__int32 stbsp__real_to_str(char const **start, stbsp__uint32 *len, char *out, stbsp__int32 *decimal_pos, double value, stbsp__uint32 frac_digits)
+{
+    double d;
+    stbsp__int64 bits = 0;
+    stbsp__int32 expo, e, ng, tens;
+    
+    d = value;
+    STBSP__COPYFP(bits, d);
+    expo = (stbsp__int32)((bits >> 52) & 2047);
+    ng = (stbsp__int32)((stbsp__uint64) bits >> 63);
+    if (ng)
+        d = -d;
+    
+    if (expo == 2047) // is nan or inf?
+    {
+        *start = (bits & ((((stbsp__uint64)1) << 52) - 1)) ? "NaN" : "Inf";
+        *decimal_pos = STBSP__SPECIAL;
+        *len = 3;
+        return ng;
+    }
+    
+    if (expo == 0) // is zero or denormal
+    {
+        if (((stbsp__uint64) bits << 1) == 0) // do zero
+        {
+            *decimal_pos = 1;
+            *start = out;
+            out[0] = '0';
+            *len = 1;
+            return ng;
+        }
+        // find the right expo for denormals
+        {
+            stbsp__int64 v = ((stbsp__uint64)1) << 51;
+            while ((bits & v) == 0) {
+                --expo;
+                v >>= 1;
+            }
+        }
+    }
+    
+    // find the decimal exponent as well as the decimal bits of the value
+    {
+        double ph, pl;
+        
+        // log10 estimate - very specifically tweaked to hit or undershoot by no more than 1 of log10 of all expos 1..2046
+        tens = expo - 1023;
+        tens = (tens < 0) ? ((tens * 617) / 2048) : (((tens * 1233) / 4096) + 1);
+        
+        // move the significant bits into position and stick them into an int
+        stbsp__raise_to_power10(&ph, &pl, d, 18 - tens);
+        
+        // get full as much precision from double-double as possible
+        stbsp__ddtoS64(bits, ph, pl);
+        
+        // check if we undershot
+        if (((stbsp__uint64)bits) >= stbsp__tento19th)
+            ++tens;
+    }
+    
+    // now do the rounding in integer land
+    frac_digits = (frac_digits & 0x80000000) ? ((frac_digits & 0x7ffffff) + 1) : (tens + frac_digits);
+    if ((frac_digits < 24)) {
+        stbsp__uint32 dg = 1;
+        if ((stbsp__uint64)bits >= stbsp__powten[9])
+            dg = 10;
+        while ((stbsp__uint64)bits >= stbsp__powten[dg]) {
+            ++dg;
+            if (dg == 20)
+                goto noround;
+        }
+        if (frac_digits < dg) {
+            stbsp__uint64 r;
+            // add 0.5 at the right position and round
+            e = dg - frac_digits;
+            if ((stbsp__uint32)e >= 24)
+                goto noround;
+            r = stbsp__powten[e];
+            bits = bits + (r / 2);
+            if ((stbsp__uint64)bits >= stbsp__powten[dg])
+                ++tens;
+            bits /= r;
+        }
+        noround:;
+    }
+    
+    // kill long trailing runs of zeros
+    if (bits) {
+        stbsp__uint32 n;
+        for (;;) {
+            if (bits <= 0xffffffff)
+                break;
+            if (bits % 1000)
+                goto donez;
+            bits /= 1000;
+        }
+        n = (stbsp__uint32)bits;
+        while ((n % 1000) == 0)
+            n /= 1000;
+        bits = n;
+        donez:;
+    }
+    
+    // convert to string
+    out += 64;
+    e = 0;
+    for (;;) {
+        stbsp__uint32 n;
+        char *o = out - 8;
+        // do the conversion in chunks of U32s (avoid most 64-bit divides, worth it, constant denomiators be damned)
+        if (bits >= 100000000) {
+            n = (stbsp__uint32)(bits % 100000000);
+            bits /= 100000000;
+        } else {
+            n = (stbsp__uint32)bits;
+            bits = 0;
+        }
+        while (n) {
+            out -= 2;
+            *(stbsp__uint16 *)out = *(stbsp__uint16 *)&stbsp__digitpair.pair[(n % 100) * 2];
+            n /= 100;
+            e += 2;
+        }
+        if (bits == 0) {
+            if ((e) && (out[0] == '0')) {
+                ++out;
+                --e;
+            }
+            break;
+        }
+        while (out != o) {
+            *--out = '0';
+            ++e;
+        }
+    }
+    
+    *decimal_pos = tens;
+    *start = out;
+    *len = e;
+    return ng;
+}
+
+#undef stbsp__ddmulthi
+#undef stbsp__ddrenorm
+#undef stbsp__ddmultlo
+#undef stbsp__ddmultlos
+#undef STBSP__SPECIAL
+#undef STBSP__COPYFP
+
+#endif // STB_SPRINTF_NOFLOAT
+
+// clean up
+#undef stbsp__uint16
+#undef stbsp__uint32
+#undef stbsp__int32
+#undef stbsp__uint64
+#undef stbsp__int64
+#undef STBSP__UNALIGNED
+
+#endif // STB_SPRINTF_IMPLEMENTATION
+
+/*
+------------------------------------------------------------------------------
+This software is available under 2 licenses -- choose whichever you prefer.
+------------------------------------------------------------------------------
+ALTERNATIVE A - MIT License
+Copyright (c) 2017 Sean Barrett
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+------------------------------------------------------------------------------
+ALTERNATIVE B - Public Domain (www.unlicense.org)
+This is free and unencumbered software released into the public domain.
+Anyone is free to copy, modify, publish, use, compile, sell, or distribute this
+software, either in source code form or as a compiled binary, for any purpose,
+commercial or non-commercial, and by any means.
+In jurisdictions that recognize copyright laws, the author or authors of this
+software dedicate any and all copyright interest in the software to the public
+domain. We make this dedication for the benefit of the public at large and to
+the detriment of our heirs and successors. We intend this dedication to be an
+overt act of relinquishment in perpetuity of all present and future rights to
+this software under copyright law.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN
+ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+------------------------------------------------------------------------------
+*/
+
+bool AK_Is_Newline(char Code)
+{
+    return Code == '\n' || Code == '\r';
+}
+
+bool AK_Is_Whitespace(char Code)
+{
+    return AK_Is_Newline(Code) || Code == ' ' || Code == '\t' || Code == '\v' || Code == '\f';
+}
+
+uint64_t AK_CStr_Length(const char* Str)
+{
+    uint64_t Result = 0;
+    while(*Str++) Result++;
+    return Result;
+}
+
+const char& ak_str8::operator[](uint64_t Index) const
+{
+    return Str[Index];
+}
+
+bool ak_str8::Is_Null_Or_Empty()
+{
+    return !Str || !Length;
+}
+
+bool ak_str8::Is_Null_Or_Whitespace()
+{
+    if(Is_Null_Or_Empty())
+        return true;
+    
+    for(uint64_t i = 0; i < Length; i++)
+    {
+        if(!AK_Is_Whitespace(Str[i]))
+            return false;
+    }
+    
+    return true;
+}
+
+uint64_t ak_str8::Find_First(char Code)
+{
+    const char* Start = Str;
+    const char* End = Str+Length;
+    
+    while(Start != End)
+    {
+        if(*Start == Code)
+            return (uint64_t)(Start - Str);
+        Start++;
+    }
+    
+    return AK_STR8_FIND_ERROR;
+}
+
+uint64_t ak_str8::Find_Last(char Code)
+{
+    const char* End = Str + (Length-1);
+    while(End != Str-1)
+    {
+        if(*End == Code)
+            return (uint64_t)(End-Str);
+        
+        End--;
+    }
+    
+    return AK_STR8_FIND_ERROR;
+}
+
+ak_str8 ak_str8::Prefix(uint64_t Count)
+{
+    Count = AK__Min(Count, Length);
+    ak_str8 Result = {Str, Count};
+    return Result;
+}
+
+ak_str8 ak_str8::Chop(uint64_t Count)
+{
+    Count = AK__Min(Count, Length);
+    uint64_t Remaining = Length - Count;
+    ak_str8 Result = {Str, Remaining};
+    return Result;
+}
+
+ak_str8 ak_str8::Postfix(uint64_t Count)
+{
+    Count = AK__Min(Count, Length);
+    uint64_t Skip = Length - Count;
+    ak_str8 Result = {Str+Skip, Count};
+    return Result;
+}
+
+ak_str8 ak_str8::Skip(uint64_t Count)
+{
+    Count= AK__Min(Count, Length);
+    uint64_t Remaining = Length-Count;
+    ak_str8 Result = {Str + Count, Remaining};
+    return Result;
+}
+
+ak_str8 ak_str8::Substr(uint64_t First, uint64_t End)
+{
+    End = AK__Min(End, Length);
+    First = AK__Min(First, Length);
+    ak_str8 Result = {Str+First, End-First};
+    return Result;
+}
+
+bool ak_str8::Begins_With(const ak_str8& CompStr)
+{
+    if(Length < CompStr.Length)
+        return false;
+    
+    for(uint64_t Index = 0; Index < CompStr.Length; Index++)
+    {           
+        if(Str[Index] != CompStr.Str[Index])
+        {
+            return false;
+        }
+    }    
+    
+    return true;
+}
+
+bool ak_str8::Ends_With(const ak_str8& CompStr)
+{
+    if(Length < CompStr.Length) return false;
+    
+    const char* StrLast = Str + Length-1;
+    const char* CompStrLast = CompStr.Str + CompStr.Length-1;
+    
+    for(uint64_t Index = 0; Index < CompStr.Length; Index++)
+    {
+        if(*StrLast != *CompStrLast)
+            return false;
+        
+        StrLast--;
+        CompStrLast--;
+    }
+    
+    return true;
+}
+
+ak_str8 ak_str8::Trim_Whitespace()
+{
+    ak_str8 Result = *this;
+    
+    while(AK_Is_Whitespace(*Result.Str) && Result.Length)
+    {
+        Result.Str++;
+        Result.Length--;
+    }
+    
+    while(Result.Length && AK_Is_Whitespace(Result.Str[Result.Length-1]))
+        Result.Length--;
+    
+    return Result;
+}
+
+bool ak_str8::Is_Null_Term()
+{
+    return Str[Length] == 0;
+}
+
+const char* ak_str8::To_CStr(ak_arena* Arena)
+{
+    ak_array<char> Result = Arena->Push_Array<char>(Length+1);
+    if(!Result.Data)
+    {
+        //TODO(JJ): Diagnostic and error logging
+        return NULL;
+    }
+    
+    Result[Length] = 0;
+    AK__Memory_Copy(Result.Data, Str, Length);
+    return Result.Data;
+}
+
+ak_str8 ak_str8::Copy(ak_arena* Arena)
+{
+    ak_str8 Result = AK_Str8(To_CStr(Arena), Length);
+    return Result;
+}
+
+void ak_str8_list::Push_Explicit(const ak_str8& PushedString, ak_str8_node* Node)
+{
+    Node->String = PushedString;
+    AK_SLL_Queue_Push(First, Last, Node);
+    NodeCount++;
+    TotalLength += PushedString.Length;
+}
+
+void ak_str8_list::Push(const ak_str8& PushedString, ak_arena* Arena)
+{
+    ak_str8_node* Node = Arena->Push_Struct<ak_str8_node>();
+    Push_Explicit(PushedString, Node);
+}
+
+ak_str8 ak_str8_list::Join(ak_arena* Arena)
+{
+    ak_array<char> Str = Arena->Push_Array<char>(TotalLength+1);
+    char* At = Str.Data;
+    
+    for(ak_str8_node* Node = First; Node; Node = Node->Next)
+    {
+        AK__Memory_Copy(At, Node->String.Str, Node->String.Length);
+        At += Node->String.Length;
+    }
+    
+    Str[TotalLength] = 0;
+    return AK_Str8(Str.Data, TotalLength);
+}
+
+ak_str8 ak_str8_list::Join_New_Line(ak_arena* Arena)
+{
+    ak_array<char> Str = Arena->Push_Array<char>(TotalLength+NodeCount+1);
+    char* At = Str.Data;
+    
+    for(ak_str8_node* Node = First; Node; Node = Node->Next)
+    {
+        AK__Memory_Copy(At, Node->String.Str, Node->String.Length);
+        At += Node->String.Length;
+        *At++ = '\n';
+    }
+    
+    Str[TotalLength+NodeCount] = 0;
+    return AK_Str8(Str.Data, TotalLength+NodeCount);
+}
+
+void ak_str8_list::FormatV(ak_arena* Arena, const char* Format, va_list Args)
+{
+    ak_str8 Result = AK_Str8_FormatV(Arena, Format, Args);
+    Push(Result, Arena);
+}
+
+void ak_str8_list::Format(ak_arena* Arena, const char* Format, ...)
+{
+    va_list Args;
+    va_start(Args, Format);
+    FormatV(Arena, Format, Args);
+    va_end(Args);
+}
+
+ak_str8 AK_Str8(const char* Str)
+{
+    return AK_Str8(Str, AK_CStr_Length(Str));
+}
+
+ak_str8 AK_Str8(const char* Str, uint64_t StrLength)
+{
+    ak_str8 Result;
+    Result.Str = Str;
+    Result.Length = StrLength;
+    return Result;
+}
+
+ak_str8 AK_Str8(const char* First, const char* Last)
+{
+    return AK_Str8(First, Last-First);
+}
+
+ak_str8_list AK_Str8_Split(const ak_str8& String, ak_arena* Arena, char* SplitChars, uint32_t CharCount)
+{
+    ak_str8_list Result = {};
+    
+    const char* StrAt = String.Str;
+    const char* WordFirst = StrAt;
+    const char* StrEnd = String.Str + String.Length;
+    for(;StrAt < StrEnd; StrAt++)
+    {
+        char Byte = *StrAt;
+        int32_t IsSplit = false;
+        
+        for(uint32_t Index = 0; Index < CharCount; Index++)
+        {
+            if(Byte == SplitChars[Index])
+            {
+                IsSplit = true;
+                break;
+            }
+        }
+        
+        if(IsSplit)
+        {
+            if(WordFirst < StrAt) 
+                Result.Push(AK_Str8(WordFirst, StrAt), Arena);
+            WordFirst = StrAt + 1;
+        }
+    }
+    
+    if(WordFirst < StrAt) 
+        Result.Push(AK_Str8(WordFirst, StrAt), Arena);
+    
+    return Result;
+}
+
+ak_str8 AK_Str8_FormatV(ak_arena* Arena, const char* Format, va_list Args)
+{
+    //NOTE(EVERYONE): Measuring consumes the arguments on some platforms, so it works on a copy
+    va_list SizeArgs;
+    va_copy(SizeArgs, Args);
+    int ActualSize = stbsp_vsnprintf(NULL, 0, Format, SizeArgs);
+    va_end(SizeArgs);
+    
+    ak_array<char> Result = Arena->Push_Array<char>(ActualSize+1);
+    stbsp_vsnprintf(Result.Data, ActualSize+1, Format, Args);
+    
+    return AK_Str8(Result.Data, ActualSize);
+}
+
+ak_str8 AK_Str8_Format(ak_arena* Arena, const char* Format, ...)
+{
+    va_list Args;
+    va_start(Args, Format);
+    ak_str8 Result = AK_Str8_FormatV(Arena, Format, Args);
+    va_end(Args);
+    return Result;
+}
+
+bool operator!=(const ak_str8& A, const ak_str8& B)
+{
+    if(A.Length != B.Length) return true;
+    for(uint64_t Index = 0; Index < A.Length; Index++)
+        if(A[Index] != B[Index]) return true;
+    return false;
+}
+
+bool operator==(const ak_str8& A, const ak_str8& B)
+{
+    if(A.Length != B.Length) return false;
+    for(uint64_t Index = 0; Index < A.Length; Index++)
+        if(A[Index] != B[Index]) return false;
+    return true;
+}
+
+uint32_t AK_Hash_Function(const ak_str8& Str)
+{
+    uint64_t Result = AK_Hash64(Str.Str, Str.Length);
+    return (uint32_t)(Result ^ (Result >> 32));
+}
+
+uint32_t ak_hash_traits<ak_str8>::Hash(const ak_str8& Key)
+{
+    return AK_Hash_Function(Key);
+}
+
+uint32_t ak_hash_traits<ak_str8>::Hash(const char* Key)
+{
+    //NOTE(EVERYONE): Must match AK_Hash_Function(const ak_str8&) so C strings can probe ak_str8 keyed maps
+    return AK_Hash_Function(Key);
+}
+
+uint64_t ak_hash_traits<ak_str8>::Hash64(const ak_str8& Key)
+{
+    return AK_Hash64(Key.Str, Key.Length);
+}
+
+uint64_t ak_hash_traits<ak_str8>::Hash64(const char* Key)
+{
+    return AK_Hash64(Key, AK_CStr_Length(Key));
+}
+
+bool ak_hash_traits<ak_str8>::Equals(const ak_str8& A, const ak_str8& B)
+{
+    return A == B;
+}
+
+bool ak_hash_traits<ak_str8>::Equals(const ak_str8& A, const char* B)
+{
+    uint64_t Index = 0;
+    for(; Index < A.Length; Index++)
+        if(!B[Index] || A[Index] != B[Index]) return false;
+    return B[Index] == 0;
+}
+
+#endif //AK_STD_IMPLEMENTATION
+
+#ifdef AK_STD_TESTS
+
+/*
+   The latest version of this library is available on GitHub;
+   https://github.com/sheredom/utest.h
+*/
+
+/*
+   This is free and unencumbered software released into the public domain.
+
+   Anyone is free to copy, modify, publish, use, compile, sell, or
+   distribute this software, either in source code form or as a compiled
+   binary, for any purpose, commercial or non-commercial, and by any
+   means.
+
+   In jurisdictions that recognize copyright laws, the author or authors
+   of this software dedicate any and all copyright interest in the
+   software to the public domain. We make this dedication for the benefit
+   of the public at large and to the detriment of our heirs and
+   successors. We intend this dedication to be an overt act of
+   relinquishment in perpetuity of all present and future rights to this
+   software under copyright law.
+
+   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+   EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+   MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+   IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+   OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+   ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+   OTHER DEALINGS IN THE SOFTWARE.
+
+   For more information, please refer to <http://unlicense.org/>
+*/
+
+#ifndef SHEREDOM_UTEST_H_INCLUDED
+#define SHEREDOM_UTEST_H_INCLUDED
+
+#ifdef _MSC_VER
+/*
+   Disable warning about not inlining 'inline' functions.
+*/
+#pragma warning(disable : 4710)
+
+/*
+   Disable warning about inlining functions that are not marked 'inline'.
+*/
+#pragma warning(disable : 4711)
+
+#if _MSC_VER > 1900
+/*
+  Disable warning about preprocessor macros not being defined in MSVC headers.
+*/
+#pragma warning(disable : 4668)
+
+/*
+  Disable warning about no function prototype given in MSVC headers.
+*/
+#pragma warning(disable : 4255)
+
+/*
+  Disable warning about pointer or reference to potentially throwing function.
+*/
+#pragma warning(disable : 5039)
+#endif
+
+#pragma warning(push, 1)
+#endif
+
+#if defined(_MSC_VER) && (_MSC_VER < 1920)
+typedef __int64 utest_int64_t;
+typedef unsigned __int64 utest_uint64_t;
+typedef unsigned __int32 utest_uint32_t;
+#else
+#include <stdint.h>
+typedef int64_t utest_int64_t;
+typedef uint64_t utest_uint64_t;
+typedef uint32_t utest_uint32_t;
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#if defined(__cplusplus)
+#define UTEST_C_FUNC extern "C"
+#else
+#define UTEST_C_FUNC
+#endif
+
+#if defined(_MSC_VER) \
+|| defined(__MINGW64__) \
+|| defined(__MINGW32__)
+
+#if defined(__MINGW64__) || defined(__MINGW32__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC diagnostic ignored "-Wunknown-pragmas"
+#endif
+
+// define UTEST_USE_OLD_QPC before #include "utest.h" to use old QueryPerformanceCounter
+#ifndef UTEST_USE_OLD_QPC
+#pragma warning(push, 0)
+#include <Windows.h>
+#pragma warning(pop)
+
+typedef LARGE_INTEGER utest_large_integer;
+#else
+//use old QueryPerformanceCounter definitions (not sure is this needed in some edge cases or not)
+//on Win7 with VS2015 these extern declaration cause "second C linkage of overloaded function not allowed" error
+typedef union {
+    struct {
+        unsigned long LowPart;
+        long HighPart;
+    } DUMMYSTRUCTNAME;
+    struct {
+        unsigned long LowPart;
+        long HighPart;
+    } u;
+    utest_int64_t QuadPart;
+} utest_large_integer;
+
+UTEST_C_FUNC __declspec(dllimport) int __stdcall QueryPerformanceCounter(
+                                                                         utest_large_integer *);
+UTEST_C_FUNC __declspec(dllimport) int __stdcall QueryPerformanceFrequency(
+                                                                           utest_large_integer *);
+
+#if defined(__MINGW64__) || defined(__MINGW32__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+#elif defined(__linux__) \
+|| defined(__FreeBSD__) \
+|| defined(__OpenBSD__) \
+|| defined(__NetBSD__) \
+|| defined(__DragonFly__) \
+|| defined(__sun__) \
+|| defined(__HAIKU__)
+/*
+   slightly obscure include here - we need to include glibc's features.h, but
+   we don't want to just include a header that might not be defined for other
+   c libraries like musl. Instead we include limits.h, which we know on all
+   glibc distributions includes features.h
+*/
+#include <limits.h>
+
+#if defined(__GLIBC__) && defined(__GLIBC_MINOR__)
+#include <time.h>
+
+#if ((2 < __GLIBC__) || ((2 == __GLIBC__) && (17 <= __GLIBC_MINOR__)))
+/* glibc is version 2.17 or above, so we can just use clock_gettime */
+#define UTEST_USE_CLOCKGETTIME
+#else
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#else // Other libc implementations
+#include <time.h>
+#define UTEST_USE_CLOCKGETTIME
+#endif
+
+#elif defined(__APPLE__)
+#include <mach/mach_time.h>
+#endif
+
+#if defined(_MSC_VER) && (_MSC_VER < 1920)
+#define UTEST_PRId64 "I64d"
+#define UTEST_PRIu64 "I64u"
+#else
+#include <inttypes.h>
+
+#define UTEST_PRId64 PRId64
+#define UTEST_PRIu64 PRIu64
+#endif
+
+#if defined(__cplusplus)
+#define UTEST_INLINE inline
+
+#if defined(__clang__)
+#define UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS                               \
+_Pragma("clang diagnostic push")                                             \
+_Pragma("clang diagnostic ignored \"-Wglobal-constructors\"")
+
+#define UTEST_INITIALIZER_END_DISABLE_WARNINGS _Pragma("clang diagnostic pop")
+#else
+#define UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS
+#define UTEST_INITIALIZER_END_DISABLE_WARNINGS
+#endif
+
+#define UTEST_INITIALIZER(f)                                                   \
+struct f##_cpp_struct { f##_cpp_struct(); }; \
+UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS static f##_cpp_struct f##_cpp_global UTEST_INITIALIZER_END_DISABLE_WARNINGS; \
+f##_cpp_struct::f##_cpp_struct()
+#elif defined(_MSC_VER)
+#define UTEST_INLINE __forceinline
+
+#if defined(_WIN64)
+#define UTEST_SYMBOL_PREFIX
+#else
+#define UTEST_SYMBOL_PREFIX "_"
+#endif
+
+#if defined(__clang__)
+#define UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS                               \
+_Pragma("clang diagnostic push")                                             \
+_Pragma("clang diagnostic ignored \"-Wmissing-variable-declarations\"")
+
+#define UTEST_INITIALIZER_END_DISABLE_WARNINGS _Pragma("clang diagnostic pop")
+#else
+#define UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS
+#define UTEST_INITIALIZER_END_DISABLE_WARNINGS
+#endif
+
+#pragma section(".CRT$XCU", read)
+#define UTEST_INITIALIZER(f)                                                   \
+static void __cdecl f(void);                                                 \
+UTEST_INITIALIZER_BEGIN_DISABLE_WARNINGS                                     \
+__pragma(comment(linker, "/include:" UTEST_SYMBOL_PREFIX #f "_"))            \
+UTEST_C_FUNC __declspec(allocate(".CRT$XCU")) void(__cdecl *             \
+f##_)(void) = f;      \
+UTEST_INITIALIZER_END_DISABLE_WARNINGS                                       \
+static void __cdecl f(void)
+#else
+#if defined(__linux__)
+#if defined(__clang__)
+#if __has_warning("-Wreserved-id-macro")
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wreserved-id-macro"
+#endif
+#endif
+
+#define __STDC_FORMAT_MACROS 1
+
+#if defined(__clang__)
+#if __has_warning("-Wreserved-id-macro")
+#pragma clang diagnostic pop
+#endif
+#endif
+#endif
+
+#define UTEST_INLINE inline
+
+#define UTEST_INITIALIZER(f)                                                   \
+static void f(void) __attribute__((constructor));                            \
+static void f(void)
+#endif
+
+#if defined(__cplusplus)
+#define UTEST_CAST(type, x) static_cast<type>(x)
+#define UTEST_PTR_CAST(type, x) reinterpret_cast<type>(x)
+#define UTEST_EXTERN extern "C"
+#define UTEST_NULL NULL
+#else
+#define UTEST_CAST(type, x) ((type)(x))
+#define UTEST_PTR_CAST(type, x) ((type)(x))
+#define UTEST_EXTERN extern
+#define UTEST_NULL 0
+#endif
+
+#ifdef _MSC_VER
+/*
+    io.h contains definitions for some structures with natural padding. This is
+    uninteresting, but for some reason MSVC's behaviour is to warn about
+    including this system header. That *is* interesting
+*/
+#pragma warning(disable : 4820)
+#pragma warning(push, 1)
+#include <io.h>
+#pragma warning(pop)
+#define UTEST_COLOUR_OUTPUT() (_isatty(_fileno(stdout)))
+#else
+#if  defined(__EMSCRIPTEN__)
+#include <emscripten/html5.h>
+#define UTEST_COLOUR_OUTPUT() false
+#else
+#include <unistd.h>
+#define UTEST_COLOUR_OUTPUT() (isatty(STDOUT_FILENO))
+#endif
+#endif
+
+static UTEST_INLINE void *utest_realloc(void *const pointer, size_t new_size) {
+    void *const new_pointer = realloc(pointer, new_size);
+    
+    if (UTEST_NULL == new_pointer) {
+        free(new_pointer);
+    }
+    
+    return new_pointer;
+}
+
+static UTEST_INLINE utest_int64_t utest_ns(void) {
+#if defined(_MSC_VER) || defined(__MINGW64__) || defined(__MINGW32__)
+    utest_large_integer counter;
+    utest_large_integer frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return UTEST_CAST(utest_int64_t,
+                      (counter.QuadPart * 1000000000) / frequency.QuadPart);
+#elif defined(__linux__) && defined(__STRICT_ANSI__)
+    return UTEST_CAST(utest_int64_t, clock()) * 1000000000 / CLOCKS_PER_SEC;
+#elif defined(__linux__) \
+|| defined(__FreeBSD__) \
+|| defined(__OpenBSD__) \
+|| defined(__NetBSD__) \
+|| defined(__DragonFly__) \
+|| defined(__sun__) \
+|| defined(__HAIKU__)
+    struct timespec ts;
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__HAIKU__)
+    timespec_get(&ts, TIME_UTC);
+#else
+    const clockid_t cid = CLOCK_REALTIME;
+#if defined(UTEST_USE_CLOCKGETTIME)
+    clock_gettime(cid, &ts);
+#else
+    syscall(SYS_clock_gettime, cid, &ts);
+#endif
+#endif
+    return UTEST_CAST(utest_int64_t, ts.tv_sec) * 1000 * 1000 * 1000 + ts.tv_nsec;
+#elif __APPLE__
+    return UTEST_CAST(utest_int64_t, mach_absolute_time());
+#elif __EMSCRIPTEN__
+    return emscripten_performance_now() * 1000000.0;
+#else
+#error Unsupported platform!
+#endif
+}
+
+typedef void (*utest_testcase_t)(int *, size_t);
+
+struct utest_test_state_s {
+    utest_testcase_t func;
+    size_t index;
+    char *name;
+};
+
+struct utest_state_s {
+    struct utest_test_state_s *tests;
+    size_t tests_length;
+    FILE *output;
+};
+
+/* extern to the global state utest needs to execute */
+UTEST_EXTERN struct utest_state_s utest_state;
+
+#if defined(_MSC_VER)
+#define UTEST_WEAK __forceinline
+#else
+#define UTEST_WEAK __attribute__((weak))
+#endif
+
+#if defined(_MSC_VER)
+#define UTEST_UNUSED
+#else
+#define UTEST_UNUSED __attribute__((unused))
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wvariadic-macros"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#endif
+#define UTEST_PRINTF(...)                                                      \
+if (utest_state.output) {                                                    \
+fprintf(utest_state.output, __VA_ARGS__);                                  \
+}                                                                            \
+printf(__VA_ARGS__)
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wvariadic-macros"
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#endif
+
+#ifdef _MSC_VER
+#define UTEST_SNPRINTF(BUFFER, N, ...) _snprintf_s(BUFFER, N, N, __VA_ARGS__)
+#else
+#define UTEST_SNPRINTF(...) snprintf(__VA_ARGS__)
+#endif
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+#if defined(__cplusplus)
+/* if we are using c++ we can use overloaded methods (its in the language) */
+#define UTEST_OVERLOADABLE
+#elif defined(__clang__)
+/* otherwise, if we are using clang with c - use the overloadable attribute */
+#define UTEST_OVERLOADABLE __attribute__((overloadable))
+#endif
+
+#if defined(UTEST_OVERLOADABLE)
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(float f);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(float f) {
+    UTEST_PRINTF("%f", UTEST_CAST(double, f));
+}
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(double d);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(double d) {
+    UTEST_PRINTF("%f", d);
+}
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long double d);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long double d) {
+    UTEST_PRINTF("%Lf", d);
+}
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(int i);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(int i) {
+    UTEST_PRINTF("%d", i);
+}
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(unsigned int i);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(unsigned int i) {
+    UTEST_PRINTF("%u", i);
+}
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long int i);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long int i) {
+    UTEST_PRINTF("%ld", i);
+}
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long unsigned int i);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long unsigned int i) {
+    UTEST_PRINTF("%lu", i);
+}
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(const void *p);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(const void *p) {
+    UTEST_PRINTF("%p", p);
+}
+
+/*
+   long long is a c++11 extension
+*/
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L) ||              \
+defined(__cplusplus) && (__cplusplus >= 201103L)
+
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wc++98-compat-pedantic"
+#endif
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long long int i);
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long long int i) {
+    UTEST_PRINTF("%lld", i);
+}
+
+UTEST_WEAK UTEST_OVERLOADABLE void utest_type_printer(long long unsigned int i);
+UTEST_WEAK UTEST_OVERLOADABLE void
+utest_type_printer(long long unsigned int i) {
+    UTEST_PRINTF("%llu", i);
+}
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+
+#endif
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define utest_type_printer(val)                                                \
+UTEST_PRINTF(_Generic((val), signed char                                     \
+: "%d", unsigned char                                  \
+: "%u", short                                          \
+: "%d", unsigned short                                 \
+: "%u", int                                            \
+: "%d", long                                           \
+: "%ld", long long                                     \
+: "%lld", unsigned                                     \
+: "%u", unsigned long                                  \
+: "%lu", unsigned long long                            \
+: "%llu", float                                        \
+: "%f", double                                         \
+: "%f", long double                                    \
+: "%Lf", default                                       \
+: _Generic((val - val), ptrdiff_t                      \
+: "%p", default                             \
+: "undef")),                                \
+(val))
+#else
+/*
+   we don't have the ability to print the values we got, so we create a macro
+   to tell our users we can't do anything fancy
+*/
+#define utest_type_printer(...) UTEST_PRINTF("undef")
+#endif
+
+#ifdef _MSC_VER
+#define UTEST_SURPRESS_WARNING_BEGIN                                           \
+__pragma(warning(push)) __pragma(warning(disable : 4127))
+#define UTEST_SURPRESS_WARNING_END __pragma(warning(pop))
+#else
+#define UTEST_SURPRESS_WARNING_BEGIN
+#define UTEST_SURPRESS_WARNING_END
+#endif
+
+#if defined(__cplusplus) && (__cplusplus >= 201103L)
+#define UTEST_AUTO(x) auto
+#elif !defined(__cplusplus)
+
+#if defined(__clang__)
+/* clang-format off */
+/* had to disable clang-format here because it malforms the pragmas */
+#define UTEST_AUTO(x)                                                          \
+_Pragma("clang diagnostic push")                                             \
+_Pragma("clang diagnostic ignored \"-Wgnu-auto-type\"") __auto_type      \
+_Pragma("clang diagnostic pop")
+/* clang-format on */
+#else
+#define UTEST_AUTO(x) __typeof__(x + 0)
+#endif
+
+#else
+#define UTEST_AUTO(x) typeof(x + 0)
+#endif
+
+#if defined(__clang__)
+#define UTEST_STRNCMP(x, y, size)                                              \
+_Pragma("clang diagnostic push")                                             \
+_Pragma("clang diagnostic ignored \"-Wdisabled-macro-expansion\"")       \
+strncmp(x, y, size) _Pragma("clang diagnostic pop")
+#else
+#define UTEST_STRNCMP(x, y, size) strncmp(x, y, size)
+#endif
+
+#if defined(__clang__)
+#define UTEST_EXPECT(x, y, cond)                                               \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+_Pragma("clang diagnostic push")                                           \
+_Pragma("clang diagnostic ignored \"-Wlanguage-extension-token\"")     \
+_Pragma("clang diagnostic ignored \"-Wc++98-compat-pedantic\"")    \
+_Pragma("clang diagnostic ignored \"-Wfloat-equal\"")          \
+UTEST_AUTO(x) xEval = (x);                                 \
+UTEST_AUTO(y) yEval = (y);                                                 \
+if (!((xEval)cond(yEval))) {                                               \
+_Pragma("clang diagnostic pop")                                          \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                \
+UTEST_PRINTF("  Expected : ");                                           \
+utest_type_printer(xEval);                                               \
+UTEST_PRINTF("\n");                                                      \
+UTEST_PRINTF("    Actual : ");                                           \
+utest_type_printer(yEval);                                               \
+UTEST_PRINTF("\n");                                                      \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+#elif defined(__GNUC__)
+#define UTEST_EXPECT(x, y, cond)                                               \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+UTEST_AUTO(x) xEval = (x);                                                 \
+UTEST_AUTO(y) yEval = (y);                                                 \
+if (!((xEval)cond(yEval))) {                                               \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : ");                                           \
+utest_type_printer(xEval);                                               \
+UTEST_PRINTF("\n");                                                      \
+UTEST_PRINTF("    Actual : ");                                           \
+utest_type_printer(yEval);                                               \
+UTEST_PRINTF("\n");                                                      \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+#else
+#define UTEST_EXPECT(x, y, cond)                                               \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (!((x)cond(y))) {                                                       \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+#endif
+
+#define EXPECT_TRUE(x)                                                         \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (!(x)) {                                                                \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : true\n");                                     \
+UTEST_PRINTF("    Actual : %s\n", (x) ? "true" : "false");               \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define EXPECT_FALSE(x)                                                        \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (x) {                                                                   \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : false\n");                                    \
+UTEST_PRINTF("    Actual : %s\n", (x) ? "true" : "false");               \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define EXPECT_EQ(x, y) UTEST_EXPECT(x, y, ==)
+#define EXPECT_NE(x, y) UTEST_EXPECT(x, y, !=)
+#define EXPECT_LT(x, y) UTEST_EXPECT(x, y, <)
+#define EXPECT_LE(x, y) UTEST_EXPECT(x, y, <=)
+#define EXPECT_GT(x, y) UTEST_EXPECT(x, y, >)
+#define EXPECT_GE(x, y) UTEST_EXPECT(x, y, >=)
+
+#define EXPECT_STREQ(x, y)                                                     \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (0 != strcmp(x, y)) {                                                   \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : \"%s\"\n", x);                                \
+UTEST_PRINTF("    Actual : \"%s\"\n", y);                                \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define EXPECT_STRNE(x, y)                                                     \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (0 == strcmp(x, y)) {                                                   \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : \"%s\"\n", x);                                \
+UTEST_PRINTF("    Actual : \"%s\"\n", y);                                \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define EXPECT_STRNEQ(x, y, n)                                                 \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (0 != UTEST_STRNCMP(x, y, n)) {                                         \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : \"%.*s\"\n", UTEST_CAST(int, n), x);          \
+UTEST_PRINTF("    Actual : \"%.*s\"\n", UTEST_CAST(int, n), y);          \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define EXPECT_STRNNE(x, y, n)                                                 \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (0 == UTEST_STRNCMP(x, y, n)) {                                         \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : \"%.*s\"\n", UTEST_CAST(int, n), x);          \
+UTEST_PRINTF("    Actual : \"%.*s\"\n", UTEST_CAST(int, n), y);          \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define EXPECT_NEAR(x, y, epsilon)                                             \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (utest_fabs(UTEST_CAST(double, x) - UTEST_CAST(double, y)) >            \
+UTEST_CAST(double, epsilon)) {                                         \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : %f\n", UTEST_CAST(double, x));                \
+UTEST_PRINTF("    Actual : %f\n", UTEST_CAST(double, y));                \
+*utest_result = 1;                                                       \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#if defined(__clang__)
+#define UTEST_ASSERT(x, y, cond)                                               \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+_Pragma("clang diagnostic push")                                           \
+_Pragma("clang diagnostic ignored \"-Wlanguage-extension-token\"")     \
+_Pragma("clang diagnostic ignored \"-Wc++98-compat-pedantic\"")    \
+_Pragma("clang diagnostic ignored \"-Wfloat-equal\"")          \
+UTEST_AUTO(x) xEval = (x);                                 \
+UTEST_AUTO(y) yEval = (y);                                                 \
+if (!((xEval)cond(yEval))) {                                               \
+_Pragma("clang diagnostic pop")                                          \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                \
+UTEST_PRINTF("  Expected : ");                                           \
+utest_type_printer(xEval);                                               \
+UTEST_PRINTF("\n");                                                      \
+UTEST_PRINTF("    Actual : ");                                           \
+utest_type_printer(yEval);                                               \
+UTEST_PRINTF("\n");                                                      \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+#elif defined(__GNUC__)
+#define UTEST_ASSERT(x, y, cond)                                               \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+UTEST_AUTO(x) xEval = (x);                                                 \
+UTEST_AUTO(y) yEval = (y);                                                 \
+if (!((xEval)cond(yEval))) {                                               \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : ");                                           \
+utest_type_printer(xEval);                                               \
+UTEST_PRINTF("\n");                                                      \
+UTEST_PRINTF("    Actual : ");                                           \
+utest_type_printer(yEval);                                               \
+UTEST_PRINTF("\n");                                                      \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+#else
+#define UTEST_ASSERT(x, y, cond)                                               \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (!((x)cond(y))) {                                                       \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+#endif
+
+#define ASSERT_TRUE(x)                                                         \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (!(x)) {                                                                \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : true\n");                                     \
+UTEST_PRINTF("    Actual : %s\n", (x) ? "true" : "false");               \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
 UTEST_SURPRESS_WARNING_END
+
+#define ASSERT_FALSE(x)                                                        \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (x) {                                                                   \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : false\n");                                    \
+UTEST_PRINTF("    Actual : %s\n", (x) ? "true" : "false");               \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define ASSERT_EQ(x, y) UTEST_ASSERT(x, y, ==)
+#define ASSERT_NE(x, y) UTEST_ASSERT(x, y, !=)
+#define ASSERT_LT(x, y) UTEST_ASSERT(x, y, <)
+#define ASSERT_LE(x, y) UTEST_ASSERT(x, y, <=)
+#define ASSERT_GT(x, y) UTEST_ASSERT(x, y, >)
+#define ASSERT_GE(x, y) UTEST_ASSERT(x, y, >=)
+
+#define ASSERT_STREQ(x, y)                                                     \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (0 != strcmp(x, y)) {                                                   \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : \"%s\"\n", x);                                \
+UTEST_PRINTF("    Actual : \"%s\"\n", y);                                \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define ASSERT_STRNE(x, y)                                                     \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (0 == strcmp(x, y)) {                                                   \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : \"%s\"\n", x);                                \
+UTEST_PRINTF("    Actual : \"%s\"\n", y);                                \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define ASSERT_STRNEQ(x, y, n)                                                 \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (0 != UTEST_STRNCMP(x, y, n)) {                                         \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : \"%.*s\"\n", UTEST_CAST(int, n), x);          \
+UTEST_PRINTF("    Actual : \"%.*s\"\n", UTEST_CAST(int, n), y);          \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define ASSERT_STRNNE(x, y, n)                                                 \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (0 == UTEST_STRNCMP(x, y, n)) {                                         \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : \"%.*s\"\n", UTEST_CAST(int, n), x);          \
+UTEST_PRINTF("    Actual : \"%.*s\"\n", UTEST_CAST(int, n), y);          \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define ASSERT_NEAR(x, y, epsilon)                                             \
+UTEST_SURPRESS_WARNING_BEGIN do {                                            \
+if (utest_fabs(UTEST_CAST(double, x) - UTEST_CAST(double, y)) >            \
+UTEST_CAST(double, epsilon)) {                                         \
+UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
+UTEST_PRINTF("  Expected : %f\n", UTEST_CAST(double, x));                \
+UTEST_PRINTF("    Actual : %f\n", UTEST_CAST(double, y));                \
+*utest_result = 1;                                                       \
+return;                                                                  \
+}                                                                          \
+}                                                                            \
+while (0)                                                                    \
+UTEST_SURPRESS_WARNING_END
+
+#define UTEST(SET, NAME)                                                       \
+UTEST_EXTERN struct utest_state_s utest_state;                               \
+static void utest_run_##SET##_##NAME(int *utest_result);                     \
+static void utest_##SET##_##NAME(int *utest_result, size_t utest_index) {    \
+(void)utest_index;                                                         \
+utest_run_##SET##_##NAME(utest_result);                                    \
+}                                                                            \
+UTEST_INITIALIZER(utest_register_##SET##_##NAME) {                           \
+const size_t index = utest_state.tests_length++;                           \
+const char *name_part = #SET "." #NAME;                                    \
+const size_t name_size = strlen(name_part) + 1;                            \
+char *name = UTEST_PTR_CAST(char *, malloc(name_size));                    \
+utest_state.tests = UTEST_PTR_CAST(                                        \
+struct utest_test_state_s *,                                           \
+utest_realloc(UTEST_PTR_CAST(void *, utest_state.tests),               \
+sizeof(struct utest_test_state_s) *                      \
+utest_state.tests_length));                          \
+if (utest_state.tests) {                                                   \
+utest_state.tests[index].func = &utest_##SET##_##NAME;                   \
+utest_state.tests[index].name = name;                                    \
+utest_state.tests[index].index = 0;                                      \
+}                                                                          \
+UTEST_SNPRINTF(name, name_size, "%s", name_part);                          \
+}                                                                            \
+void utest_run_##SET##_##NAME(int *utest_result)
+
+#define UTEST_F_SETUP(FIXTURE)                                                 \
+static void utest_f_setup_##FIXTURE(int *utest_result,                       \
+struct FIXTURE *utest_fixture)
+
+#define UTEST_F_TEARDOWN(FIXTURE)                                              \
+static void utest_f_teardown_##FIXTURE(int *utest_result,                    \
+struct FIXTURE *utest_fixture)
+
+#define UTEST_F(FIXTURE, NAME)                                                 \
+UTEST_EXTERN struct utest_state_s utest_state;                               \
+static void utest_f_setup_##FIXTURE(int *, struct FIXTURE *);                \
+static void utest_f_teardown_##FIXTURE(int *, struct FIXTURE *);             \
+static void utest_run_##FIXTURE##_##NAME(int *, struct FIXTURE *);           \
+static void utest_f_##FIXTURE##_##NAME(int *utest_result,                    \
+size_t utest_index) {                 \
+struct FIXTURE fixture;                                                    \
+(void)utest_index;                                                         \
+memset(&fixture, 0, sizeof(fixture));                                      \
+utest_f_setup_##FIXTURE(utest_result, &fixture);                           \
+if (0 != *utest_result) {                                                  \
+return;                                                                  \
+}                                                                          \
+utest_run_##FIXTURE##_##NAME(utest_result, &fixture);                      \
+utest_f_teardown_##FIXTURE(utest_result, &fixture);                        \
+}                                                                            \
+UTEST_INITIALIZER(utest_register_##FIXTURE##_##NAME) {                       \
+const size_t index = utest_state.tests_length++;                           \
+const char *name_part = #FIXTURE "." #NAME;                                \
+const size_t name_size = strlen(name_part) + 1;                            \
+char *name = UTEST_PTR_CAST(char *, malloc(name_size));                    \
+utest_state.tests = UTEST_PTR_CAST(                                        \
+struct utest_test_state_s *,                                           \
+utest_realloc(UTEST_PTR_CAST(void *, utest_state.tests),               \
+sizeof(struct utest_test_state_s) *                      \
+utest_state.tests_length));                          \
+utest_state.tests[index].func = &utest_f_##FIXTURE##_##NAME;               \
+utest_state.tests[index].name = name;                                      \
+UTEST_SNPRINTF(name, name_size, "%s", name_part);                          \
+}                                                                            \
+void utest_run_##FIXTURE##_##NAME(int *utest_result,                         \
+struct FIXTURE *utest_fixture)
+
+#define UTEST_I_SETUP(FIXTURE)                                                 \
+static void utest_i_setup_##FIXTURE(                                         \
+int *utest_result, struct FIXTURE *utest_fixture, size_t utest_index)
+
+#define UTEST_I_TEARDOWN(FIXTURE)                                              \
+static void utest_i_teardown_##FIXTURE(                                      \
+int *utest_result, struct FIXTURE *utest_fixture, size_t utest_index)
+
+#define UTEST_I(FIXTURE, NAME, INDEX)                                          \
+UTEST_EXTERN struct utest_state_s utest_state;                               \
+static void utest_run_##FIXTURE##_##NAME##_##INDEX(int *, struct FIXTURE *); \
+static void utest_i_##FIXTURE##_##NAME##_##INDEX(int *utest_result,          \
+size_t index) {             \
+struct FIXTURE fixture;                                                    \
+memset(&fixture, 0, sizeof(fixture));                                      \
+utest_i_setup_##FIXTURE(utest_result, &fixture, index);                    \
+if (0 != *utest_result) {                                                  \
+return;                                                                  \
+}                                                                          \
+utest_run_##FIXTURE##_##NAME##_##INDEX(utest_result, &fixture);            \
+utest_i_teardown_##FIXTURE(utest_result, &fixture, index);                 \
+}                                                                            \
+UTEST_INITIALIZER(utest_register_##FIXTURE##_##NAME##_##INDEX) {             \
+size_t i;                                                                  \
+utest_uint64_t iUp;                                                        \
+for (i = 0; i < (INDEX); i++) {                                            \
+const size_t index = utest_state.tests_length++;                         \
+const char *name_part = #FIXTURE "." #NAME;                              \
+const size_t name_size = strlen(name_part) + 32;                         \
+char *name = UTEST_PTR_CAST(char *, malloc(name_size));                  \
+utest_state.tests = UTEST_PTR_CAST(                                      \
+struct utest_test_state_s *,                                         \
+utest_realloc(UTEST_PTR_CAST(void *, utest_state.tests),             \
+sizeof(struct utest_test_state_s) *                    \
+utest_state.tests_length));                        \
+utest_state.tests[index].func = &utest_i_##FIXTURE##_##NAME##_##INDEX;   \
+utest_state.tests[index].index = i;                                      \
+utest_state.tests[index].name = name;                                    \
+iUp = UTEST_CAST(utest_uint64_t, i);                                     \
+UTEST_SNPRINTF(name, name_size, "%s/%" UTEST_PRIu64, name_part, iUp);    \
+}                                                                          \
+}                                                                            \
+void utest_run_##FIXTURE##_##NAME##_##INDEX(int *utest_result,               \
+struct FIXTURE *utest_fixture)
+
+UTEST_WEAK
+double utest_fabs(double d);
+UTEST_WEAK
+double utest_fabs(double d) {
+    union {
+        double d;
+        utest_uint64_t u;
+    } both;
+    both.d = d;
+    both.u &= 0x7fffffffffffffffu;
+    return both.d;
+}
+
+UTEST_WEAK
+int utest_should_filter_test(const char *filter, const char *testcase);
+UTEST_WEAK int utest_should_filter_test(const char *filter,
+                                        const char *testcase) {
+    if (filter) {
+        const char *filter_cur = filter;
+        const char *testcase_cur = testcase;
+        const char *filter_wildcard = UTEST_NULL;
+        
+        while (('\0' != *filter_cur) && ('\0' != *testcase_cur)) {
+            if ('*' == *filter_cur) {
+                /* store the position of the wildcard */
+                filter_wildcard = filter_cur;
+                
+                /* skip the wildcard character */
+                filter_cur++;
+                
+                while (('\0' != *filter_cur) && ('\0' != *testcase_cur)) {
+                    if ('*' == *filter_cur) {
+                        /*
+                           we found another wildcard (filter is something like *foo*) so we
+                           exit the current loop, and return to the parent loop to handle
+                           the wildcard case
+                        */
+                        break;
+                    } else if (*filter_cur != *testcase_cur) {
+                        /* otherwise our filter didn't match, so reset it */
+                        filter_cur = filter_wildcard;
+                    }
+                    
+                    /* move testcase along */
+                    testcase_cur++;
+                    
+                    /* move filter along */
+                    filter_cur++;
+                }
+                
+                if (('\0' == *filter_cur) && ('\0' == *testcase_cur)) {
+                    return 0;
+                }
+                
+                /* if the testcase has been exhausted, we don't have a match! */
+                if ('\0' == *testcase_cur) {
+                    return 1;
+                }
+            } else {
+                if (*testcase_cur != *filter_cur) {
+                    /* test case doesn't match filter */
+                    return 1;
+                } else {
+                    /* move our filter and testcase forward */
+                    testcase_cur++;
+                    filter_cur++;
+                }
+            }
+        }
+        
+        if (('\0' != *filter_cur) ||
+            (('\0' != *testcase_cur) &&
+             ((filter == filter_cur) || ('*' != filter_cur[-1])))) {
+            /* we have a mismatch! */
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+static UTEST_INLINE FILE *utest_fopen(const char *filename, const char *mode) {
+#ifdef _MSC_VER
+    FILE *file;
+    if (0 == fopen_s(&file, filename, mode)) {
+        return file;
+    } else {
+        return UTEST_NULL;
+    }
+#else
+    return fopen(filename, mode);
+#endif
+}
+
+static UTEST_INLINE int utest_main(int argc, const char *const argv[]);
+int utest_main(int argc, const char *const argv[]) {
+    utest_uint64_t failed = 0;
+    size_t index = 0;
+    size_t *failed_testcases = UTEST_NULL;
+    size_t failed_testcases_length = 0;
+    const char *filter = UTEST_NULL;
+    utest_uint64_t ran_tests = 0;
+    int enable_mixed_units = 0;
+    int random_order = 0;
+    utest_uint32_t seed = 0;
+    
+    enum colours { RESET, GREEN, RED };
+    
+    const int use_colours = UTEST_COLOUR_OUTPUT();
+    const char *colours[] = {"\033[0m", "\033[32m", "\033[31m"};
+    
+    if (!use_colours) {
+        for (index = 0; index < sizeof colours / sizeof colours[0]; index++) {
+            colours[index] = "";
+        }
+    }
+    /* loop through all arguments looking for our options */
+    for (index = 1; index < UTEST_CAST(size_t, argc); index++) {
+        /* Informational switches */
+        const char help_str[] = "--help";
+        const char list_str[] = "--list-tests";
+        /* Test config switches */
+        const char filter_str[] = "--filter=";
+        const char output_str[] = "--output=";
+        const char enable_mixed_units_str[] = "--enable-mixed-units";
+        const char random_order_str[] = "--random-order";
+        const char random_order_with_seed_str[] = "--random-order=";
+        
+        if (0 == UTEST_STRNCMP(argv[index], help_str, strlen(help_str))) {
+            printf("utest.h - the single file unit testing solution for C/C++!\n"
+                   "Command line Options:\n"
+                   "  --help                  Show this message and exit.\n"
+                   "  --filter=<filter>       Filter the test cases to run (EG. "
+                   "MyTest*.a would run MyTestCase.a but not MyTestCase.b).\n"
+                   "  --list-tests            List testnames, one per line. Output "
+                   "names can be passed to --filter.\n");
+            printf("  --output=<output>       Output an xunit XML file to the file "
+                   "specified in <output>.\n"
+                   "  --enable-mixed-units    Enable the per-test output to contain "
+                   "mixed units (s/ms/us/ns).\n"
+                   "  --random-order[=<seed>] Randomize the order that the tests are "
+                   "ran in. If the optional <seed> argument is not provided, then a "
+                   "random starting seed is used.\n");
+            goto cleanup;
+        } else if (0 ==
+                   UTEST_STRNCMP(argv[index], filter_str, strlen(filter_str))) {
+            /* user wants to filter what test cases run! */
+            filter = argv[index] + strlen(filter_str);
+        } else if (0 ==
+                   UTEST_STRNCMP(argv[index], output_str, strlen(output_str))) {
+            utest_state.output = utest_fopen(argv[index] + strlen(output_str), "w+");
+        } else if (0 == UTEST_STRNCMP(argv[index], list_str, strlen(list_str))) {
+            for (index = 0; index < utest_state.tests_length; index++) {
+                UTEST_PRINTF("%s\n", utest_state.tests[index].name);
+            }
+            /* when printing the test list, don't actually run the tests */
+            return 0;
+        } else if (0 == UTEST_STRNCMP(argv[index], enable_mixed_units_str,
+                                      strlen(enable_mixed_units_str))) {
+            enable_mixed_units = 1;
+        } else if (0 == UTEST_STRNCMP(argv[index], random_order_with_seed_str,
+                                      strlen(random_order_with_seed_str))) {
+            seed =
+                UTEST_CAST(utest_uint32_t,
+                           strtoul(argv[index] + strlen(random_order_with_seed_str),
+                                   UTEST_NULL, 10));
+            random_order = 1;
+        } else if (0 == UTEST_STRNCMP(argv[index], random_order_str,
+                                      strlen(random_order_str))) {
+            const utest_int64_t ns = utest_ns();
+            
+            // Some really poor pseudo-random using the current time. I do this
+            // because I really want to avoid using C's rand() because that'd mean our
+            // random would be affected by any srand() usage by the user (which I
+            // don't want).
+            seed = UTEST_CAST(utest_uint32_t, ns >> 32) * 31 +
+                UTEST_CAST(utest_uint32_t, ns & 0xffffffff);
+            random_order = 1;
+        }
+    }
+    
+    if (random_order) {
+        // Use Fisher-Yates with the Durstenfield's version to randomly re-order the
+        // tests.
+        for (index = utest_state.tests_length; index > 1; index--) {
+            // For the random order we'll use PCG.
+            const utest_uint32_t state = seed;
+            const utest_uint32_t word =
+            ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+            const utest_uint32_t next = ((word >> 22u) ^ word) % index;
+            
+            // Swap the randomly chosen element into the last location.
+            const struct utest_test_state_s copy = utest_state.tests[index - 1];
+            utest_state.tests[index - 1] = utest_state.tests[next];
+            utest_state.tests[next] = copy;
+            
+            // Move the seed onwards.
+            seed = seed * 747796405u + 2891336453u;
+        }
+    }
+    
+    for (index = 0; index < utest_state.tests_length; index++) {
+        if (utest_should_filter_test(filter, utest_state.tests[index].name)) {
+            continue;
+        }
+        
+        ran_tests++;
+    }
+    
+    printf("%s[==========]%s Running %" UTEST_PRIu64 " test cases.\n",
+           colours[GREEN], colours[RESET], UTEST_CAST(utest_uint64_t, ran_tests));
+    
+    if (utest_state.output) {
+        fprintf(utest_state.output, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+        fprintf(utest_state.output,
+                "<testsuites tests=\"%" UTEST_PRIu64 "\" name=\"All\">\n",
+                UTEST_CAST(utest_uint64_t, ran_tests));
+        fprintf(utest_state.output,
+                "<testsuite name=\"Tests\" tests=\"%" UTEST_PRIu64 "\">\n",
+                UTEST_CAST(utest_uint64_t, ran_tests));
+    }
+    
+    for (index = 0; index < utest_state.tests_length; index++) {
+        int result = 0;
+        utest_int64_t ns = 0;
+        
+        if (utest_should_filter_test(filter, utest_state.tests[index].name)) {
+            continue;
+        }
+        
+        printf("%s[ RUN      ]%s %s\n", colours[GREEN], colours[RESET],
+               utest_state.tests[index].name);
+        
+        if (utest_state.output) {
+            fprintf(utest_state.output, "<testcase name=\"%s\">",
+                    utest_state.tests[index].name);
+        }
+        
+        ns = utest_ns();
+        errno = 0;
+        utest_state.tests[index].func(&result, utest_state.tests[index].index);
+        ns = utest_ns() - ns;
+        
+        if (utest_state.output) {
+            fprintf(utest_state.output, "</testcase>\n");
+        }
+        
+        // Record the failing test.
+        if (0 != result) {
+            const size_t failed_testcase_index = failed_testcases_length++;
+            failed_testcases = UTEST_PTR_CAST(
+                                              size_t *, utest_realloc(UTEST_PTR_CAST(void *, failed_testcases),
+                                                                      sizeof(size_t) * failed_testcases_length));
+            if (UTEST_NULL != failed_testcases) {
+                failed_testcases[failed_testcase_index] = index;
+            }
+            failed++;
+        }
+        
+        {
+            const char *const units[] = {"ns", "us", "ms", "s", UTEST_NULL};
+            unsigned int unit_index = 0;
+            utest_int64_t time = ns;
+            
+            if (enable_mixed_units) {
+                for (unit_index = 0; UTEST_NULL != units[unit_index]; unit_index++) {
+                    if (10000 > time) {
+                        break;
+                    }
+                    
+                    time /= 1000;
+                }
+            }
+            
+            if (0 != result) {
+                printf("%s[  FAILED  ]%s %s (%" UTEST_PRId64 "%s)\n", colours[RED],
+                       colours[RESET], utest_state.tests[index].name, time,
+                       units[unit_index]);
+            } else {
+                printf("%s[       OK ]%s %s (%" UTEST_PRId64 "%s)\n", colours[GREEN],
+                       colours[RESET], utest_state.tests[index].name, time,
+                       units[unit_index]);
+            }
+        }
+    }
+    
+    printf("%s[==========]%s %" UTEST_PRIu64 " test cases ran.\n", colours[GREEN],
+           colours[RESET], ran_tests);
+    printf("%s[  PASSED  ]%s %" UTEST_PRIu64 " tests.\n", colours[GREEN],
+           colours[RESET], ran_tests - failed);
+    
+    if (0 != failed) {
+        printf("%s[  FAILED  ]%s %" UTEST_PRIu64 " tests, listed below:\n",
+               colours[RED], colours[RESET], failed);
+        for (index = 0; index < failed_testcases_length; index++) {
+            printf("%s[  FAILED  ]%s %s\n", colours[RED], colours[RESET],
+                   utest_state.tests[failed_testcases[index]].name);
+        }
+    }
+    
+    if (utest_state.output) {
+        fprintf(utest_state.output, "</testsuite>\n</testsuites>\n");
+    }
+    
+    cleanup:
+    for (index = 0; index < utest_state.tests_length; index++) {
+        free(UTEST_PTR_CAST(void *, utest_state.tests[index].name));
+    }
+    
+    free(UTEST_PTR_CAST(void *, failed_testcases));
+    free(UTEST_PTR_CAST(void *, utest_state.tests));
+    
+    if (utest_state.output) {
+        fclose(utest_state.output);
+    }
+    
+    return UTEST_CAST(int, failed);
+}
+
+/*
+   we need, in exactly one source file, define the global struct that will hold
+   the data we need to run utest. This macro allows the user to declare the
+   data without having to use the UTEST_MAIN macro, thus allowing them to write
+   their own main() function.
+*/
+#define UTEST_STATE() struct utest_state_s utest_state = {0, 0, 0}
+
+/*
+   define a main() function to call into utest.h and start executing tests! A
+   user can optionally not use this macro, and instead define their own main()
+   function and manually call utest_main. The user must, in exactly one source
+   file, use the UTEST_STATE macro to declare a global struct variable that
+   utest requires.
+*/
+#define UTEST_MAIN()                                                           \
+UTEST_STATE();                                                               \
+int main(int argc, const char *const argv[]) {                               \
+return utest_main(argc, argv);                                             \
+}
+
+#endif /* SHEREDOM_UTEST_H_INCLUDED */
+
+#if 1
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+//NOTE(EVERYONE): Runs Proc on ThreadCount threads at once and waits for all of them to finish
+#define AK__TEST_MAX_THREAD_COUNT 8
+typedef void ak__test_thread_proc(void* UserData, uint32_t ThreadIndex);
+
+struct ak__test_thread
+{
+    ak__test_thread_proc* Proc;
+    void*                 UserData;
+    uint32_t              ThreadIndex;
+};
+
+#ifdef _WIN32
+static DWORD WINAPI AK__Test_Thread_Entry(LPVOID Parameter)
 #else
-#define UTEST_ASSERT(x, y, cond)                                               \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (!((x)cond(y))) {                                                       \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+static void* AK__Test_Thread_Entry(void* Parameter)
 #endif
+{
+    ak__test_thread* Thread = (ak__test_thread*)Parameter;
+    Thread->Proc(Thread->UserData, Thread->ThreadIndex);
+    return 0;
+}
 
-#define ASSERT_TRUE(x)                                                         \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (!(x)) {                                                                \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : true\n");                                     \
-UTEST_PRINTF("    Actual : %s\n", (x) ? "true" : "false");               \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+static void AK__Test_Run_Threads(uint32_t ThreadCount, ak__test_thread_proc* Proc, void* UserData)
+{
+    AK_STD_ASSERT(ThreadCount <= AK__TEST_MAX_THREAD_COUNT, "Too many test threads");
+    
+    ak__test_thread Threads[AK__TEST_MAX_THREAD_COUNT];
+    for(uint32_t ThreadIndex = 0; ThreadIndex < ThreadCount; ThreadIndex++)
+        Threads[ThreadIndex] = {Proc, UserData, ThreadIndex};
 
-#define ASSERT_FALSE(x)                                                        \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (x) {                                                                   \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : false\n");                                    \
-UTEST_PRINTF("    Actual : %s\n", (x) ? "true" : "false");               \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+#ifdef _WIN32
+    HANDLE Handles[AK__TEST_MAX_THREAD_COUNT];
+    for(uint32_t ThreadIndex = 0; ThreadIndex < ThreadCount; ThreadIndex++)
+        Handles[ThreadIndex] = CreateThread(NULL, 0, AK__Test_Thread_Entry, Threads + ThreadIndex, 0, NULL);
+    WaitForMultipleObjects(ThreadCount, Handles, TRUE, INFINITE);
+    for(uint32_t ThreadIndex = 0; ThreadIndex < ThreadCount; ThreadIndex++)
+        CloseHandle(Handles[ThreadIndex]);
+#else
+    pthread_t Handles[AK__TEST_MAX_THREAD_COUNT];
+    for(uint32_t ThreadIndex = 0; ThreadIndex < ThreadCount; ThreadIndex++)
+        pthread_create(Handles + ThreadIndex, NULL, AK__Test_Thread_Entry, Threads + ThreadIndex);
+    for(uint32_t ThreadIndex = 0; ThreadIndex < ThreadCount; ThreadIndex++)
+        pthread_join(Handles[ThreadIndex], NULL);
+#endif
+}
 
-#define ASSERT_EQ(x, y) UTEST_ASSERT(x, y, ==)
-#define ASSERT_NE(x, y) UTEST_ASSERT(x, y, !=)
-#define ASSERT_LT(x, y) UTEST_ASSERT(x, y, <)
-#define ASSERT_LE(x, y) UTEST_ASSERT(x, y, <=)
-#define ASSERT_GT(x, y) UTEST_ASSERT(x, y, >)
-#define ASSERT_GE(x, y) UTEST_ASSERT(x, y, >=)
+UTEST(ak_bucket_array, Tests)
+{
+    ak_bucket_array<int32_t, 3> Array;
+    
+    Array.Add(5);
+    
+    int32_t T = *Array.Pop();
+    
+    ASSERT_EQ(Array.CurrentBucketIndex, 0);
+    ASSERT_EQ(Array.Length, 0);
+    ASSERT_EQ(Array.Buckets[0]->Length, 0);
+    ASSERT_EQ(T, 5);
+    
+    Array.Add(6);
+    Array.Add(12);
+    
+    ASSERT_EQ(Array.Length, 2);
+    ASSERT_EQ(Array.Buckets.Length, 1);
+    ASSERT_EQ(Array[1], 12);
+    
+    Array.Add(4);
+    Array.Add(5);
+    ASSERT_EQ(Array.CurrentBucketIndex, 1);
+    ASSERT_EQ(Array.Buckets[1]->Length, 1);
+    
+    T = *Array.Pop();
+    ASSERT_EQ(Array.CurrentBucketIndex, 0);
+    ASSERT_EQ(Array.Buckets[0]->Length, 3);
+    ASSERT_EQ(T, 5);
+    
+    Array.Add(5);
+    
+    int32_t Temp[5] = {1, 2, 3, 4, 5};
+    Array.Add_Range(Temp, 5);
+    
+    ASSERT_EQ(Array.CurrentBucketIndex, 2);
+    ASSERT_EQ(Array.Buckets[2]->Length, 3);
+    
+    ASSERT_EQ(Array.Length, 9);
+    ASSERT_EQ(Array[7], 4);
+    
+    
+    ak_bucket_array<int32_t, 3> Array2 = Array.Copy();
+    ASSERT_EQ(Array.Length, Array2.Length);
+    ASSERT_EQ(Array.CurrentBucketIndex, Array2.CurrentBucketIndex);
+    ASSERT_EQ(Array.Buckets.Length, Array2.Buckets.Length);
+    
+    for(uint64_t Index = 0; Index < Array.Length; Index++)
+    {
+        ASSERT_EQ(Array[Index], Array2[Index]);
+    }
+    
+    uint32_t Length = 0;
+    for(int32_t x : Array)
+    {
+        Length++;
+    }
+    ASSERT_EQ(Length, Array.Length);
+    
+    for(uint64_t BucketIndex = 0; BucketIndex < Array.Buckets.Length; BucketIndex++)
+    {
+        ASSERT_EQ(Array.Buckets[BucketIndex]->Length, Array2.Buckets[BucketIndex]->Length);
+    }
+    
+    ak_bucket_array<int32_t, 3> Array3 = Array.Copy();
+    
+    Array.Resize(7);
+    Array2.Resize(17);
+    Array3.Resize(2);
+    
+    ASSERT_EQ(Array.CurrentBucketIndex, 2);
+    ASSERT_EQ(Array2.Buckets.Length, 6);
+    ASSERT_EQ(Array2.CurrentBucketIndex, 5);
+    ASSERT_EQ(Array3.CurrentBucketIndex, 0);
+}
 
-#define ASSERT_STREQ(x, y)                                                     \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (0 != strcmp(x, y)) {                                                   \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : \"%s\"\n", x);                                \
-UTEST_PRINTF("    Actual : \"%s\"\n", y);                                \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+UTEST(ak_bucket_array, Add_Range)
+{
+    ak_bucket_array<int32_t, 4> Array;
+    
+    int32_t Temp[11];
+    for(int32_t Index = 0; Index < 11; Index++) Temp[Index] = Index;
+    
+    Array.Add(-1);
+    Array.Add_Range(Temp, 11);
+    
+    ASSERT_EQ(Array.Length, 12);
+    ASSERT_EQ(Array.Buckets.Length, 3);
+    ASSERT_EQ(Array.CurrentBucketIndex, 2);
+    ASSERT_EQ(Array.Buckets[2]->Length, 4);
+    
+    for(uint64_t Index = 1; Index < Array.Length; Index++)
+        ASSERT_EQ(Array[Index], (int32_t)Index-1);
+    
+    ak_arena* Arena = AK_Create_Arena();
+    ak_array<ak_array<int32_t>> Spans = Array.Push_Uninitialized(6, Arena);
+    
+    ASSERT_EQ(Spans.Length, 2);
+    ASSERT_EQ(Spans[0].Length, 4);
+    ASSERT_EQ(Spans[1].Length, 2);
+    ASSERT_EQ(Array.Length, 18);
+    ASSERT_EQ(Array.CurrentBucketIndex, 4);
+    
+    int32_t Value = 100;
+    for(ak_array<int32_t>& Span : Spans)
+        for(int32_t& Entry : Span) Entry = Value++;
+    
+    ASSERT_EQ(Array[12], 100);
+    ASSERT_EQ(Array[17], 105);
+    
+    AK_Delete(Arena);
+    AK_Delete(&Array);
+}
 
-#define ASSERT_STRNE(x, y)                                                     \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (0 == strcmp(x, y)) {                                                   \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : \"%s\"\n", x);                                \
-UTEST_PRINTF("    Actual : \"%s\"\n", y);                                \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+UTEST(ak_bucket_array, Indexing)
+{
+    uint64_t Indices[] = {0, 1, 5, 6, 7, 63, 64, 1000, 0xFFFFFFFE, 0xFFFFFFFF, 0x100000000, 0xFFFFFFFFFFFFFFFF};
+    for(uint64_t Index : Indices)
+    {
+        uint64_t BucketIndex = ak__bucket_indexer<6>::Get_Bucket_Index(Index);
+        ASSERT_EQ(BucketIndex, Index / 6);
+        ASSERT_EQ(ak__bucket_indexer<6>::Get_Entry_Index(Index, BucketIndex), Index % 6);
+        
+        BucketIndex = ak__bucket_indexer<1000>::Get_Bucket_Index(Index);
+        ASSERT_EQ(BucketIndex, Index / 1000);
+        ASSERT_EQ(ak__bucket_indexer<1000>::Get_Entry_Index(Index, BucketIndex), Index % 1000);
+        
+        BucketIndex = ak__bucket_indexer<64>::Get_Bucket_Index(Index);
+        ASSERT_EQ(BucketIndex, Index / 64);
+        ASSERT_EQ(ak__bucket_indexer<64>::Get_Entry_Index(Index, BucketIndex), Index % 64);
+        ASSERT_EQ(ak__bucket_indexer<64>::Get_Base_Index(BucketIndex), Index - (Index % 64));
+    }
+}
 
-#define ASSERT_STRNEQ(x, y, n)                                                 \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (0 != UTEST_STRNCMP(x, y, n)) {                                         \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : \"%.*s\"\n", UTEST_CAST(int, n), x);          \
-UTEST_PRINTF("    Actual : \"%.*s\"\n", UTEST_CAST(int, n), y);          \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+UTEST(ak_bucket_array, Spans)
+{
+    ak_bucket_array<uint32_t, 8> Array;
+    
+    uint32_t Count = 0;
+    for(uint32_t Entry : Array) Count++;
+    for(ak_array<uint32_t> Span : Array.Spans()) Count += (uint32_t)Span.Length;
+    ASSERT_EQ(Count, 0);
+    
+    for(uint32_t Index = 0; Index < 21; Index++) Array.Add(Index);
+    
+    uint32_t Sum = 0;
+    uint32_t SpanCount = 0;
+    for(ak_array<uint32_t> Span : Array.Spans())
+    {
+        for(uint32_t Entry : Span) Sum += Entry;
+        SpanCount++;
+    }
+    ASSERT_EQ(SpanCount, 3);
+    ASSERT_EQ(Sum, 210);
+    
+    uint32_t Expected = 0;
+    for(uint32_t Entry : Array) ASSERT_EQ(Entry, Expected++);
+    ASSERT_EQ(Expected, 21);
+    
+    Array.Resize(16);
+    Expected = 0;
+    for(uint32_t Entry : Array) ASSERT_EQ(Entry, Expected++);
+    ASSERT_EQ(Expected, 16);
+    
+    AK_Delete(&Array);
+}
 
-#define ASSERT_STRNNE(x, y, n)                                                 \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (0 == UTEST_STRNCMP(x, y, n)) {                                         \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : \"%.*s\"\n", UTEST_CAST(int, n), x);          \
-UTEST_PRINTF("    Actual : \"%.*s\"\n", UTEST_CAST(int, n), y);          \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+UTEST(ak_bucket_array, Trim)
+{
+    ak_slab* Slab = AK_Create_Bucket_Array_Slab<uint32_t, 4>();
+    ak_bucket_array<uint32_t, 4> A = AK_Create_Bucket_Array<uint32_t, 4>(Slab);
+    ak_bucket_array<uint32_t, 4> B = AK_Create_Bucket_Array<uint32_t, 4>(Slab);
+    
+    for(uint32_t Index = 0; Index < 20; Index++) A.Add(Index);
+    ASSERT_EQ(A.Buckets.Length, 5);
+    
+    A.Resize(6);
+    A.Trim();
+    ASSERT_EQ(A.Buckets.Length, 2);
+    ASSERT_EQ(Slab->FreeBlockCount, 3);
+    ASSERT_EQ(A[5], 5);
+    
+    uint64_t SlabUsed = Slab->Arena->Get_Total_Used();
+    for(uint32_t Index = 0; Index < 12; Index++) B.Add(Index);
+    ASSERT_EQ(Slab->FreeBlockCount, 0);
+    ASSERT_EQ(Slab->Arena->Get_Total_Used(), SlabUsed);
+    
+    ak_bucket_array<uint32_t, 4> C = B.Copy();
+    ASSERT_EQ(C.Storage, Slab);
+    ASSERT_EQ(C[11], 11);
+    
+    AK_Delete(&B);
+    ASSERT_EQ(Slab->FreeBlockCount, 3);
+    
+    A.Clear();
+    A.Trim();
+    ASSERT_EQ(A.Buckets.Length, 0);
+    ASSERT_EQ(Slab->FreeBlockCount, 5);
+    A.Add(1);
+    ASSERT_EQ(A[0], 1);
+    
+    ak_bucket_array<uint32_t, 4> D;
+    D.Add(1);
+    ASSERT_TRUE(D.OwnsStorage);
+    D.Pop();
+    D.Trim();
+    ASSERT_EQ(D.Storage, NULL);
+    
+    //NOTE(EVERYONE): An array that owns its slab hands the memory of trimmed buckets back
+    for(uint32_t Index = 0; Index < 100000; Index++) D.Add(Index);
+    uint64_t PeakUsed = D.Storage->Arena->Get_Total_Used();
+    D.Resize(5);
+    D.Trim();
+    ASSERT_TRUE(D.OwnsStorage);
+    ASSERT_EQ(D.Buckets.Length, 2);
+    ASSERT_LT(D.Storage->Arena->Get_Total_Used()*100, PeakUsed);
+    ASSERT_EQ(D[4], 4);
+    D.Add(5);
+    ASSERT_EQ(D[5], 5);
+    ASSERT_EQ(D.Length, 6);
+    AK_Delete(&D);
+    
+    AK_Delete(&A);
+    AK_Delete(&C);
+    AK_Delete(Slab);
+}
+
+UTEST(ak_concurrent_bucket_array, Tests)
+{
+    ak_concurrent_bucket_array<uint32_t, 4> Array = AK_Create_Concurrent_Bucket_Array<uint32_t, 4>(3);
+    
+    ASSERT_EQ(Array.Get_Length(), 0);
+    ASSERT_EQ(Array.Get(0), NULL);
+    
+    uint32_t* First = Array.Add_And_Get(7);
+    for(uint32_t Index = 1; Index < 10; Index++) Array.Add(Index*2);
+    
+    ASSERT_EQ(*First, 7);
+    ASSERT_EQ(Array.Get_Length(), 10);
+    ASSERT_EQ(Array[0], 7);
+    ASSERT_EQ(Array[9], 18);
+    ASSERT_EQ(&Array[0], First);
+    
+    Array.Add(20);
+    Array.Add(22);
+    ASSERT_FALSE(Array.Add(24));
+    ASSERT_EQ(Array.Get_Length(), 12);
+    
+    Array.Clear();
+    ASSERT_EQ(Array.Get_Length(), 0);
+    Array.Add(1);
+    ASSERT_EQ(Array.Get_Length(), 1);
+    
+    AK_Delete(&Array);
+}
 
-#define ASSERT_NEAR(x, y, epsilon)                                             \
-UTEST_SURPRESS_WARNING_BEGIN do {                                            \
-if (utest_fabs(UTEST_CAST(double, x) - UTEST_CAST(double, y)) >            \
-UTEST_CAST(double, epsilon)) {                                         \
-UTEST_PRINTF("%s:%u: Failure\n", __FILE__, __LINE__);                    \
-UTEST_PRINTF("  Expected : %f\n", UTEST_CAST(double, x));                \
-UTEST_PRINTF("    Actual : %f\n", UTEST_CAST(double, y));                \
-*utest_result = 1;                                                       \
-return;                                                                  \
-}                                                                          \
-}                                                                            \
-while (0)                                                                    \
-UTEST_SURPRESS_WARNING_END
+#define AK__TEST_PRODUCER_COUNT 4
+#define AK__TEST_PRODUCER_ADD_COUNT 4096
 
-#define UTEST(SET, NAME)                                                       \
-UTEST_EXTERN struct utest_state_s utest_state;                               \
-static void utest_run_##SET##_##NAME(int *utest_result);                     \
-static void utest_##SET##_##NAME(int *utest_result, size_t utest_index) {    \
-(void)utest_index;                                                         \
-utest_run_##SET##_##NAME(utest_result);                                    \
-}                                                                            \
-UTEST_INITIALIZER(utest_register_##SET##_##NAME) {                           \
-const size_t index = utest_state.tests_length++;                           \
-const char *name_part = #SET "." #NAME;                                    \
-const size_t name_size = strlen(name_part) + 1;                            \
-char *name = UTEST_PTR_CAST(char *, malloc(name_size));                    \
-utest_state.tests = UTEST_PTR_CAST(                                        \
-struct utest_test_state_s *,                                           \
-utest_realloc(UTEST_PTR_CAST(void *, utest_state.tests),               \
-sizeof(struct utest_test_state_s) *                      \
-utest_state.tests_length));                          \
-if (utest_state.tests) {                                                   \
-utest_state.tests[index].func = &utest_##SET##_##NAME;                   \
-utest_state.tests[index].name = name;                                    \
-utest_state.tests[index].index = 0;                                      \
-}                                                                          \
-UTEST_SNPRINTF(name, name_size, "%s", name_part);                          \
-}                                                                            \
-void utest_run_##SET##_##NAME(int *utest_result)
+static void AK__Test_Bucket_Array_Producer(void* UserData, uint32_t ThreadIndex)
+{
+    ak_concurrent_bucket_array<uint32_t, 16>* Array = (ak_concurrent_bucket_array<uint32_t, 16>*)UserData;
+    for(uint32_t Index = 0; Index < AK__TEST_PRODUCER_ADD_COUNT; Index++)
+        Array->Add(ThreadIndex*AK__TEST_PRODUCER_ADD_COUNT + Index);
+}
 
-#define UTEST_F_SETUP(FIXTURE)                                                 \
-static void utest_f_setup_##FIXTURE(int *utest_result,                       \
-struct FIXTURE *utest_fixture)
+UTEST(ak_concurrent_bucket_array, Producers)
+{
+    //NOTE(EVERYONE): Small buckets so the producers keep racing to install new ones
+    uint32_t TotalCount = AK__TEST_PRODUCER_COUNT*AK__TEST_PRODUCER_ADD_COUNT;
+    ak_concurrent_bucket_array<uint32_t, 16> Array = AK_Create_Concurrent_Bucket_Array<uint32_t, 16>(TotalCount/16);
+    
+    AK__Test_Run_Threads(AK__TEST_PRODUCER_COUNT, AK__Test_Bucket_Array_Producer, &Array);
+    ASSERT_EQ(Array.Get_Length(), TotalCount);
+    
+    uint8_t Seen[AK__TEST_PRODUCER_COUNT*AK__TEST_PRODUCER_ADD_COUNT] = {};
+    for(uint32_t Index = 0; Index < TotalCount; Index++)
+    {
+        uint32_t Value = Array[Index];
+        ASSERT_LT(Value, TotalCount);
+        ASSERT_EQ(Seen[Value], 0);
+        Seen[Value] = 1;
+    }
+    
+    ASSERT_FALSE(Array.Add(0));
+    AK_Delete(&Array);
+}
 
-#define UTEST_F_TEARDOWN(FIXTURE)                                              \
-static void utest_f_teardown_##FIXTURE(int *utest_result,                    \
-struct FIXTURE *utest_fixture)
+UTEST(ak_hash, Hash64)
+{
+    uint8_t Buffer[256];
+    for(uint32_t Index = 0; Index < sizeof(Buffer); Index++) Buffer[Index] = (uint8_t)(Index*31+7);
+    
+    //NOTE(EVERYONE): Every length goes through a different tail path, and none of them should collide
+    ak_hashmap<uint64_t, uint32_t> Seen;
+    for(uint32_t Length = 0; Length <= sizeof(Buffer); Length++)
+    {
+        uint64_t Hash = AK_Hash64(Buffer, Length);
+        ASSERT_EQ(Hash, AK_Hash64(Buffer, Length));
+        ASSERT_TRUE(Seen.Try_Add(Hash, Length));
+        ASSERT_NE(Hash, AK_Hash64(Buffer, Length, 1));
+    }
+    
+    //NOTE(EVERYONE): Flipping a single bit of a long key changes the hash
+    uint64_t Hash = AK_Hash64(Buffer, sizeof(Buffer));
+    Buffer[100] ^= 1;
+    ASSERT_NE(Hash, AK_Hash64(Buffer, sizeof(Buffer)));
+    
+    ASSERT_EQ(AK_Hash_Function("Hello World"), AK_Hash_Function(AK_Str8_Lit("Hello World")));
+    ASSERT_NE(AK_Hash_Function(AK_Str8_Lit("Key0")), AK_Hash_Function(AK_Str8_Lit("Key1")));
+    
+    ASSERT_EQ(AK_Hash_CRC32C("123456789", 9), 0xE3069283);
+    ASSERT_EQ(AK_Hash_CRC32C("", 0), 0);
+    
+#ifndef AK__SSE42
+    //NOTE(EVERYONE): Whichever path the CPU picks has to agree with the table for every length and alignment
+    for(uint32_t Length = 0; Length < 64; Length++)
+    {
+        const uint8_t* Bytes = (const uint8_t*)Buffer + (Length % 7);
+        ASSERT_EQ(AK_Hash_CRC32C(Bytes, Length, Length), ~AK__CRC32C_Table(Bytes, Length, ~Length));
+    }
+#endif
 
-#define UTEST_F(FIXTURE, NAME)                                                 \
-UTEST_EXTERN struct utest_state_s utest_state;                               \
-static void utest_f_setup_##FIXTURE(int *, struct FIXTURE *);                \
-static void utest_f_teardown_##FIXTURE(int *, struct FIXTURE *);             \
-static void utest_run_##FIXTURE##_##NAME(int *, struct FIXTURE *);           \
-static void utest_f_##FIXTURE##_##NAME(int *utest_result,                    \
-size_t utest_index) {                 \
-struct FIXTURE fixture;                                                    \
-(void)utest_index;                                                         \
-memset(&fixture, 0, sizeof(fixture));                                      \
-utest_f_setup_##FIXTURE(utest_result, &fixture);                           \
-if (0 != *utest_result) {                                                  \
-return;                                                                  \
-}                                                                          \
-utest_run_##FIXTURE##_##NAME(utest_result, &fixture);                      \
-utest_f_teardown_##FIXTURE(utest_result, &fixture);                        \
-}                                                                            \
-UTEST_INITIALIZER(utest_register_##FIXTURE##_##NAME) {                       \
-const size_t index = utest_state.tests_length++;                           \
-const char *name_part = #FIXTURE "." #NAME;                                \
-const size_t name_size = strlen(name_part) + 1;                            \
-char *name = UTEST_PTR_CAST(char *, malloc(name_size));                    \
-utest_state.tests = UTEST_PTR_CAST(                                        \
-struct utest_test_state_s *,                                           \
-utest_realloc(UTEST_PTR_CAST(void *, utest_state.tests),               \
-sizeof(struct utest_test_state_s) *                      \
-utest_state.tests_length));                          \
-utest_state.tests[index].func = &utest_f_##FIXTURE##_##NAME;               \
-utest_state.tests[index].name = name;                                      \
-UTEST_SNPRINTF(name, name_size, "%s", name_part);                          \
-}                                                                            \
-void utest_run_##FIXTURE##_##NAME(int *utest_result,                         \
-struct FIXTURE *utest_fixture)
+    AK_Delete(&Seen);
+}
 
-#define UTEST_I_SETUP(FIXTURE)                                                 \
-static void utest_i_setup_##FIXTURE(                                         \
-int *utest_result, struct FIXTURE *utest_fixture, size_t utest_index)
+static uint32_t AK__Test_Keyword_Index(ak_str8 Word)
+{
+    switch(AK_Hash_Function(Word))
+    {
+        case AK_Str8_Lit_Hash("struct"): return ak_hash_traits<ak_str8>::Equals(Word, "struct") ? 1 : 0;
+        case AK_Str8_Lit_Hash("template"): return ak_hash_traits<ak_str8>::Equals(Word, "template") ? 2 : 0;
+        case AK_Str8_Lit_Hash("constexpr"): return ak_hash_traits<ak_str8>::Equals(Word, "constexpr") ? 3 : 0;
+    }
+    return 0;
+}
 
-#define UTEST_I_TEARDOWN(FIXTURE)                                              \
-static void utest_i_teardown_##FIXTURE(                                      \
-int *utest_result, struct FIXTURE *utest_fixture, size_t utest_index)
+UTEST(ak_hash, Const_Hash)
+{
+    const char Text[] = "The quick brown fox jumps over the lazy dog, then the lazy dog jumps over the quick brown fox again";
+    for(uint64_t Length = 0; Length < sizeof(Text); Length++)
+    {
+        ASSERT_EQ(AK_Const_Hash64(Text, Length), AK_Hash64(Text, Length));
+        ASSERT_EQ(AK_Const_Hash64(Text, Length, 1234), AK_Hash64(Text, Length, 1234));
+        ASSERT_EQ(AK_Const_Hash_Str8(Text, Length), AK_Hash_Function(AK_Str8(Text, Length)));
+    }
+    
+    static_assert(AK_Str8_Lit_Hash("Position") != AK_Str8_Lit_Hash("Normal"), "Literal hashes are compile time constants");
+    ASSERT_EQ(AK_Str8_Lit_Hash(""), AK_Hash_Function(AK_Str8_Lit("")));
+    
+    ASSERT_EQ(AK__Test_Keyword_Index(AK_Str8_Lit("template")), 2);
+    ASSERT_EQ(AK__Test_Keyword_Index(AK_Str8_Lit("struct")), 1);
+    ASSERT_EQ(AK__Test_Keyword_Index(AK_Str8_Lit("class")), 0);
+    
+    ak_hashmap<ak_str8, uint32_t> Map;
+    Map.Add(AK_Str8_Lit("Position"), 0);
+    Map.Add(AK_Str8_Lit("Normal"), 1);
+    ASSERT_EQ(*Map.Find_With_Hash("Normal", AK_Str8_Lit_Hash("Normal")), 1);
+    ASSERT_EQ(*Map.Find_With_Hash(AK_Str8_Lit("Position"), AK_Str8_Lit_Hash("Position")), 0);
+    AK_Delete(&Map);
+}
 
-#define UTEST_I(FIXTURE, NAME, INDEX)                                          \
-UTEST_EXTERN struct utest_state_s utest_state;                               \
-static void utest_run_##FIXTURE##_##NAME##_##INDEX(int *, struct FIXTURE *); \
-static void utest_i_##FIXTURE##_##NAME##_##INDEX(int *utest_result,          \
-size_t index) {             \
-struct FIXTURE fixture;                                                    \
-memset(&fixture, 0, sizeof(fixture));                                      \
-utest_i_setup_##FIXTURE(utest_result, &fixture, index);                    \
-if (0 != *utest_result) {                                                  \
-return;                                                                  \
-}                                                                          \
-utest_run_##FIXTURE##_##NAME##_##INDEX(utest_result, &fixture);            \
-utest_i_teardown_##FIXTURE(utest_result, &fixture, index);                 \
-}                                                                            \
-UTEST_INITIALIZER(utest_register_##FIXTURE##_##NAME##_##INDEX) {             \
-size_t i;                                                                  \
-utest_uint64_t iUp;                                                        \
-for (i = 0; i < (INDEX); i++) {                                            \
-const size_t index = utest_state.tests_length++;                         \
-const char *name_part = #FIXTURE "." #NAME;                              \
-const size_t name_size = strlen(name_part) + 32;                         \
-char *name = UTEST_PTR_CAST(char *, malloc(name_size));                  \
-utest_state.tests = UTEST_PTR_CAST(                                      \
-struct utest_test_state_s *,                                         \
-utest_realloc(UTEST_PTR_CAST(void *, utest_state.tests),             \
-sizeof(struct utest_test_state_s) *                    \
-utest_state.tests_length));                        \
-utest_state.tests[index].func = &utest_i_##FIXTURE##_##NAME##_##INDEX;   \
-utest_state.tests[index].index = i;                                      \
-utest_state.tests[index].name = name;                                    \
-iUp = UTEST_CAST(utest_uint64_t, i);                                     \
-UTEST_SNPRINTF(name, name_size, "%s/%" UTEST_PRIu64, name_part, iUp);    \
-}                                                                          \
-}                                                                            \
-void utest_run_##FIXTURE##_##NAME##_##INDEX(int *utest_result,               \
-struct FIXTURE *utest_fixture)
+UTEST(ak_hashmap, Find_Or_Add)
+{
+    ak_hashmap<uint32_t, uint32_t> Map;
+    
+    uint32_t Keys[] = {5, 9, 5, 12, 9, 5};
+    for(uint32_t Key : Keys)
+    {
+        bool WasInserted;
+        uint32_t* Count = Map.Find_Or_Add(Key, &WasInserted);
+        if(WasInserted) ASSERT_EQ(*Count, 0);
+        (*Count)++;
+    }
+    
+    ASSERT_EQ(Map.Length, 3);
+    ASSERT_EQ(*Map.Find(5), 3);
+    ASSERT_EQ(*Map.Find(9), 2);
+    ASSERT_EQ(*Map.Find(12), 1);
+    
+    ASSERT_FALSE(Map.Try_Add(5, 100));
+    ASSERT_EQ(*Map.Find(5), 3);
+    ASSERT_TRUE(Map.Try_Add(6, 100));
+    ASSERT_EQ(*Map.Find(6), 100);
+    
+    Map.Insert_Or_Assign(5, 50);
+    Map.Insert_Or_Assign(7, 70);
+    ASSERT_EQ(*Map.Find(5), 50);
+    ASSERT_EQ(*Map.Find(7), 70);
+    ASSERT_EQ(Map.Length, 5);
+    
+    //NOTE(EVERYONE): Grow past the initial slot capacity through the upsert path
+    for(uint32_t Index = 100; Index < 2000; Index++) *Map.Find_Or_Add(Index) = Index;
+    for(uint32_t Index = 100; Index < 2000; Index++) ASSERT_EQ(*Map.Find(Index), Index);
+    ASSERT_EQ(*Map.Find(9), 2);
+    
+    AK_Delete(&Map);
+}
 
-UTEST_WEAK
-double utest_fabs(double d);
-UTEST_WEAK
-double utest_fabs(double d) {
-    union {
-        double d;
-        utest_uint64_t u;
-    } both;
-    both.d = d;
-    both.u &= 0x7fffffffffffffffu;
-    return both.d;
+UTEST(ak_hashmap, Find_With_Hash)
+{
+    ak_hashmap<ak_str8, uint32_t> Map;
+    
+    const char* Names[] = {"Position", "Normal", "UV", "Color"};
+    for(uint32_t Index = 0; Index < 4; Index++)
+    {
+        ak_str8 Name = AK_Str8(Names[Index]);
+        uint32_t Hash = ak_hash_traits<ak_str8>::Hash(Names[Index]);
+        ASSERT_EQ(Hash, AK_Hash_Function(Name));
+        Map.Add_With_Hash(Name, Index, Hash);
+    }
+    
+    for(uint32_t Index = 0; Index < 4; Index++)
+    {
+        ASSERT_EQ(*Map.Find_As(Names[Index]), Index);
+        ASSERT_EQ(*Map.Find_With_Hash(Names[Index], ak_hash_traits<ak_str8>::Hash(Names[Index])), Index);
+    }
+    
+    ASSERT_EQ(Map.Find_As("Norm"), NULL);
+    ASSERT_EQ(Map.Find_As("Normals"), NULL);
+    ASSERT_EQ(*Map.Find(AK_Str8_Lit("UV")), 2);
+    
+    ak_str8 Normal = AK_Str8_Lit("Normal");
+    Map.Remove_With_Hash(Normal, AK_Hash_Function(Normal));
+    ASSERT_EQ(Map.Find_As("Normal"), NULL);
+    ASSERT_EQ(*Map.Find_As("Color"), 3);
+    
+    AK_Delete(&Map);
 }
 
-UTEST_WEAK
-int utest_should_filter_test(const char *filter, const char *testcase);
-UTEST_WEAK int utest_should_filter_test(const char *filter,
-                                        const char *testcase) {
-    if (filter) {
-        const char *filter_cur = filter;
-        const char *testcase_cur = testcase;
-        const char *filter_wildcard = UTEST_NULL;
-        
-        while (('\0' != *filter_cur) && ('\0' != *testcase_cur)) {
-            if ('*' == *filter_cur) {
-                /* store the position of the wildcard */
-                filter_wildcard = filter_cur;
-                
-                /* skip the wildcard character */
-                filter_cur++;
-                
-                while (('\0' != *filter_cur) && ('\0' != *testcase_cur)) {
-                    if ('*' == *filter_cur) {
-                        /*
-                           we found another wildcard (filter is something like *foo*) so we
-                           exit the current loop, and return to the parent loop to handle
-                           the wildcard case
-                        */
-                        break;
-                    } else if (*filter_cur != *testcase_cur) {
-                        /* otherwise our filter didn't match, so reset it */
-                        filter_cur = filter_wildcard;
-                    }
-                    
-                    /* move testcase along */
-                    testcase_cur++;
-                    
-                    /* move filter along */
-                    filter_cur++;
-                }
-                
-                if (('\0' == *filter_cur) && ('\0' == *testcase_cur)) {
-                    return 0;
-                }
-                
-                /* if the testcase has been exhausted, we don't have a match! */
-                if ('\0' == *testcase_cur) {
-                    return 1;
-                }
-            } else {
-                if (*testcase_cur != *filter_cur) {
-                    /* test case doesn't match filter */
-                    return 1;
-                } else {
-                    /* move our filter and testcase forward */
-                    testcase_cur++;
-                    filter_cur++;
-                }
-            }
-        }
+UTEST(ak_hashmap, Batch)
+{
+    ak_hashmap<uint64_t, uint64_t> Map;
+    
+    uint64_t Keys[1000];
+    uint64_t Values[1000];
+    for(uint32_t Index = 0; Index < 1000; Index++)
+    {
+        Keys[Index] = (uint64_t)Index*7919;
+        Values[Index] = Index;
+    }
+    
+    Map.Add_Batch(Keys, Values, 1000);
+    ASSERT_EQ(Map.Length, 1000);
+    
+    //NOTE(EVERYONE): Every other key is missing from the map
+    uint64_t Lookups[1001];
+    uint64_t* Results[1001];
+    for(uint32_t Index = 0; Index < 1001; Index++)
+        Lookups[Index] = (Index % 2) ? (uint64_t)Index*7919 : (uint64_t)Index*7919+1;
+    
+    Map.Find_Batch(Lookups, 1001, Results);
+    for(uint32_t Index = 0; Index < 1001; Index++)
+    {
+        if(Index % 2) ASSERT_EQ(*Results[Index], Index);
+        else ASSERT_EQ(Results[Index], NULL);
+    }
+    
+    AK_Delete(&Map);
+}
+
+UTEST(ak_hashmap, Incremental_Rehash)
+{
+    ak_hashmap<uint32_t, uint32_t> Map = AK_Create_Hash_Map<uint32_t, uint32_t>(16, 16);
+    Map.IncrementalRehash = true;
+    
+    static bool Removed[20000];
+    AK__Memory_Clear(Removed, sizeof(Removed));
+    
+    bool Migrated = false;
+    uint32_t RemovedCount = 0;
+    for(uint32_t Index = 0; Index < 20000; Index++)
+    {
+        Map.Add(Index, Index+1);
+        if(Map.OldSlots) Migrated = true;
         
-        if (('\0' != *filter_cur) ||
-            (('\0' != *testcase_cur) &&
-             ((filter == filter_cur) || ('*' != filter_cur[-1])))) {
-            /* we have a mismatch! */
-            return 1;
+        //NOTE(EVERYONE): Remove some keys while they may still live in the old table
+        if(Index % 3 == 0 && Map.OldSlots)
+        {
+            Map.Remove(Index/2);
+            Removed[Index/2] = true;
+            RemovedCount++;
         }
     }
+    ASSERT_TRUE(Migrated);
+    ASSERT_GT(RemovedCount, 0);
+    ASSERT_EQ(Map.Length, 20000-RemovedCount);
     
-    return 0;
+    for(uint32_t Index = 0; Index < 20000; Index++)
+    {
+        uint32_t* Value = Map.Find(Index);
+        if(Removed[Index])
+        {
+            ASSERT_EQ(Value, NULL);
+        }
+        else
+        {
+            ASSERT_NE(Value, NULL);
+            ASSERT_EQ(*Value, Index+1);
+        }
+    }
+    
+    uint32_t Length = 0;
+    for(auto Pair : Map)
+    {
+        ASSERT_EQ(*Map.Find(Pair.Key), Pair.Value);
+        Length++;
+    }
+    ASSERT_EQ(Length, Map.Length);
+    
+    AK_Delete(&Map);
 }
 
-static UTEST_INLINE FILE *utest_fopen(const char *filename, const char *mode) {
-#ifdef _MSC_VER
-    FILE *file;
-    if (0 == fopen_s(&file, filename, mode)) {
-        return file;
-    } else {
-        return UTEST_NULL;
+UTEST(ak_hashmap, Reserve)
+{
+    ak_hashmap<uint32_t, uint32_t> Map;
+    Map.MaxLoadFactor = 0.5f;
+    Map.Reserve(10000);
+    
+    uint32_t SlotCapacity = Map.SlotCapacity;
+    uint32_t ItemCapacity = Map.ItemCapacity;
+    ASSERT_TRUE(ItemCapacity >= 10000);
+    ASSERT_TRUE(SlotCapacity/2 >= 10000);
+    
+    for(uint32_t Index = 0; Index < 10000; Index++) Map.Add(Index, Index);
+    ASSERT_EQ(Map.SlotCapacity, SlotCapacity);
+    ASSERT_EQ(Map.ItemCapacity, ItemCapacity);
+    
+    for(uint32_t Index = 0; Index < 9900; Index++) Map.Remove(Index);
+    Map.Shrink_To_Fit();
+    ASSERT_EQ(Map.ItemCapacity, 100);
+    ASSERT_EQ(Map.SlotCapacity, 256);
+    
+    for(uint32_t Index = 0; Index < 10000; Index++)
+    {
+        if(Index < 9900) ASSERT_EQ(Map.Find(Index), NULL);
+        else ASSERT_EQ(*Map.Find(Index), Index);
     }
-#else
-    return fopen(filename, mode);
-#endif
+    
+    Map.Add(0, 0);
+    ASSERT_EQ(*Map.Find(0), 0);
+    
+    AK_Delete(&Map);
 }
 
-static UTEST_INLINE int utest_main(int argc, const char *const argv[]);
-int utest_main(int argc, const char *const argv[]) {
-    utest_uint64_t failed = 0;
-    size_t index = 0;
-    size_t *failed_testcases = UTEST_NULL;
-    size_t failed_testcases_length = 0;
-    const char *filter = UTEST_NULL;
-    utest_uint64_t ran_tests = 0;
-    int enable_mixed_units = 0;
-    int random_order = 0;
-    utest_uint32_t seed = 0;
+UTEST(ak_hashmap, Small)
+{
+    ak_hashmap<uint32_t, uint32_t> Map;
+    for(uint32_t Key = 1; Key <= AK_HASH_MAP_SMALL_CAPACITY; Key++) Map.Add(Key*31, Key);
+    ASSERT_EQ(Map.Slots, NULL);
+    ASSERT_EQ(Map.ItemCapacity, AK_HASH_MAP_SMALL_CAPACITY);
     
-    enum colours { RESET, GREEN, RED };
+    for(uint32_t Key = 1; Key <= AK_HASH_MAP_SMALL_CAPACITY; Key++) ASSERT_EQ(*Map.Find(Key*31), Key);
+    ASSERT_EQ(Map.Find(32), NULL);
     
-    const int use_colours = UTEST_COLOUR_OUTPUT();
-    const char *colours[] = {"\033[0m", "\033[32m", "\033[31m"};
+    Map.Remove(31);
+    ASSERT_EQ(Map.Find(31), NULL);
+    ASSERT_FALSE(Map.Try_Add(62, 0));
+    ASSERT_TRUE(Map.Try_Add(31, 1));
     
-    if (!use_colours) {
-        for (index = 0; index < sizeof colours / sizeof colours[0]; index++) {
-            colours[index] = "";
-        }
-    }
-    /* loop through all arguments looking for our options */
-    for (index = 1; index < UTEST_CAST(size_t, argc); index++) {
-        /* Informational switches */
-        const char help_str[] = "--help";
-        const char list_str[] = "--list-tests";
-        /* Test config switches */
-        const char filter_str[] = "--filter=";
-        const char output_str[] = "--output=";
-        const char enable_mixed_units_str[] = "--enable-mixed-units";
-        const char random_order_str[] = "--random-order";
-        const char random_order_with_seed_str[] = "--random-order=";
-        
-        if (0 == UTEST_STRNCMP(argv[index], help_str, strlen(help_str))) {
-            printf("utest.h - the single file unit testing solution for C/C++!\n"
-                   "Command line Options:\n"
-                   "  --help                  Show this message and exit.\n"
-                   "  --filter=<filter>       Filter the test cases to run (EG. "
-                   "MyTest*.a would run MyTestCase.a but not MyTestCase.b).\n"
-                   "  --list-tests            List testnames, one per line. Output "
-                   "names can be passed to --filter.\n");
-            printf("  --output=<output>       Output an xunit XML file to the file "
-                   "specified in <output>.\n"
-                   "  --enable-mixed-units    Enable the per-test output to contain "
-                   "mixed units (s/ms/us/ns).\n"
-                   "  --random-order[=<seed>] Randomize the order that the tests are "
-                   "ran in. If the optional <seed> argument is not provided, then a "
-                   "random starting seed is used.\n");
-            goto cleanup;
-        } else if (0 ==
-                   UTEST_STRNCMP(argv[index], filter_str, strlen(filter_str))) {
-            /* user wants to filter what test cases run! */
-            filter = argv[index] + strlen(filter_str);
-        } else if (0 ==
-                   UTEST_STRNCMP(argv[index], output_str, strlen(output_str))) {
-            utest_state.output = utest_fopen(argv[index] + strlen(output_str), "w+");
-        } else if (0 == UTEST_STRNCMP(argv[index], list_str, strlen(list_str))) {
-            for (index = 0; index < utest_state.tests_length; index++) {
-                UTEST_PRINTF("%s\n", utest_state.tests[index].name);
-            }
-            /* when printing the test list, don't actually run the tests */
-            return 0;
-        } else if (0 == UTEST_STRNCMP(argv[index], enable_mixed_units_str,
-                                      strlen(enable_mixed_units_str))) {
-            enable_mixed_units = 1;
-        } else if (0 == UTEST_STRNCMP(argv[index], random_order_with_seed_str,
-                                      strlen(random_order_with_seed_str))) {
-            seed =
-                UTEST_CAST(utest_uint32_t,
-                           strtoul(argv[index] + strlen(random_order_with_seed_str),
-                                   UTEST_NULL, 10));
-            random_order = 1;
-        } else if (0 == UTEST_STRNCMP(argv[index], random_order_str,
-                                      strlen(random_order_str))) {
-            const utest_int64_t ns = utest_ns();
-            
-            // Some really poor pseudo-random using the current time. I do this
-            // because I really want to avoid using C's rand() because that'd mean our
-            // random would be affected by any srand() usage by the user (which I
-            // don't want).
-            seed = UTEST_CAST(utest_uint32_t, ns >> 32) * 31 +
-                UTEST_CAST(utest_uint32_t, ns & 0xffffffff);
-            random_order = 1;
-        }
+    //NOTE(EVERYONE): Growing past the small capacity builds the slot table
+    Map.Add(1000, 1000);
+    ASSERT_NE(Map.Slots, NULL);
+    for(uint32_t Key = 1; Key <= AK_HASH_MAP_SMALL_CAPACITY; Key++) ASSERT_EQ(*Map.Find(Key*31), Key);
+    ASSERT_EQ(*Map.Find(1000), 1000);
+    
+    for(uint32_t Key = 1; Key <= AK_HASH_MAP_SMALL_CAPACITY; Key += 2) Map.Remove(Key*31);
+    Map.Shrink_To_Fit();
+    ASSERT_EQ(Map.Slots, NULL);
+    for(uint32_t Key = 2; Key <= AK_HASH_MAP_SMALL_CAPACITY; Key += 2) ASSERT_EQ(*Map.Find(Key*31), Key);
+    ASSERT_EQ(*Map.Find(1000), 1000);
+    ASSERT_EQ(Map.Find(31), NULL);
+    
+    AK_Delete(&Map);
+}
+
+UTEST(ak_hashmap, Clear)
+{
+    ak_hashmap<uint32_t, uint32_t> Map;
+    for(uint32_t Key = 0; Key < 50000; Key++) Map.Add(Key, Key);
+    uint32_t SlotCapacity = Map.SlotCapacity;
+    Map.Clear();
+    
+    //NOTE(EVERYONE): Reuse the large table with a handful of entries, clearing has to leave no stale slots behind
+    for(uint32_t Iteration = 0; Iteration < 100; Iteration++)
+    {
+        for(uint32_t Key = 0; Key < 64; Key++) Map.Add(Key*(Iteration+1), Key);
+        Map.Remove(Iteration+1);
+        Map.Clear();
     }
+    ASSERT_EQ(Map.SlotCapacity, SlotCapacity);
+    ASSERT_EQ(Map.Length, 0);
     
-    if (random_order) {
-        // Use Fisher-Yates with the Durstenfield's version to randomly re-order the
-        // tests.
-        for (index = utest_state.tests_length; index > 1; index--) {
-            // For the random order we'll use PCG.
-            const utest_uint32_t state = seed;
-            const utest_uint32_t word =
-            ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
-            const utest_uint32_t next = ((word >> 22u) ^ word) % index;
-            
-            // Swap the randomly chosen element into the last location.
-            const struct utest_test_state_s copy = utest_state.tests[index - 1];
-            utest_state.tests[index - 1] = utest_state.tests[next];
-            utest_state.tests[next] = copy;
-            
-            // Move the seed onwards.
-            seed = seed * 747796405u + 2891336453u;
-        }
+    for(uint32_t SlotIndex = 0; SlotIndex < Map.SlotCapacity; SlotIndex++)
+    {
+        ASSERT_FALSE(Map.Slots[SlotIndex].IsValid);
+        ASSERT_EQ(Map.Slots[SlotIndex].BaseCount, 0);
     }
     
-    for (index = 0; index < utest_state.tests_length; index++) {
-        if (utest_should_filter_test(filter, utest_state.tests[index].name)) {
-            continue;
-        }
-        
-        ran_tests++;
+    Map.Add(7, 70);
+    ASSERT_EQ(*Map.Find(7), 70);
+    ASSERT_EQ(Map.Find(8), NULL);
+    AK_Delete(&Map);
+}
+
+#ifdef AK_HASH_MAP_STATS
+UTEST(ak_hashmap, Stats)
+{
+    ak_hashmap<uint32_t, uint32_t> Map;
+    for(uint32_t Key = 0; Key < 1000; Key++) Map.Add(Key, Key);
+    for(uint32_t Key = 0; Key < 2000; Key++) Map.Find(Key);
+    
+    ak_hashmap_stats Stats = AK_Get_Hash_Map_Stats(&Map);
+    ASSERT_EQ(Stats.Length, 1000);
+    ASSERT_EQ(Stats.HitCount, 1000);
+    
+    //NOTE(EVERYONE): Every add after the map left small mode missed, as did every find of a key past 1000
+    ASSERT_EQ(Stats.MissCount, (1000-AK_HASH_MAP_SMALL_CAPACITY) + 1000);
+    ASSERT_TRUE(Stats.RehashCount > 0);
+    ASSERT_TRUE(Stats.MaxProbeLength >= 1);
+    ASSERT_TRUE(Stats.MaxClusterLength >= 1);
+    ASSERT_TRUE(Stats.LoadFactor > 0.0f && Stats.LoadFactor < 1.0f);
+    
+    uint64_t HitTotal = 0;
+    uint64_t SlotTotal = 0;
+    for(uint32_t Index = 0; Index < AK_HASH_MAP_STATS_BUCKET_COUNT; Index++)
+    {
+        HitTotal += Stats.HitProbeLengths[Index];
+        SlotTotal += Stats.BaseCounts[Index];
     }
+    ASSERT_EQ(HitTotal, Stats.HitCount);
+    ASSERT_EQ(SlotTotal, Stats.SlotCapacity);
     
-    printf("%s[==========]%s Running %" UTEST_PRIu64 " test cases.\n",
-           colours[GREEN], colours[RESET], UTEST_CAST(utest_uint64_t, ran_tests));
+    ak_arena* Arena = AK_Create_Arena();
+    ak_str8 Text = AK_Hash_Map_Stats_To_Text(Stats, Arena);
+    ak_str8 JSON = AK_Hash_Map_Stats_To_JSON(Stats, Arena);
+    ASSERT_NE(Text.Find_First('\n'), AK_STR8_FIND_ERROR);
+    ASSERT_EQ(JSON.Str[0], '{');
+    ASSERT_EQ(JSON.Str[JSON.Length-1], '}');
+    AK_Delete(Arena);
     
-    if (utest_state.output) {
-        fprintf(utest_state.output, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
-        fprintf(utest_state.output,
-                "<testsuites tests=\"%" UTEST_PRIu64 "\" name=\"All\">\n",
-                UTEST_CAST(utest_uint64_t, ran_tests));
-        fprintf(utest_state.output,
-                "<testsuite name=\"Tests\" tests=\"%" UTEST_PRIu64 "\">\n",
-                UTEST_CAST(utest_uint64_t, ran_tests));
-    }
+    AK_Delete(&Map);
+}
+#endif
+
+UTEST(ak_hashmap, Tests)
+{
+    ak_hashmap<uint32_t, uint32_t> Map;
     
-    for (index = 0; index < utest_state.tests_length; index++) {
-        int result = 0;
-        utest_int64_t ns = 0;
-        
-        if (utest_should_filter_test(filter, utest_state.tests[index].name)) {
-            continue;
-        }
-        
-        printf("%s[ RUN      ]%s %s\n", colours[GREEN], colours[RESET],
-               utest_state.tests[index].name);
-        
-        if (utest_state.output) {
-            fprintf(utest_state.output, "<testcase name=\"%s\">",
-                    utest_state.tests[index].name);
-        }
-        
-        ns = utest_ns();
-        errno = 0;
-        utest_state.tests[index].func(&result, utest_state.tests[index].index);
-        ns = utest_ns() - ns;
-        
-        if (utest_state.output) {
-            fprintf(utest_state.output, "</testcase>\n");
-        }
-        
-        // Record the failing test.
-        if (0 != result) {
-            const size_t failed_testcase_index = failed_testcases_length++;
-            failed_testcases = UTEST_PTR_CAST(
-                                              size_t *, utest_realloc(UTEST_PTR_CAST(void *, failed_testcases),
-                                                                      sizeof(size_t) * failed_testcases_length));
-            if (UTEST_NULL != failed_testcases) {
-                failed_testcases[failed_testcase_index] = index;
-            }
-            failed++;
-        }
-        
-        {
-            const char *const units[] = {"ns", "us", "ms", "s", UTEST_NULL};
-            unsigned int unit_index = 0;
-            utest_int64_t time = ns;
-            
-            if (enable_mixed_units) {
-                for (unit_index = 0; UTEST_NULL != units[unit_index]; unit_index++) {
-                    if (10000 > time) {
-                        break;
-                    }
-                    
-                    time /= 1000;
-                }
-            }
-            
-            if (0 != result) {
-                printf("%s[  FAILED  ]%s %s (%" UTEST_PRId64 "%s)\n", colours[RED],
-                       colours[RESET], utest_state.tests[index].name, time,
-                       units[unit_index]);
-            } else {
-                printf("%s[       OK ]%s %s (%" UTEST_PRId64 "%s)\n", colours[GREEN],
-                       colours[RESET], utest_state.tests[index].name, time,
-                       units[unit_index]);
-            }
-        }
+    Map.Add(5, 10);
+    Map.Add(10, 13);
+    Map.Add(4, 2);
+    
+    uint32_t* A = Map.Find(10);
+    ASSERT_EQ(*A, 13);
+    
+    uint32_t* B = Map.Find(5);
+    ASSERT_EQ(*B, 10);
+    
+    uint32_t* C = Map.Find(8);
+    ASSERT_EQ(C, NULL);
+    
+    ASSERT_EQ(Map.Length, 3);
+    
+    uint32_t Length = 0;
+    for(auto pair : Map)
+    {
+        Length++;
     }
+    ASSERT_EQ(Length, 3);
     
-    printf("%s[==========]%s %" UTEST_PRIu64 " test cases ran.\n", colours[GREEN],
-           colours[RESET], ran_tests);
-    printf("%s[  PASSED  ]%s %" UTEST_PRIu64 " tests.\n", colours[GREEN],
-           colours[RESET], ran_tests - failed);
+    Map.Remove(10);
+    ASSERT_EQ(Map.Length, 2);
     
-    if (0 != failed) {
-        printf("%s[  FAILED  ]%s %" UTEST_PRIu64 " tests, listed below:\n",
-               colours[RED], colours[RESET], failed);
-        for (index = 0; index < failed_testcases_length; index++) {
-            printf("%s[  FAILED  ]%s %s\n", colours[RED], colours[RESET],
-                   utest_state.tests[failed_testcases[index]].name);
-        }
-    }
+    uint32_t* D = Map.Find(10);
+    ASSERT_EQ(D, NULL);
+}
+
+#ifndef AK_STD_NO_FILE_IO
+UTEST(ak_mapped_hashmap, Tests)
+{
+    ak_hashmap<uint32_t, uint64_t> Map;
+    for(uint32_t Index = 0; Index < 5000; Index++) Map.Add(Index*3, (uint64_t)Index << 32);
+    ASSERT_TRUE(Map.Save("ak_hashmap_image.bin"));
     
-    if (utest_state.output) {
-        fprintf(utest_state.output, "</testsuite>\n</testsuites>\n");
+    ak_mapped_hashmap<uint32_t, uint64_t> Mapped = AK_Load_Mapped_Hash_Map<uint32_t, uint64_t>("ak_hashmap_image.bin");
+    ASSERT_EQ(Mapped.Get_Length(), 5000);
+    for(uint32_t Index = 0; Index < 5000; Index++)
+    {
+        ASSERT_EQ(*Mapped.Find(Index*3), (uint64_t)Index << 32);
+        ASSERT_EQ(Mapped.Find(Index*3+1), NULL);
+    }
+    AK_Delete(&Mapped);
+    
+    //NOTE(EVERYONE): The image stores the key and value sizes so loading with other types fails
+    ak_mapped_hashmap<uint64_t, uint64_t> Invalid = AK_Load_Mapped_Hash_Map<uint64_t, uint64_t>("ak_hashmap_image.bin");
+    ASSERT_EQ(Invalid.Get_Length(), 0);
+    ASSERT_EQ(Invalid.Find(3), NULL);
+    
+    //NOTE(EVERYONE): Corrupt slots must fail to load rather than point outside the image or break probing
+    FILE* File = fopen("ak_hashmap_image.bin", "rb");
+    fseek(File, 0, SEEK_END);
+    size_t FileSize = (size_t)ftell(File);
+    fseek(File, 0, SEEK_SET);
+    uint8_t* Image = (uint8_t*)malloc(FileSize);
+    ASSERT_EQ(fread(Image, 1, FileSize, File), FileSize);
+    fclose(File);
+    
+    ak__hashmap_image_header* Header = (ak__hashmap_image_header*)Image;
+    ak__hashmap_slot* ImageSlots = (ak__hashmap_slot*)(Image + Header->SlotsOffset);
+    uint32_t ValidSlot = 0;
+    while(!ImageSlots[ValidSlot].IsValid) ValidSlot++;
+    
+    for(uint32_t Corruption = 0; Corruption < 2; Corruption++)
+    {
+        ak__hashmap_slot Original = ImageSlots[ValidSlot];
+        if(Corruption == 0) ImageSlots[ValidSlot].ItemIndex = Header->Length+5;
+        else ImageSlots[ValidSlot].BaseCount += 1;
+        
+        File = fopen("ak_hashmap_image.bin", "wb");
+        ASSERT_EQ(fwrite(Image, 1, FileSize, File), FileSize);
+        fclose(File);
+        ImageSlots[ValidSlot] = Original;
+        
+        ak_mapped_hashmap<uint32_t, uint64_t> Corrupt = AK_Load_Mapped_Hash_Map<uint32_t, uint64_t>("ak_hashmap_image.bin");
+        ASSERT_EQ(Corrupt.Get_Length(), 0);
+        ASSERT_EQ(Corrupt.Find(3), NULL);
+    }
+    free(Image);
+    
+    ak_hashmap<ak_str8, uint32_t> Names;
+    Names.Add(AK_Str8_Lit("Albedo"), 1);
+    Names.Add(AK_Str8_Lit("Normal"), 2);
+    Names.Add(AK_Str8_Lit(""), 3);
+    ASSERT_TRUE(Names.Save("ak_hashmap_image.bin"));
+    
+    ak_mapped_hashmap<ak_str8, uint32_t> MappedNames = AK_Load_Mapped_Hash_Map<ak_str8, uint32_t>("ak_hashmap_image.bin");
+    ASSERT_EQ(MappedNames.Get_Length(), 3);
+    ASSERT_EQ(*MappedNames.Find_As("Albedo"), 1);
+    ASSERT_EQ(*MappedNames.Find(AK_Str8_Lit("Normal")), 2);
+    ASSERT_EQ(*MappedNames.Find_As(""), 3);
+    ASSERT_EQ(MappedNames.Find_As("Roughness"), NULL);
+    
+    uint32_t Sum = 0;
+    for(auto Pair : MappedNames) Sum += Pair.Value;
+    ASSERT_EQ(Sum, 6);
+    
+    AK_Delete(&MappedNames);
+    AK_Delete(&Names);
+    AK_Delete(&Map);
+    remove("ak_hashmap_image.bin");
+}
+#endif
+
+//NOTE(EVERYONE): Key whose padding bytes are not part of its identity
+struct ak__test_padded_key
+{
+    uint8_t  Kind;
+    uint32_t ID;
+};
+
+template <>
+uint32_t ak_hash_traits<ak__test_padded_key>::Hash(const ak__test_padded_key& Key)
+{
+    return AK_Hash_Function(((uint32_t)Key.Kind << 24) ^ Key.ID);
+}
+
+template <>
+bool ak_hash_traits<ak__test_padded_key>::Equals(const ak__test_padded_key& A, const ak__test_padded_key& B)
+{
+    return A.Kind == B.Kind && A.ID == B.ID;
+}
+
+UTEST(ak_static_hashmap, Tests)
+{
+    ak_str8 Keywords[] = 
+    {
+        AK_Str8_Lit("if"), AK_Str8_Lit("else"), AK_Str8_Lit("for"), AK_Str8_Lit("while"), AK_Str8_Lit("return"),
+        AK_Str8_Lit("struct"), AK_Str8_Lit("switch"), AK_Str8_Lit("case")
+    };
+    uint32_t Tokens[] = {0, 1, 2, 3, 4, 5, 6, 7};
+    
+    ak_static_hashmap<ak_str8, uint32_t> KeywordMap = AK_Create_Static_Hash_Map(Keywords, Tokens, 8);
+    ASSERT_EQ(KeywordMap.Length, 8);
+    ASSERT_EQ(*KeywordMap.Find(AK_Str8_Lit("while")), 3);
+    ASSERT_EQ(*KeywordMap.Find_As("case"), 7);
+    ASSERT_EQ(KeywordMap.Find_As("do"), NULL);
+    
+    uint32_t TokenSum = 0;
+    for(auto Pair : KeywordMap) TokenSum += Pair.Value;
+    ASSERT_EQ(TokenSum, 28);
+    
+    const uint32_t Count = 10000;
+    uint64_t* Keys = (uint64_t*)malloc(Count*sizeof(uint64_t));
+    uint32_t* Values = (uint32_t*)malloc(Count*sizeof(uint32_t));
+    for(uint32_t Index = 0; Index < Count; Index++)
+    {
+        Keys[Index] = (uint64_t)Index*2654435761u + 17;
+        Values[Index] = Index;
     }
     
-    cleanup:
-    for (index = 0; index < utest_state.tests_length; index++) {
-        free(UTEST_PTR_CAST(void *, utest_state.tests[index].name));
+    ak_static_hashmap<uint64_t, uint32_t> Map = AK_Create_Static_Hash_Map(Keys, Values, Count);
+    ASSERT_EQ(Map.Length, Count);
+    for(uint32_t Index = 0; Index < Count; Index++)
+    {
+        ASSERT_EQ(*Map.Find(Keys[Index]), Index);
+        ASSERT_EQ(Map.Find(Keys[Index]+1), NULL);
     }
     
-    free(UTEST_PTR_CAST(void *, failed_testcases));
-    free(UTEST_PTR_CAST(void *, utest_state.tests));
+    //NOTE(EVERYONE): Duplicate keys cannot be perfectly hashed
+    Keys[1] = Keys[0];
+    ak_static_hashmap<uint64_t, uint32_t> Failed = AK_Create_Static_Hash_Map(Keys, Values, Count);
+    ASSERT_EQ(Failed.Length, 0);
+    ASSERT_EQ(Failed.Keys, NULL);
     
-    if (utest_state.output) {
-        fclose(utest_state.output);
+    //NOTE(EVERYONE): Lookups have to match on Equals, not on the bytes of the key
+    ak__test_padded_key PaddedKeys[16];
+    AK__Memory_Set(PaddedKeys, 0xAB, sizeof(PaddedKeys));
+    for(uint32_t Index = 0; Index < 16; Index++)
+    {
+        PaddedKeys[Index].Kind = (uint8_t)(Index % 3);
+        PaddedKeys[Index].ID = Index*100;
     }
     
-    return UTEST_CAST(int, failed);
+    ak_static_hashmap<ak__test_padded_key, uint32_t> PaddedMap = AK_Create_Static_Hash_Map(PaddedKeys, Values, 16);
+    ASSERT_EQ(PaddedMap.Length, 16);
+    for(uint32_t Index = 0; Index < 16; Index++)
+    {
+        ak__test_padded_key Key;
+        AK__Memory_Clear(&Key, sizeof(Key));
+        Key.Kind = (uint8_t)(Index % 3);
+        Key.ID = Index*100;
+        ASSERT_EQ(*PaddedMap.Find(Key), Values[Index]);
+    }
+    
+    free(Keys);
+    free(Values);
+    AK_Delete(&Map);
+    AK_Delete(&KeywordMap);
+    AK_Delete(&PaddedMap);
 }
 
-/*
-   we need, in exactly one source file, define the global struct that will hold
-   the data we need to run utest. This macro allows the user to declare the
-   data without having to use the UTEST_MAIN macro, thus allowing them to write
-   their own main() function.
-*/
-#define UTEST_STATE() struct utest_state_s utest_state = {0, 0, 0}
+UTEST(ak_concurrent_hashmap, Tests)
+{
+    ak_concurrent_hashmap<uint32_t, uint32_t> Map = AK_Create_Concurrent_Hash_Map<uint32_t, uint32_t>(8, 16, 16);
+    
+    for(uint32_t Index = 0; Index < 4000; Index++) ASSERT_TRUE(Map.Try_Add(Index, Index*2));
+    ASSERT_FALSE(Map.Try_Add(10, 0));
+    ASSERT_EQ(Map.Get_Length(), 4000);
+    
+    //NOTE(EVERYONE): Keys have to spread over every shard
+    for(uint32_t ShardIndex = 0; ShardIndex < Map.ShardCount; ShardIndex++)
+        ASSERT_TRUE(Map.Shards[ShardIndex].Map.Length > 0);
+    
+    uint32_t Value = 0;
+    ASSERT_TRUE(Map.Find(10, &Value));
+    ASSERT_EQ(Value, 20);
+    ASSERT_FALSE(Map.Find(4000, &Value));
+    
+    Map.Insert_Or_Assign(10, 7);
+    ASSERT_TRUE(Map.Find(10, &Value));
+    ASSERT_EQ(Value, 7);
+    
+    for(uint32_t Index = 0; Index < 4000; Index += 2) ASSERT_TRUE(Map.Remove(Index));
+    ASSERT_FALSE(Map.Remove(0));
+    ASSERT_EQ(Map.Get_Length(), 2000);
+    for(uint32_t Index = 0; Index < 4000; Index++) ASSERT_EQ(Map.Contains(Index), (Index % 2) == 1);
+    
+    AK_Delete(&Map);
+    
+    //NOTE(EVERYONE): Shards created this small start without a slot table
+    ak_concurrent_hashmap<uint32_t, uint32_t> Small = AK_Create_Concurrent_Hash_Map<uint32_t, uint32_t>(16, 256, 16);
+    ASSERT_EQ(Small.Shards[0].Map.Slots, NULL);
+    ASSERT_TRUE(Small.Try_Add(1, 2));
+    ASSERT_TRUE(Small.Remove(1));
+    ASSERT_FALSE(Small.Remove(1));
+    ASSERT_FALSE(Small.Contains(1));
+    ASSERT_EQ(Small.Get_Length(), 0);
+    AK_Delete(&Small);
+}
 
-/*
-   define a main() function to call into utest.h and start executing tests! A
-   user can optionally not use this macro, and instead define their own main()
-   function and manually call utest_main. The user must, in exactly one source
-   file, use the UTEST_STATE macro to declare a global struct variable that
-   utest requires.
-*/
-#define UTEST_MAIN()                                                           \
-UTEST_STATE();                                                               \
-int main(int argc, const char *const argv[]) {                               \
-return utest_main(argc, argv);                                             \
+#define AK__TEST_MAP_THREAD_COUNT 4
+#define AK__TEST_MAP_KEY_COUNT 16384
+
+struct ak__test_concurrent_map
+{
+    ak_concurrent_hashmap<uint32_t, uint32_t> Map;
+    volatile uint64_t ErrorCount;
+};
+
+//NOTE(EVERYONE): Every thread owns the keys equal to its index modulo the thread count. It adds them, removes every 
+//third one right away and reads keys owned by the other threads while they are being written
+static void AK__Test_Concurrent_Map_Worker(void* UserData, uint32_t ThreadIndex)
+{
+    ak__test_concurrent_map* Test = (ak__test_concurrent_map*)UserData;
+    for(uint32_t Key = ThreadIndex; Key < AK__TEST_MAP_KEY_COUNT; Key += AK__TEST_MAP_THREAD_COUNT)
+    {
+        uint64_t ErrorCount = 0;
+        if(!Test->Map.Try_Add(Key, Key*3)) ErrorCount++;
+        if(Key % 3 == 0 && !Test->Map.Remove(Key)) ErrorCount++;
+        
+        uint32_t OtherKey = (Key*7 + 1) % AK__TEST_MAP_KEY_COUNT;
+        uint32_t Value;
+        if(Test->Map.Find(OtherKey, &Value) && Value != OtherKey*3) ErrorCount++;
+        
+        if(ErrorCount) AK__Atomic_Add64(&Test->ErrorCount, ErrorCount);
+    }
 }
 
-#endif /* SHEREDOM_UTEST_H_INCLUDED */
+UTEST(ak_concurrent_hashmap, Threads)
+{
+    ak__test_concurrent_map Test = {};
+    Test.Map = AK_Create_Concurrent_Hash_Map<uint32_t, uint32_t>(4);
+    
+    AK__Test_Run_Threads(AK__TEST_MAP_THREAD_COUNT, AK__Test_Concurrent_Map_Worker, &Test);
+    ASSERT_EQ(Test.ErrorCount, 0);
+    
+    uint32_t ExpectedLength = 0;
+    for(uint32_t Key = 0; Key < AK__TEST_MAP_KEY_COUNT; Key++)
+    {
+        uint32_t Value = 0;
+        bool Found = Test.Map.Find(Key, &Value);
+        ASSERT_EQ(Found, Key % 3 != 0);
+        if(Found)
+        {
+            ASSERT_EQ(Value, Key*3);
+            ExpectedLength++;
+        }
+    }
+    ASSERT_EQ(Test.Map.Get_Length(), ExpectedLength);
+    
+    AK_Delete(&Test.Map);
+}
 
-#if 1
-UTEST(ak_bucket_array, Tests)
+UTEST(ak_hashset, Tests)
 {
-    ak_bucket_array<int32_t, 3> Array;
+    ak_hashset<uint32_t> A;
+    ak_hashset<uint32_t> B;
     
-    Array.Add(5);
+    ASSERT_FALSE(A.Contains(1));
+    ASSERT_FALSE(A.Remove(1));
     
-    int32_t T = *Array.Pop();
+    for(uint32_t Index = 0; Index < 1000; Index++)
+    {
+        ASSERT_TRUE(A.Add(Index));
+        ASSERT_FALSE(A.Add(Index));
+        if(Index % 2 == 0) B.Add(Index);
+    }
+    for(uint32_t Index = 1000; Index < 1500; Index++) B.Add(Index);
+    ASSERT_EQ(A.Length, 1000);
+    
+    uint64_t Sum = 0;
+    for(uint32_t Key : A) Sum += Key;
+    ASSERT_EQ(Sum, 999*1000/2);
+    
+    ak_hashset<uint32_t> Union;
+    Union.Union(A);
+    Union.Union(B);
+    ASSERT_EQ(Union.Length, 1500);
+    
+    ak_hashset<uint32_t> Intersect;
+    Intersect.Union(A);
+    Intersect.Intersect(B);
+    ASSERT_EQ(Intersect.Length, 500);
+    for(uint32_t Key : Intersect) ASSERT_TRUE(Key % 2 == 0 && Key < 1000);
+    
+    A.Difference(B);
+    ASSERT_EQ(A.Length, 500);
+    for(uint32_t Index = 0; Index < 1000; Index++) ASSERT_EQ(A.Contains(Index), (Index % 2) == 1);
+    
+    //NOTE(EVERYONE): Sets grow through the ak_hashmap engine, so they follow the same settings
+    ak_hashset<uint32_t> Sparse;
+    Sparse.MaxLoadFactor = 0.25f;
+    Sparse.IncrementalRehash = true;
+    
+    bool Migrated = false;
+    for(uint32_t Index = 0; Index < 5000; Index++)
+    {
+        ASSERT_TRUE(Sparse.Add(Index));
+        if(Sparse.OldSlots) Migrated = true;
+        if(Index % 4 == 0) ASSERT_TRUE(Sparse.Remove(Index/2));
+        ASSERT_LE(Sparse.Length, Sparse.SlotCapacity/4);
+    }
+    ASSERT_TRUE(Migrated);
+    ASSERT_EQ(Sparse.Length, 5000-1250);
+    for(uint32_t Index = 0; Index < 5000; Index++)
+    {
+        bool WasRemoved = (Index % 2 == 0) && Index < 2500;
+        ASSERT_EQ(Sparse.Contains(Index), !WasRemoved);
+    }
     
-    ASSERT_EQ(Array.CurrentBucketIndex, 0);
-    ASSERT_EQ(Array.Length, 0);
-    ASSERT_EQ(Array.Buckets[0]->Length, 0);
-    ASSERT_EQ(T, 5);
+    AK_Delete(&A);
+    AK_Delete(&B);
+    AK_Delete(&Union);
+    AK_Delete(&Intersect);
+    AK_Delete(&Sparse);
+}
+
+UTEST(ak_hash_multimap, Tests)
+{
+    ak_hash_multimap<uint32_t, uint32_t> Map;
+    ASSERT_EQ(Map.Find(1).Length, 0);
     
-    Array.Add(6);
-    Array.Add(12);
+    //NOTE(EVERYONE): Value i belongs to key i % 7, interleaved so nothing arrives grouped
+    for(uint32_t Index = 0; Index < 700; Index++) Map.Add(Index % 7, Index);
+    ASSERT_EQ(Map.Length, 700);
     
-    ASSERT_EQ(Array.Length, 2);
-    ASSERT_EQ(Array.Buckets.Length, 1);
-    ASSERT_EQ(Array[1], 12);
+    for(uint32_t Key = 0; Key < 7; Key++)
+    {
+        ak_array<uint32_t> Values = Map.Find(Key);
+        ASSERT_EQ(Values.Length, 100);
+        for(uint32_t Index = 0; Index < Values.Length; Index++)
+            ASSERT_EQ(Values[Index], Key + Index*7);
+    }
+    ASSERT_EQ(Map.Find(7).Length, 0);
+    
+    //NOTE(EVERYONE): Adding after a build appends to the existing groups and creates new ones
+    Map.Add(3, 5000);
+    Map.Add(42, 42);
+    ak_array<uint32_t> Three = Map.Find(3);
+    ASSERT_EQ(Three.Length, 101);
+    ASSERT_EQ(Three[0], 3);
+    ASSERT_EQ(Three[100], 5000);
+    ASSERT_EQ(Map.Find(42).Length, 1);
+    ASSERT_EQ(Map.Find(6).Length, 100);
+    
+    Map.Clear();
+    ASSERT_EQ(Map.Find(3).Length, 0);
+    Map.Add(3, 1);
+    ASSERT_EQ(Map.Find(3)[0], 1);
+    AK_Delete(&Map);
+    
+    //NOTE(EVERYONE): Finds between adds only pack the new pairs, so the packed array stays proportional to the values
+    ak_hash_multimap<uint32_t, uint32_t> Mixed;
+    for(uint32_t Index = 0; Index < 20000; Index++)
+    {
+        uint32_t Key = (Index % 5 == 0) ? Index : Index % 3;
+        Mixed.Add(Key, Index);
+        
+        ak_array<uint32_t> Values = Mixed.Find(Key);
+        ASSERT_EQ(Values[Values.Length-1], Index);
+        ASSERT_LE(Mixed.PackedCapacity, Mixed.Length*8);
+    }
+    ak_array<uint32_t> Twos = Mixed.Find(2);
+    for(uint32_t Index = 1; Index < Twos.Length; Index++)
+    {
+        ASSERT_EQ(Twos[Index] % 3, 2);
+        ASSERT_LT(Twos[Index-1], Twos[Index]);
+    }
+    ASSERT_EQ(Mixed.Find(15000).Length, 1);
     
-    Array.Add(4);
-    Array.Add(5);
-    ASSERT_EQ(Array.CurrentBucketIndex, 1);
-    ASSERT_EQ(Array.Buckets[1]->Length, 1);
+    Mixed.Build();
+    ASSERT_EQ(Mixed.PackedLength, Mixed.Length);
+    ASSERT_EQ(Mixed.Find(2).Length, Twos.Length);
+    AK_Delete(&Mixed);
     
-    T = *Array.Pop();
-    ASSERT_EQ(Array.CurrentBucketIndex, 0);
-    ASSERT_EQ(Array.Buckets[0]->Length, 3);
-    ASSERT_EQ(T, 5);
+    ak_hash_multimap<ak_str8, uint32_t> Names = AK_Create_Hash_Multimap<ak_str8, uint32_t>();
+    Names.Add(AK_Str8_Lit("Mesh"), 1);
+    Names.Add(AK_Str8_Lit("Texture"), 2);
+    Names.Add(AK_Str8_Lit("Mesh"), 3);
+    ASSERT_EQ(Names.Find_As("Mesh").Length, 2);
+    ASSERT_EQ(Names.Find_As("Mesh")[1], 3);
+    ASSERT_EQ(Names.Find_As("Sound").Length, 0);
+    AK_Delete(&Names);
+}
+
+UTEST(ak_paged_hashmap, Tests)
+{
+    ak_arena* Arena = AK_Create_Arena();
+    ak_paged_hashmap<uint32_t, uint64_t> Map = AK_Create_Paged_Hash_Map<uint32_t, uint64_t>(Arena, 100);
     
-    Array.Add(5);
+    Map.Add(5, 50);
+    uint64_t* Five = Map.Find(5);
     
-    int32_t Temp[5] = {1, 2, 3, 4, 5};
-    Array.Add_Range(Temp, 5);
+    //NOTE(EVERYONE): Grow far past the estimate, items never move
+    for(uint32_t Key = 6; Key < 20000; Key++) Map.Add(Key, (uint64_t)Key*10);
+    ASSERT_EQ(Map.Length, 19995);
+    ASSERT_EQ(Map.Find(5), Five);
+    ASSERT_EQ(*Five, 50);
+    for(uint32_t Key = 5; Key < 20000; Key++) ASSERT_EQ(*Map.Find(Key), (uint64_t)Key*10);
+    ASSERT_EQ(Map.Find(4), NULL);
+    ASSERT_TRUE(Map.RetiredBlocks != NULL || Map.PageCount > 1);
     
-    ASSERT_EQ(Array.CurrentBucketIndex, 2);
-    ASSERT_EQ(Array.Buckets[2]->Length, 3);
+    //NOTE(EVERYONE): Outgrown slot tables are reused as pages, so the arena holds little more than the final map
+    uint64_t SlotBytes = Map.SlotCapacity*sizeof(ak__hashmap_slot);
+    uint64_t PageBytes = (uint64_t)Map.PageCount*(AK__Paged_HashMap_Links_Offset(&Map) + (sizeof(uint32_t) << Map.PageShift));
+    ASSERT_TRUE(Arena->Get_Total_Used() < SlotBytes*2 + PageBytes);
     
-    ASSERT_EQ(Array.Length, 9);
-    ASSERT_EQ(Array[7], 4);
+    ASSERT_TRUE(Map.Remove(7));
+    ASSERT_FALSE(Map.Remove(7));
+    uint64_t* Reused = Map.Find_Or_Add(1);
+    ASSERT_EQ(*Reused, 0);
+    ASSERT_EQ(Map.Find(7), NULL);
+    ASSERT_EQ(*Map.Find(8), 80);
     
+    //NOTE(EVERYONE): Refilling after a clear does not touch the arena
+    uint64_t Used = Arena->Get_Total_Used();
+    Map.Clear();
+    ASSERT_EQ(Map.Find(5), NULL);
+    for(uint32_t Key = 0; Key < 15000; Key++) Map.Add(Key*3, Key);
+    ASSERT_EQ(Arena->Get_Total_Used(), Used);
+    ASSERT_EQ(*Map.Find(300), 100);
     
-    ak_bucket_array<int32_t, 3> Array2 = Array.Copy();
-    ASSERT_EQ(Array.Length, Array2.Length);
-    ASSERT_EQ(Array.CurrentBucketIndex, Array2.CurrentBucketIndex);
-    ASSERT_EQ(Array.Buckets.Length, Array2.Buckets.Length);
+    ak_paged_hashmap<ak_str8, uint32_t> Names = AK_Create_Paged_Hash_Map<ak_str8, uint32_t>(Arena, 4);
+    Names.Add(AK_Str8_Lit("Mesh"), 1);
+    ASSERT_EQ(*Names.Find_As("Mesh"), 1);
+    ASSERT_EQ(Names.Find_As("Sound"), NULL);
     
-    for(uint64_t Index = 0; Index < Array.Length; Index++)
+    AK_Delete(Arena);
+}
+
+UTEST(ak_swiss_hashmap, Tests)
+{
+    ak_swiss_hashmap<uint32_t, uint32_t> Map;
+    
+    for(uint32_t Index = 0; Index < 1000; Index++) Map.Add(Index, Index*3);
+    ASSERT_EQ(Map.Length, 1000);
+    
+    for(uint32_t Index = 0; Index < 1000; Index++) ASSERT_EQ(*Map.Find(Index), Index*3);
+    ASSERT_EQ(Map.Find(1000), NULL);
+    
+    for(uint32_t Index = 0; Index < 1000; Index += 2) Map.Remove(Index);
+    ASSERT_EQ(Map.Length, 500);
+    
+    for(uint32_t Index = 0; Index < 1000; Index++)
     {
-        ASSERT_EQ(Array[Index], Array2[Index]);
+        if(Index % 2) ASSERT_EQ(*Map.Find(Index), Index*3);
+        else ASSERT_EQ(Map.Find(Index), NULL);
     }
     
+    //NOTE(EVERYONE): Churn through deleted slots so the table has to rehash in place
+    uint32_t SlotCapacity = Map.SlotCapacity;
+    for(uint32_t Index = 2000; Index < 20000; Index++)
+    {
+        Map.Add(Index, Index);
+        Map.Remove(Index);
+    }
+    ASSERT_EQ(Map.SlotCapacity, SlotCapacity);
+    ASSERT_EQ(Map.Length, 500);
+    
     uint32_t Length = 0;
-    for(int32_t x : Array)
+    for(auto Pair : Map)
     {
+        ASSERT_EQ(Pair.Value, Pair.Key*3);
         Length++;
     }
-    ASSERT_EQ(Length, Array.Length);
+    ASSERT_EQ(Length, 500);
     
-    for(uint64_t BucketIndex = 0; BucketIndex < Array.Buckets.Length; BucketIndex++)
+    Map.Clear();
+    ASSERT_EQ(Map.Find(1), NULL);
+    
+    AK_Delete(&Map);
+}
+
+UTEST(ak_robin_hood_hashmap, Tests)
+{
+    ak_robin_hood_hashmap<uint32_t, uint32_t> Map;
+    
+    for(uint32_t Index = 0; Index < 5000; Index++) Map.Add(Index, Index*2);
+    for(uint32_t Index = 0; Index < 5000; Index += 3) Map.Remove(Index);
+    
+    //NOTE(EVERYONE): Churn through removes, which must not leave probe runs behind
+    for(uint32_t Iteration = 0; Iteration < 20000; Iteration++)
     {
-        ASSERT_EQ(Array.Buckets[BucketIndex]->Length, Array2.Buckets[BucketIndex]->Length);
+        uint32_t Key = 100000 + Iteration;
+        Map.Add(Key, Key*2);
+        Map.Remove(Key);
     }
     
-    ak_bucket_array<int32_t, 3> Array3 = Array.Copy();
+    for(uint32_t Index = 0; Index < 5000; Index++)
+    {
+        if(Index % 3) ASSERT_EQ(*Map.Find(Index), Index*2);
+        else ASSERT_EQ(Map.Find(Index), NULL);
+    }
     
-    Array.Resize(7);
-    Array2.Resize(17);
-    Array3.Resize(2);
+    uint32_t MaxDistance = 0;
+    for(uint32_t Slot = 0; Slot < Map.SlotCapacity; Slot++)
+    {
+        if(Map.Slots[Slot].Distance)
+        {
+            uint32_t BaseSlot = Map.Slots[Slot].Hash & (Map.SlotCapacity-1);
+            ASSERT_EQ(Map.Slots[Slot].Distance-1, (Slot-BaseSlot) & (Map.SlotCapacity-1));
+            MaxDistance = AK__Max(MaxDistance, Map.Slots[Slot].Distance);
+        }
+    }
+    ASSERT_TRUE(MaxDistance < 64);
     
-    ASSERT_EQ(Array.CurrentBucketIndex, 2);
-    ASSERT_EQ(Array2.Buckets.Length, 6);
-    ASSERT_EQ(Array2.CurrentBucketIndex, 5);
-    ASSERT_EQ(Array3.CurrentBucketIndex, 0);
+    uint32_t Length = 0;
+    for(auto Pair : Map)
+    {
+        ASSERT_EQ(Pair.Value, Pair.Key*2);
+        Length++;
+    }
+    ASSERT_EQ(Length, Map.Length);
+    
+    AK_Delete(&Map);
 }
 
-UTEST(ak_hashmap, Tests)
+UTEST(ak_btree_map, Tests)
 {
-    ak_hashmap<uint32_t, uint32_t> Map;
+    ak_btree_map<uint32_t, uint32_t> Map;
     
-    Map.Add(5, 10);
-    Map.Add(10, 13);
-    Map.Add(4, 2);
+    //NOTE(EVERYONE): Insert in a scrambled order so splits happen all over the tree
+    for(uint32_t Index = 0; Index < 20000; Index++)
+    {
+        uint32_t Key = (Index*7919) % 20000;
+        Map.Add(Key, Key*2);
+    }
+    ASSERT_EQ(Map.Length, 20000);
+    ASSERT_TRUE(Map.Height > 1);
     
-    uint32_t* A = Map.Find(10);
-    ASSERT_EQ(*A, 13);
+    uint32_t Expected = 0;
+    for(auto Pair : Map)
+    {
+        ASSERT_EQ(Pair.Key, Expected);
+        ASSERT_EQ(Pair.Value, Expected*2);
+        Expected++;
+    }
+    ASSERT_EQ(Expected, 20000);
     
-    uint32_t* B = Map.Find(5);
-    ASSERT_EQ(*B, 10);
+    ASSERT_EQ(*Map.Find(12345), 24690);
+    ASSERT_EQ(Map.Find(20000), NULL);
     
-    uint32_t* C = Map.Find(8);
-    ASSERT_EQ(C, NULL);
+    for(uint32_t Key = 0; Key < 20000; Key++)
+        if(Key % 2 == 0 || (Key >= 5000 && Key < 9000)) ASSERT_TRUE(Map.Remove(Key));
+    ASSERT_FALSE(Map.Remove(0));
     
-    ASSERT_EQ(Map.Length, 3);
+    uint32_t Count = 0;
+    uint32_t Last = 0;
+    for(auto Pair : Map.Range(4000, 10000))
+    {
+        ASSERT_TRUE(Pair.Key % 2 == 1 && (Pair.Key < 5000 || Pair.Key >= 9000));
+        ASSERT_TRUE(Pair.Key > Last);
+        Last = Pair.Key;
+        Count++;
+    }
+    ASSERT_EQ(Count, 1000);
+    ASSERT_EQ((*Map.Lower_Bound(5000)).Key, 9001);
+    
+    //NOTE(EVERYONE): Removing almost everything merges the leaves back together and hands them to the slab
+    uint64_t FreeBlockCount = Map.Storage->FreeBlockCount;
+    for(uint32_t Key = 0; Key < 20000; Key++)
+        if(Key % 100 != 1) Map.Remove(Key);
+    ASSERT_EQ(Map.Length, 160);
+    ASSERT_TRUE(Map.Storage->FreeBlockCount > FreeBlockCount);
+    
+    typedef ak__btree_leaf<uint32_t, uint32_t> test_leaf;
+    uint32_t LeafCount = 0;
+    for(test_leaf* Leaf = Map.FirstLeaf; Leaf; Leaf = Leaf->Next)
+    {
+        if(Leaf->Next) ASSERT_EQ(Leaf->Next->Prev, Leaf);
+        LeafCount++;
+    }
+    ASSERT_TRUE(LeafCount <= 160/(test_leaf::Capacity/2));
     
-    uint32_t Length = 0;
-    for(auto pair : Map)
+    Expected = 1;
+    for(auto Pair : Map)
     {
-        Length++;
+        if(Expected == 5001) Expected = 9001;
+        ASSERT_EQ(Pair.Key, Expected);
+        ASSERT_EQ(*Map.Find(Expected), Expected*2);
+        Expected += 100;
     }
-    ASSERT_EQ(Length, 3);
+    ASSERT_EQ(Expected, 20001);
     
-    Map.Remove(10);
-    ASSERT_EQ(Map.Length, 2);
+    for(uint32_t Key = 1; Key < 20000; Key += 100) ASSERT_EQ(Map.Remove(Key), Key < 5000 || Key >= 9000);
+    ASSERT_EQ(Map.Length, 0);
+    ASSERT_EQ(Map.Root, NULL);
+    ASSERT_EQ(Map.Height, 0);
+    Map.Add(7, 14);
+    ASSERT_EQ(*Map.Find(7), 14);
     
-    uint32_t* D = Map.Find(10);
-    ASSERT_EQ(D, NULL);
+    AK_Delete(&Map);
+    
+    //NOTE(EVERYONE): Generic key path with a shared slab and bulk loading
+    ak_slab* Slab = AK_Create_BTree_Map_Slab<uint64_t, double>();
+    ak_btree_map<uint64_t, double> Sorted = AK_Create_BTree_Map<uint64_t, double>(Slab);
+    
+    uint64_t* Keys = (uint64_t*)malloc(10000*sizeof(uint64_t));
+    double* Values = (double*)malloc(10000*sizeof(double));
+    for(uint32_t Index = 0; Index < 10000; Index++)
+    {
+        Keys[Index] = (uint64_t)Index*10;
+        Values[Index] = Index*0.5;
+    }
+    Sorted.Bulk_Load(Keys, Values, 10000);
+    ASSERT_EQ(Sorted.Length, 10000);
+    
+    for(uint32_t Index = 0; Index < 10000; Index++) ASSERT_EQ(*Sorted.Find(Keys[Index]), Index*0.5);
+    ASSERT_EQ(Sorted.Find(15), NULL);
+    
+    Sorted.Add(15, 1.0);
+    Count = 0;
+    for(auto Pair : Sorted.Range(0, 31))
+    {
+        ASSERT_TRUE(Pair.Key == 0 || Pair.Key == 10 || Pair.Key == 15 || Pair.Key == 20 || Pair.Key == 30);
+        Count++;
+    }
+    ASSERT_EQ(Count, 5);
+    
+    //NOTE(EVERYONE): Bulk loaded trees rebalance on remove like built up ones
+    for(uint32_t Index = 0; Index < 10000; Index++)
+        if(Index % 3) ASSERT_TRUE(Sorted.Remove(Keys[Index]));
+    for(uint32_t Index = 0; Index < 10000; Index++)
+    {
+        double* Value = Sorted.Find(Keys[Index]);
+        if(Index % 3) ASSERT_EQ(Value, NULL);
+        else ASSERT_EQ(*Value, Index*0.5);
+    }
+    ASSERT_EQ(Sorted.Length, 3335);
+    
+    free(Keys);
+    free(Values);
+    AK_Delete(&Sorted);
+    AK_Delete(Slab);
+}
+
+static void AK__Test_LRU_Evict(const uint32_t& Key, uint32_t* Value, uint64_t UserData)
+{
+    uint32_t* EvictedSum = (uint32_t*)UserData;
+    *EvictedSum += Key + *Value;
+}
+
+UTEST(ak_lru_cache, Tests)
+{
+    uint32_t EvictedSum = 0;
+    ak_lru_cache<uint32_t, uint32_t> Cache = AK_Create_LRU_Cache<uint32_t, uint32_t>(4);
+    Cache.EvictCallback = AK__Test_LRU_Evict;
+    Cache.EvictUserData = (uint64_t)&EvictedSum;
+    
+    for(uint32_t Key = 0; Key < 4; Key++) Cache.Put(Key, Key*10);
+    ASSERT_EQ(*Cache.Get(0), 0);
+    Cache.Put(4, 40);
+    
+    //NOTE(EVERYONE): 0 was touched so 1 is the least recent
+    ASSERT_EQ(Cache.Get(1), NULL);
+    ASSERT_EQ(EvictedSum, 11);
+    ASSERT_EQ(Cache.Length, 4);
+    
+    ASSERT_TRUE(Cache.Remove(2));
+    ASSERT_FALSE(Cache.Remove(2));
+    Cache.Put(5, 50);
+    Cache.Put(6, 60);
+    ASSERT_EQ(Cache.Get(3), NULL);
+    ASSERT_EQ(*Cache.Get(0), 0);
+    ASSERT_EQ(*Cache.Get(6), 60);
+    AK_Delete(&Cache);
+    
+    //NOTE(EVERYONE): Clock mode with cost based capacity
+    ak_lru_cache<uint32_t, uint32_t> Clock = AK_Create_LRU_Cache<uint32_t, uint32_t>(64, 100, AK_CACHE_POLICY_CLOCK);
+    Clock.Put(1, 1, 40);
+    Clock.Put(2, 2, 40);
+    ASSERT_EQ(*Clock.Get(1), 1);
+    Clock.Put(3, 3, 40);
+    
+    ASSERT_EQ(Clock.Get(2), NULL);
+    ASSERT_EQ(*Clock.Get(1), 1);
+    ASSERT_EQ(*Clock.Get(3), 3);
+    ASSERT_EQ(Clock.TotalCost, 80);
+    
+    //NOTE(EVERYONE): An entry larger than the budget evicts everything else but stays cached itself
+    Clock.Put(4, 4, 500);
+    ASSERT_EQ(Clock.Length, 1);
+    ASSERT_EQ(*Clock.Get(4), 4);
+    
+    for(uint32_t Key = 0; Key < 1000; Key++)
+    {
+        Clock.Put(Key, Key, 1);
+        if(Key % 3 == 0) Clock.Get(Key/2);
+    }
+    ASSERT_EQ(Clock.Length, 64);
+    ASSERT_EQ(Clock.TotalCost, 64);
+    ASSERT_EQ(Clock.Lookup.Length, 64);
+    
+    AK_Delete(&Clock);
 }
 
 UTEST(ak_pool, Tests)